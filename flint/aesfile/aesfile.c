@@ -0,0 +1,246 @@
+/******************************************************************************/
+/*                                                                            */
+/*  Software supplement to the book "Cryptography in C and C++"               */
+/*  by Michael Welschenbach                                                   */
+/*                                                                            */
+/*  Module aesfile.c        Revision: 19.10.2026                              */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 2001-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+
+/* Encryption and decryption of files with the AES streaming API, reports  */
+/* the throughput achieved for benchmarking with large files               */
+
+/* POSIX interfaces for file descriptors and timing */
+#define _XOPEN_SOURCE 600
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include "flint.h"
+#include "aes.h"
+#include "aesstrm.h"
+
+static int scanhex (UCHAR *Out, char *Hex, int MaxLen);
+static void usage (void);
+
+
+int main (int argc, char *argv[])
+{
+  AESWORKSPACE ws;
+  AESKEYSCHED ks;
+  AESKEY RawKey;
+  AESBLOCK IV;
+  struct timeval start, stop;
+  struct stat st;
+  double secs;
+  int mode = AES_CTR, DFlag = AES_ENC, Method = AESSTREAM_AUTO;
+  int KeyLength = 128, repeat = 1, i, infd, outfd, error;
+
+  memset (RawKey, 0, sizeof (RawKey));
+  memset (IV, 0, sizeof (IV));
+
+  while (--argc > 0 && (*++argv)[0] == '-')
+    {
+      switch ((*argv)[1])
+        {
+          case 'd':
+            DFlag = AES_DEC;
+            break;
+
+          case 'm':
+            if (--argc == 0)
+              {
+                usage ();
+              }
+            ++argv;
+            if (!strcmp (*argv, "ecb"))
+              {
+                mode = AES_ECB;
+              }
+            else if (!strcmp (*argv, "cbc"))
+              {
+                mode = AES_CBC;
+              }
+            else if (!strcmp (*argv, "ctr"))
+              {
+                mode = AES_CTR;
+              }
+            else
+              {
+                usage ();
+              }
+            break;
+
+          case 'k':
+            if (--argc == 0)
+              {
+                usage ();
+              }
+            KeyLength = atoi (*++argv);
+            break;
+
+          case 's':
+            if (--argc == 0)
+              {
+                usage ();
+              }
+            ++argv;
+            if (!strcmp (*argv, "mmap"))
+              {
+                Method = AESSTREAM_MMAP;
+              }
+            else if (!strcmp (*argv, "buf"))
+              {
+                Method = AESSTREAM_BUFFERED;
+              }
+            else if (!strcmp (*argv, "auto"))
+              {
+                Method = AESSTREAM_AUTO;
+              }
+            else
+              {
+                usage ();
+              }
+            break;
+
+          case 'r':
+            if (--argc == 0)
+              {
+                usage ();
+              }
+            repeat = atoi (*++argv);
+            break;
+
+          default:
+            usage ();
+        }
+    }
+
+  if (argc != 4 || repeat < 1 ||
+      scanhex (RawKey, argv[0], KeyLength >> 3) < 0 ||
+      scanhex (IV, argv[1], 16) < 0)
+    {
+      usage ();
+    }
+
+  secs = 0.0;
+  for (i = 0; i < repeat; i++)
+    {
+      if ((infd = open (argv[2], O_RDONLY)) < 0)
+        {
+          perror (argv[2]);
+          exit (1);
+        }
+
+      if ((outfd = open (argv[3], O_RDWR | O_CREAT | O_TRUNC, 0600)) < 0)
+        {
+          perror (argv[3]);
+          exit (1);
+        }
+
+      if ((error = AESInit (&ws, mode, 128, IV, &ks, RawKey, KeyLength, DFlag)) != AES_OK)
+        {
+          fprintf (stderr, "AESInit failed, error %d\n", error);
+          exit (1);
+        }
+
+      gettimeofday (&start, NULL);
+      error = AESCryptFd (outfd, infd, &ws, &ks, Method);
+      gettimeofday (&stop, NULL);
+
+      secs += (stop.tv_sec - start.tv_sec) + (stop.tv_usec - start.tv_usec) / 1e6;
+
+      fstat (infd, &st);
+      close (infd);
+      close (outfd);
+      AESPurge (&ws, &ks);
+
+      if (error != AES_OK)
+        {
+          fprintf (stderr, "AESCryptFd failed, error %d\n", error);
+          exit (1);
+        }
+    }
+
+  secs /= repeat;
+  printf ("%s %ld bytes in %.3f s", (DFlag == AES_ENC) ? "Encrypted" : "Decrypted",
+          (long)st.st_size, secs);
+  if (secs > 0.0)
+    {
+      printf (", %.1f MB/s", (double)st.st_size / secs / 1e6);
+    }
+  printf ("\n");
+
+  memset (RawKey, 0, sizeof (RawKey));
+  return 0;
+}
+
+
+static int scanhex (UCHAR *Out, char *Hex, int MaxLen)
+{
+  int i, hi, lo;
+
+  for (i = 0; Hex[0] && Hex[1]; i++, Hex += 2)
+    {
+      if (i == MaxLen ||
+          sscanf (Hex, "%1x", &hi) != 1 || sscanf (Hex + 1, "%1x", &lo) != 1)
+        {
+          return -1;
+        }
+      Out[i] = (UCHAR)((hi << 4) | lo);
+    }
+
+  return (*Hex) ? -1 : i;
+}
+
+
+static void usage (void)
+{
+  fprintf (stderr, "Usage: aesfile [-d] [-m ecb|cbc|ctr] [-k 128|192|256] [-s mmap|buf|auto]\n");
+  fprintf (stderr, "               [-r repeat] key iv infile outfile\n");
+  fprintf (stderr, "       key and iv in hexadecimal, missing bytes are set to 0\n");
+  exit (1);
+}
@@ -12,5 +12,5 @@ REM A reinitialization of the bank of registers by an application is without
 REM effect, though the application has to free the allocated registers in its
 REM own responsibility.
 
-cl -O2 -DFLINT_ASM -I..\..\src -LD -MD -DFLINT_INITRAND ..\..\flint.c ..\..\aes.c ..\..\ripemd.c ..\..\sha1.c ..\..\sha256.c ..\..\random.c ..\..\entropy.c dllmain.c ..\flintavc.lib advapi32.lib flint.def
+cl -O2 -DFLINT_ASM -I..\..\src -LD -MD -DFLINT_INITRAND ..\..\flint.c ..\..\aes.c ..\..\aesgcm.c ..\..\ripemd.c ..\..\sha1.c ..\..\sha256.c ..\..\sha512.c ..\..\hashmb.c ..\..\hmac.c ..\..\multihash.c ..\..\random.c ..\..\entropy.c dllmain.c ..\flintavc.lib advapi32.lib flint.def
 
@@ -64,8 +64,8 @@ FLINTLIB = flint
 #FLINTLIB = flinta
 
 
-rsademo: rsademo.o rsakey.o flintpp.o flint.o random.o entropy.o aes.o ripemd.o sha1.o randompp.o
-	gcc $(EXECUTABLE) rsademo.o rsakey.o random.o entropy.o aes.o ripemd.o sha1.o randompp.o flintpp.o flint.o -l$(FLINTLIB) -l$(STDCPP)
+rsademo: rsademo.o rsakey.o flintpp.o flint.o random.o entropy.o aes.o ripemd.o sha1.o randompp.o primepar.o primeparpp.o primepool.o threadrand.o
+	gcc $(EXECUTABLE) rsademo.o rsakey.o random.o entropy.o aes.o ripemd.o sha1.o randompp.o primepar.o primeparpp.o primepool.o threadrand.o flintpp.o flint.o -l$(FLINTLIB) -l$(STDCPP) -lpthread
 
 rsademo.o: rsademo.cpp
 	gcc $(CFLAGS) rsademo.cpp
@@ -85,6 +85,18 @@ ripemd.o: ../src/ripemd.c
 randompp.o: ../src/randompp.cpp
 	gcc $(CFLAGS) ../src/randompp.cpp
 
+primepar.o: ../src/primepar.c
+	gcc $(CFLAGS) ../src/primepar.c
+
+primeparpp.o: ../src/primeparpp.cpp
+	gcc $(CFLAGS) ../src/primeparpp.cpp
+
+primepool.o: ../src/primepool.c
+	gcc $(CFLAGS) ../src/primepool.c
+
+threadrand.o: ../src/threadrand.c
+	gcc $(CFLAGS) ../src/threadrand.c
+
 random.o: ../src/random.c
 	gcc $(CFLAGS) ../src/random.c
 
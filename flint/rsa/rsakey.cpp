@@ -82,14 +82,18 @@ RSAkey::RSAkey (int bitlen)
 // a random exponent is created. If the given exponent is even, an error 
 // condition is generated, that can be handled by try() and catch() if 
 // exceptions are enabled.
+// The primes are searched by Threads threads in parallel if Threads != 1
+// (0: number of processors). If a prime pool for bitlen/2 and PubExp is
+// defined by PrimePoolAdd_l, the primes are taken from the pool as long
+// as it is not empty.
 
-RSAkey::RSAkey (int bitlen, STATEPRNG& xrstate, const LINT& PubExp)
+RSAkey::RSAkey (int bitlen, STATEPRNG& xrstate, const LINT& PubExp, int Threads)
 {
   int done;
 
   do
     {
-      done = RSAkey::makekey (bitlen, xrstate, PubExp);
+      done = RSAkey::makekey (bitlen, xrstate, PubExp, Threads);
     }
   while (!done);
 }
@@ -189,25 +193,68 @@ void RSAkey::purge (void)
 // A public exponent may be given in PubExp. If PubExp is omitted or
 // PubExp == 1 a public exponent of half the modulus length
 // is choosen at random.
+// If Threads != 1 the primes are searched by Threads threads in parallel.
 
-int RSAkey::makekey (int length, STATEPRNG& xrstate, const LINT& PubExp)
+int RSAkey::makekey (int length, STATEPRNG& xrstate, const LINT& PubExp, int Threads)
 {
-  // Generate prime p
-  // 2^(m - r - 1) <= p < 2^(m - r), with
-  // m = floor((length + 1)/2) and r randomly chosen from intervall 2 <= r < 15
-  const USHORT m = (((const USHORT)length + 1) >> 1) - 2 - sRand_l (&xrstate) % 13;
-
-  key.p = FindPrime (m, PubExp, xrstate);
-
-  // Determine intervall qmin and qmax for prime q
-  // Set qmin = floor ((2^(length - 1))/p + 1)
-  LINT qmin = LINT(0).setbit (length - 1)/key.p + 1;
-  // Set qmax = floor ((2^length - 1)/p)
-  LINT qmax = (((LINT(0).setbit (length - 1) - 1) << 1) + 1)/key.p; 
-
-  // Generate prime q > p
-  // qmin <= q <= qmax
-  key.q = FindPrime (qmin, qmax, PubExp, xrstate);
+  // Take primes p and q of length/2 binary digits from the prime pool
+  // if one is defined for length/2 and PubExp, see primepool.h. Since
+  // sqrt(2) * 2^(length/2 - 1) < p, q < 2^(length/2), the modulus p*q
+  // has exactly length binary digits. Primes missing in the pool are
+  // generated as follows.
+  CLINT pp_l;
+  int pooledp = 0, pooledq = 0;
+
+  if (0 == (length & 1) &&
+      0 == PrimePoolGet_l (pp_l, (USHORT)(length >> 1), PubExp.lint2clint ()))
+    {
+      key.p = LINT (pp_l);
+      pooledp = 1;
+      if (0 == PrimePoolGet_l (pp_l, (USHORT)(length >> 1), PubExp.lint2clint ()) &&
+          LINT (pp_l) != key.p)
+        {
+          key.q = LINT (pp_l);
+          pooledq = 1;
+        }
+    }
+  memset (pp_l, 0, sizeof (pp_l));
+
+  if (!pooledp)
+    {
+      // Generate prime p
+      // 2^(m - r - 1) <= p < 2^(m - r), with
+      // m = floor((length + 1)/2) and r randomly chosen from intervall 2 <= r < 15
+      const USHORT m = (((const USHORT)length + 1) >> 1) - 2 - sRand_l (&xrstate) % 13;
+
+      if (1 == Threads)
+        {
+          key.p = FindPrime (m, PubExp, xrstate);
+        }
+      else
+        {
+          key.p = FindPrimePar (m, PubExp, xrstate, Threads, PRIMEPAR_FIRST);
+        }
+    }
+
+  if (!pooledq)
+    {
+      // Determine intervall qmin and qmax for prime q
+      // Set qmin = floor ((2^(length - 1))/p + 1)
+      LINT qmin = LINT(0).setbit (length - 1)/key.p + 1;
+      // Set qmax = floor ((2^length - 1)/p)
+      LINT qmax = (((LINT(0).setbit (length - 1) - 1) << 1) + 1)/key.p; 
+
+      // Generate prime q > p
+      // qmin <= q <= qmax
+      if (1 == Threads)
+        {
+          key.q = FindPrime (qmin, qmax, PubExp, xrstate);
+        }
+      else
+        {
+          key.q = FindPrimePar (qmin, qmax, PubExp, xrstate, Threads, PRIMEPAR_FIRST);
+        }
+    }
 
   // Generate modulus p*q
   // 2^(length - 1) <= p*q < 2^length
@@ -52,6 +52,8 @@
 #define __RSAKEYH__             // rsakey.h is #included
 
 #include "flintpp.h"
+#include "primepar.h"
+#include "primepool.h"
 #include "ripemd.h"
 #include "sha1.h"
 
@@ -80,7 +82,7 @@ class RSAkey
   public:
     inline RSAkey (void) {};
     RSAkey (int);
-    RSAkey (int, STATEPRNG&, const LINT& = 1);
+    RSAkey (int, STATEPRNG&, const LINT& = 1, int = 1);
     PKEYSTRUCT export_public (void) const;
     UCHAR* decrypt (const LINT&, int*);
     LINT sign (const UCHAR* ,int);
@@ -96,7 +98,7 @@ class RSAkey
     KEYSTRUCT key;
 
     // Auxiliary functions
-    int makekey (int, STATEPRNG&, const LINT& = 1);
+    int makekey (int, STATEPRNG&, const LINT& = 1, int = 1);
     int testkey (STATEPRNG&);
     LINT fastdecrypt (const LINT&);
 };
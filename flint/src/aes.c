@@ -675,6 +675,18 @@ static inline void FinalRound (AESSTATE State, AESROUNDKEY RoundKey, int Nb);
 static inline void InvRound (AESSTATE State, AESROUNDKEY RoundKey, int Nb);
 static inline void InvFinalRound (AESSTATE State, AESROUNDKEY RoundKey, int Nb);
 
+/* Interleaved processing of blocks with individual keys */
+static void EncState4Keys (AESSTATE *States, ULONG **ExpandedKeys, int Nk);
+
+/* Counter mode */
+static int CryptCTR (AESBLOCK OutBlock, AESWORKSPACE *ws, ULONG *xpkey,
+                     int Nk, AESBLOCK InBlock, int InLength);
+
+/* Selection of the key schedule for a workspace */
+static int GetKey (AESWORKSPACE *ws, AESKEYSCHED *ks, ULONG **xpkey,
+                   int *Nk, int *DFlag);
+static inline void IncCounter (UCHAR *Ctr, int Len);
+
 /* Functions for purging security critical data */
 static inline void ZeroUchar (UCHAR *a);
 static inline void Zero2Uchar (UCHAR *a, UCHAR *b);
@@ -702,11 +714,13 @@ static inline void PrintState (char * step, AESSTATE State, int Nb);
 /*              int KeyLength (Length of user key in bit: 128, 192, 256)      */
 /*              int BlkLength (Length of plaintext/cipherblocks in bit)       */
 /*              int DFlag (Encipher/decipher mode AES_ENC, AES_DEC)           */
-/*              int mode (Mode of operation AES_ECB, AES_CBC)                 */
+/*              int mode (Mode of operation AES_ECB, AES_CBC, AES_CTR)        */
 /*  Output:     AESKEYSCHED *CookedKey (Keyschedule)                          */
+/*              In CTR mode the key schedule for encryption is generated      */
+/*              for both directions                                           */
 /*  Returns:    E_AES_OK if everything is O.K.                                */
 /*              E_AES_DIRECTION if DFlag != AES_ENC or AES_DEC                */
-/*              E_AES_MODE if mode != AES_ECB or AES_CBC                      */
+/*              E_AES_MODE if mode != AES_ECB, AES_CBC or AES_CTR             */
 /*              E_AES_KEYLENGTH if KeyLength != 128, 192 or 256               */
 /*                                                                            */
 /******************************************************************************/
@@ -738,7 +752,7 @@ AESKeySched_l (AESKEYSCHED *CookedKey, AESKEY RawKey, int KeyLength,
       return AES_ERR_BLKLENGTH;
     }
 
-  switch (DFlag)
+  switch ((mode == AES_CTR) ? AES_ENC : DFlag)
     {
       case AES_ENC:
         AESKeyExpansion (CookedKey->ExpandedKey, RawKey, KeyLength, BlkLength);
@@ -765,9 +779,10 @@ AESKeySched_l (AESKEYSCHED *CookedKey, AESKEY RawKey, int KeyLength,
 /*              AESInit_l (AESWORKSPACE *ws, int mode, int BlkLength,         */
 /*                       AESBLOCK IV, AESKEYSCHED *CookedKey, AESKEY RawKey,  */
 /*                       int KeyLength, int DFlag);                           */
-/*  Input:      int mode (Mode of operation AES_ECB, AES_CBC)                 */
+/*  Input:      int mode (Mode of operation AES_ECB, AES_CBC, AES_CTR)        */
 /*              int BlkLength (Length of plaintext/cipherblocks in bit)       */
 /*              AESBLOCK IV (Initialization vector for CBC mode operation,    */
+/*                           initial counter block for CTR mode operation,    */
 /*                           IV may be NULL for ECB mode)                     */
 /*              AESKEY RawKey (Key vector provided by user)                   */
 /*              int KeyLength (Length of user key in bit: 128, 192, 256)      */
@@ -776,7 +791,7 @@ AESKeySched_l (AESKEYSCHED *CookedKey, AESKEY RawKey, int KeyLength,
 /*              AESKEYSCHED *CookedKey (Keyschedule)                          */
 /*  Returns:    E_AES_OK if everything is O.K.                                */
 /*              E_AES_DIRECTION if DFlag != AES_ENC or AES_DEC                */
-/*              E_AES_MODE if mode != AES_ECB or AES_CBC                      */
+/*              E_AES_MODE if mode != AES_ECB, AES_CBC or AES_CTR             */
 /*              E_AES_KEYLENGTH if KeyLength != 128, 192 or 256               */
 /*              E_AES_BLKLENGTH if BlkLength != 128, 192 or 256               */
 /*                                                                            */
@@ -786,7 +801,7 @@ AESInit_l (AESWORKSPACE *ws, int mode, int BlkLength, AESBLOCK IV,
            AESKEYSCHED *CookedKey, AESKEY RawKey, int KeyLength, int DFlag)
 {
   int col, col4, Nb;
-  if ((mode != AES_CBC) && (mode != AES_ECB))
+  if ((mode != AES_CBC) && (mode != AES_ECB) && (mode != AES_CTR))
     {
 #ifdef AES_TEST
       fprintf (stderr, "AES_ERR_MODE in line %d\n", __LINE__);
@@ -822,6 +837,8 @@ AESInit_l (AESWORKSPACE *ws, int mode, int BlkLength, AESBLOCK IV,
 
   ws->mode = mode;
   ws->BlkLength = BlkLength;
+  ws->Key = NULL;
+  ws->DFlag = DFlag;
   Nb = BlkLength/32;
 
   AESKeySched (CookedKey, RawKey, KeyLength, BlkLength, DFlag, mode);
@@ -845,26 +862,194 @@ AESInit_l (AESWORKSPACE *ws, int mode, int BlkLength, AESBLOCK IV,
         }
     }
 
+  if (ws->mode == AES_CTR)
+    {
+      memcpy (ws->IV, IV, (size_t)(BlkLength >> 3));
+      ws->KeyStreamPos = BlkLength >> 3;
+    }
+
   return AES_OK;
 }
   
 
 /******************************************************************************/
 /*                                                                            */
-/*  Function:   AES encryption and decryption with support for ECB/CBC modes  */
+/*  Function:   Set up of a cached key holding the expanded keys for          */
+/*              encryption and decryption                                     */
+/*              After set up the cached key is only read, it may be shared    */
+/*              by any number of workspaces and threads                       */
+/*  Syntax:     int                                                           */
+/*              AESKeyCacheInit_l (AESKEYCACHE *Key, AESKEY RawKey,           */
+/*                                      int KeyLength, int BlkLength);        */
+/*  Input:      AESKEY RawKey (Key vector provided by user)                   */
+/*              int KeyLength (Length of user key in bit: 128, 192, 256)      */
+/*              int BlkLength (Length of plaintext/cipherblocks in bit)       */
+/*  Output:     AESKEYCACHE *Key (Cached key)                                 */
+/*  Returns:    E_AES_OK if everything is O.K.                                */
+/*              E_AES_INIT if Key == NULL                                     */
+/*              E_AES_KEYLENGTH if KeyLength != 128, 192 or 256               */
+/*              E_AES_BLKLENGTH if BlkLength != 128, 192 or 256               */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+AESKeyCacheInit_l (AESKEYCACHE *Key, AESKEY RawKey, int KeyLength,
+                                                    int BlkLength)
+{
+  if (Key == NULL)
+    {
+      return AES_ERR_INIT;
+    }
+
+  if ((KeyLength != 128) && (KeyLength != 192) && (KeyLength != 256))
+    {
+#ifdef AES_TEST
+      fprintf (stderr, "AES_ERR_KEYLENGTH in line %d\n", __LINE__);
+#endif
+      return AES_ERR_KEYLENGTH;
+    }
+
+  if ((BlkLength != 128) && (BlkLength != 192) && (BlkLength != 256))
+    {
+#ifdef AES_TEST
+      fprintf (stderr, "AES_ERR_BLKLENGTH in line %d\n", __LINE__);
+#endif
+      return AES_ERR_BLKLENGTH;
+    }
+
+  TestEndian (&IsBigEndian);
+
+  AESKeyExpansion (Key->EncKey, RawKey, KeyLength, BlkLength);
+  AESInvKeyExpansion (Key->DecKey, RawKey, KeyLength, BlkLength);
+  Key->KeyLength = KeyLength;
+  Key->BlkLength = BlkLength;
+
+  return AES_OK;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Initialization of a workspace referencing a cached key        */
+/*              No key expansion is performed, the workspace is used with     */
+/*              AESCrypt_l (OutBlock, ws, NULL, InBlock, InLength)            */
+/*  Syntax:     int                                                           */
+/*              AESInitCached_l (AESWORKSPACE *ws, int mode, AESBLOCK IV,     */
+/*                               const AESKEYCACHE *Key, int DFlag);          */
+/*  Input:      int mode (Mode of operation AES_ECB, AES_CBC, AES_CTR)        */
+/*              AESBLOCK IV (Initialization vector for CBC mode operation,    */
+/*                           initial counter block for CTR mode operation,    */
+/*                           IV may be NULL for ECB mode)                     */
+/*              const AESKEYCACHE *Key (Cached key set up by                  */
+/*                                      AESKeyCacheInit_l)                    */
+/*              int DFlag (Encipher/decipher mode AES_ENC, AES_DEC)           */
+/*  Output:     AESWORKSPACE *ws (Initialized buffer)                         */
+/*  Returns:    E_AES_OK if everything is O.K.                                */
+/*              E_AES_INIT if Key == NULL                                     */
+/*              E_AES_DIRECTION if DFlag != AES_ENC or AES_DEC                */
+/*              E_AES_MODE if mode != AES_ECB, AES_CBC or AES_CTR             */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+AESInitCached_l (AESWORKSPACE *ws, int mode, AESBLOCK IV,
+                                   const AESKEYCACHE *Key, int DFlag)
+{
+  int col, col4, Nb;
+
+  if (ws == NULL || Key == NULL)
+    {
+      return AES_ERR_INIT;
+    }
+
+  if ((mode != AES_CBC) && (mode != AES_ECB) && (mode != AES_CTR))
+    {
+#ifdef AES_TEST
+      fprintf (stderr, "AES_ERR_MODE in line %d\n", __LINE__);
+#endif
+      return AES_ERR_MODE;
+    }
+
+  if ((DFlag != AES_ENC) && (DFlag != AES_DEC))
+    {
+#ifdef AES_TEST
+      fprintf (stderr, "AES_ERR_DIRECTION in line %d\n", __LINE__);
+#endif
+      return AES_ERR_DIRECTION;
+    }
+
+  ws->mode = mode;
+  ws->BlkLength = Key->BlkLength;
+  ws->Key = Key;
+  ws->DFlag = DFlag;
+  Nb = Key->BlkLength/32;
+
+  if (ws->mode == AES_CBC)
+    {
+      switch (DFlag)
+        {
+          case AES_ENC:
+            for (col = col4 = 0; col < Nb; col++, col4+=4)
+              {
+                ws->State[col] = UC2UL(&IV[col4]);
+              }
+            break;
+          case AES_DEC:
+            for (col = col4 = 0; col < Nb; col++, col4+=4)
+              {
+                ws->Block[col] = UC2UL(&IV[col4]);
+              }
+            break;
+        }
+    }
+
+  if (ws->mode == AES_CTR)
+    {
+      memcpy (ws->IV, IV, (size_t)(Key->BlkLength >> 3));
+      ws->KeyStreamPos = Key->BlkLength >> 3;
+    }
+
+  return AES_OK;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Purging of a cached key                                       */
+/*              The caller must make sure that no workspace references Key    */
+/*  Syntax:     void                                                          */
+/*              AESKeyCachePurge_l (AESKEYCACHE *Key);                        */
+/*  Input:      AESKEYCACHE *Key (Cached key)                                 */
+/*  Output:     AESKEYCACHE *Key (Overwritten with 0)                         */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+void __FLINT_API
+AESKeyCachePurge_l (AESKEYCACHE *Key)
+{
+  memset ((char *)Key, 0, sizeof (AESKEYCACHE));
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   AES encryption and decryption with support for ECB/CBC/CTR    */
+/*              modes                                                         */
 /*              Processing of several portions of text by subsequent calls to */
-/*              AESCrypt_l is supported for ECB and CBC mode                  */
+/*              AESCrypt_l is supported for ECB, CBC and CTR mode             */
 /*              If not #defined AES_COMPACT fast table lookup is performed    */
 /*  Syntax:     int                                                           */
 /*              AESCrypt_l (AESBLOCK OutBlock, AESWORKSPACE *ws,              */
 /*                          AESKEYSCHED *ks, AESBLOCK InBlock, int InLength); */
 /*  Input:      AESWORKSPACE *ws (Initialized buffer)                         */
-/*              AESKEYSCHED *ks (Initialized Keyschedule)                     */
+/*              AESKEYSCHED *ks (Initialized Keyschedule, may be NULL if ws   */
+/*                               was initialized by AESInitCached_l)          */
 /*              AESBLOCK InBlock (Plaintext/Ciphertext)                       */
 /*              int InLength (Length of InBlock in bytes                      */
 /*                            InLength = 0 mod BlkLength/8 given in AESInit_l */
+/*                            for ECB and CBC mode, arbitrary for CTR mode)   */
 /*  Output:     AESBLOCK OutBlock (Ciphertext/Plaintext)                      */
+/*              OutBlock may be identical with InBlock                        */
 /*  Returns:    E_AES_OK if everything is O.K.                                */
+/*              E_AES_INIT if no key schedule is available                    */
 /*              E_AES_DIRECTION if DFlag differs in ws and ks                 */
 /*              E_AES_MODE if mode differs in ws and ks                       */
 /*              E_AES_KEYLENGTH if KeyLength given in ks != 128, 192 or 256   */
@@ -875,9 +1060,11 @@ int __FLINT_API
 AESCrypt_l (AESBLOCK OutBlock, AESWORKSPACE *ws, AESKEYSCHED *ks, 
             AESBLOCK InBlock, int InLength)
 {
-  int indx, blck, block, col, Nbc, Nbw, Nk, noofblocks;
+  int indx, blck, block, par, col, Nbc, Nbw, Nk, DFlag, noofblocks, error;
+  AESSTATE States[AES_PARBLOCKS], Cipher[AES_PARBLOCKS];
+  ULONG *xpkey;
 
-  if (ws == NULL || ks == NULL || InBlock == NULL)
+  if (ws == NULL || InBlock == NULL)
     {
 #ifdef AES_TEST
       fprintf (stderr, "AES_ERR_INIT in line %d\n", __LINE__);
@@ -885,35 +1072,18 @@ AESCrypt_l (AESBLOCK OutBlock, AESWORKSPACE *ws, AESKEYSCHED *ks,
       return AES_ERR_INIT;
     }
 
-  if (ws->mode != ks->mode)
+  if ((error = GetKey (ws, ks, &xpkey, &Nk, &DFlag)) != AES_OK)
     {
-#ifdef AES_TEST
-      fprintf (stderr, "AES_ERR_MODE in line %d\n", __LINE__);
-#endif
-      return AES_ERR_MODE;
-    }
-
-  if (ws->BlkLength != ks->BlkLength)
-    {
-#ifdef AES_TEST
-      fprintf (stderr, "AES_ERR_BLKLENGTH in line %d\n", __LINE__);
-#endif
-      return AES_ERR_BLKLENGTH;
+      return error;
     }
 
-  if ((ks->KeyLength != 128) && 
-      (ks->KeyLength != 192) && 
-      (ks->KeyLength != 256))
+  if (ws->mode == AES_CTR)
     {
-#ifdef AES_TEST
-      fprintf (stderr, "AES_ERR_KEYLENGTH in line %d\n", __LINE__);
-#endif
-      return AES_ERR_KEYLENGTH;
+      return CryptCTR (OutBlock, ws, xpkey, Nk, InBlock, InLength);
     }
 
   Nbc = ws->BlkLength/8;
   Nbw = ws->BlkLength/32;
-  Nk = ks->KeyLength/32;
   noofblocks = InLength/Nbc;
 
   if (InLength % Nbc)
@@ -927,7 +1097,7 @@ AESCrypt_l (AESBLOCK OutBlock, AESWORKSPACE *ws, AESKEYSCHED *ks,
   switch (ws->mode)
     {
       case AES_ECB:
-        switch (ks->DFlag)
+        switch (DFlag)
           {
             case AES_ENC: /* ECB-Mode */
               for (block = 0; block < noofblocks; block++)
@@ -939,7 +1109,7 @@ AESCrypt_l (AESBLOCK OutBlock, AESWORKSPACE *ws, AESKEYSCHED *ks,
                       ws->State[col] = UC2UL(&InBlock[indx]);
                     }
 
-                  AESEncState (ws->State, ks->ExpandedKey, Nk, Nbw);
+                  AESEncState (ws->State, xpkey, Nk, Nbw);
 
                   for (col = 0; col < Nbw; col++)
                     {
@@ -962,7 +1132,7 @@ AESCrypt_l (AESBLOCK OutBlock, AESWORKSPACE *ws, AESKEYSCHED *ks,
                       ws->State[col] = UC2UL(&InBlock[indx]);
                     }
 
-                  AESDecState (ws->State, ks->ExpandedKey, Nk, Nbw);
+                  AESDecState (ws->State, xpkey, Nk, Nbw);
 
                   for (col = 0; col < Nbw; col++)
                     {
@@ -980,7 +1150,7 @@ AESCrypt_l (AESBLOCK OutBlock, AESWORKSPACE *ws, AESKEYSCHED *ks,
         break;
 
       case AES_CBC:
-        switch (ks->DFlag)
+        switch (DFlag)
           {
             case AES_ENC: /* CBC-Mode */
               for (block = 0; block < noofblocks; block++)
@@ -992,7 +1162,7 @@ AESCrypt_l (AESBLOCK OutBlock, AESWORKSPACE *ws, AESKEYSCHED *ks,
                       ws->State[col] ^= UC2UL(&InBlock[indx]);
                     }
 
-                  AESEncState (ws->State, ks->ExpandedKey, Nk, Nbw);
+                  AESEncState (ws->State, xpkey, Nk, Nbw);
 
                   for (col = 0; col < Nbw; col++)
                     {
@@ -1006,7 +1176,56 @@ AESCrypt_l (AESBLOCK OutBlock, AESWORKSPACE *ws, AESKEYSCHED *ks,
 
               break;
             case AES_DEC: /* CBC-Mode */
-              for (block = 0; block < noofblocks; block++)
+              block = 0;
+
+              /* Decryption of CBC blocks is independent, hence
+                 AES_PARBLOCKS blocks are processed interleaved */
+              if (Nbw == 4)
+                {
+                  for (; block + AES_PARBLOCKS <= noofblocks;
+                       block += AES_PARBLOCKS)
+                    {
+                      blck = Nbc*block;
+                      for (par = 0; par < AES_PARBLOCKS; par++)
+                        {
+                          for (col = 0; col < Nbw; col++)
+                            {
+                              indx = blck + Nbc*par + ((unsigned)col<<2);
+                              Cipher[par][col] = UC2UL(&InBlock[indx]);
+                              States[par][col] = Cipher[par][col];
+                            }
+                        }
+
+                      AESDecState4 (States, xpkey, Nk);
+
+                      for (par = 0; par < AES_PARBLOCKS; par++)
+                        {
+                          for (col = 0; col < Nbw; col++)
+                            {
+                              indx = blck + Nbc*par + ((unsigned)col<<2);
+
+                              States[par][col] ^= (par == 0) ?
+                                  ws->Block[col] : Cipher[par - 1][col];
+
+                              OutBlock[indx]     = (UCHAR)(States[par][col]      );
+                              OutBlock[indx + 1] = (UCHAR)(States[par][col] >>  8);
+                              OutBlock[indx + 2] = (UCHAR)(States[par][col] >> 16);
+                              OutBlock[indx + 3] = (UCHAR)(States[par][col] >> 24);
+                            }
+                        }
+
+                      for (col = 0; col < Nbw; col++)
+                        {
+                          ws->Block[col] = Cipher[AES_PARBLOCKS - 1][col];
+                        }
+                    }
+
+#ifdef AES_SECURE
+                  ZeroUcharArray ((UCHAR *)States, sizeof (States));
+#endif
+                }
+
+              for (; block < noofblocks; block++)
                 {
                   blck = Nbc*block;
                   for (col = 0; col < Nbw; col++)
@@ -1015,7 +1234,7 @@ AESCrypt_l (AESBLOCK OutBlock, AESWORKSPACE *ws, AESKEYSCHED *ks,
                       ws->State[col] = UC2UL(&InBlock[indx]);
                     }
 
-                  AESDecState (ws->State, ks->ExpandedKey, Nk, Nbw);
+                  AESDecState (ws->State, xpkey, Nk, Nbw);
 
                   for (col = 0; col < Nbw; col++)
                     {
@@ -1045,6 +1264,406 @@ AESCrypt_l (AESBLOCK OutBlock, AESWORKSPACE *ws, AESKEYSCHED *ks,
 }
 
 
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   AES CBC encryption of several independent streams             */
+/*              Each stream has its own workspace and key schedule. Since     */
+/*              CBC encryption of a single stream is strictly sequential,     */
+/*              blocks of up to AES_PARBLOCKS different streams with equal    */
+/*              key length are encrypted interleaved. Streams are assigned    */
+/*              to free lanes as soon as a previous stream is finished.       */
+/*              If fewer streams remain, the free lanes run idle.             */
+/*              Chaining values are kept in the workspaces, hence streams     */
+/*              may be continued by AESCrypt_l or further calls to            */
+/*              AESCryptCBCMulti_l                                            */
+/*  Syntax:     int                                                           */
+/*              AESCryptCBCMulti_l (UCHAR **OutBlocks, AESWORKSPACE **ws,     */
+/*                                  AESKEYSCHED **ks, UCHAR **InBlocks,       */
+/*                                  int *InLengths, int NoOfStreams);         */
+/*  Input:      AESWORKSPACE **ws (Workspaces initialized for CBC mode,       */
+/*                                 blocklength 128 bit, one for each stream)  */
+/*              AESKEYSCHED **ks (Key schedules for encryption, ks or ks[i]   */
+/*                                may be NULL for workspaces initialized by   */
+/*                                AESInitCached_l)                            */
+/*              UCHAR **InBlocks (Plaintexts)                                 */
+/*              int *InLengths (Lengths of plaintexts in bytes, multiples of  */
+/*                              16)                                           */
+/*              int NoOfStreams (Number of streams)                           */
+/*  Output:     UCHAR **OutBlocks (Ciphertexts, each OutBlocks[i] may be      */
+/*                                 identical with InBlocks[i])                */
+/*  Returns:    E_AES_OK if everything is O.K.                                */
+/*              E_AES_INIT if a pointer is NULL or NoOfStreams < 0            */
+/*              E_AES_MODE if mode of a stream is not AES_CBC                 */
+/*              E_AES_DIRECTION if a key schedule is not for encryption       */
+/*              E_AES_KEYLENGTH if KeyLength given in ks != 128, 192 or 256   */
+/*              E_AES_BLKLENGTH if BlkLength of a stream != 128 or            */
+/*                              InLengths[i] != 0 mod 16                      */
+/*              No data is processed if an error is returned                  */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+AESCryptCBCMulti_l (UCHAR **OutBlocks, AESWORKSPACE **ws, AESKEYSCHED **ks,
+                    UCHAR **InBlocks, int *InLengths, int NoOfStreams)
+{
+  int stream, next, lane, nolanes, busy, Nk, nk, DFlag;
+  int noofblocks, block, col, indx, error;
+  int Stream[AES_PARBLOCKS], Pos[AES_PARBLOCKS];
+  ULONG *Keys[AES_PARBLOCKS], *xpkey;
+  AESSTATE States[AES_PARBLOCKS];
+
+  if (ws == NULL || InBlocks == NULL || OutBlocks == NULL ||
+      InLengths == NULL || NoOfStreams < 0)
+    {
+      return AES_ERR_INIT;
+    }
+
+  for (stream = 0; stream < NoOfStreams; stream++)
+    {
+      if (ws[stream] == NULL ||
+          InBlocks[stream] == NULL || OutBlocks[stream] == NULL)
+        {
+          return AES_ERR_INIT;
+        }
+
+      if ((error = GetKey (ws[stream], (ks == NULL) ? NULL : ks[stream],
+                           &xpkey, &nk, &DFlag)) != AES_OK)
+        {
+          return error;
+        }
+
+      if (ws[stream]->mode != AES_CBC)
+        {
+          return AES_ERR_MODE;
+        }
+
+      if (DFlag != AES_ENC)
+        {
+          return AES_ERR_DIRECTION;
+        }
+
+      if (ws[stream]->BlkLength != 128 ||
+          InLengths[stream] < 0 || (InLengths[stream] & 15))
+        {
+          return AES_ERR_BLKLENGTH;
+        }
+    }
+
+  /* Only streams with equal key lengths share the interleaved kernel,
+     therefore the streams are scheduled separately for each key length */
+  for (Nk = 4; Nk <= 8; Nk += 2)
+    {
+      next = 0;
+      nolanes = 0;
+
+      for (;;)
+        {
+          /* Assign pending streams to free lanes */
+          while (nolanes < AES_PARBLOCKS)
+            {
+              for (; next < NoOfStreams; next++)
+                {
+                  GetKey (ws[next], (ks == NULL) ? NULL : ks[next],
+                          &xpkey, &nk, &DFlag);
+                  if (nk == Nk && InLengths[next] > 0)
+                    {
+                      break;
+                    }
+                }
+
+              if (next == NoOfStreams)
+                {
+                  break;
+                }
+
+              Stream[nolanes] = next;
+              Pos[nolanes] = 0;
+              Keys[nolanes] = xpkey;
+              nolanes++;
+              next++;
+            }
+
+          if (nolanes == 0)
+            {
+              break;
+            }
+
+          /* Encrypt as many blocks as the shortest stream in the lanes
+             has left. Lanes without a stream duplicate lane 0, their
+             results are discarded */
+          noofblocks = InLengths[Stream[0]] - Pos[0];
+          for (lane = 1; lane < nolanes; lane++)
+            {
+              if (InLengths[Stream[lane]] - Pos[lane] < noofblocks)
+                {
+                  noofblocks = InLengths[Stream[lane]] - Pos[lane];
+                }
+            }
+          noofblocks >>= 4;
+
+          for (lane = nolanes; lane < AES_PARBLOCKS; lane++)
+            {
+              Keys[lane] = Keys[0];
+            }
+
+          for (block = 0; block < noofblocks; block++)
+            {
+              for (lane = 0; lane < nolanes; lane++)
+                {
+                  stream = Stream[lane];
+                  for (col = 0; col < 4; col++)
+                    {
+                      indx = Pos[lane] + ((unsigned)col<<2);
+                      States[lane][col] = ws[stream]->State[col] ^
+                                          UC2UL(&InBlocks[stream][indx]);
+                    }
+                }
+
+              for (lane = nolanes; lane < AES_PARBLOCKS; lane++)
+                {
+                  for (col = 0; col < 4; col++)
+                    {
+                      States[lane][col] = States[0][col];
+                    }
+                }
+
+              EncState4Keys (States, Keys, Nk);
+
+              for (lane = 0; lane < nolanes; lane++)
+                {
+                  stream = Stream[lane];
+                  for (col = 0; col < 4; col++)
+                    {
+                      indx = Pos[lane] + ((unsigned)col<<2);
+                      ws[stream]->State[col] = States[lane][col];
+                      OutBlocks[stream][indx]     = (UCHAR)(States[lane][col]      );
+                      OutBlocks[stream][indx + 1] = (UCHAR)(States[lane][col] >>  8);
+                      OutBlocks[stream][indx + 2] = (UCHAR)(States[lane][col] >> 16);
+                      OutBlocks[stream][indx + 3] = (UCHAR)(States[lane][col] >> 24);
+                    }
+                  Pos[lane] += 16;
+                }
+            }
+
+          /* Release lanes of finished streams */
+          for (lane = 0, busy = 0; lane < nolanes; lane++)
+            {
+              if (Pos[lane] < InLengths[Stream[lane]])
+                {
+                  Stream[busy] = Stream[lane];
+                  Pos[busy] = Pos[lane];
+                  Keys[busy] = Keys[lane];
+                  busy++;
+                }
+            }
+          nolanes = busy;
+        }
+    }
+
+#ifdef AES_SECURE
+  ZeroUcharArray ((UCHAR *)States, sizeof (States));
+#endif
+
+  return AES_OK;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Selection of the key schedule used with a workspace           */
+/*              If ks is given it is checked against ws, otherwise the cached */
+/*              key referenced by ws is used                                  */
+/*  Syntax:     static int                                                    */
+/*              GetKey (AESWORKSPACE *ws, AESKEYSCHED *ks, ULONG **xpkey,     */
+/*                                             int *Nk, int *DFlag);          */
+/*  Input:      AESWORKSPACE *ws (Initialized buffer)                         */
+/*              AESKEYSCHED *ks (Keyschedule or NULL)                         */
+/*  Output:     ULONG **xpkey (Pointer to expanded key)                       */
+/*              int *Nk (Keylength in 4-byte-words 4, 6, 8)                   */
+/*              int *DFlag (AES_ENC, AES_DEC)                                 */
+/*  Returns:    E_AES_OK if everything is O.K.                                */
+/*              E_AES_INIT if neither ks nor a cached key is available        */
+/*              E_AES_MODE if mode differs in ws and ks                       */
+/*              E_AES_KEYLENGTH if KeyLength given in ks != 128, 192 or 256   */
+/*              E_AES_BLKLENGTH if BlkLength differs in ws and ks             */
+/*                                                                            */
+/******************************************************************************/
+static int
+GetKey (AESWORKSPACE *ws, AESKEYSCHED *ks, ULONG **xpkey, int *Nk, int *DFlag)
+{
+  if (ks == NULL)
+    {
+      if (ws->Key == NULL || ws->Key->BlkLength != ws->BlkLength)
+        {
+#ifdef AES_TEST
+          fprintf (stderr, "AES_ERR_INIT in line %d\n", __LINE__);
+#endif
+          return AES_ERR_INIT;
+        }
+
+      /* CTR mode uses the encryption schedule in both directions */
+      *DFlag = ws->DFlag;
+      *xpkey = (ULONG *)((*DFlag == AES_DEC && ws->mode != AES_CTR) ?
+                         ws->Key->DecKey : ws->Key->EncKey);
+      *Nk = ws->Key->KeyLength/32;
+      return AES_OK;
+    }
+
+  if (ws->mode != ks->mode)
+    {
+#ifdef AES_TEST
+      fprintf (stderr, "AES_ERR_MODE in line %d\n", __LINE__);
+#endif
+      return AES_ERR_MODE;
+    }
+
+  if (ws->BlkLength != ks->BlkLength)
+    {
+#ifdef AES_TEST
+      fprintf (stderr, "AES_ERR_BLKLENGTH in line %d\n", __LINE__);
+#endif
+      return AES_ERR_BLKLENGTH;
+    }
+
+  if ((ks->KeyLength != 128) && 
+      (ks->KeyLength != 192) && 
+      (ks->KeyLength != 256))
+    {
+#ifdef AES_TEST
+      fprintf (stderr, "AES_ERR_KEYLENGTH in line %d\n", __LINE__);
+#endif
+      return AES_ERR_KEYLENGTH;
+    }
+
+  *xpkey = ks->ExpandedKey;
+  *Nk = ks->KeyLength/32;
+  *DFlag = ks->DFlag;
+  return AES_OK;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   AES encryption and decryption in CTR mode                     */
+/*              Full blocks of key stream are generated by encrypting         */
+/*              AES_PARBLOCKS counter blocks in parallel where possible,      */
+/*              unused key stream bytes are kept in the workspace for         */
+/*              subsequent calls                                              */
+/*  Syntax:     int                                                           */
+/*              CryptCTR (AESBLOCK OutBlock, AESWORKSPACE *ws, ULONG *xpkey,  */
+/*                        int Nk, AESBLOCK InBlock, int InLength);            */
+/*  Input:      AESWORKSPACE *ws (Workspace initialized for CTR mode)         */
+/*              ULONG *xpkey (Key schedule for encryption)                    */
+/*              int Nk (Keylength in 4-byte-words 4, 6, 8)                    */
+/*              AESBLOCK InBlock (Plaintext/Ciphertext)                       */
+/*              int InLength (Length of InBlock in bytes)                     */
+/*  Output:     AESBLOCK OutBlock (Ciphertext/Plaintext)                      */
+/*  Returns:    E_AES_OK                                                      */
+/*                                                                            */
+/******************************************************************************/
+static int
+CryptCTR (AESBLOCK OutBlock, AESWORKSPACE *ws, ULONG *xpkey,
+          int Nk, AESBLOCK InBlock, int InLength)
+{
+  int indx, blck, block, col, Nbc, Nbw;
+  AESSTATE States[AES_PARBLOCKS];
+
+  Nbc = ws->BlkLength/8;
+  Nbw = ws->BlkLength/32;
+  indx = 0;
+
+  /* Use up key stream left over from previous call */
+  while ((ws->KeyStreamPos < Nbc) && (indx < InLength))
+    {
+      OutBlock[indx] = InBlock[indx] ^ ws->KeyStream[ws->KeyStreamPos++];
+      indx++;
+    }
+
+  /* Interleaved processing of AES_PARBLOCKS counter blocks */
+  if (Nbw == 4)
+    {
+      while (InLength - indx >= AES_PARBLOCKS*Nbc)
+        {
+          for (block = 0; block < AES_PARBLOCKS; block++)
+            {
+              for (col = 0; col < Nbw; col++)
+                {
+                  States[block][col] = UC2UL(&ws->IV[(unsigned)col<<2]);
+                }
+              IncCounter (ws->IV, Nbc);
+            }
+
+          AESEncState4 (States, xpkey, Nk);
+
+          for (block = 0; block < AES_PARBLOCKS; block++)
+            {
+              for (col = 0; col < Nbw; col++, indx += 4)
+                {
+                  OutBlock[indx]     = InBlock[indx]     ^ (UCHAR)(States[block][col]      );
+                  OutBlock[indx + 1] = InBlock[indx + 1] ^ (UCHAR)(States[block][col] >>  8);
+                  OutBlock[indx + 2] = InBlock[indx + 2] ^ (UCHAR)(States[block][col] >> 16);
+                  OutBlock[indx + 3] = InBlock[indx + 3] ^ (UCHAR)(States[block][col] >> 24);
+                }
+            }
+        }
+    }
+
+  /* Remaining full blocks */
+  while (InLength - indx >= Nbc)
+    {
+      for (col = 0; col < Nbw; col++)
+        {
+          ws->State[col] = UC2UL(&ws->IV[(unsigned)col<<2]);
+        }
+      IncCounter (ws->IV, Nbc);
+
+      AESEncState (ws->State, xpkey, Nk, Nbw);
+
+      for (col = 0; col < Nbw; col++, indx += 4)
+        {
+          OutBlock[indx]     = InBlock[indx]     ^ (UCHAR)(ws->State[col]      );
+          OutBlock[indx + 1] = InBlock[indx + 1] ^ (UCHAR)(ws->State[col] >>  8);
+          OutBlock[indx + 2] = InBlock[indx + 2] ^ (UCHAR)(ws->State[col] >> 16);
+          OutBlock[indx + 3] = InBlock[indx + 3] ^ (UCHAR)(ws->State[col] >> 24);
+        }
+    }
+
+  /* Partial final block, key stream is buffered for subsequent calls */
+  if (indx < InLength)
+    {
+      for (col = 0; col < Nbw; col++)
+        {
+          ws->State[col] = UC2UL(&ws->IV[(unsigned)col<<2]);
+        }
+      IncCounter (ws->IV, Nbc);
+
+      AESEncState (ws->State, xpkey, Nk, Nbw);
+
+      for (col = 0; col < Nbw; col++)
+        {
+          blck = (unsigned)col<<2;
+          ws->KeyStream[blck]     = (UCHAR)(ws->State[col]      );
+          ws->KeyStream[blck + 1] = (UCHAR)(ws->State[col] >>  8);
+          ws->KeyStream[blck + 2] = (UCHAR)(ws->State[col] >> 16);
+          ws->KeyStream[blck + 3] = (UCHAR)(ws->State[col] >> 24);
+        }
+
+      ws->KeyStreamPos = 0;
+      while (indx < InLength)
+        {
+          OutBlock[indx] = InBlock[indx] ^ ws->KeyStream[ws->KeyStreamPos++];
+          indx++;
+        }
+    }
+
+#ifdef AES_SECURE
+  ZeroUcharArray ((UCHAR *)States, sizeof (States));
+  ZeroUcharArray ((UCHAR *)ws->State, sizeof (ws->State));
+#endif
+
+  return AES_OK;
+}
+
+
 /******************************************************************************/
 /* AES Public Kernel Functions                                                */
 
@@ -1801,6 +2420,192 @@ AESDecState_l (AESSTATE State, AESXPKEY InvExpandedKey, int Nk, int Nb)
   return 0;
 }
 
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Interleaved AES processing of AES_PARBLOCKS state variables   */
+/*              with blocklength 128 bit (encryption)                         */
+/*              The round transformations of independent states are computed  */
+/*              side by side to keep the table lookups of the processor busy  */
+/*  Syntax:     int                                                           */
+/*              AESEncState4_l (AESSTATE *States, AESXPKEY ExpandedKey,       */
+/*                                                     int Nk);               */
+/*  Input:      AESSTATE *States (AES_PARBLOCKS state variables to process)   */
+/*              AESEXPKEY ExpandedKey (Key schedule)                          */
+/*              int Nk (Keylength in 4-byte-words 4, 6, 8)                    */
+/*  Output:     AESSTATE *States (processed state variables)                  */
+/*  Returns:    0                                                             */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+AESEncState4_l (AESSTATE *States, AESXPKEY ExpandedKey, int Nk)
+{
+  ULONG *ExpandedKeys[AES_PARBLOCKS];
+  int block;
+
+  for (block = 0; block < AES_PARBLOCKS; block++)
+    {
+      ExpandedKeys[block] = ExpandedKey;
+    }
+
+  EncState4Keys (States, ExpandedKeys, Nk);
+  return 0;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Interleaved AES processing of AES_PARBLOCKS state variables   */
+/*              with blocklength 128 bit and individual keys (encryption)     */
+/*  Syntax:     void                                                          */
+/*              EncState4Keys (AESSTATE *States, ULONG **ExpandedKeys,        */
+/*                                                     int Nk);               */
+/*  Input:      AESSTATE *States (AES_PARBLOCKS state variables to process)   */
+/*              ULONG **ExpandedKeys (Key schedules, one for each state)      */
+/*              int Nk (Keylength in 4-byte-words 4, 6, 8, same for all keys) */
+/*  Output:     AESSTATE *States (processed state variables)                  */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+
+#define ENCCOL(x0, x1, x2, x3)\
+   (Table0[(x0) & 0xff] ^ Table1[((x1) >> 8) & 0xff]\
+  ^ Table2[((x2) >> 16) & 0xff] ^ Table3[((x3) >> 24) & 0xff])
+
+#define ENCFINALCOL(x0, x1, x2, x3)\
+   ((ULONG)SBox[(x0) & 0xff]\
+  ^ ((ULONG)SBox[((x1) >>  8) & 0xff] <<  8)\
+  ^ ((ULONG)SBox[((x2) >> 16) & 0xff] << 16)\
+  ^ ((ULONG)SBox[((x3) >> 24) & 0xff] << 24))
+
+static void
+EncState4Keys (AESSTATE *States, ULONG **ExpandedKeys, int Nk)
+{
+  int round, block, Nr = NR[(Nk - 4)/2][0];
+  ULONG *keyptr;
+  ULONG a[AES_PARBLOCKS][4], b0, b1, b2, b3;
+
+  for (block = 0; block < AES_PARBLOCKS; block++)
+    {
+      keyptr = ExpandedKeys[block];
+      a[block][0] = States[block][0] ^ keyptr[0];
+      a[block][1] = States[block][1] ^ keyptr[1];
+      a[block][2] = States[block][2] ^ keyptr[2];
+      a[block][3] = States[block][3] ^ keyptr[3];
+    }
+
+  for (round = 1; round < Nr; round++)
+    {
+      for (block = 0; block < AES_PARBLOCKS; block++)
+        {
+          keyptr = &ExpandedKeys[block][round << 2];
+
+          b0 = ENCCOL (a[block][0], a[block][1], a[block][2], a[block][3]);
+          b1 = ENCCOL (a[block][1], a[block][2], a[block][3], a[block][0]);
+          b2 = ENCCOL (a[block][2], a[block][3], a[block][0], a[block][1]);
+          b3 = ENCCOL (a[block][3], a[block][0], a[block][1], a[block][2]);
+
+          a[block][0] = b0 ^ keyptr[0];
+          a[block][1] = b1 ^ keyptr[1];
+          a[block][2] = b2 ^ keyptr[2];
+          a[block][3] = b3 ^ keyptr[3];
+        }
+    }
+
+  /* Final round */
+  for (block = 0; block < AES_PARBLOCKS; block++)
+    {
+      keyptr = &ExpandedKeys[block][Nr << 2];
+      States[block][0] = ENCFINALCOL (a[block][0], a[block][1], a[block][2], a[block][3]) ^ keyptr[0];
+      States[block][1] = ENCFINALCOL (a[block][1], a[block][2], a[block][3], a[block][0]) ^ keyptr[1];
+      States[block][2] = ENCFINALCOL (a[block][2], a[block][3], a[block][0], a[block][1]) ^ keyptr[2];
+      States[block][3] = ENCFINALCOL (a[block][3], a[block][0], a[block][1], a[block][2]) ^ keyptr[3];
+    }
+
+#ifdef AES_SECURE
+  ZeroUcharArray ((UCHAR *)a, sizeof (a));
+  Zero4Ulong (&b3, &b2, &b1, &b0);
+#endif
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Interleaved AES processing of AES_PARBLOCKS state variables   */
+/*              with blocklength 128 bit (decryption)                         */
+/*  Syntax:     int                                                           */
+/*              AESDecState4_l (AESSTATE *States, AESXPKEY InvExpandedKey,    */
+/*                                                     int Nk);               */
+/*  Input:      AESSTATE *States (AES_PARBLOCKS state variables to process)   */
+/*              AESEXPKEY InvExpandedKey (Key schedule)                       */
+/*              int Nk (Keylength in 4-byte-words 4, 6, 8)                    */
+/*  Output:     AESSTATE *States (processed state variables)                  */
+/*  Returns:    0                                                             */
+/*                                                                            */
+/******************************************************************************/
+
+#define DECCOL(x0, x1, x2, x3)\
+   (InvTable0[(x0) & 0xff] ^ InvTable1[((x1) >> 8) & 0xff]\
+  ^ InvTable2[((x2) >> 16) & 0xff] ^ InvTable3[((x3) >> 24) & 0xff])
+
+#define DECFINALCOL(x0, x1, x2, x3)\
+   ((ULONG)InvSBox[(x0) & 0xff]\
+  ^ ((ULONG)InvSBox[((x1) >>  8) & 0xff] <<  8)\
+  ^ ((ULONG)InvSBox[((x2) >> 16) & 0xff] << 16)\
+  ^ ((ULONG)InvSBox[((x3) >> 24) & 0xff] << 24))
+
+int __FLINT_API
+AESDecState4_l (AESSTATE *States, AESXPKEY InvExpandedKey, int Nk)
+{
+  int round, block, Nr = NR[(Nk - 4)/2][0];
+  ULONG *keyptr;
+  ULONG a[AES_PARBLOCKS][4], b0, b1, b2, b3;
+
+  keyptr = &InvExpandedKey[Nr << 2];
+  for (block = 0; block < AES_PARBLOCKS; block++)
+    {
+      a[block][0] = States[block][0] ^ keyptr[0];
+      a[block][1] = States[block][1] ^ keyptr[1];
+      a[block][2] = States[block][2] ^ keyptr[2];
+      a[block][3] = States[block][3] ^ keyptr[3];
+    }
+
+  for (round = Nr - 1; round > 0; round--)
+    {
+      keyptr = &InvExpandedKey[round << 2];
+
+      for (block = 0; block < AES_PARBLOCKS; block++)
+        {
+          b0 = DECCOL (a[block][0], a[block][3], a[block][2], a[block][1]);
+          b1 = DECCOL (a[block][1], a[block][0], a[block][3], a[block][2]);
+          b2 = DECCOL (a[block][2], a[block][1], a[block][0], a[block][3]);
+          b3 = DECCOL (a[block][3], a[block][2], a[block][1], a[block][0]);
+
+          a[block][0] = b0 ^ keyptr[0];
+          a[block][1] = b1 ^ keyptr[1];
+          a[block][2] = b2 ^ keyptr[2];
+          a[block][3] = b3 ^ keyptr[3];
+        }
+    }
+
+  /* Final round */
+  keyptr = InvExpandedKey;
+  for (block = 0; block < AES_PARBLOCKS; block++)
+    {
+      States[block][0] = DECFINALCOL (a[block][0], a[block][3], a[block][2], a[block][1]) ^ keyptr[0];
+      States[block][1] = DECFINALCOL (a[block][1], a[block][0], a[block][3], a[block][2]) ^ keyptr[1];
+      States[block][2] = DECFINALCOL (a[block][2], a[block][1], a[block][0], a[block][3]) ^ keyptr[2];
+      States[block][3] = DECFINALCOL (a[block][3], a[block][2], a[block][1], a[block][0]) ^ keyptr[3];
+    }
+
+#ifdef AES_SECURE
+  ZeroUcharArray ((UCHAR *)a, sizeof (a));
+  Zero4Ulong (&b3, &b2, &b1, &b0);
+#endif
+
+  return 0;
+}
+
 #else /* AES_COMPACT */
 
 
@@ -1906,6 +2711,87 @@ AESDecState_l (AESSTATE State, AESXPKEY InvExpandedKey, int Nk, int Nb)
   return 0;
 }
 
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   AES processing of AES_PARBLOCKS state variables with          */
+/*              blocklength 128 bit (encryption)                              */
+/*  Syntax:     int                                                           */
+/*              AESEncState4_l (AESSTATE *States, AESXPKEY ExpandedKey,       */
+/*                                                     int Nk);               */
+/*  Input:      AESSTATE *States (AES_PARBLOCKS state variables to process)   */
+/*              AESEXPKEY ExpandedKey (Key schedule)                          */
+/*              int Nk (Keylength in 4-byte-words 4, 6, 8)                    */
+/*  Output:     AESSTATE *States (processed state variables)                  */
+/*  Returns:    0                                                             */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+AESEncState4_l (AESSTATE *States, AESXPKEY ExpandedKey, int Nk)
+{
+  int block;
+
+  for (block = 0; block < AES_PARBLOCKS; block++)
+    {
+      AESEncState_l (States[block], ExpandedKey, Nk, 4);
+    }
+
+  return 0;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   AES processing of AES_PARBLOCKS state variables with          */
+/*              blocklength 128 bit and individual keys (encryption)          */
+/*  Syntax:     void                                                          */
+/*              EncState4Keys (AESSTATE *States, ULONG **ExpandedKeys,        */
+/*                                                     int Nk);               */
+/*  Input:      AESSTATE *States (AES_PARBLOCKS state variables to process)   */
+/*              ULONG **ExpandedKeys (Key schedules, one for each state)      */
+/*              int Nk (Keylength in 4-byte-words 4, 6, 8, same for all keys) */
+/*  Output:     AESSTATE *States (processed state variables)                  */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+static void
+EncState4Keys (AESSTATE *States, ULONG **ExpandedKeys, int Nk)
+{
+  int block;
+
+  for (block = 0; block < AES_PARBLOCKS; block++)
+    {
+      AESEncState_l (States[block], ExpandedKeys[block], Nk, 4);
+    }
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   AES processing of AES_PARBLOCKS state variables with          */
+/*              blocklength 128 bit (decryption)                              */
+/*  Syntax:     int                                                           */
+/*              AESDecState4_l (AESSTATE *States, AESXPKEY InvExpandedKey,    */
+/*                                                     int Nk);               */
+/*  Input:      AESSTATE *States (AES_PARBLOCKS state variables to process)   */
+/*              AESEXPKEY InvExpandedKey (Key schedule)                       */
+/*              int Nk (Keylength in 4-byte-words 4, 6, 8)                    */
+/*  Output:     AESSTATE *States (processed state variables)                  */
+/*  Returns:    0                                                             */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+AESDecState4_l (AESSTATE *States, AESXPKEY InvExpandedKey, int Nk)
+{
+  int block;
+
+  for (block = 0; block < AES_PARBLOCKS; block++)
+    {
+      AESDecState_l (States[block], InvExpandedKey, Nk, 4);
+    }
+
+  return 0;
+}
+
 #endif /* !AES_COMPACT? */
 
 
@@ -2105,6 +2991,66 @@ AESDecryptBlock_l (AESBLOCK MessBlock, AESBLOCK CipherBlock, AESKEY RawKey,
 }
 
 
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   AES encryption of one single block of text with cached key    */
+/*              The key schedule set up by AESKeyCacheInit_l is used, no key  */
+/*              expansion is performed                                        */
+/*  Syntax:     int                                                           */
+/*              AESEncryptBlockCached_l (AESBLOCK CipherBlock,                */
+/*                             AESBLOCK MessBlock, const AESKEYCACHE *Key);   */
+/*  Input:      AESBLOCK MessBlock (Message block to encrypt)                 */
+/*              const AESKEYCACHE *Key (Cached key set up by                  */
+/*                                      AESKeyCacheInit_l)                    */
+/*  Output:     AESBLOCK CipherBlock (Ciphertext)                             */
+/*  Returns:    E_AES_OK if everything is O.K.                                */
+/*              E_AES_INIT if Key == NULL                                     */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+AESEncryptBlockCached_l (AESBLOCK CipherBlock, AESBLOCK MessBlock,
+                                               const AESKEYCACHE *Key)
+{
+  if (Key == NULL)
+    {
+      return AES_ERR_INIT;
+    }
+
+  return AESEncBlock_l (CipherBlock, MessBlock, (ULONG *)Key->EncKey,
+                        Key->KeyLength, Key->BlkLength);
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   AES decryption of one single block of text with cached key    */
+/*              The inverse key schedule set up by AESKeyCacheInit_l is used, */
+/*              no key expansion is performed                                 */
+/*  Syntax:     int                                                           */
+/*              AESDecryptBlockCached_l (AESBLOCK MessBlock,                  */
+/*                           AESBLOCK CipherBlock, const AESKEYCACHE *Key);   */
+/*  Input:      AESBLOCK CipherBlock (Message block to decrypt)               */
+/*              const AESKEYCACHE *Key (Cached key set up by                  */
+/*                                      AESKeyCacheInit_l)                    */
+/*  Output:     AESBLOCK MessBlock (Plaintext)                                */
+/*  Returns:    E_AES_OK if everything is O.K.                                */
+/*              E_AES_INIT if Key == NULL                                     */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+AESDecryptBlockCached_l (AESBLOCK MessBlock, AESBLOCK CipherBlock,
+                                             const AESKEYCACHE *Key)
+{
+  if (Key == NULL)
+    {
+      return AES_ERR_INIT;
+    }
+
+  return AESDecBlock_l (MessBlock, CipherBlock, (ULONG *)Key->DecKey,
+                        Key->KeyLength, Key->BlkLength);
+}
+
+
 /******************************************************************************/
 /*                                                                            */
 /*  Function:   AES encryption of one single block of text with variable      */
@@ -2810,7 +3756,10 @@ void __FLINT_API
 AESPurge_l (AESWORKSPACE *ws, AESKEYSCHED *ks)
 {
     memset((char *)ws, 0, sizeof(AESWORKSPACE));
-    memset((char *)ks, 0, sizeof(AESKEYSCHED));
+    if (ks != NULL)
+      {
+        memset((char *)ks, 0, sizeof(AESKEYSCHED));
+      }
 }
 
 
@@ -2935,6 +3884,29 @@ ZeroUcharArray (UCHAR *a, int Len)
 }
 
 
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Increment of counter block for CTR mode                       */
+/*  Syntax:     IncCounter (UCHAR *Ctr, int Len);                             */
+/*  Input:      UCHAR *Ctr (Counter block, most significant byte first)       */
+/*              int Len (Length of counter block in byte)                     */
+/*  Output:     UCHAR *Ctr (Counter block incremented by 1 mod 2^(8*Len))     */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+static inline void
+IncCounter (UCHAR *Ctr, int Len)
+{
+  while (--Len >= 0)
+    {
+      if (++Ctr[Len] != 0)
+        {
+          break;
+        }
+    }
+}
+
+
 /******************************************************************************/
 /*                                                                            */
 /*  Function:   Test of endianness                                            */
@@ -68,6 +68,9 @@ extern "C" {
 #define AES_DEC              1
 #define AES_ECB             10
 #define AES_CBC             11
+#define AES_CTR             12
+
+#define AES_PARBLOCKS        4  /* Number of blocks processed interleaved */
 
 #define AES_OK               0
 #define AES_ERR_INIT        -1
@@ -90,13 +93,29 @@ extern "C" {
 #define	AESInvKeyExpansion    AESInvKeyExpansion_l
 #define	AESEncryptBlock       AESEncryptBlock_l
 #define	AESDecryptBlock       AESDecryptBlock_l
+#define	AESEncryptBlockCached AESEncryptBlockCached_l
+#define	AESDecryptBlockCached AESDecryptBlockCached_l
 #define	AESEncBlock           AESEncBlock_l
 #define	AESDecBlock           AESDecBlock_l    
 #define	AESEncState           AESEncState_l    
 #define	AESDecState           AESDecState_l    
+#define	AESEncState4          AESEncState4_l
+#define	AESDecState4          AESDecState4_l
+#define	AESCryptCBCMulti      AESCryptCBCMulti_l
+#define AESKeyCacheInit       AESKeyCacheInit_l
+#define AESKeyCachePurge      AESKeyCachePurge_l
+#define AESInitCached         AESInitCached_l
 #define	AESEncBlockRounds     AESEncBlockRounds_l
 #define	AESDecBlockRounds     AESDecBlockRounds_l
 
+/* Alignment of key schedules for SIMD access */
+
+#if defined __GNUC__
+#define AES_ALIGNED   __attribute__ ((aligned (16)))
+#else
+#define AES_ALIGNED   /**/
+#endif
+
 /* Conversion of a vector of type UCHAR into ULONG word */
 
 #if !defined AES_BIGENDIAN
@@ -119,20 +138,36 @@ typedef unsigned char AESKEY[4*MAXCKEY];
 typedef struct
 {
   AESXPKEY ExpandedKey; 
-  int mode;            /* Mode of Operation: AES_ECB, AES_CBC */
+  int mode;            /* Mode of Operation: AES_ECB, AES_CBC, AES_CTR */
   int KeyLength;       /* 128, 192, 256 */
   int BlkLength;       /* 128, 192, 256 */
   int DFlag;           /* AES_ENC, AES_DEC */
 } AESKEYSCHED;
 
 
+/* Expanded keys for encryption and decryption, set up once by            */
+/* AESKeyCacheInit_l and shared read-only by any number of workspaces     */
+typedef struct
+{
+  AESXPKEY EncKey AES_ALIGNED; /* Key schedule for encryption */
+  AESXPKEY DecKey AES_ALIGNED; /* Key schedule for decryption */
+  int KeyLength;       /* 128, 192, 256 */
+  int BlkLength;       /* 128, 192, 256 */
+} AESKEYCACHE;
+
+
 typedef struct
 {
-  int mode;            /* Mode of Operation: AES_ECB, AES_CBC */
+  int mode;            /* Mode of Operation: AES_ECB, AES_CBC, AES_CTR */
   int BlkLength;       /* 128, 192, 256 */
-  AESBLOCK IV;         /* Initialization Vector for CBC Mode */
+  AESBLOCK IV;         /* Initialization Vector for CBC Mode, */
+                       /* Counter Block for CTR Mode */
   AESSTATE State;      /* State Buffer */
   AESSTATE Block;      /* Previous State Buffer for CBC Decryption */
+  AESBLOCK KeyStream;  /* Key stream buffer for CTR Mode */
+  int KeyStreamPos;    /* Number of key stream bytes used in CTR Mode */
+  const AESKEYCACHE *Key; /* Cached key or NULL if a key schedule is used */
+  int DFlag;           /* AES_ENC, AES_DEC */
 } AESWORKSPACE;
   
 
@@ -179,6 +214,22 @@ AESInit_l (AESWORKSPACE *   ws,
            int              KeyLength, 
            int              DFlag);
 
+int __FLINT_API
+AESKeyCacheInit_l (AESKEYCACHE *   Key,
+                   AESKEY          RawKey,
+                   int             KeyLength,
+                   int             BlkLength);
+
+int __FLINT_API
+AESInitCached_l (AESWORKSPACE *       ws,
+                 int                  mode,
+                 AESBLOCK             IV,
+                 const AESKEYCACHE *  Key,
+                 int                  DFlag);
+
+void __FLINT_API
+AESKeyCachePurge_l (AESKEYCACHE *  Key);
+
 int __FLINT_API 
 AESCrypt_l (AESBLOCK        OutBlock, 
             AESWORKSPACE *  ws, 
@@ -194,6 +245,14 @@ AESKeySched_l (AESKEYSCHED *AESKey,
                int          DFlag, 
                int          mode);
 
+int __FLINT_API
+AESCryptCBCMulti_l (unsigned char **OutBlocks,
+                    AESWORKSPACE **ws,
+                    AESKEYSCHED ** ks,
+                    unsigned char **InBlocks,
+                    int *          InLengths,
+                    int            NoOfStreams);
+
 void __FLINT_API
 AESPurge_l (AESWORKSPACE *  ws, 
             AESKEYSCHED *   ks);
@@ -217,6 +276,14 @@ AESEncryptBlock_l (AESBLOCK CipherBlock, AESBLOCK MessBlock, AESKEY RawKey, int
 int __FLINT_API
 AESDecryptBlock_l (AESBLOCK MessBlock, AESBLOCK CipherBlock, AESKEY RawKey, int KeyLength, int BlockLength);
 
+/* Encryption of a single block with cached key */
+int __FLINT_API
+AESEncryptBlockCached_l (AESBLOCK CipherBlock, AESBLOCK MessBlock, const AESKEYCACHE *Key);
+
+/* Decryption of a single block with cached key */
+int __FLINT_API
+AESDecryptBlockCached_l (AESBLOCK MessBlock, AESBLOCK CipherBlock, const AESKEYCACHE *Key);
+
 /* Encryption of a single block w/o KeyExpansion */
 int __FLINT_API
 AESEncBlock_l (AESBLOCK CipherBlock, AESBLOCK MessBlock, AESXPKEY ExpandedKey, int KeyLength, int BlockLength);
@@ -233,6 +300,14 @@ AESEncState_l (AESSTATE State, AESXPKEY ExpandedKey, int Nk, int Nb);
 int  __FLINT_API
 AESDecState_l (AESSTATE State, AESXPKEY InvExpandedKey, int Nk, int Nb);
 
+/* Interleaved encryption of AES_PARBLOCKS states, blocklength 128 bit */
+int __FLINT_API
+AESEncState4_l (AESSTATE *States, AESXPKEY ExpandedKey, int Nk);
+
+/* Interleaved decryption of AES_PARBLOCKS states, blocklength 128 bit */
+int __FLINT_API
+AESDecState4_l (AESSTATE *States, AESXPKEY InvExpandedKey, int Nk);
+
 /* Block encryption w/ variable number of rounds */
 int __FLINT_API
 AESEncBlockRounds_l (AESBLOCK CipherBlock, AESBLOCK MessBlock, AESXPKEY ExpandedKey, int KeyLength, int BlockLength, int Rounds);
@@ -0,0 +1,1033 @@
+/******************************************************************************/
+/*                                                                            */
+/* Functions for arithmetic and number theory with large integers in C        */
+/* Software supplement to the book "Cryptography in C and C++"                */
+/* by Michael Welschenbach                                                    */
+/*                                                                            */
+/* Module aesgcm.c         Revision: 19.10.2026                               */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 2001-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+/*                                                                            */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "flint.h"
+#include "aes.h"
+#include "aesgcm.h"
+
+
+/* Macros */
+
+#ifndef inline
+#if (_MSC_VER >= 1100) || defined __GNUC__
+#define inline __inline
+#else 
+#define inline /**/
+#endif
+#endif
+
+/* GHASH by carry-less multiplication (PCLMULQDQ) on x86 processors,  */
+/* selected at runtime. Compile with -DAESGCM_NO_CLMUL to use the     */
+/* portable 4-bit table implementation only.                          */
+#if !defined AESGCM_NO_CLMUL
+#if defined __GNUC__ && (defined __x86_64__ || defined __i386__)
+#define AESGCM_CLMUL
+#include <cpuid.h>
+#include <wmmintrin.h>
+#include <tmmintrin.h>
+#define CLMUL_TARGET __attribute__ ((target ("pclmul,ssse3")))
+#elif defined _MSC_VER && (_MSC_VER >= 1600) && (defined _M_X64 || defined _M_IX86)
+#define AESGCM_CLMUL
+#include <intrin.h>
+#include <wmmintrin.h>
+#include <tmmintrin.h>
+#define CLMUL_TARGET /**/
+#endif
+#endif /* !AESGCM_NO_CLMUL */
+
+/* Conversion of 4 bytes in Big-Endian representation into ULONG */
+#define UC2ULBE(ucptr) \
+  (((ULONG) *((ucptr)+3)      ) | \
+   ((ULONG) *((ucptr)+2) <<  8) | \
+   ((ULONG) *((ucptr)+1) << 16) | \
+   ((ULONG) *(ucptr)     << 24))
+
+/* Conversion of ULONG into 4 bytes in Big-Endian representation */
+#define UL2UCBE(ucptr, ul) {\
+  *(ucptr)     = (UCHAR)((ul) >> 24);\
+  *((ucptr)+1) = (UCHAR)((ul) >> 16);\
+  *((ucptr)+2) = (UCHAR)((ul) >>  8);\
+  *((ucptr)+3) = (UCHAR)((ul)      );\
+}
+
+/* Addition of a byte count b to a 64-bit length (a[1],a[0]) of 32-bit words */
+#define ADDLEN(a, b) { \
+  (a)[0] = ((a)[0] + (ULONG)(b)) & 0xffffffffUL; \
+  if ((a)[0] < (ULONG)(b)) {(a)[1]++;} \
+}
+
+
+/* Prototypes */
+
+static void GHashInitTable (AESGCMCTX *ctx, UCHAR *H);
+static void GHashMultTable (AESGCMCTX *ctx, UCHAR *X);
+static void GHashBlocks (AESGCMCTX *ctx, UCHAR *Data, int noofblocks);
+static void GHashData (AESGCMCTX *ctx, UCHAR *Data, int Length);
+static void GHashFlush (AESGCMCTX *ctx);
+static void CtrStates (AESGCMCTX *ctx, AESSTATE *States, int noofblocks);
+static void XorStates (UCHAR *OutBlock, UCHAR *InBlock, AESSTATE *States,
+                       int noofblocks);
+static void PutBitLength (UCHAR *Block, ULONG *Length);
+static inline void Inc32 (UCHAR *Ctr);
+
+#ifdef AESGCM_CLMUL
+static int HasClmul (void);
+static void GHashInitClmul (AESGCMCTX *ctx, UCHAR *H);
+static void GHashBlocksClmul (AESGCMCTX *ctx, UCHAR *Data, int noofblocks);
+#endif
+
+
+/* Reduction constants for 4-bit table GHASH (Shoup's method) */
+static const ULONG Last4[16] = {
+  0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+  0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0};
+
+
+/******************************************************************************/
+/* AES-GCM API                                                                */
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Initialization of AES-GCM authenticated encryption            */
+/*  Syntax:     int                                                           */
+/*              AESGCMInit_l (AESGCMCTX *ctx, AESKEY RawKey, int KeyLength,   */
+/*                            UCHAR *IV, int IVLength, int DFlag);            */
+/*  Input:      AESKEY RawKey (Key vector provided by user)                   */
+/*              int KeyLength (Length of user key in bit: 128, 192, 256)      */
+/*              UCHAR *IV (Initialization vector, 12 bytes recommended)       */
+/*              int IVLength (Length of IV in bytes, > 0)                     */
+/*              int DFlag (Encipher/decipher mode AES_ENC, AES_DEC)           */
+/*  Output:     AESGCMCTX *ctx (Initialized context)                          */
+/*  Returns:    E_AES_OK if everything is O.K.                                */
+/*              E_AES_INIT if IV == NULL or IVLength <= 0                     */
+/*              E_AES_DIRECTION if DFlag != AES_ENC or AES_DEC                */
+/*              E_AES_KEYLENGTH if KeyLength != 128, 192 or 256               */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+AESGCMInit_l (AESGCMCTX *ctx, AESKEY RawKey, int KeyLength, 
+              UCHAR *IV, int IVLength, int DFlag)
+{
+  AESBLOCK H;
+  int error;
+
+  if (IV == NULL || IVLength <= 0)
+    {
+      return AES_ERR_INIT;
+    }
+
+  if ((DFlag != AES_ENC) && (DFlag != AES_DEC))
+    {
+      return AES_ERR_DIRECTION;
+    }
+
+  /* GCM uses the forward cipher in both directions */
+  error = AESKeySched (&ctx->ks, RawKey, KeyLength, 128, AES_ENC, AES_CTR);
+  if (error)
+    {
+      return error;
+    }
+
+  /* Hash subkey H = E(K, 0^128) */
+  memset (H, 0, sizeof (H));
+  AESEncBlock (H, H, ctx->ks.ExpandedKey, KeyLength, 128);
+
+  GHashInitTable (ctx, H);
+  ctx->UseClmul = 0;
+
+#ifdef AESGCM_CLMUL
+  if (HasClmul ())
+    {
+      GHashInitClmul (ctx, H);
+      ctx->UseClmul = 1;
+    }
+#endif
+
+  memset (ctx->X, 0, sizeof (ctx->X));
+  ctx->BufPos = 0;
+  ctx->AadLen[0] = ctx->AadLen[1] = 0;
+  ctx->TextLen[0] = ctx->TextLen[1] = 0;
+
+  /* Pre-counter block J0 */
+  if (IVLength == 12)
+    {
+      memcpy (ctx->J0, IV, 12);
+      ctx->J0[12] = ctx->J0[13] = ctx->J0[14] = 0;
+      ctx->J0[15] = 1;
+    }
+  else
+    {
+      /* J0 = GHASH (IV || 0^s || [0]_64 || [len(IV)]_64) */
+      GHashData (ctx, IV, IVLength);
+      GHashFlush (ctx);
+      ADDLEN (ctx->TextLen, IVLength);
+      memset (ctx->Buf, 0, 8);
+      PutBitLength (ctx->Buf + 8, ctx->TextLen);
+      GHashBlocks (ctx, ctx->Buf, 1);
+
+      memcpy (ctx->J0, ctx->X, 16);
+      memset (ctx->X, 0, sizeof (ctx->X));
+      ctx->TextLen[0] = ctx->TextLen[1] = 0;
+    }
+
+  memcpy (ctx->Ctr, ctx->J0, 16);
+  Inc32 (ctx->Ctr);
+
+  ctx->DFlag = DFlag;
+  ctx->Phase = AESGCM_AAD;
+
+#ifdef AES_SECURE
+  memset (H, 0, sizeof (H));
+#endif
+
+  return AES_OK;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Processing of additional authenticated data (AAD)             */
+/*              AAD may be passed in several portions of arbitrary length     */
+/*              by subsequent calls, all preceding AESGCMUpdate_l             */
+/*  Syntax:     int                                                           */
+/*              AESGCMAad_l (AESGCMCTX *ctx, UCHAR *Aad, int AadLength);      */
+/*  Input:      AESGCMCTX *ctx (Context initialized by AESGCMInit_l)          */
+/*              UCHAR *Aad (Additional authenticated data)                    */
+/*              int AadLength (Length of Aad in bytes)                        */
+/*  Output:     AESGCMCTX *ctx (Updated context)                              */
+/*  Returns:    E_AES_OK if everything is O.K.                                */
+/*              E_AES_INIT if ctx == NULL or AadLength < 0                    */
+/*              E_AES_PHASE if text processing has already started or the     */
+/*                          context is finished                               */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+AESGCMAad_l (AESGCMCTX *ctx, UCHAR *Aad, int AadLength)
+{
+  if (ctx == NULL || AadLength < 0)
+    {
+      return AES_ERR_INIT;
+    }
+
+  if (ctx->Phase != AESGCM_AAD)
+    {
+      return AES_ERR_PHASE;
+    }
+
+  ADDLEN (ctx->AadLen, AadLength);
+  GHashData (ctx, Aad, AadLength);
+
+  return AES_OK;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   AES-GCM encryption or decryption of text                      */
+/*              Encryption and authentication are performed in one pass:      */
+/*              AES_PARBLOCKS counter blocks are encrypted at a time and the  */
+/*              corresponding ciphertext blocks are hashed while in cache     */
+/*              Text may be passed in several portions of arbitrary length    */
+/*  Syntax:     int                                                           */
+/*              AESGCMUpdate_l (AESGCMCTX *ctx, UCHAR *OutBlock,              */
+/*                                          UCHAR *InBlock, int InLength);    */
+/*  Input:      AESGCMCTX *ctx (Context initialized by AESGCMInit_l)          */
+/*              UCHAR *InBlock (Plaintext/Ciphertext)                         */
+/*              int InLength (Length of InBlock in bytes)                     */
+/*  Output:     UCHAR *OutBlock (Ciphertext/Plaintext, may be identical       */
+/*                               with InBlock)                                */
+/*  Returns:    E_AES_OK if everything is O.K.                                */
+/*              E_AES_INIT if ctx == NULL or InLength < 0                     */
+/*              E_AES_PHASE if the context is finished                        */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+AESGCMUpdate_l (AESGCMCTX *ctx, UCHAR *OutBlock, UCHAR *InBlock, int InLength)
+{
+  int indx, Nk;
+  UCHAR c, o;
+  AESSTATE States[AES_PARBLOCKS];
+
+  if (ctx == NULL || InLength < 0)
+    {
+      return AES_ERR_INIT;
+    }
+
+  if (ctx->Phase == AESGCM_FINAL)
+    {
+      return AES_ERR_PHASE;
+    }
+
+  if (ctx->Phase == AESGCM_AAD)
+    {
+      GHashFlush (ctx);
+      ctx->Phase = AESGCM_TEXT;
+    }
+
+  ADDLEN (ctx->TextLen, InLength);
+  Nk = ctx->ks.KeyLength/32;
+  indx = 0;
+
+  /* Complete partial block left over from previous call */
+  if (ctx->BufPos)
+    {
+      while ((ctx->BufPos < 16) && (indx < InLength))
+        {
+          c = InBlock[indx];
+          o = c ^ ctx->KeyStream[ctx->BufPos];
+          OutBlock[indx++] = o;
+          ctx->Buf[ctx->BufPos++] = (ctx->DFlag == AES_ENC) ? o : c;
+        }
+
+      if (ctx->BufPos == 16)
+        {
+          GHashBlocks (ctx, ctx->Buf, 1);
+          ctx->BufPos = 0;
+        }
+    }
+
+  /* Stitched encryption and authentication of AES_PARBLOCKS blocks */
+  while (InLength - indx >= AES_PARBLOCKS*16)
+    {
+      CtrStates (ctx, States, AES_PARBLOCKS);
+      AESEncState4 (States, ctx->ks.ExpandedKey, Nk);
+
+      if (ctx->DFlag == AES_DEC)
+        {
+          GHashBlocks (ctx, &InBlock[indx], AES_PARBLOCKS);
+        }
+
+      XorStates (&OutBlock[indx], &InBlock[indx], States, AES_PARBLOCKS);
+
+      if (ctx->DFlag == AES_ENC)
+        {
+          GHashBlocks (ctx, &OutBlock[indx], AES_PARBLOCKS);
+        }
+
+      indx += AES_PARBLOCKS*16;
+    }
+
+  /* Remaining full blocks */
+  while (InLength - indx >= 16)
+    {
+      CtrStates (ctx, States, 1);
+      AESEncState (States[0], ctx->ks.ExpandedKey, Nk, 4);
+
+      if (ctx->DFlag == AES_DEC)
+        {
+          GHashBlocks (ctx, &InBlock[indx], 1);
+        }
+
+      XorStates (&OutBlock[indx], &InBlock[indx], States, 1);
+
+      if (ctx->DFlag == AES_ENC)
+        {
+          GHashBlocks (ctx, &OutBlock[indx], 1);
+        }
+
+      indx += 16;
+    }
+
+  /* Partial final block, hashed when completed or in AESGCMFinal_l */
+  if (indx < InLength)
+    {
+      CtrStates (ctx, States, 1);
+      AESEncState (States[0], ctx->ks.ExpandedKey, Nk, 4);
+      memset (ctx->KeyStream, 0, 16);
+      XorStates (ctx->KeyStream, ctx->KeyStream, States, 1);
+
+      while (indx < InLength)
+        {
+          c = InBlock[indx];
+          o = c ^ ctx->KeyStream[ctx->BufPos];
+          OutBlock[indx++] = o;
+          ctx->Buf[ctx->BufPos++] = (ctx->DFlag == AES_ENC) ? o : c;
+        }
+    }
+
+#ifdef AES_SECURE
+  memset (States, 0, sizeof (States));
+#endif
+
+  return AES_OK;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Completion of AES-GCM processing                              */
+/*              Encryption: the authentication tag is output                  */
+/*              Decryption: the authentication tag is verified, plaintext     */
+/*              output by AESGCMUpdate_l must be discarded if AES_ERR_TAG is  */
+/*              returned                                                      */
+/*  Syntax:     int                                                           */
+/*              AESGCMFinal_l (AESGCMCTX *ctx, UCHAR *Tag, int TagLength);    */
+/*  Input:      AESGCMCTX *ctx (Context)                                      */
+/*              UCHAR *Tag (Tag to verify in case of decryption)              */
+/*              int TagLength (Length of tag in bytes, 4 ... 16)              */
+/*  Output:     UCHAR *Tag (Tag in case of encryption)                        */
+/*  Returns:    E_AES_OK if everything is O.K.                                */
+/*              E_AES_INIT if ctx == NULL or Tag == NULL                      */
+/*              E_AES_BLKLENGTH if TagLength is out of range                  */
+/*              E_AES_PHASE if the context is already finished                */
+/*              E_AES_TAG if the tag is not valid (decryption)                */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+AESGCMFinal_l (AESGCMCTX *ctx, UCHAR *Tag, int TagLength)
+{
+  AESBLOCK S;
+  int i, diff;
+
+  if (ctx == NULL || Tag == NULL)
+    {
+      return AES_ERR_INIT;
+    }
+
+  if ((TagLength < 4) || (TagLength > AESGCM_MAXTAG))
+    {
+      return AES_ERR_BLKLENGTH;
+    }
+
+  if (ctx->Phase == AESGCM_FINAL)
+    {
+      return AES_ERR_PHASE;
+    }
+
+  /* Pad pending AAD or ciphertext */
+  GHashFlush (ctx);
+  ctx->Phase = AESGCM_FINAL;
+
+  /* Hash [len(A)]_64 || [len(C)]_64 */
+  PutBitLength (ctx->Buf, ctx->AadLen);
+  PutBitLength (ctx->Buf + 8, ctx->TextLen);
+  GHashBlocks (ctx, ctx->Buf, 1);
+
+  /* T = E(K, J0) xor S */
+  memcpy (S, ctx->J0, 16);
+  AESEncBlock (S, S, ctx->ks.ExpandedKey, ctx->ks.KeyLength, 128);
+  for (i = 0; i < 16; i++)
+    {
+      S[i] ^= ctx->X[i];
+    }
+
+  diff = 0;
+  if (ctx->DFlag == AES_ENC)
+    {
+      memcpy (Tag, S, (size_t)TagLength);
+    }
+  else
+    {
+      /* Comparison in constant time */
+      for (i = 0; i < TagLength; i++)
+        {
+          diff |= Tag[i] ^ S[i];
+        }
+    }
+
+#ifdef AES_SECURE
+  memset (S, 0, sizeof (S));
+#endif
+
+  return (diff == 0) ? AES_OK : AES_ERR_TAG;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Purging of AES-GCM context                                    */
+/*  Syntax:     void AESGCMPurge_l (AESGCMCTX *ctx);                          */
+/*  Input:      AESGCMCTX *ctx (Context)                                      */
+/*  Output:     ctx overwritten by 0                                          */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+void __FLINT_API
+AESGCMPurge_l (AESGCMCTX *ctx)
+{
+  memset ((char *)ctx, 0, sizeof (AESGCMCTX));
+}
+
+
+/******************************************************************************/
+/* AES-GCM private functions                                                  */
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Preparation of counter blocks as AES states                   */
+/*  Syntax:     CtrStates (AESGCMCTX *ctx, AESSTATE *States, int noofblocks); */
+/*  Input:      AESGCMCTX *ctx (Context holding the counter block)            */
+/*              int noofblocks (Number of counter blocks)                     */
+/*  Output:     AESSTATE *States (States for encryption)                      */
+/*              Counter block in ctx incremented by noofblocks                */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+static void
+CtrStates (AESGCMCTX *ctx, AESSTATE *States, int noofblocks)
+{
+  int block, col;
+
+  for (block = 0; block < noofblocks; block++)
+    {
+      for (col = 0; col < 4; col++)
+        {
+          States[block][col] = UC2UL(&ctx->Ctr[(unsigned)col<<2]);
+        }
+      Inc32 (ctx->Ctr);
+    }
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Addition of key stream given as AES states to text            */
+/*  Syntax:     XorStates (UCHAR *OutBlock, UCHAR *InBlock, AESSTATE *States, */
+/*                                                       int noofblocks);     */
+/*  Input:      UCHAR *InBlock (Text)                                         */
+/*              AESSTATE *States (Encrypted counter blocks)                   */
+/*              int noofblocks (Number of blocks)                             */
+/*  Output:     UCHAR *OutBlock (InBlock xor key stream)                      */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+static void
+XorStates (UCHAR *OutBlock, UCHAR *InBlock, AESSTATE *States, int noofblocks)
+{
+  int block, col, indx;
+
+  for (block = indx = 0; block < noofblocks; block++)
+    {
+      for (col = 0; col < 4; col++, indx += 4)
+        {
+          OutBlock[indx]     = InBlock[indx]     ^ (UCHAR)(States[block][col]      );
+          OutBlock[indx + 1] = InBlock[indx + 1] ^ (UCHAR)(States[block][col] >>  8);
+          OutBlock[indx + 2] = InBlock[indx + 2] ^ (UCHAR)(States[block][col] >> 16);
+          OutBlock[indx + 3] = InBlock[indx + 3] ^ (UCHAR)(States[block][col] >> 24);
+        }
+    }
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   GHASH of complete blocks                                      */
+/*  Syntax:     GHashBlocks (AESGCMCTX *ctx, UCHAR *Data, int noofblocks);    */
+/*  Input:      AESGCMCTX *ctx (Context)                                      */
+/*              UCHAR *Data (Data blocks)                                     */
+/*              int noofblocks (Number of 16-byte blocks)                     */
+/*  Output:     GHASH accumulator in ctx updated                              */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+static void
+GHashBlocks (AESGCMCTX *ctx, UCHAR *Data, int noofblocks)
+{
+  int i;
+
+#ifdef AESGCM_CLMUL
+  if (ctx->UseClmul)
+    {
+      GHashBlocksClmul (ctx, Data, noofblocks);
+      return;
+    }
+#endif
+
+  while (noofblocks-- > 0)
+    {
+      for (i = 0; i < 16; i++)
+        {
+          ctx->X[i] ^= Data[i];
+        }
+      GHashMultTable (ctx, ctx->X);
+      Data += 16;
+    }
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   GHASH of data of arbitrary length, an incomplete final block  */
+/*              is kept in the buffer of the context                          */
+/*  Syntax:     GHashData (AESGCMCTX *ctx, UCHAR *Data, int Length);          */
+/*  Input:      AESGCMCTX *ctx (Context)                                      */
+/*              UCHAR *Data (Data)                                            */
+/*              int Length (Length of data in bytes)                          */
+/*  Output:     GHASH accumulator and buffer in ctx updated                   */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+static void
+GHashData (AESGCMCTX *ctx, UCHAR *Data, int Length)
+{
+  int noofblocks;
+
+  if (ctx->BufPos)
+    {
+      while ((ctx->BufPos < 16) && (Length > 0))
+        {
+          ctx->Buf[ctx->BufPos++] = *Data++;
+          Length--;
+        }
+
+      if (ctx->BufPos == 16)
+        {
+          GHashBlocks (ctx, ctx->Buf, 1);
+          ctx->BufPos = 0;
+        }
+    }
+
+  noofblocks = Length/16;
+  if (noofblocks)
+    {
+      GHashBlocks (ctx, Data, noofblocks);
+      Data += noofblocks*16;
+      Length -= noofblocks*16;
+    }
+
+  while (Length-- > 0)
+    {
+      ctx->Buf[ctx->BufPos++] = *Data++;
+    }
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   GHASH of a pending incomplete block, padded with zeros        */
+/*  Syntax:     GHashFlush (AESGCMCTX *ctx);                                  */
+/*  Input:      AESGCMCTX *ctx (Context)                                      */
+/*  Output:     GHASH accumulator in ctx updated, buffer emptied              */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+static void
+GHashFlush (AESGCMCTX *ctx)
+{
+  if (ctx->BufPos)
+    {
+      memset (ctx->Buf + ctx->BufPos, 0, (size_t)(16 - ctx->BufPos));
+      GHashBlocks (ctx, ctx->Buf, 1);
+      ctx->BufPos = 0;
+    }
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Computation of multiples of H for 4-bit table GHASH           */
+/*  Syntax:     GHashInitTable (AESGCMCTX *ctx, UCHAR *H);                    */
+/*  Input:      UCHAR *H (Hash subkey)                                        */
+/*  Output:     Table of i*H, i = 0,...,15, in ctx                            */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+static void
+GHashInitTable (AESGCMCTX *ctx, UCHAR *H)
+{
+  int i, j;
+  ULONG v0, v1, v2, v3, T;
+
+  v0 = UC2ULBE (H);
+  v1 = UC2ULBE (H + 4);
+  v2 = UC2ULBE (H + 8);
+  v3 = UC2ULBE (H + 12);
+
+  memset (ctx->HTable[0], 0, sizeof (ctx->HTable[0]));
+  ctx->HTable[8][0] = v0;
+  ctx->HTable[8][1] = v1;
+  ctx->HTable[8][2] = v2;
+  ctx->HTable[8][3] = v3;
+
+  /* Multiplication by x in the bit-reflected representation of GCM */
+  for (i = 4; i > 0; i >>= 1)
+    {
+      T = (v3 & 1) ? 0xe1000000UL : 0;
+      v3 = (v3 >> 1) | ((v2 & 1) << 31);
+      v2 = (v2 >> 1) | ((v1 & 1) << 31);
+      v1 = (v1 >> 1) | ((v0 & 1) << 31);
+      v0 = (v0 >> 1) ^ T;
+
+      ctx->HTable[i][0] = v0;
+      ctx->HTable[i][1] = v1;
+      ctx->HTable[i][2] = v2;
+      ctx->HTable[i][3] = v3;
+    }
+
+  for (i = 2; i <= 8; i <<= 1)
+    {
+      for (j = 1; j < i; j++)
+        {
+          ctx->HTable[i + j][0] = ctx->HTable[i][0] ^ ctx->HTable[j][0];
+          ctx->HTable[i + j][1] = ctx->HTable[i][1] ^ ctx->HTable[j][1];
+          ctx->HTable[i + j][2] = ctx->HTable[i][2] ^ ctx->HTable[j][2];
+          ctx->HTable[i + j][3] = ctx->HTable[i][3] ^ ctx->HTable[j][3];
+        }
+    }
+
+#ifdef AES_SECURE
+  v0 = v1 = v2 = v3 = 0;
+#endif
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Multiplication X = X*H in GF(2^128) with 4-bit table          */
+/*  Syntax:     GHashMultTable (AESGCMCTX *ctx, UCHAR *X);                    */
+/*  Input:      AESGCMCTX *ctx (Context holding the table of multiples of H)  */
+/*              UCHAR *X (Factor, 16 bytes)                                   */
+/*  Output:     UCHAR *X (Product X*H)                                        */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+
+/* Shift of (z0,z1,z2,z3) by 4 bits with reduction of the bits shifted out */
+#define SHR4(z0, z1, z2, z3, rem) {\
+  (rem) = (int)((z3) & 0xf);\
+  (z3) = ((z3) >> 4) | (((z2) & 0xf) << 28);\
+  (z2) = ((z2) >> 4) | (((z1) & 0xf) << 28);\
+  (z1) = ((z1) >> 4) | (((z0) & 0xf) << 28);\
+  (z0) = ((z0) >> 4) ^ (Last4[(rem)] << 16);\
+}
+
+static void
+GHashMultTable (AESGCMCTX *ctx, UCHAR *X)
+{
+  int i, lo, hi, rem;
+  ULONG z0, z1, z2, z3;
+
+  lo = X[15] & 0xf;
+  z0 = ctx->HTable[lo][0];
+  z1 = ctx->HTable[lo][1];
+  z2 = ctx->HTable[lo][2];
+  z3 = ctx->HTable[lo][3];
+
+  for (i = 15; i >= 0; i--)
+    {
+      lo = X[i] & 0xf;
+      hi = (X[i] >> 4) & 0xf;
+
+      if (i != 15)
+        {
+          SHR4 (z0, z1, z2, z3, rem);
+          z0 ^= ctx->HTable[lo][0];
+          z1 ^= ctx->HTable[lo][1];
+          z2 ^= ctx->HTable[lo][2];
+          z3 ^= ctx->HTable[lo][3];
+        }
+
+      SHR4 (z0, z1, z2, z3, rem);
+      z0 ^= ctx->HTable[hi][0];
+      z1 ^= ctx->HTable[hi][1];
+      z2 ^= ctx->HTable[hi][2];
+      z3 ^= ctx->HTable[hi][3];
+    }
+
+  UL2UCBE (X, z0);
+  UL2UCBE (X + 4, z1);
+  UL2UCBE (X + 8, z2);
+  UL2UCBE (X + 12, z3);
+
+#ifdef AES_SECURE
+  z0 = z1 = z2 = z3 = 0;
+#endif
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Conversion of a length in bytes into a 64-bit bit length      */
+/*              in Big-Endian representation                                  */
+/*  Syntax:     PutBitLength (UCHAR *Block, ULONG *Length);                   */
+/*  Input:      ULONG *Length (Length in bytes as (Length[1],Length[0]))      */
+/*  Output:     UCHAR *Block (8 bytes)                                        */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+static void
+PutBitLength (UCHAR *Block, ULONG *Length)
+{
+  ULONG hi, lo;
+
+  hi = ((Length[1] << 3) | (Length[0] >> 29)) & 0xffffffffUL;
+  lo = (Length[0] << 3) & 0xffffffffUL;
+
+  UL2UCBE (Block, hi);
+  UL2UCBE (Block + 4, lo);
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Increment of the rightmost 32 bits of the counter block       */
+/*  Syntax:     Inc32 (UCHAR *Ctr);                                           */
+/*  Input:      UCHAR *Ctr (Counter block)                                    */
+/*  Output:     UCHAR *Ctr (Counter block, incremented mod 2^32)              */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+static inline void
+Inc32 (UCHAR *Ctr)
+{
+  int i;
+
+  for (i = 15; i >= 12; i--)
+    {
+      if (++Ctr[i] != 0)
+        {
+          break;
+        }
+    }
+}
+
+
+#ifdef AESGCM_CLMUL
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Test of processor support of PCLMULQDQ and SSSE3              */
+/*  Syntax:     HasClmul (void);                                              */
+/*  Input:      -                                                             */
+/*  Output:     -                                                             */
+/*  Returns:    1 if PCLMULQDQ and SSSE3 are available, 0 else                */
+/*                                                                            */
+/******************************************************************************/
+static int
+HasClmul (void)
+{
+#if defined __GNUC__
+  unsigned int a, b, c, d;
+  if (!__get_cpuid (1, &a, &b, &c, &d))
+    {
+      return 0;
+    }
+  return ((c & 0x2) && (c & 0x200));
+#else
+  int info[4];
+  __cpuid (info, 1);
+  return ((info[2] & 0x2) && (info[2] & 0x200));
+#endif
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Functions for GHASH by carry-less multiplication. Field elements are      */
+/*  held byte-reflected in SSE registers, multiplication and reduction        */
+/*  follow Gueron/Kounavis, "Intel Carry-Less Multiplication Instruction      */
+/*  and its Usage for Computing the GCM Mode". Four blocks are multiplied     */
+/*  with H^4, ..., H and reduced once (aggregated reduction).                 */
+/*                                                                            */
+/******************************************************************************/
+
+CLMUL_TARGET static inline __m128i
+ByteReflect (__m128i x)
+{
+  return _mm_shuffle_epi8 (x, _mm_set_epi8 (0, 1, 2, 3, 4, 5, 6, 7,
+                                            8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+
+/* Unreduced 256-bit product a*b added to (*lo, *hi) */
+CLMUL_TARGET static inline void
+ClMulAcc (__m128i a, __m128i b, __m128i *lo, __m128i *hi)
+{
+  __m128i t0, t1, t2, t3;
+
+  t0 = _mm_clmulepi64_si128 (a, b, 0x00);
+  t1 = _mm_clmulepi64_si128 (a, b, 0x10);
+  t2 = _mm_clmulepi64_si128 (a, b, 0x01);
+  t3 = _mm_clmulepi64_si128 (a, b, 0x11);
+
+  t1 = _mm_xor_si128 (t1, t2);
+  *lo = _mm_xor_si128 (*lo, _mm_xor_si128 (t0, _mm_slli_si128 (t1, 8)));
+  *hi = _mm_xor_si128 (*hi, _mm_xor_si128 (t3, _mm_srli_si128 (t1, 8)));
+}
+
+
+/* Reduction of the 256-bit product (lo, hi) modulo x^128+x^7+x^2+x+1 */
+CLMUL_TARGET static inline __m128i
+ClMulReduce (__m128i lo, __m128i hi)
+{
+  __m128i t2, t4, t5, t7, t8, t9;
+
+  /* Shift product left by one bit (reflected representation) */
+  t7 = _mm_srli_epi32 (lo, 31);
+  t8 = _mm_srli_epi32 (hi, 31);
+  lo = _mm_slli_epi32 (lo, 1);
+  hi = _mm_slli_epi32 (hi, 1);
+
+  t9 = _mm_srli_si128 (t7, 12);
+  t8 = _mm_slli_si128 (t8, 4);
+  t7 = _mm_slli_si128 (t7, 4);
+  lo = _mm_or_si128 (lo, t7);
+  hi = _mm_or_si128 (hi, t8);
+  hi = _mm_or_si128 (hi, t9);
+
+  /* First phase of reduction */
+  t7 = _mm_slli_epi32 (lo, 31);
+  t8 = _mm_slli_epi32 (lo, 30);
+  t9 = _mm_slli_epi32 (lo, 25);
+  t7 = _mm_xor_si128 (t7, t8);
+  t7 = _mm_xor_si128 (t7, t9);
+  t8 = _mm_srli_si128 (t7, 4);
+  t7 = _mm_slli_si128 (t7, 12);
+  lo = _mm_xor_si128 (lo, t7);
+
+  /* Second phase of reduction */
+  t2 = _mm_srli_epi32 (lo, 1);
+  t4 = _mm_srli_epi32 (lo, 2);
+  t5 = _mm_srli_epi32 (lo, 7);
+  t2 = _mm_xor_si128 (t2, t4);
+  t2 = _mm_xor_si128 (t2, t5);
+  t2 = _mm_xor_si128 (t2, t8);
+  lo = _mm_xor_si128 (lo, t2);
+
+  return _mm_xor_si128 (hi, lo);
+}
+
+
+CLMUL_TARGET static inline __m128i
+ClMul (__m128i a, __m128i b)
+{
+  __m128i lo, hi;
+
+  lo = hi = _mm_setzero_si128 ();
+  ClMulAcc (a, b, &lo, &hi);
+  return ClMulReduce (lo, hi);
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Computation of powers of H for carry-less multiplication      */
+/*  Syntax:     GHashInitClmul (AESGCMCTX *ctx, UCHAR *H);                    */
+/*  Input:      UCHAR *H (Hash subkey)                                        */
+/*  Output:     H^4, H^3, H^2, H in ctx                                       */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+CLMUL_TARGET static void
+GHashInitClmul (AESGCMCTX *ctx, UCHAR *H)
+{
+  __m128i h1, h2, h3, h4;
+
+  h1 = ByteReflect (_mm_loadu_si128 ((__m128i *)H));
+  h2 = ClMul (h1, h1);
+  h3 = ClMul (h2, h1);
+  h4 = ClMul (h3, h1);
+
+  _mm_storeu_si128 ((__m128i *)ctx->HPow[0], h4);
+  _mm_storeu_si128 ((__m128i *)ctx->HPow[1], h3);
+  _mm_storeu_si128 ((__m128i *)ctx->HPow[2], h2);
+  _mm_storeu_si128 ((__m128i *)ctx->HPow[3], h1);
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   GHASH of complete blocks by carry-less multiplication         */
+/*  Syntax:     GHashBlocksClmul (AESGCMCTX *ctx, UCHAR *Data,                */
+/*                                                     int noofblocks);       */
+/*  Input:      AESGCMCTX *ctx (Context)                                      */
+/*              UCHAR *Data (Data blocks)                                     */
+/*              int noofblocks (Number of 16-byte blocks)                     */
+/*  Output:     GHASH accumulator in ctx updated                              */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+CLMUL_TARGET static void
+GHashBlocksClmul (AESGCMCTX *ctx, UCHAR *Data, int noofblocks)
+{
+  __m128i x, d, lo, hi, h1, h2, h3, h4;
+
+  h4 = _mm_loadu_si128 ((__m128i *)ctx->HPow[0]);
+  h3 = _mm_loadu_si128 ((__m128i *)ctx->HPow[1]);
+  h2 = _mm_loadu_si128 ((__m128i *)ctx->HPow[2]);
+  h1 = _mm_loadu_si128 ((__m128i *)ctx->HPow[3]);
+
+  x = ByteReflect (_mm_loadu_si128 ((__m128i *)ctx->X));
+
+  /* X = (X + D0)*H^4 + D1*H^3 + D2*H^2 + D3*H */
+  while (noofblocks >= 4)
+    {
+      lo = hi = _mm_setzero_si128 ();
+
+      d = ByteReflect (_mm_loadu_si128 ((__m128i *)Data));
+      ClMulAcc (_mm_xor_si128 (x, d), h4, &lo, &hi);
+      d = ByteReflect (_mm_loadu_si128 ((__m128i *)(Data + 16)));
+      ClMulAcc (d, h3, &lo, &hi);
+      d = ByteReflect (_mm_loadu_si128 ((__m128i *)(Data + 32)));
+      ClMulAcc (d, h2, &lo, &hi);
+      d = ByteReflect (_mm_loadu_si128 ((__m128i *)(Data + 48)));
+      ClMulAcc (d, h1, &lo, &hi);
+
+      x = ClMulReduce (lo, hi);
+      Data += 64;
+      noofblocks -= 4;
+    }
+
+  while (noofblocks-- > 0)
+    {
+      d = ByteReflect (_mm_loadu_si128 ((__m128i *)Data));
+      x = ClMul (_mm_xor_si128 (x, d), h1);
+      Data += 16;
+    }
+
+  _mm_storeu_si128 ((__m128i *)ctx->X, ByteReflect (x));
+}
+
+#endif /* AESGCM_CLMUL */
@@ -0,0 +1,146 @@
+/******************************************************************************/
+/*                                                                            */
+/* Functions for arithmetic and number theory with large integers in C        */
+/* Software supplement to the book "Cryptography in C and C++"                */
+/* by Michael Welschenbach                                                    */
+/*                                                                            */
+/* Module aesgcm.h         Revision: 19.10.2026                               */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 1998-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+/*                                                                            */
+/******************************************************************************/
+
+#ifndef __AESGCMH__
+#define __AESGCMH__
+
+#include "aes.h"
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+
+/* Macros */
+
+#define AES_ERR_TAG        -32  /* Authentication tag does not match */
+#define AES_ERR_PHASE     -256  /* Function called out of order */
+
+#define AESGCM_MAXTAG       16  /* Maximum length of authentication tag */
+
+/* Processing phases of a context */
+
+#define AESGCM_AAD           0  /* AAD accepted */
+#define AESGCM_TEXT          1  /* Text processing has started */
+#define AESGCM_FINAL         2  /* Tag computed, context finished */
+
+/* Macros maintaining FLINT/C namespace */
+
+#define AESGCMInit            AESGCMInit_l
+#define AESGCMAad             AESGCMAad_l
+#define AESGCMUpdate          AESGCMUpdate_l
+#define AESGCMFinal           AESGCMFinal_l
+#define AESGCMPurge           AESGCMPurge_l
+
+/* GCM specific types */
+
+typedef struct
+{
+  AESKEYSCHED ks;              /* Key schedule for encryption */
+  unsigned long HTable[16][4]; /* Multiples of H for 4-bit table GHASH */
+  unsigned char HPow[4][16];   /* H^4, H^3, H^2, H (reflected) for PCLMULQDQ */
+  unsigned char J0[16];        /* Pre-counter block */
+  unsigned char Ctr[16];       /* Counter block */
+  unsigned char X[16];         /* GHASH accumulator */
+  unsigned char KeyStream[16]; /* Key stream of current partial block */
+  unsigned char Buf[16];       /* Pending partial block of AAD or ciphertext */
+  int BufPos;                  /* Number of bytes in Buf */
+  unsigned long AadLen[2];     /* Length of AAD in byte (low, high word) */
+  unsigned long TextLen[2];    /* Length of text in byte (low, high word) */
+  int DFlag;                   /* AES_ENC, AES_DEC */
+  int Phase;                   /* AESGCM_AAD, AESGCM_TEXT, AESGCM_FINAL */
+  int UseClmul;                /* GHASH by carry-less multiplication */
+} AESGCMCTX;
+
+
+/******************************************************************************/
+/* AES-GCM API: Public Functions */
+
+#ifndef __FLINT_API
+#ifdef FLINT_USEDLL
+#define __FLINT_API                   __cdecl
+#else
+#define __FLINT_API                   /**/
+#endif /* FLINT_USEDLL */
+#endif /* !defined __FLINT_API */
+
+int __FLINT_API
+AESGCMInit_l (AESGCMCTX *      ctx,
+              AESKEY           RawKey,
+              int              KeyLength,
+              unsigned char *  IV,
+              int              IVLength,
+              int              DFlag);
+
+int __FLINT_API
+AESGCMAad_l (AESGCMCTX *       ctx,
+             unsigned char *   Aad,
+             int               AadLength);
+
+int __FLINT_API
+AESGCMUpdate_l (AESGCMCTX *    ctx,
+                unsigned char *OutBlock,
+                unsigned char *InBlock,
+                int            InLength);
+
+int __FLINT_API
+AESGCMFinal_l (AESGCMCTX *     ctx,
+               unsigned char * Tag,
+               int             TagLength);
+
+void __FLINT_API
+AESGCMPurge_l (AESGCMCTX *     ctx);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* __AESGCMH__ */
@@ -0,0 +1,465 @@
+/******************************************************************************/
+/*                                                                            */
+/* Functions for arithmetic and number theory with large integers in C        */
+/* Software supplement to the book "Cryptography in C and C++"                */
+/* by Michael Welschenbach                                                    */
+/*                                                                            */
+/* Module aesstrm.c        Revision: 19.10.2026                               */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 2001-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+
+/* POSIX interfaces for memory mapping, file advice and threads */
+#define _XOPEN_SOURCE 600
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "aes.h"
+#include "aesstrm.h"
+
+
+/* Types */
+
+/* State shared by reader thread and encrypting thread */
+typedef struct
+{
+  int fd;                      /* Input file descriptor */
+  unsigned char *Buf[2];       /* Alternating buffers of AESSTREAM_CHUNK bytes */
+  size_t Chunk;                /* Bytes read into a full buffer, multiple of */
+                               /* the block length */
+  size_t Len[2];               /* Number of bytes read into Buf[i] */
+  int Full[2];                 /* Buf[i] is ready for encryption */
+  int Error;                   /* Read error occurred */
+  int Stop;                    /* Reader must stop due to an error */
+  pthread_mutex_t Lock;
+  pthread_cond_t Cond;
+} AESPIPE;
+
+
+/* Prototypes */
+
+static int CryptMapped (int OutFd, int InFd, AESWORKSPACE *ws,
+                        AESKEYSCHED *ks, off_t Size);
+static int CryptBuffered (int OutFd, int InFd, AESWORKSPACE *ws,
+                          AESKEYSCHED *ks);
+static void *Reader (void *arg);
+static int WriteAll (int fd, unsigned char *Buf, size_t Len);
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   AES encryption and decryption of a file                       */
+/*              The data read from InFd are processed by AESCrypt_l in the    */
+/*              mode given by ws and ks and written to OutFd                  */
+/*              If both descriptors refer to regular files positioned at      */
+/*              offset 0 and OutFd is open for reading and writing, input     */
+/*              and output are memory mapped and encrypted without copying.   */
+/*              Otherwise a reader thread fills one buffer while the other    */
+/*              buffer is encrypted and written                               */
+/*  Syntax:     int                                                           */
+/*              AESCryptFd_l (int OutFd, int InFd, AESWORKSPACE *ws,          */
+/*                                          AESKEYSCHED *ks, int Method);     */
+/*  Input:      int InFd (File descriptor opened for reading)                 */
+/*              int OutFd (File descriptor opened for reading and writing if  */
+/*                         memory mapping is to be used, else for writing)    */
+/*              AESWORKSPACE *ws (Initialized buffer)                         */
+/*              AESKEYSCHED *ks (Initialized Keyschedule, may be NULL if ws   */
+/*                               was initialized by AESInitCached_l)          */
+/*              int Method (AESSTREAM_AUTO, AESSTREAM_MMAP or                 */
+/*                          AESSTREAM_BUFFERED)                               */
+/*  Output:     Ciphertext/Plaintext written to OutFd                         */
+/*  Returns:    E_AES_OK if everything is O.K.                                */
+/*              E_AES_IO if reading, writing or mapping failed or if          */
+/*                       AESSTREAM_MMAP is requested for unsuitable files     */
+/*              E_AES_MEM if no buffers could be allocated                    */
+/*              E_AES_BLKLENGTH if the file length is not a multiple of the   */
+/*                              block length in ECB or CBC mode               */
+/*              Error codes of AESCrypt_l                                     */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+AESCryptFd_l (int OutFd, int InFd, AESWORKSPACE *ws, AESKEYSCHED *ks,
+                                                      int Method)
+{
+  struct stat InStat, OutStat;
+  int mappable;
+
+  if (ws == NULL || InFd < 0 || OutFd < 0)
+    {
+      return AES_ERR_INIT;
+    }
+
+  mappable = (fstat (InFd, &InStat) == 0) && S_ISREG (InStat.st_mode) &&
+             (fstat (OutFd, &OutStat) == 0) && S_ISREG (OutStat.st_mode) &&
+             (lseek (InFd, 0, SEEK_CUR) == 0) &&
+             (lseek (OutFd, 0, SEEK_CUR) == 0) &&
+             ((fcntl (OutFd, F_GETFL) & O_ACCMODE) == O_RDWR);
+
+  switch (Method)
+    {
+      case AESSTREAM_AUTO:
+        if (mappable)
+          {
+            return CryptMapped (OutFd, InFd, ws, ks, InStat.st_size);
+          }
+        return CryptBuffered (OutFd, InFd, ws, ks);
+
+      case AESSTREAM_MMAP:
+        if (!mappable)
+          {
+            return AES_ERR_IO;
+          }
+        return CryptMapped (OutFd, InFd, ws, ks, InStat.st_size);
+
+      case AESSTREAM_BUFFERED:
+        return CryptBuffered (OutFd, InFd, ws, ks);
+
+      default:
+        return AES_ERR_MODE;
+    }
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Encryption between memory mapped files                        */
+/*              Input and output are mapped in windows of AESSTREAM_WINDOW    */
+/*              bytes, rounded down to a multiple of the page size times the  */
+/*              block length. While a window is encrypted, the kernel is      */
+/*              advised to read ahead the next window of the input, and       */
+/*              written output windows are scheduled for asynchronous write   */
+/*              back                                                          */
+/*  Syntax:     static int                                                    */
+/*              CryptMapped (int OutFd, int InFd, AESWORKSPACE *ws,           */
+/*                                         AESKEYSCHED *ks, off_t Size);      */
+/*  Input:      int InFd, OutFd (File descriptors of regular files)           */
+/*              AESWORKSPACE *ws (Initialized buffer)                         */
+/*              AESKEYSCHED *ks (Initialized Keyschedule or NULL)             */
+/*              off_t Size (Length of input file)                             */
+/*  Output:     Output file of length Size                                    */
+/*  Returns:    E_AES_OK if everything is O.K.                                */
+/*              E_AES_IO if mapping failed                                    */
+/*              Error codes of AESCrypt_l                                     */
+/*                                                                            */
+/******************************************************************************/
+static int
+CryptMapped (int OutFd, int InFd, AESWORKSPACE *ws, AESKEYSCHED *ks,
+                                                    off_t Size)
+{
+  unsigned char *in, *out;
+  off_t offset;
+  size_t window, pos, len, chunk, maxwindow, align;
+  int error = AES_OK;
+
+  if (ws->mode != AES_CTR && (Size % (ws->BlkLength >> 3)))
+    {
+      return AES_ERR_BLKLENGTH;
+    }
+
+  /* Windows start at multiples of the page size and of the block length,
+     hence every call of AESCrypt_l but the last gets whole blocks */
+  align = (size_t)sysconf (_SC_PAGESIZE) * (size_t)(ws->BlkLength >> 3);
+  maxwindow = AESSTREAM_WINDOW - AESSTREAM_WINDOW % align;
+  chunk = AESSTREAM_CHUNK - AESSTREAM_CHUNK % (ws->BlkLength >> 3);
+
+  if (ftruncate (OutFd, Size) != 0)
+    {
+      return AES_ERR_IO;
+    }
+
+  for (offset = 0; offset < Size && error == AES_OK; offset += window)
+    {
+      window = (Size - offset < (off_t)maxwindow) ?
+                 (size_t)(Size - offset) : maxwindow;
+
+      /* Read ahead of the next window overlaps with encryption of this one */
+      posix_fadvise (InFd, offset + window, AESSTREAM_WINDOW,
+                     POSIX_FADV_WILLNEED);
+
+      in = (unsigned char *)mmap (NULL, window, PROT_READ, MAP_SHARED,
+                                  InFd, offset);
+      if (in == (unsigned char *)MAP_FAILED)
+        {
+          return AES_ERR_IO;
+        }
+
+      out = (unsigned char *)mmap (NULL, window, PROT_READ | PROT_WRITE,
+                                   MAP_SHARED, OutFd, offset);
+      if (out == (unsigned char *)MAP_FAILED)
+        {
+          munmap (in, window);
+          return AES_ERR_IO;
+        }
+
+      posix_madvise (in, window, POSIX_MADV_SEQUENTIAL);
+
+      for (pos = 0; pos < window && error == AES_OK; pos += len)
+        {
+          len = (window - pos < chunk) ? window - pos : chunk;
+          error = AESCrypt_l (out + pos, ws, ks, in + pos, (int)len);
+        }
+
+      /* Start write back of the output window without waiting for it */
+      msync (out, window, MS_ASYNC);
+
+      munmap (out, window);
+      munmap (in, window);
+      posix_fadvise (InFd, offset, window, POSIX_FADV_DONTNEED);
+    }
+
+  lseek (InFd, Size, SEEK_SET);
+  lseek (OutFd, Size, SEEK_SET);
+
+  return error;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Encryption by a double buffered read/write pipeline           */
+/*              A reader thread fills two buffers alternately, the calling    */
+/*              thread encrypts a filled buffer in place and writes it while  */
+/*              the reader fills the other buffer                             */
+/*  Syntax:     static int                                                    */
+/*              CryptBuffered (int OutFd, int InFd, AESWORKSPACE *ws,         */
+/*                                                  AESKEYSCHED *ks);         */
+/*  Input:      int InFd, OutFd (File descriptors)                            */
+/*              AESWORKSPACE *ws (Initialized buffer)                         */
+/*              AESKEYSCHED *ks (Initialized Keyschedule or NULL)             */
+/*  Output:     Ciphertext/Plaintext written to OutFd                         */
+/*  Returns:    E_AES_OK if everything is O.K.                                */
+/*              E_AES_IO if reading or writing failed                         */
+/*              E_AES_MEM if no buffers could be allocated                    */
+/*              Error codes of AESCrypt_l                                     */
+/*                                                                            */
+/******************************************************************************/
+static int
+CryptBuffered (int OutFd, int InFd, AESWORKSPACE *ws, AESKEYSCHED *ks)
+{
+  AESPIPE pl;
+  pthread_t reader;
+  size_t len;
+  int i, error = AES_OK;
+
+  memset (&pl, 0, sizeof (pl));
+  pl.fd = InFd;
+  pl.Chunk = AESSTREAM_CHUNK - AESSTREAM_CHUNK % (ws->BlkLength >> 3);
+
+  if ((pl.Buf[0] = (unsigned char *)malloc (2 * AESSTREAM_CHUNK)) == NULL)
+    {
+      return AES_ERR_MEM;
+    }
+  pl.Buf[1] = pl.Buf[0] + AESSTREAM_CHUNK;
+
+  pthread_mutex_init (&pl.Lock, NULL);
+  pthread_cond_init (&pl.Cond, NULL);
+
+  if (pthread_create (&reader, NULL, Reader, &pl) != 0)
+    {
+      error = AES_ERR_MEM;
+    }
+
+  for (i = 0; error == AES_OK; i ^= 1)
+    {
+      pthread_mutex_lock (&pl.Lock);
+      while (!pl.Full[i])
+        {
+          pthread_cond_wait (&pl.Cond, &pl.Lock);
+        }
+      len = pl.Len[i];
+      if (pl.Error)
+        {
+          error = AES_ERR_IO;
+        }
+      pthread_mutex_unlock (&pl.Lock);
+
+      if (error == AES_OK && len > 0)
+        {
+          error = AESCrypt_l (pl.Buf[i], ws, ks, pl.Buf[i], (int)len);
+          if (error == AES_OK && WriteAll (OutFd, pl.Buf[i], len) != 0)
+            {
+              error = AES_ERR_IO;
+            }
+        }
+
+      pthread_mutex_lock (&pl.Lock);
+      pl.Full[i] = 0;
+      if (error != AES_OK)
+        {
+          pl.Stop = 1;
+        }
+      pthread_cond_broadcast (&pl.Cond);
+      pthread_mutex_unlock (&pl.Lock);
+
+      if (len < pl.Chunk)
+        {
+          break;
+        }
+    }
+
+  if (error != AES_ERR_MEM)
+    {
+      pthread_join (reader, NULL);
+    }
+
+  pthread_cond_destroy (&pl.Cond);
+  pthread_mutex_destroy (&pl.Lock);
+
+#ifdef AES_SECURE
+  memset (pl.Buf[0], 0, 2 * AESSTREAM_CHUNK);
+#endif
+  free (pl.Buf[0]);
+
+  return error;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Reader thread of the buffered pipeline                        */
+/*              Fills the buffers alternately with Chunk bytes.               */
+/*              A buffer with fewer bytes marks the end of the input          */
+/*  Syntax:     static void *                                                 */
+/*              Reader (void *arg);                                           */
+/*  Input:      void *arg (Pointer to AESPIPE)                                */
+/*  Output:     Filled buffers                                                */
+/*  Returns:    NULL                                                          */
+/*                                                                            */
+/******************************************************************************/
+static void *
+Reader (void *arg)
+{
+  AESPIPE *pl = (AESPIPE *)arg;
+  size_t len;
+  ssize_t n;
+  int i, error;
+
+  for (i = 0;; i ^= 1)
+    {
+      pthread_mutex_lock (&pl->Lock);
+      while (pl->Full[i] && !pl->Stop)
+        {
+          pthread_cond_wait (&pl->Cond, &pl->Lock);
+        }
+      if (pl->Stop)
+        {
+          pthread_mutex_unlock (&pl->Lock);
+          break;
+        }
+      pthread_mutex_unlock (&pl->Lock);
+
+      for (len = 0, error = 0; len < pl->Chunk;)
+        {
+          n = read (pl->fd, pl->Buf[i] + len, pl->Chunk - len);
+          if (n < 0)
+            {
+              if (errno == EINTR)
+                {
+                  continue;
+                }
+              error = 1;
+              break;
+            }
+          if (n == 0)
+            {
+              break;
+            }
+          len += (size_t)n;
+        }
+
+      pthread_mutex_lock (&pl->Lock);
+      pl->Len[i] = len;
+      pl->Error = error;
+      pl->Full[i] = 1;
+      pthread_cond_broadcast (&pl->Cond);
+      pthread_mutex_unlock (&pl->Lock);
+
+      if (error || len < pl->Chunk)
+        {
+          break;
+        }
+    }
+
+  return NULL;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Writing of a complete buffer                                  */
+/*  Syntax:     static int                                                    */
+/*              WriteAll (int fd, unsigned char *Buf, size_t Len);            */
+/*  Input:      int fd (File descriptor)                                      */
+/*              unsigned char *Buf (Data)                                     */
+/*              size_t Len (Number of bytes)                                  */
+/*  Output:     -                                                             */
+/*  Returns:    0 if all bytes were written, -1 else                          */
+/*                                                                            */
+/******************************************************************************/
+static int
+WriteAll (int fd, unsigned char *Buf, size_t Len)
+{
+  ssize_t n;
+
+  while (Len > 0)
+    {
+      n = write (fd, Buf, Len);
+      if (n < 0)
+        {
+          if (errno == EINTR)
+            {
+              continue;
+            }
+          return -1;
+        }
+      Buf += n;
+      Len -= (size_t)n;
+    }
+
+  return 0;
+}
@@ -0,0 +1,101 @@
+/******************************************************************************/
+/*                                                                            */
+/* Functions for arithmetic and number theory with large integers in C        */
+/* Software supplement to the book "Cryptography in C and C++"                */
+/* by Michael Welschenbach                                                    */
+/*                                                                            */
+/* Module aesstrm.h        Revision: 19.10.2026                               */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 1998-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+
+#ifndef __AESSTRMH__
+#define __AESSTRMH__
+
+#include "aes.h"
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/* Macros */
+
+#define AES_ERR_IO         -64  /* Read, write or mapping of a file failed */
+#define AES_ERR_MEM       -128  /* Allocation of buffers failed */
+
+#define AESSTREAM_AUTO       0  /* Memory mapping if possible, else buffers */
+#define AESSTREAM_MMAP       1  /* Memory mapping of input and output only */
+#define AESSTREAM_BUFFERED   2  /* Double buffered read/write pipeline */
+
+/* Both sizes are rounded down to whole blocks of the workspace */
+#define AESSTREAM_CHUNK   (1L << 20) /* Bytes per call of AESCrypt_l */
+#ifndef AESSTREAM_WINDOW
+#define AESSTREAM_WINDOW (64L << 20) /* Bytes mapped at once */
+#endif
+
+/* Macros maintaining FLINT/C namespace */
+
+#define AESCryptFd            AESCryptFd_l
+
+
+/******************************************************************************/
+/* AES streaming API: Public Functions */
+
+#ifndef __FLINT_API
+#ifdef FLINT_USEDLL
+#define __FLINT_API                   __cdecl
+#else
+#define __FLINT_API                   /**/
+#endif /* FLINT_USEDLL */
+#endif /* !defined __FLINT_API */
+
+int __FLINT_API
+AESCryptFd_l (int             OutFd,
+              int             InFd,
+              AESWORKSPACE *  ws,
+              AESKEYSCHED *   ks,
+              int             Method);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* __AESSTRMH__ */
@@ -67,6 +67,32 @@
 
 #include "flint.h"
 
+/* Trial division in sieve_l by AVX, selected at runtime. Compile with     */
+/* -DFLINT_NO_SIEVESIMD to use the portable C implementation only.         */
+#if !defined FLINT_NO_SIEVESIMD
+#if defined __GNUC__ && (defined __x86_64__ || defined __i386__)
+#define SIEVE_SIMD
+#include <cpuid.h>
+#include <immintrin.h>
+#define AVX_TARGET __attribute__ ((target ("avx")))
+#elif defined _MSC_VER && (_MSC_VER >= 1900) && (defined _M_X64 || defined _M_IX86)
+#define SIEVE_SIMD
+#include <intrin.h>
+#include <immintrin.h>
+#define AVX_TARGET /**/
+#endif
+#endif /* !FLINT_NO_SIEVESIMD */
+
+/* Unsigned integer type of 64 bit for the remainders in sieve_l */
+#ifndef __ULLONG_DEFINED
+#define __ULLONG_DEFINED
+#if defined _MSC_VER || defined __BORLANDC__ || defined __WATCOMC__
+typedef unsigned __int64 ULLONG;
+#else
+typedef unsigned long long ULLONG;
+#endif
+#endif /* !__ULLONG_DEFINED */
+
 #define NO_ASSERTS 1
 
 #define FLINTCVMAJ  3
@@ -112,11 +138,68 @@ static int
 allocate_reg_l (void);
 /* Integer square roots from ULONG values */
 static ULONG
-ul_iroot (unsigned long n);
+ul_iroot (ULONG n);
 /*  Test and set bit w/o checking for overrun */
 static int 
 setbit (CLINT a_l, unsigned int pos);
 
+/* Trial division in sieve_l: Consecutive small primes are grouped to    */
+/* products m < 2^32, the remainders of the dividend modulo SIEVEBATCH   */
+/* products are computed at once and then reduced modulo the primes.    */
+#define SIEVEBATCH      8  /* Number of products per block */
+#define SIEVEMAXGROUP   9  /* Maximum number of primes per product */
+
+typedef struct
+{
+  ULONG m[SIEVEBATCH];                  /* Products of small primes */
+  ULONG r[SIEVEBATCH];                  /* Remainders of the dividend mod m */
+  USHORT p[SIEVEBATCH * SIEVEMAXGROUP]; /* Primes in ascending order */
+  unsigned int end[SIEVEBATCH];         /* Primes of m[k] end before p[end[k]] */
+  unsigned int count;                   /* Number of products in the block */
+} SIEVEBLOCK;
+
+static unsigned int
+sieve_block (SIEVEBLOCK *b, unsigned int i, unsigned int n, USHORT *qv);
+static void
+sieve_rem (CLINT a_l, SIEVEBLOCK *b);
+#ifdef SIEVE_SIMD
+static int
+SieveCpuSupport (void);
+static void
+sieve_rem_avx (CLINT a_l, SIEVEBLOCK *b);
+#endif
+
+/* Prime iterator: Segments of 32 KByte, the size of a typical L1 data    */
+/* cache, with one bit per odd number. The segments are initialized with  */
+/* a pattern sieved by the wheel primes 3, 5, 7 and 11 with a period of   */
+/* 8 * 1155 odd numbers.                                                  */
+#define PRIMESEGBYTES   32768UL
+#define PRIMESEGBITS    (PRIMESEGBYTES << 3)
+#define PRIMEWHEEL      1155UL  /* 3 * 5 * 7 * 11 bytes */
+
+static void
+sieve_segment (PRIMEITER *it);
+
+/* Primality tests in prime_l: Strong probable prime test, strong Lucas  */
+/* probable prime test, Baillie-PSW test and Miller-Rabin rounds with    */
+/* pseudo-random bases                                                   */
+static int
+sprp (CLINT x_l, CLINT d_l, CLINT n_l, USHORT k);
+static int
+slprp (CLINT n_l);
+static int
+bpsw (CLINT n_l, CLINT d_l, CLINT q_l, USHORT k);
+static int
+mrrandom (CLINT n_l, CLINT d_l, CLINT q_l, USHORT k, unsigned int rounds);
+
+/* Policy of prime_l for iterations == 0, number of additional MR rounds */
+static int PrimeTest = PRIMETEST_LEGACY;
+static unsigned int PrimeTestRounds = 0;
+
+/* Implementation of the trial division in use, -1 if not yet selected */
+static int SieveImpl = -1;
+#define SIEVEIMPL() ((SieveImpl < 0) ? sieveimpl_l (SIEVE_IMPL_BEST) : SieveImpl)
+
 #ifdef FLINT_SECURE
 #define PURGEVARS_L(X) purgevars_l X
 /* Function to purge variables */
@@ -4713,6 +4796,9 @@ jacobi_l (CLINT aa_l, CLINT bb_l)
 /******************************************************************************/
 /*                                                                            */
 /*  Function:  Sieving by dividing by small primes                            */
+/*             The remainders modulo products of consecutive primes are       */
+/*             computed first, eight products at a time, then reduced modulo  */
+/*             the single primes. The smallest prime factor is returned.      */
 /*  Syntax:    USHORT sieve_l (CLINT a_l, unsigned int no_of_smallprimes);    */
 /*  Input:     a_l (Dividend),                                                */
 /*             no_of_smallprimes (Number of small primes to divide by)        */
@@ -4725,10 +4811,9 @@ jacobi_l (CLINT aa_l, CLINT bb_l)
 USHORT __FLINT_API
 sieve_l (CLINT a_l, unsigned int no_of_smallprimes)
 {
-  clint *aptr_l;
-  USHORT bv, rv, qv;
-  ULONG rhat;
-  unsigned int i = 1;
+  SIEVEBLOCK b;
+  USHORT bv = 0, qv = 2;
+  unsigned int i = 1, j, k;
 
   if (ISEVEN_L (a_l))
     {
@@ -4742,63 +4827,300 @@ sieve_l (CLINT a_l, unsigned int no_of_smallprimes)
         }
     }
 
-  no_of_smallprimes = MIN (no_of_smallprimes, NOOFSMALLPRIMES);
-  bv = 2;
-  do
-    {
-      rv = 0;
-      bv += smallprimes[i];
+  /* Odd primes smallprimes[1], ..., smallprimes[NOOFSMALLPRIMES - 1], */
+  /* at least 3 is tested                                                */
+  no_of_smallprimes = MIN (no_of_smallprimes, NOOFSMALLPRIMES - 1);
+  no_of_smallprimes = MAX (no_of_smallprimes, 1);
 
-      Assert (bv < 2000);
+  while (0 == bv && i <= no_of_smallprimes)
+    {
+      i = sieve_block (&b, i, no_of_smallprimes, &qv);
 
-      for (aptr_l = MSDPTR_L (a_l); aptr_l >= LSDPTR_L (a_l); aptr_l--)
+#ifdef SIEVE_SIMD
+      if (SIEVE_IMPL_AVX == SIEVEIMPL ())
         {
-          qv = (USHORT)((rhat = ((((ULONG)rv) << BITPERDGT) +
-                                           (ULONG)*aptr_l)) / bv);
-          rv = (USHORT)(rhat - (ULONG)bv * (ULONG)qv);
+          sieve_rem_avx (a_l, &b);
+        }
+      else
+#endif
+        {
+          sieve_rem (a_l, &b);
         }
 
-    }
-  while (rv != 0 && ++i <= no_of_smallprimes);
-
-  if (0 == rv)
-    {
-      if (DIGITS_L (a_l) == 1 && *LSDPTR_L (a_l) == bv)
+      for (k = 0, j = 0; 0 == bv && k < b.count; k++)
         {
-          bv = 1;
+          for (; 0 == bv && j < b.end[k]; j++)
+            {
+              if (0 == b.r[k] % b.p[j])
+                {
+                  bv = b.p[j];
+                }
+            }
         }
-      /* else: result is bv */
     }
-  else
+
+  if (bv != 0 && DIGITS_L (a_l) == 1 && *LSDPTR_L (a_l) == bv)
     {
-      bv = 0;
+      bv = 1;
     }
 
   /* Purging of variables */
-  PURGEVARS_L ((4, sizeof (rhat), &rhat,
-                   sizeof (i), &i,
-                   sizeof (rv), &rv,
+#ifdef FLINT_SECURE
+  memset (&b, 0, sizeof (b));
+#endif
+  PURGEVARS_L ((2, sizeof (i), &i,
                    sizeof (qv), &qv));
 
-  ISPURGED_L  ((4, sizeof (rhat), &rhat,
-                   sizeof (i), &i,
-                   sizeof (rv), &rv,
+  ISPURGED_L  ((2, sizeof (i), &i,
                    sizeof (qv), &qv));
 
   return bv;
 }
 
 
+/******************************************************************************/
+/*                                                                            */
+/*  Function:  Next block of products of consecutive small primes for sieve_l */
+/*             Each product m < 2^32 is extended by the next prime as long as */
+/*             it stays below 2^32, i.e. from 3*5*...*29 down to pairs of     */
+/*             primes close to 2^16.                                          */
+/*  Syntax:    static unsigned int sieve_block (SIEVEBLOCK *b, unsigned int i,*/
+/*                                           unsigned int n, USHORT *qv);     */
+/*  Input:     i (Index of the first prime in smallprimes[])                  */
+/*             n (Index of the last prime to be used)                         */
+/*             qv (Prime preceding the first one)                             */
+/*  Output:    b (Products and their primes)                                  */
+/*             qv (Last prime in b)                                           */
+/*  Returns:   Index of the prime following the block                         */
+/*                                                                            */
+/******************************************************************************/
+static unsigned int
+sieve_block (SIEVEBLOCK *b, unsigned int i, unsigned int n, USHORT *qv)
+{
+  ULONG m;
+  unsigned int j = 0;
+
+  for (b->count = 0; b->count < SIEVEBATCH && i <= n; b->count++)
+    {
+      m = 1;
+      while (i <= n && m <= 0xffffffffUL / (ULONG)(*qv + smallprimes[i]))
+        {
+          *qv += smallprimes[i++];
+          m *= *qv;
+          b->p[j++] = *qv;
+        }
+      b->m[b->count] = m;
+      b->end[b->count] = j;
+    }
+
+  return i;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:  Remainders of a_l modulo the products in a block, two digits   */
+/*             per division                                                   */
+/*  Syntax:    static void sieve_rem (CLINT a_l, SIEVEBLOCK *b);              */
+/*  Input:     a_l (Dividend)                                                 */
+/*             b (Products)                                                   */
+/*  Output:    b (Remainders)                                                 */
+/*  Returns:   -                                                              */
+/*                                                                            */
+/******************************************************************************/
+static void
+sieve_rem (CLINT a_l, SIEVEBLOCK *b)
+{
+  clint *aptr_l;
+  ULLONG r;
+  unsigned int k;
+
+  for (k = 0; k < b->count; k++)
+    {
+      aptr_l = MSDPTR_L (a_l);
+      r = 0;
+      if (DIGITS_L (a_l) & 1)
+        {
+          r = *aptr_l-- % b->m[k];
+        }
+
+      for (; aptr_l > LSDPTR_L (a_l); aptr_l -= 2)
+        {
+          r = ((r << (BITPERDGT << 1)) | ((ULLONG)*aptr_l << BITPERDGT) |
+               (ULLONG)*(aptr_l - 1)) % b->m[k];
+        }
+
+      b->r[k] = (ULONG)r;
+    }
+
+#ifdef FLINT_SECURE
+  memset (&r, 0, sizeof (r));
+#endif
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:  Selection of the implementation of the trial division in       */
+/*             sieve_l. The fastest implementation available on the           */
+/*             processor up to Impl is selected. Without a call of            */
+/*             sieveimpl_l the fastest implementation available is used.      */
+/*  Syntax:    int sieveimpl_l (int Impl);                                    */
+/*  Input:     Impl (SIEVE_IMPL_C, SIEVE_IMPL_AVX or SIEVE_IMPL_BEST)         */
+/*  Output:    -                                                              */
+/*  Returns:   Implementation selected                                        */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+sieveimpl_l (int Impl)
+{
+  int impl = SIEVE_IMPL_C;
+
+#ifdef SIEVE_SIMD
+  if (Impl >= SIEVE_IMPL_AVX && SieveCpuSupport ())
+    {
+      impl = SIEVE_IMPL_AVX;
+    }
+#else
+  (void)Impl;
+#endif
+
+  SieveImpl = impl;
+  return impl;
+}
+
+
+#ifdef SIEVE_SIMD
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:  Test of processor support of AVX, including the support of the */
+/*             operating system for saving the AVX registers                  */
+/*  Syntax:    static int SieveCpuSupport (void);                             */
+/*  Input:     -                                                              */
+/*  Output:    -                                                              */
+/*  Returns:   1 if AVX is available, 0 else                                  */
+/*                                                                            */
+/******************************************************************************/
+static int
+SieveCpuSupport (void)
+{
+  unsigned int ecx1, xcr0 = 0;
+#if defined __GNUC__
+  unsigned int a, b, c, d;
+
+  if (!__get_cpuid (1, &a, &b, &c, &d))
+    {
+      return 0;
+    }
+  ecx1 = c;
+  if (c & 0x08000000)
+    {
+      __asm__ ("xgetbv" : "=a" (xcr0), "=d" (d) : "c" (0));
+    }
+#else
+  int info[4];
+
+  __cpuid (info, 0);
+  if (info[0] < 1)
+    {
+      return 0;
+    }
+  __cpuid (info, 1);
+  ecx1 = (unsigned int)info[2];
+  if (ecx1 & 0x08000000)
+    {
+      xcr0 = (unsigned int)_xgetbv (0);
+    }
+#endif
+
+  return (ecx1 & 0x18000000) == 0x18000000 && (xcr0 & 0x06) == 0x06;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:  Remainders of a_l modulo the products in a block by AVX, four  */
+/*             products per register in double precision. Since r < m < 2^32, */
+/*             all values r*2^16 + digit and q*m are exact; the quotient q    */
+/*             from the reciprocal of m is corrected by at most one.          */
+/*  Syntax:    static void sieve_rem_avx (CLINT a_l, SIEVEBLOCK *b);          */
+/*  Input:     a_l (Dividend)                                                 */
+/*             b (Products)                                                   */
+/*  Output:    b (Remainders)                                                 */
+/*  Returns:   -                                                              */
+/*                                                                            */
+/******************************************************************************/
+#define SIEVE_AVX_STEP(R, M, INV)                                             \
+  t = _mm256_add_pd (_mm256_mul_pd ((R), base), d);                           \
+  q = _mm256_floor_pd (_mm256_mul_pd (t, (INV)));                             \
+  (R) = _mm256_sub_pd (t, _mm256_mul_pd (q, (M)));                            \
+  (R) = _mm256_add_pd ((R), _mm256_and_pd (_mm256_cmp_pd ((R), zero,          \
+                                             _CMP_LT_OQ), (M)));              \
+  (R) = _mm256_sub_pd ((R), _mm256_and_pd (_mm256_cmp_pd ((R), (M),           \
+                                             _CMP_GE_OQ), (M)))
+
+static void AVX_TARGET
+sieve_rem_avx (CLINT a_l, SIEVEBLOCK *b)
+{
+  __m256d m0, m1, inv0, inv1, r0, r1, t, q, d, base, zero;
+  double v[SIEVEBATCH];
+  clint *aptr_l;
+  unsigned int k;
+
+  /* Unused lanes are set to m = 1 */
+  for (k = 0; k < SIEVEBATCH; k++)
+    {
+      v[k] = (k < b->count) ? (double)b->m[k] : 1.0;
+    }
+
+  m0 = _mm256_loadu_pd (v);
+  m1 = _mm256_loadu_pd (v + 4);
+  inv0 = _mm256_div_pd (_mm256_set1_pd (1.0), m0);
+  inv1 = _mm256_div_pd (_mm256_set1_pd (1.0), m1);
+  base = _mm256_set1_pd ((double)BASE);
+  zero = _mm256_setzero_pd ();
+  r0 = zero;
+  r1 = zero;
+
+  for (aptr_l = MSDPTR_L (a_l); aptr_l >= LSDPTR_L (a_l); aptr_l--)
+    {
+      d = _mm256_set1_pd ((double)*aptr_l);
+      SIEVE_AVX_STEP (r0, m0, inv0);
+      SIEVE_AVX_STEP (r1, m1, inv1);
+    }
+
+  _mm256_storeu_pd (v, r0);
+  _mm256_storeu_pd (v + 4, r1);
+  for (k = 0; k < b->count; k++)
+    {
+      b->r[k] = (ULONG)v[k];
+    }
+
+#ifdef FLINT_SECURE
+  memset (v, 0, sizeof (v));
+  r0 = r1 = t = d = zero;
+#endif
+}
+
+#endif /* SIEVE_SIMD */
+
+
 /******************************************************************************/
 /*                                                                            */
 /*  Function:  Probabilistic primality test acc. to Miller-Rabin (MR-Test)    */
+/*             or Baillie-PSW                                                 */
 /*  Syntax:    int prime_l (CLINT n_l, unsigned int no_of_smallprimes,        */
 /*                                                 unsigned int iterations);  */
 /*  Input:     n_l (Number to be tested),                                     */
 /*             no_of_smallprimes (Number of small primes for the sieve)       */
 /*             iterations (Number of rounds for the MR-Test.                  */
-/*                         If iterations == 0 the optimized number of rounds  */
-/*                         for an error probability < 2^-80 is used.)         */
+/*                         If iterations == 0 the policy set by primetest_l() */
+/*                         is applied: PRIMETEST_LEGACY uses the optimized    */
+/*                         number of rounds for an error probability < 2^-80, */
+/*                         PRIMETEST_BPSW the Baillie-PSW test and            */
+/*                         PRIMETEST_BPSWMR the Baillie-PSW test followed by  */
+/*                         MR rounds with pseudo-random bases.)               */
 /*  Output:    -                                                              */
 /*  Returns:   1: n_l probably prime                                          */
 /*             0: n_l definitely not prime                                    */
@@ -4808,7 +5130,7 @@ int __FLINT_API
 prime_l (CLINT n_l, unsigned int no_of_smallprimes, unsigned int iterations)
 {
   CLINT d_l, x_l, q_l;
-  USHORT i, j, k, p;
+  USHORT i, k, p;
   int isprime;
 
   if (EQONE_L (n_l))
@@ -4829,37 +5151,56 @@ prime_l (CLINT n_l, unsigned int no_of_smallprimes, unsigned int iterations)
     }
   else
     {
+      cpy_l (d_l, n_l);
+      dec_l (d_l);
+      k = (USHORT)twofact_l (d_l, q_l);
+
+      if (0 == iterations && PRIMETEST_LEGACY != PrimeTest)
+        {
+          isprime = bpsw (n_l, d_l, q_l, k);
+          if (isprime && PRIMETEST_BPSWMR == PrimeTest)
+            {
+              isprime = mrrandom (n_l, d_l, q_l, k, PrimeTestRounds);
+            }
+
+          PURGEVARS_L ((3, sizeof (k), &k,
+                           sizeof (d_l), d_l,
+                           sizeof (q_l), q_l));
+
+          ISPURGED_L  ((3, sizeof (k), &k,
+                           sizeof (d_l), d_l,
+                           sizeof (q_l), q_l));
+
+          return isprime;
+        }
+
       /* If iterations == 0 was given as a parameter optimize the number */
       /* of iterations for an error probability < 2^-80 (cf. Chap. 10.5) */
       if (0 == iterations)
         {
-          k = ld_l (n_l);
-          if      (k <   73) iterations = 37;
-          else if (k <  105) iterations = 32;
-          else if (k <  137) iterations = 25;
-          else if (k <  197) iterations = 19;
-          else if (k <  220) iterations = 15;
-          else if (k <  235) iterations = 13;
-          else if (k <  252) iterations = 12;
-          else if (k <  273) iterations = 11;
-          else if (k <  300) iterations = 10;
-          else if (k <  332) iterations =  9;
-          else if (k <  375) iterations =  8;
-          else if (k <  433) iterations =  7;
-          else if (k <  514) iterations =  6;
-          else if (k <  638) iterations =  5;
-          else if (k <  847) iterations =  4;
-          else if (k < 1275) iterations =  3;
-          else if (k < 2861) iterations =  2;
+          i = ld_l (n_l);
+          if      (i <   73) iterations = 37;
+          else if (i <  105) iterations = 32;
+          else if (i <  137) iterations = 25;
+          else if (i <  197) iterations = 19;
+          else if (i <  220) iterations = 15;
+          else if (i <  235) iterations = 13;
+          else if (i <  252) iterations = 12;
+          else if (i <  273) iterations = 11;
+          else if (i <  300) iterations = 10;
+          else if (i <  332) iterations =  9;
+          else if (i <  375) iterations =  8;
+          else if (i <  433) iterations =  7;
+          else if (i <  514) iterations =  6;
+          else if (i <  638) iterations =  5;
+          else if (i <  847) iterations =  4;
+          else if (i < 1275) iterations =  3;
+          else if (i < 2861) iterations =  2;
           else iterations = 1;
         }
 
-      cpy_l (d_l, n_l);
-      dec_l (d_l);
-      k = (USHORT)twofact_l (d_l, q_l);
       p = 0; /* Start with base a = 2 */
       i = 0;
-      isprime = 1;
 
       do
         {
@@ -4871,35 +5212,19 @@ prime_l (CLINT n_l, unsigned int no_of_smallprimes, unsigned int iterations)
           wmexpm_l (p, q_l, x_l, n_l);
 #endif /* FLINT_ASM */
 
-          if (!EQONE_L (x_l))
-            {
-
-              j = 0;
-
-              while (!EQONE_L (x_l) && !equ_l (x_l, d_l) && ++j < k)
-                {
-                  msqr_l (x_l, x_l, n_l);
-                }
-
-              if (!equ_l (x_l, d_l))
-                {
-                  isprime = 0;
-                }
-            }
+          isprime = sprp (x_l, d_l, n_l, k);
         }
       while ((--iterations > 0) && isprime);
 
       /* Purging of variables */
-      PURGEVARS_L ((7, sizeof (i), &i,
-                       sizeof (j), &j,
+      PURGEVARS_L ((6, sizeof (i), &i,
                        sizeof (k), &k,
                        sizeof (p), &p,
                        sizeof (d_l), d_l,
                        sizeof (x_l), x_l,
                        sizeof (q_l), q_l));
 
-      ISPURGED_L  ((7, sizeof (i), &i,
-                       sizeof (j), &j,
+      ISPURGED_L  ((6, sizeof (i), &i,
                        sizeof (k), &k,
                        sizeof (p), &p,
                        sizeof (d_l), d_l,
@@ -4911,6 +5236,332 @@ prime_l (CLINT n_l, unsigned int no_of_smallprimes, unsigned int iterations)
 }
 
 
+/******************************************************************************/
+/*                                                                            */
+/*  Function:  Selection of the policy of the primality test prime_l() for    */
+/*             iterations == 0. The policy applies to all callers, among      */
+/*             them ISPRIME_L, LINT::isprime() and the FindPrime* functions,  */
+/*             and should be set once before primes are searched by several   */
+/*             threads. Without a call of primetest_l PRIMETEST_LEGACY is     */
+/*             used.                                                          */
+/*  Syntax:    int primetest_l (int Policy, unsigned int Rounds);             */
+/*  Input:     Policy (PRIMETEST_LEGACY, PRIMETEST_BPSW or PRIMETEST_BPSWMR)  */
+/*             Rounds (Number of MR rounds following the Baillie-PSW test     */
+/*                     for PRIMETEST_BPSWMR)                                  */
+/*  Output:    -                                                              */
+/*  Returns:   Policy selected, PRIMETEST_LEGACY if Policy is not valid       */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+primetest_l (int Policy, unsigned int Rounds)
+{
+  if (PRIMETEST_BPSW != Policy && PRIMETEST_BPSWMR != Policy)
+    {
+      Policy = PRIMETEST_LEGACY;
+    }
+
+  PrimeTestRounds = (PRIMETEST_BPSWMR == Policy) ? Rounds : 0;
+  PrimeTest = Policy;
+  return Policy;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:  Strong probable prime test of an odd number n_l > 3 for the    */
+/*             base a, n_l - 1 = 2^k * q with q odd                           */
+/*  Syntax:    static int sprp (CLINT x_l, CLINT d_l, CLINT n_l, USHORT k);   */
+/*  Input:     x_l (a^q mod n_l), d_l (n_l - 1), n_l (Number to be tested),   */
+/*             k (Exponent of 2 in n_l - 1)                                   */
+/*  Output:    x_l (Overwritten)                                              */
+/*  Returns:   1: n_l strong probable prime to the base a                     */
+/*             0: n_l not prime                                               */
+/*                                                                            */
+/******************************************************************************/
+static int
+sprp (CLINT x_l, CLINT d_l, CLINT n_l, USHORT k)
+{
+  USHORT j = 0;
+
+  if (EQONE_L (x_l))
+    {
+      return 1;
+    }
+
+  while (!EQONE_L (x_l) && !equ_l (x_l, d_l) && ++j < k)
+    {
+      msqr_l (x_l, x_l, n_l);
+    }
+
+  return equ_l (x_l, d_l);
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:  Strong Lucas probable prime test with the parameters P = 1,    */
+/*             Q = (1 - D)/4 and the first D of the sequence 5, -7, 9, -11,   */
+/*             ... with Jacobi symbol (D/n_l) = -1 (Selfridge, Method A).     */
+/*             The Lucas sequences are computed in Montgomery representation. */
+/*  Syntax:    static int slprp (CLINT n_l);                                  */
+/*  Input:     n_l (Odd number to be tested, n_l >= 2^16)                     */
+/*  Output:    -                                                              */
+/*  Returns:   1: n_l strong Lucas probable prime                             */
+/*             0: n_l not prime                                               */
+/*                                                                            */
+/******************************************************************************/
+static int
+slprp (CLINT n_l)
+{
+  CLINT e_l, u_l, v_l, qk_l, t_l, h_l, one_m;
+  clint r_l[CLINTMAXSHORT + 1];
+  USHORT d, q, s, logB_r, mprime, b, w, i;
+  int sign, j, isprime = 0;
+
+  /* A perfect square has no D with (D/n_l) = -1 */
+  if (issqr_l (n_l, t_l))
+    {
+      return 0;
+    }
+
+  for (d = 5, sign = 1;; d += 2, sign = -sign)
+    {
+      u2clint_l (t_l, d);
+      if (sign < 0)
+        {
+          sub_l (n_l, t_l, t_l);
+        }
+
+      j = jacobi_l (t_l, n_l);
+      if (-1 == j)
+        {
+          break;
+        }
+
+      if (0 == j)
+        {
+          return 0;                    /* 1 < gcd (d, n_l) < n_l */
+        }
+    }
+
+  /* Montgomery representation of 1, |Q| = |1 - D|/4. The factors D and */
+  /* Q are applied by multiplication with |D| resp. |Q| and negation,    */
+  /* Q < 0 for D > 0 and vice versa.                                     */
+  SETZERO_L (r_l);
+  logB_r = DIGITS_L (n_l);
+  setbit (r_l, logB_r << LDBITPERDGT);
+  mprime = invmon_l (n_l);
+  mod_l (r_l, n_l, one_m);
+  q = (USHORT)((sign > 0) ? (d - 1) >> 2 : (d + 1) >> 2);
+
+  /* (x_l + n_l)/2 = (x_l >> 1) + h_l for odd x_l */
+  cpy_l (h_l, n_l);
+  shr_l (h_l);
+  inc_l (h_l);
+
+  /* n_l + 1 = 2^s * e_l, U_1 = 1, V_1 = P = 1, Q^1 */
+  cpy_l (t_l, n_l);
+  inc_l (t_l);
+  s = (USHORT)twofact_l (t_l, e_l);
+  cpy_l (u_l, one_m);
+  cpy_l (v_l, one_m);
+  ummul_l (one_m, q, qk_l, n_l);
+  if (sign > 0)
+    {
+      sub_l (n_l, qk_l, qk_l);
+    }
+
+  for (i = (USHORT)(ld_l (e_l) - 1); i > 0; i--)
+    {
+      /* U_2k = U_k * V_k, V_2k = V_k^2 - 2 * Q^k, Q^2k */
+      mulmon_l (u_l, v_l, n_l, mprime, logB_r, u_l);
+      sqrmon_l (v_l, n_l, mprime, logB_r, v_l);
+      madd_l (qk_l, qk_l, t_l, n_l);
+      msub_l (v_l, t_l, v_l, n_l);
+      sqrmon_l (qk_l, n_l, mprime, logB_r, qk_l);
+
+      w = e_l[((i - 1) >> LDBITPERDGT) + 1];
+      b = (USHORT)(1U << ((i - 1) & (BITPERDGT - 1)));
+      if (w & b)
+        {
+          /* U_k+1 = (U_k + V_k)/2, V_k+1 = (D * U_k + V_k)/2, Q^k+1 */
+          ummul_l (u_l, d, t_l, n_l);
+          if (sign < 0 && !EQZ_L (t_l))
+            {
+              sub_l (n_l, t_l, t_l);
+            }
+          madd_l (u_l, v_l, u_l, n_l);
+          madd_l (t_l, v_l, v_l, n_l);
+          if (ISODD_L (u_l))
+            {
+              shr_l (u_l);
+              add_l (u_l, h_l, u_l);
+            }
+          else
+            {
+              shr_l (u_l);
+            }
+          if (ISODD_L (v_l))
+            {
+              shr_l (v_l);
+              add_l (v_l, h_l, v_l);
+            }
+          else
+            {
+              shr_l (v_l);
+            }
+          ummul_l (qk_l, q, qk_l, n_l);
+          if (sign > 0 && !EQZ_L (qk_l))
+            {
+              sub_l (n_l, qk_l, qk_l);
+            }
+        }
+    }
+
+  /* U_e == 0 or V_(e * 2^r) == 0 for some 0 <= r < s */
+  if (EQZ_L (u_l) || EQZ_L (v_l))
+    {
+      isprime = 1;
+    }
+
+  for (i = 1; i < s && !isprime; i++)
+    {
+      sqrmon_l (v_l, n_l, mprime, logB_r, v_l);
+      madd_l (qk_l, qk_l, t_l, n_l);
+      msub_l (v_l, t_l, v_l, n_l);
+      sqrmon_l (qk_l, n_l, mprime, logB_r, qk_l);
+      isprime = EQZ_L (v_l);
+    }
+
+  /* Purging of variables */
+  PURGEVARS_L ((10, sizeof (e_l), e_l,
+                    sizeof (u_l), u_l,
+                    sizeof (v_l), v_l,
+                    sizeof (qk_l), qk_l,
+                    sizeof (t_l), t_l,
+                    sizeof (r_l), r_l,
+                    sizeof (d), &d,
+                    sizeof (mprime), &mprime,
+                    sizeof (w), &w,
+                    sizeof (b), &b));
+
+  ISPURGED_L  ((10, sizeof (e_l), e_l,
+                    sizeof (u_l), u_l,
+                    sizeof (v_l), v_l,
+                    sizeof (qk_l), qk_l,
+                    sizeof (t_l), t_l,
+                    sizeof (r_l), r_l,
+                    sizeof (d), &d,
+                    sizeof (mprime), &mprime,
+                    sizeof (w), &w,
+                    sizeof (b), &b));
+
+  return isprime;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:  Baillie-PSW test: Strong probable prime test for the base 2    */
+/*             and strong Lucas probable prime test. Numbers n_l < 2^16 are   */
+/*             tested by trial division.                                      */
+/*  Syntax:    static int bpsw (CLINT n_l, CLINT d_l, CLINT q_l, USHORT k);   */
+/*  Input:     n_l (Odd number to be tested, n_l > 1),                        */
+/*             d_l (n_l - 1), q_l (Odd factor of n_l - 1 = 2^k * q_l),        */
+/*             k (Exponent of 2 in n_l - 1)                                   */
+/*  Output:    -                                                              */
+/*  Returns:   1: n_l probably prime                                          */
+/*             0: n_l not prime                                               */
+/*                                                                            */
+/******************************************************************************/
+static int
+bpsw (CLINT n_l, CLINT d_l, CLINT q_l, USHORT k)
+{
+  CLINT x_l;
+  int isprime;
+
+  /* Division by the 54 odd primes up to 257 is complete for n_l < 2^16 */
+  if (DIGITS_L (n_l) <= 1)
+    {
+      return (sieve_l (n_l, 54) <= 1);
+    }
+
+#ifdef FLINT_ASM
+  wmexp_l (2, q_l, x_l, n_l);
+#else
+  wmexpm_l (2, q_l, x_l, n_l);
+#endif /* FLINT_ASM */
+
+  isprime = sprp (x_l, d_l, n_l, k) && slprp (n_l);
+
+  PURGEVARS_L ((1, sizeof (x_l), x_l));
+  ISPURGED_L  ((1, sizeof (x_l), x_l));
+
+  return isprime;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:  Miller-Rabin rounds with pseudo-random bases 2 <= a < n_l - 1  */
+/*             of 64 bit, which are derived from n_l by a linear congruential */
+/*             generator. The result is reproducible and does not depend on   */
+/*             a state shared by several threads.                             */
+/*  Syntax:    static int mrrandom (CLINT n_l, CLINT d_l, CLINT q_l, USHORT k,*/
+/*                                                      unsigned int rounds); */
+/*  Input:     n_l (Odd number to be tested, n_l >= 2^16),                    */
+/*             d_l (n_l - 1), q_l (Odd factor of n_l - 1 = 2^k * q_l),        */
+/*             k (Exponent of 2 in n_l - 1), rounds (Number of MR rounds)     */
+/*  Output:    -                                                              */
+/*  Returns:   1: n_l probably prime                                          */
+/*             0: n_l not prime                                               */
+/*                                                                            */
+/******************************************************************************/
+static int
+mrrandom (CLINT n_l, CLINT d_l, CLINT q_l, USHORT k, unsigned int rounds)
+{
+  CLINT a_l, m_l, x_l;
+  unsigned long s;
+  int j, isprime = 1;
+
+  if (DIGITS_L (n_l) <= 1)
+    {
+      return isprime;
+    }
+
+  s = ((unsigned long)n_l[2] << BITPERDGT) | (unsigned long)n_l[1];
+  usub_l (n_l, 3, m_l);
+
+  for (; rounds > 0 && isprime; rounds--)
+    {
+      for (j = 1; j <= 4; j++)
+        {
+          s = (s * 69069UL + 1UL) & 0xffffffffUL;
+          a_l[j] = (clint)(s >> 16);
+        }
+      SETDIGITS_L (a_l, 4);
+      RMLDZRS_L (a_l);
+
+      mod_l (a_l, m_l, a_l);
+      uadd_l (a_l, 2, a_l);
+      mexpkm_l (a_l, q_l, x_l, n_l);
+      isprime = sprp (x_l, d_l, n_l, k);
+    }
+
+  PURGEVARS_L ((4, sizeof (s), &s,
+                   sizeof (a_l), a_l,
+                   sizeof (m_l), m_l,
+                   sizeof (x_l), x_l));
+
+  ISPURGED_L  ((4, sizeof (s), &s,
+                   sizeof (a_l), a_l,
+                   sizeof (m_l), m_l,
+                   sizeof (x_l), x_l));
+
+  return isprime;
+}
+
+
 /******************************************************************************/
 /*                                                                            */
 /*  Function:  Factor 2^t of a CLINT operand n, such that n = 2^t * b, b odd  */
@@ -6405,6 +7056,8 @@ smod (CLINT a_l, int sign_a, CLINT b_l, CLINT c_l)
 /******************************************************************************/
 /*                                                                            */
 /*  Function:  Sieve of Eratosthenes                                          */
+/*             The primes are taken from the segmented sieve of the prime     */
+/*             iterator, see initprimes_l().                                  */
 /*  Syntax:    ULONG * genprimes (ULONG N);                                   */
 /*  Input:     N (Upper bound for prime numbers to be generated)              */
 /*  Output:    -                                                              */
@@ -6416,74 +7069,266 @@ smod (CLINT a_l, int sign_a, CLINT b_l, CLINT c_l)
 ULONG * __FLINT_API
 genprimes (ULONG N)
 {
-  ULONG i, k, p, s, L, B, count;
-  char *f;
-  ULONG *primes;
+  PRIMEITER it;
+  ULONG count = 0, size = 1024, p;
+  ULONG *primes, *tmp;
 
-  B = (1 + ul_iroot (N)) >> 1;
-  L = N >> 1;
-  if (((N&1) == 0) && (N > 0))
+  if (initprimes_l (&it, N) != E_CLINT_OK)
     {
-      --L;
+      return (ULONG *)NULL;
     }
 
-  if ((f = (char *)malloc ((size_t)L+1)) == NULL)
+  if ((primes = (ULONG*)malloc ((size_t)size * sizeof (ULONG))) == NULL)
     {
+      purgeprimes_l (&it);
       return (ULONG *)NULL;
     }
 
-  for (i = 1; i <= L; i++)
+  while ((p = nextprime_l (&it)) != 0)
+    {
+      if (++count == size)
+        {
+          size <<= 1;
+          if ((tmp = (ULONG*)realloc (primes, (size_t)size * sizeof (ULONG)))
+                                                                      == NULL)
+            {
+              free (primes);
+              purgeprimes_l (&it);
+              return (ULONG *)NULL;
+            }
+          primes = tmp;
+        }
+      primes[count] = p;
+    }
+
+  primes[0] = count;
+  purgeprimes_l (&it);
+
+  /* Release of the unused part of the array */
+  if ((tmp = (ULONG*)realloc (primes, (size_t)(count + 1) * sizeof (ULONG)))
+                                                                      != NULL)
     {
-      f[i] = 1;
+      primes = tmp;
     }
 
-  p = 3;
-  s = 4;
-  for (i = 1; i <= B; i++)
+  return primes;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:  Initialization of the prime iterator for the primes <= N       */
+/*             The primes are delivered in ascending order by nextprime_l()   */
+/*             without storing all of them. Memory needed is 33 KByte plus    */
+/*             two ULONG per prime <= sqrt(N) for sieving.                    */
+/*  Syntax:    int initprimes_l (PRIMEITER *it, ULONG N);                     */
+/*  Input:     N (Upper bound for prime numbers to be generated)              */
+/*  Output:    it (State of the iterator)                                     */
+/*  Returns:   E_CLINT_OK if everything is O.K.                               */
+/*             E_CLINT_MAL: Memory allocation error                           */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+initprimes_l (PRIMEITER *it, ULONG N)
+{
+  ULONG r, m, k, j, p, n;
+  UCHAR *f;
+
+  memset (it, 0, sizeof (PRIMEITER));
+  it->Two = (N >= 2);
+  it->End = (N > 0) ? ((N - 1) >> 1) + 1 : 0;
+
+  /* Sieving primes 13 <= p <= r = sqrt(N), one bit per odd number <= r */
+  r = ul_iroot (N);
+  m = (r + 1) >> 1;
+  if ((f = (UCHAR *)malloc ((size_t)((m >> 3) + 1))) == NULL)
     {
-      if (f[i])
+      return E_CLINT_MAL;
+    }
+  memset (f, 0xff, (size_t)((m >> 3) + 1));
+
+  for (k = 1, p = 3; p <= r / p; k++, p += 2)
+    {
+      if (f[k >> 3] & (1U << (k & 7)))
         {
-          for (k = s; k <= L; k += p)
+          for (j = (p * p) >> 1; j < m; j += p)
             {
-              f[k] = 0;
+              f[j >> 3] &= (UCHAR)~(1U << (j & 7));
             }
         }
-      s += p + p + 2;
-      p += 2;
     }
 
-  for (count = i = 1; i <= L; i++)
+  for (n = 0, k = 6; k < m; k++)
     {
-      count += f[i];
+      n += (f[k >> 3] >> (k & 7)) & 1;
     }
 
-  if ((primes = (ULONG*)malloc ((size_t)(count+1) * sizeof (ULONG))) == NULL)
+  it->Base = (ULONG *)malloc ((size_t)(2 * n + 1) * sizeof (ULONG));
+  it->Seg = (UCHAR *)malloc ((size_t)(PRIMESEGBYTES + PRIMEWHEEL));
+  if (NULL == it->Base || NULL == it->Seg)
     {
       free (f);
-      return (ULONG *)NULL;
+      purgeprimes_l (it);
+      return E_CLINT_MAL;
     }
+  it->Next = it->Base + n;
+  it->Wheel = it->Seg + PRIMESEGBYTES;
 
-  for (count = i = 1; i <= L; i++)
+  /* First multiple to be crossed off is p^2 */
+  for (n = 0, k = 6; k < m; k++)
     {
-      if (f[i])
+      if (f[k >> 3] & (1U << (k & 7)))
         {
-          ++count;
-          primes[count] = (i << 1) + 1;      /*lint !e796 !e797 */
+          p = (k << 1) + 1;
+          it->Base[n] = p;
+          it->Next[n++] = (p * p) >> 1;
         }
     }
+  it->NoofBase = n;
+  free (f);
 
-  if (N < 2)
+  /* Pattern of the numbers 2k + 1 prime to 3, 5, 7 and 11 for */
+  /* 0 <= k < 8 * PRIMEWHEEL                                   */
+  memset (it->Wheel, 0xff, (size_t)PRIMEWHEEL);
+  for (p = 3; p <= 11; p += 2)
     {
-      primes[0] = 0;
+      if (p != 9)
+        {
+          for (j = p >> 1; j < (PRIMEWHEEL << 3); j += p)
+            {
+              it->Wheel[j >> 3] &= (UCHAR)~(1U << (j & 7));
+            }
+        }
     }
-  else
+
+  sieve_segment (it);
+
+  return E_CLINT_OK;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:  Next prime of the prime iterator                               */
+/*  Syntax:    ULONG nextprime_l (PRIMEITER *it);                             */
+/*  Input:     it (State of the iterator)                                     */
+/*  Output:    it (Updated state)                                             */
+/*  Returns:   Next prime <= N in ascending order                             */
+/*             0 if all primes <= N have been delivered                       */
+/*                                                                            */
+/******************************************************************************/
+ULONG __FLINT_API
+nextprime_l (PRIMEITER *it)
+{
+  ULONG j;
+
+  if (it->Two)
     {
-      primes[0] = count;
-      primes[1] = 2;                         /*lint !e796 */
+      it->Two = 0;
+      return 2;
     }
-  free (f);
 
-  return primes;
+  for (;;)
+    {
+      while (it->Pos < it->Bits)
+        {
+          j = it->Pos;
+          if (0 == (j & 7) && 0 == it->Seg[j >> 3])
+            {
+              it->Pos += 8;
+              continue;
+            }
+
+          it->Pos++;
+          if (it->Seg[j >> 3] & (1U << (j & 7)))
+            {
+              return ((it->Seg0 + j) << 1) + 1;
+            }
+        }
+
+      if (it->Bits < PRIMESEGBITS || it->Seg0 + PRIMESEGBITS >= it->End)
+        {
+          it->Pos = it->Bits;
+          return 0;
+        }
+
+      it->Seg0 += PRIMESEGBITS;
+      sieve_segment (it);
+    }
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:  Purging and release of the memory of the prime iterator        */
+/*  Syntax:    void purgeprimes_l (PRIMEITER *it);                            */
+/*  Input:     it (State of the iterator)                                     */
+/*  Output:    it (Purged state)                                              */
+/*  Returns:   -                                                              */
+/*                                                                            */
+/******************************************************************************/
+void __FLINT_API
+purgeprimes_l (PRIMEITER *it)
+{
+  if (it->Base != NULL)
+    {
+      free (it->Base);
+    }
+
+  if (it->Seg != NULL)
+    {
+      free (it->Seg);
+    }
+
+  memset (it, 0, sizeof (PRIMEITER));
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:  Sieving of the segment starting with the odd number            */
+/*             2 * it->Seg0 + 1 by the wheel pattern and the sieving primes   */
+/*  Syntax:    static void sieve_segment (PRIMEITER *it);                     */
+/*  Input:     it (State of the iterator, Seg0 a multiple of PRIMESEGBITS)    */
+/*  Output:    it (Sieved segment, Bits and Pos set)                          */
+/*  Returns:   -                                                              */
+/*                                                                            */
+/******************************************************************************/
+static void
+sieve_segment (PRIMEITER *it)
+{
+  ULONG i, k, n, p, off, end, bytes;
+  UCHAR *seg = it->Seg;
+
+  it->Pos = 0;
+  it->Bits = MIN (PRIMESEGBITS, it->End - it->Seg0);
+  bytes = (it->Bits + 7) >> 3;
+  end = it->Seg0 + it->Bits;
+
+  /* Copy of the wheel pattern, starting at the position of Seg0 */
+  off = (it->Seg0 >> 3) % PRIMEWHEEL;
+  for (i = 0; i < bytes; i += n)
+    {
+      n = MIN (bytes - i, PRIMEWHEEL - off);
+      memcpy (seg + i, it->Wheel + off, (size_t)n);
+      off = 0;
+    }
+
+  /* 1 is not prime, 3, 5, 7 and 11 are */
+  if (0 == it->Seg0 && bytes > 0)
+    {
+      seg[0] = (UCHAR)((seg[0] & 0xfe) | 0x2e);
+    }
+
+  for (i = 0; i < it->NoofBase; i++)
+    {
+      p = it->Base[i];
+      for (k = it->Next[i]; k < end; k += p)
+        {
+          seg[(k - it->Seg0) >> 3] &= (UCHAR)~(1U << ((k - it->Seg0) & 7));
+        }
+      it->Next[i] = k;
+    }
 }
 
 
@@ -6507,25 +7352,29 @@ genprimes (ULONG N)
 static ULONG
 ul_iroot (ULONG n)
 {
-  ULONG x = 1, y = 0;
-  if (0 == n)
-    {
-      return 0;
-    }
+  ULONG x = 0, b;
 
-  while (y <= n)
+  /* Digit by digit, no overflow for n close to the maximum of ULONG */
+  b = (ULONG)1 << ((sizeof (ULONG) << 3) - 2);
+  while (b > n)
     {
-      x = x << 1;
-      y = x * x;
+      b >>= 2;
     }
-  do
+
+  while (b != 0)
     {
-      y = x;
-      x = (x * x + n) / (2 * x);
+      if (n >= x + b)
+        {
+          n -= x + b;
+          x = (x >> 1) + b;
+        }
+      else
+        {
+          x >>= 1;
+        }
+      b >>= 2;
     }
-  while (x < y);
 
-  y = 0;
   return x;
 }
 
@@ -452,8 +452,22 @@ extern "C" {
 #define SFACTOR_L(n_l) sieve_l ((n_l), NOOFSMALLPRIMES);
 #define sfactor_l(n_l) sieve_l ((n_l), NOOFSMALLPRIMES);
 
+/* Implementations of the trial division in sieve_l() for sieveimpl_l() */
+
+#define SIEVE_IMPL_C    0  /* Portable C */
+#define SIEVE_IMPL_AVX  1  /* Remainders modulo four products by AVX */
+#define SIEVE_IMPL_BEST SIEVE_IMPL_AVX
+
+
+/* Policies of prime_l() for iterations == 0, selected by primetest_l() */
+
+#define PRIMETEST_LEGACY 0 /* Miller-Rabin, error probability < 2^-80 */
+#define PRIMETEST_BPSW   1 /* Baillie-PSW */
+#define PRIMETEST_BPSWMR 2 /* Baillie-PSW plus Miller-Rabin rounds */
+
 
 /* Miller-Rabin primality test, parameters according to Lenstra and [MOV] */
+/* or Baillie-PSW test, depending on the policy set by primetest_l()      */
 
 #define ISPRIME_L(n) prime_l ((n), 302, 0)
 #define isprime_l(n) prime_l ((n), 302, 0)
@@ -516,6 +530,22 @@ typedef unsigned short USHORT;
 typedef unsigned long  ULONG;
 #endif  /* ULONG */
 
+/* State of the prime iterator initprimes_l(), nextprime_l(). The odd     */
+/* numbers are sieved in segments, one bit per odd number.                */
+typedef struct
+{
+  ULONG End;          /* Number of odd numbers 2k + 1 <= upper bound */
+  ULONG Seg0;         /* Index k of the odd number at bit 0 of Seg */
+  ULONG Bits;         /* Number of valid bits in Seg */
+  ULONG Pos;          /* Next bit of Seg to be examined */
+  ULONG NoofBase;     /* Number of sieving primes */
+  ULONG *Base;        /* Sieving primes 13 <= p <= sqrt(upper bound) */
+  ULONG *Next;        /* Index k of the next odd multiple 2k + 1 of Base[i] */
+  UCHAR *Seg;         /* Current segment */
+  UCHAR *Wheel;       /* Pattern of the odd numbers prime to 3, 5, 7, 11 */
+  int Two;            /* 1 if 2 is still to be returned */
+} PRIMEITER;
+
 
 /***********************************************************/
 /* Function prototypes                                     */
@@ -583,6 +613,7 @@ extern ULONG *  __FLINT_API  genprimes     (ULONG);
 extern clint *  __FLINT_API  get_reg_l     (unsigned int);
 extern void     __FLINT_API  gcd_l         (CLINT, CLINT, CLINT);
 extern int      __FLINT_API  inc_l         (CLINT);
+extern int      __FLINT_API  initprimes_l  (PRIMEITER *, ULONG);
 extern void     __FLINT_API  inv_l         (CLINT, CLINT, CLINT, CLINT);
 extern USHORT   __FLINT_API  invmon_l      (CLINT);
 extern void     __FLINT_API  iroot_l       (CLINT, CLINT);
@@ -605,8 +636,10 @@ extern int      __FLINT_API  msqr_l        (CLINT, CLINT, CLINT);
 extern int      __FLINT_API  msub_l        (CLINT, CLINT, CLINT, CLINT);
 extern int      __FLINT_API  mul_l         (CLINT, CLINT, CLINT);
 extern void     __FLINT_API  mulmon_l      (CLINT, CLINT, CLINT, USHORT, USHORT, CLINT);
+extern ULONG    __FLINT_API  nextprime_l   (PRIMEITER *);
 extern void     __FLINT_API  or_l          (CLINT, CLINT, CLINT);
 extern int      __FLINT_API  prime_l       (CLINT, unsigned int, unsigned int);
+extern int      __FLINT_API  primetest_l   (int, unsigned int);
 extern int      __FLINT_API  primroot_l    (CLINT, unsigned int, clint*[]);
 extern int      __FLINT_API  proot_l       (CLINT, CLINT, CLINT);
 extern void     __FLINT_API  purge_l       (CLINT);
@@ -614,6 +647,7 @@ extern void     __FLINT_API  purged_l      (CLINTD);
 extern void     __FLINT_API  purgeq_l      (CLINTQ);
 extern int      __FLINT_API  purge_reg_l   (unsigned int);
 extern int      __FLINT_API  purgeall_reg_l(void);
+extern void     __FLINT_API  purgeprimes_l (PRIMEITER *);
 extern clint *  __FLINT_API  rand64_l      (void);
 extern void     __FLINT_API  rand_l        (CLINT, int);
 extern int      __FLINT_API  randbit_l     (void);
@@ -626,6 +660,7 @@ extern int      __FLINT_API  shift_l       (CLINT, long int);
 extern int      __FLINT_API  shl_l         (CLINT);
 extern int      __FLINT_API  shr_l         (CLINT);
 extern USHORT   __FLINT_API  sieve_l       (CLINT, unsigned int);
+extern int      __FLINT_API  sieveimpl_l   (int);
 extern int      __FLINT_API  sqr_l         (CLINT, CLINT);
 extern void     __FLINT_API  sqrmon_l      (CLINT, CLINT, USHORT, USHORT, CLINT);
 extern int      __FLINT_API  str2clint_l   (CLINT, char *, USHORT);
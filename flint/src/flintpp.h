@@ -322,6 +322,7 @@ class LINT
 
   // Number theoretic friend functions
 
+  // isprime: MR or Baillie-PSW test acc. to primetest_l() if iterations == 0
   friend int isprime (const LINT&, int noofsmallprimes = 302, int iterations = 0);
   friend LINT issqr (const LINT&);
   friend unsigned int ld (const LINT&);
@@ -362,6 +363,15 @@ class LINT
   friend LINT StrongPrime (const LINT&, const LINT&, const LINT&, STATEPRNG&);
   friend LINT StrongPrime (const LINT& pmin, const LINT&, USHORT, USHORT, USHORT, const LINT&, STATEPRNG&);
 
+  // Parallel generation of pseudorandom primes
+  // Functions in module primeparpp.cpp, Mode declared in primepar.h
+
+  friend LINT FindPrimePar (USHORT, const LINT&, STATEPRNG&, int, int);
+  friend LINT FindPrimePar (const LINT&, const LINT&, const LINT&, STATEPRNG&, int, int);
+  friend LINT ExtendPrimePar (const LINT&, const LINT&, const LINT&, const LINT&, const LINT&, STATEPRNG&, int, int);
+  friend LINT StrongPrimePar (USHORT, const LINT&, STATEPRNG&, int, int);
+  friend LINT StrongPrimePar (const LINT&, const LINT&, USHORT, USHORT, USHORT, const LINT&, STATEPRNG&, int, int);
+
   // Compatibility functions: Calls to Blum-Blum-Shub-Generator
   friend LINT randBBS (int);
   friend LINT randBBS (const LINT&, const LINT&);
@@ -0,0 +1,281 @@
+/******************************************************************************/
+/*                                                                            */
+/* Functions for arithmetic and number theory with large integers in C        */
+/* Software supplement to the book "Cryptography in C and C++"                */
+/* by Michael Welschenbach                                                    */
+/*                                                                            */
+/* Module hashfile.c       Revision: 19.10.2026                               */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 2001-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+
+
+/* POSIX interfaces for mapping and advice on file access, 64-bit offsets */
+#define _XOPEN_SOURCE 600
+#define _FILE_OFFSET_BITS 64
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "flint.h"
+#include "hashfile.h"
+
+
+/* Macros */
+
+/* Bytes of a regular file mapped at once, multiple of the page size */
+#ifndef HASHFILE_WINDOW
+#define HASHFILE_WINDOW  (1UL << 26)
+#endif
+
+/* Bytes per read if a file cannot be mapped, multiple of the page size */
+#define HASHFILE_BUFSIZE (1UL << 20)
+
+
+/* Prototypes */
+
+static int MapHash (MULTIHASH *mh, int fd, off_t Size);
+static int ReadHash (MULTIHASH *mh, int fd);
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Hashing of a file with several hash functions in one pass     */
+/*  Syntax:     int hashfile_l (HASHFILEDIG *Dig, int Algs, char *Name);      */
+/*  Input:      int Algs (Hash functions, HASHFILE_SHA1, HASHFILE_SHA256 and  */
+/*                        HASHFILE_RMD160 combined by |)                      */
+/*              char *Name (Name of the file)                                 */
+/*  Output:     HASHFILEDIG *Dig (Digests of the hash functions selected)     */
+/*  Returns:    0 if everything is O.K.                                       */
+/*              E_HASHFILE_ARG if Algs is invalid                             */
+/*              E_HASHFILE_MEM if allocation of memory failed                 */
+/*              E_HASHFILE_IO if the file cannot be opened or read            */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+hashfile_l (HASHFILEDIG *Dig, int Algs, char *Name)
+{
+  int fd, error;
+
+  if (Algs <= 0 || (Algs & ~HASHFILE_ALL) != 0)
+    {
+      return E_HASHFILE_ARG;
+    }
+
+  if ((fd = open (Name, O_RDONLY)) < 0)
+    {
+      return E_HASHFILE_IO;
+    }
+
+  error = hashfilefd_l (Dig, Algs, fd);
+  close (fd);
+
+  return error;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Hashing of an open file with several hash functions in one    */
+/*              pass. Regular files are mapped into memory window by window   */
+/*              and hashed in place, with sequential access announced to the  */
+/*              kernel for readahead. Other files (pipes, sockets) and files  */
+/*              that cannot be mapped are read in large page-aligned blocks.  */
+/*              The data are hashed by multihashupdate_l, block by block      */
+/*              with all hash functions selected.                             */
+/*              A regular file must not be truncated while it is hashed       */
+/*  Syntax:     int hashfilefd_l (HASHFILEDIG *Dig, int Algs, int fd);        */
+/*  Input:      int Algs (Hash functions, HASHFILE_SHA1, HASHFILE_SHA256 and  */
+/*                        HASHFILE_RMD160 combined by |)                      */
+/*              int fd (File descriptor opened for reading, regular files     */
+/*                      are hashed from offset 0 regardless of the position)  */
+/*  Output:     HASHFILEDIG *Dig (Digests of the hash functions selected)     */
+/*  Returns:    0 if everything is O.K.                                       */
+/*              E_HASHFILE_ARG if Algs or fd are invalid                      */
+/*              E_HASHFILE_MEM if allocation of memory failed                 */
+/*              E_HASHFILE_IO if reading the file failed                      */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+hashfilefd_l (HASHFILEDIG *Dig, int Algs, int fd)
+{
+  struct stat st;
+  MULTIHASH mh;
+  int error;
+
+  if (multihashinit_l (&mh, Algs) != 0 || fd < 0 || fstat (fd, &st) != 0)
+    {
+      return E_HASHFILE_ARG;
+    }
+
+  if (S_ISREG (st.st_mode))
+    {
+      posix_fadvise (fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+      error = MapHash (&mh, fd, st.st_size);
+
+      /* File system without mmap: read from the start of the file */
+      if (error == E_HASHFILE_IO && lseek (fd, 0, SEEK_SET) == 0)
+        {
+          multihashinit_l (&mh, Algs);
+          error = ReadHash (&mh, fd);
+        }
+    }
+  else
+    {
+      error = ReadHash (&mh, fd);
+    }
+
+  /* Also purges the context if FLINT_SECURE is defined */
+  multihashfinish_l (Dig, &mh);
+
+  return error;
+}
+
+
+/******************************************************************************/
+/* Internal functions                                                         */
+/******************************************************************************/
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Hashing of a regular file mapped window by window             */
+/*  Syntax:     int MapHash (MULTIHASH *mh, int fd, off_t Size);              */
+/*  Input:      MULTIHASH *mh (Initialized multi-digest context)              */
+/*              int fd (File descriptor of a regular file)                    */
+/*              off_t Size (Size of the file in bytes)                        */
+/*  Output:     MULTIHASH *mh (Context after hashing the file)                */
+/*  Returns:    0 if everything is O.K.                                       */
+/*              E_HASHFILE_IO if a window could not be mapped                 */
+/*                                                                            */
+/******************************************************************************/
+static int
+MapHash (MULTIHASH *mh, int fd, off_t Size)
+{
+  off_t Offset;
+  size_t Len;
+  void *Map;
+
+  for (Offset = 0; Offset < Size; Offset += (off_t)Len)
+    {
+      Len = (Size - Offset > (off_t)HASHFILE_WINDOW) ?
+            HASHFILE_WINDOW : (size_t)(Size - Offset);
+
+      Map = mmap (NULL, Len, PROT_READ, MAP_SHARED, fd, Offset);
+      if (Map == MAP_FAILED)
+        {
+          return E_HASHFILE_IO;
+        }
+      posix_madvise (Map, Len, POSIX_MADV_SEQUENTIAL);
+
+      multihashupdate_l (mh, (UCHAR *)Map, (ULONG)Len);
+      munmap (Map, Len);
+    }
+
+  return 0;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Hashing of a file read sequentially in page-aligned blocks    */
+/*  Syntax:     int ReadHash (MULTIHASH *mh, int fd);                         */
+/*  Input:      MULTIHASH *mh (Initialized multi-digest context)              */
+/*              int fd (File descriptor)                                      */
+/*  Output:     MULTIHASH *mh (Context after hashing the file)                */
+/*  Returns:    0 if everything is O.K.                                       */
+/*              E_HASHFILE_MEM if allocation of memory failed                 */
+/*              E_HASHFILE_IO if reading the file failed                      */
+/*                                                                            */
+/******************************************************************************/
+static int
+ReadHash (MULTIHASH *mh, int fd)
+{
+  void *Buf;
+  size_t Len;
+  ssize_t n;
+  long PageSize = sysconf (_SC_PAGESIZE);
+
+  if (posix_memalign (&Buf, (PageSize > 0) ? (size_t)PageSize : 4096,
+                      HASHFILE_BUFSIZE) != 0)
+    {
+      return E_HASHFILE_MEM;
+    }
+
+  for (;;)
+    {
+      Len = 0;
+      do
+        {
+          n = read (fd, (UCHAR *)Buf + Len, HASHFILE_BUFSIZE - Len);
+          if (n > 0)
+            {
+              Len += (size_t)n;
+            }
+        }
+      while ((n > 0 || (n < 0 && errno == EINTR)) && Len < HASHFILE_BUFSIZE);
+
+      if (n < 0 && errno != EINTR)
+        {
+          free (Buf);
+          return E_HASHFILE_IO;
+        }
+
+      multihashupdate_l (mh, (UCHAR *)Buf, (ULONG)Len);
+
+      if (Len < HASHFILE_BUFSIZE)
+        {
+          break;
+        }
+    }
+
+#ifdef FLINT_SECURE
+  memset (Buf, 0, HASHFILE_BUFSIZE);
+#endif
+  free (Buf);
+
+  return 0;
+}
@@ -0,0 +1,690 @@
+/******************************************************************************/
+/*                                                                            */
+/* Functions for arithmetic and number theory with large integers in C        */
+/* Software supplement to the book "Cryptography in C and C++"                */
+/* by Michael Welschenbach                                                    */
+/*                                                                            */
+/* Module hashmb.c         Revision: 19.10.2026                               */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 2001-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+
+#include <stdlib.h>
+#include <string.h>
+#include "flint.h"
+#include "hashmb.h"
+
+
+/* Multi-buffer kernels for SSE2 (4 lanes), AVX2 (8 lanes) and AVX-512 (16   */
+/* lanes) on x86 processors, selected at runtime. Compile with               */
+/* -DHASHMB_NO_SIMD to use the portable single-lane kernels only.            */
+#if !defined HASHMB_NO_SIMD
+#if defined __GNUC__ && (defined __x86_64__ || defined __i386__)
+#define HASHMB_SIMD
+#include <cpuid.h>
+#include <immintrin.h>
+#define SSE2_TARGET   __attribute__ ((target ("sse2")))
+#define AVX2_TARGET   __attribute__ ((target ("avx2")))
+#define AVX512_TARGET __attribute__ ((target ("avx512f")))
+#elif defined _MSC_VER && (_MSC_VER >= 1910) && (defined _M_X64 || defined _M_IX86)
+#define HASHMB_SIMD
+#include <intrin.h>
+#include <immintrin.h>
+#define SSE2_TARGET   /**/
+#define AVX2_TARGET   /**/
+#define AVX512_TARGET /**/
+#endif
+#endif /* !HASHMB_NO_SIMD */
+
+
+/* Types */
+
+/* Block function for one 64 byte block in each of the lanes */
+typedef void (*MBKERNEL) (unsigned int *, const unsigned int *);
+
+/* Parameters of a hash algorithm */
+typedef struct
+{
+  int Words;                   /* Number of words of the chaining value */
+  int HashLen;                 /* Length of hash value in bytes */
+  int BigEndian;               /* Byte order of message words and length */
+  const ULONG *IV;             /* Initial chaining value */
+} MBALG;
+
+/* Message hashed in a lane */
+typedef struct
+{
+  HASHMBJOB *Job;              /* Job processed in this lane, NULL if idle */
+  UCHAR *Next;                 /* Next complete block of the message */
+  ULONG Blocks;                /* Number of complete blocks left */
+  UCHAR *PadNext;              /* Next block of Pad */
+  int Tail;                    /* Number of blocks in Pad left */
+  UCHAR Pad[128];              /* Last bytes of message with padding */
+} MBLANE;
+
+
+/* Prototypes */
+
+static int CpuLanes (void);
+static int CmpLength (const void *, const void *);
+static void StartLane (MBLANE *, HASHMBJOB *, const MBALG *, unsigned int *,
+                       int, int);
+static void HashLanes (HASHMBJOB **, ULONG, const MBALG *, MBKERNEL, int);
+
+
+/* Constants */
+
+static const ULONG IVSha1[] =
+  {0x67452301UL, 0xefcdab89UL, 0x98badcfeUL, 0x10325476UL, 0xc3d2e1f0UL};
+
+static const ULONG IVSha256[] =
+  {0x6a09e667UL, 0xbb67ae85UL, 0x3c6ef372UL, 0xa54ff53aUL,
+   0x510e527fUL, 0x9b05688cUL, 0x1f83d9abUL, 0x5be0cd19UL};
+
+static const MBALG AlgSha1   = {5, 20, 1, IVSha1};
+static const MBALG AlgSha256 = {8, 32, 1, IVSha256};
+static const MBALG AlgRmd160 = {5, 20, 0, IVSha1};
+
+/* Round constants of SHA-256 */
+static const ULONG K256[] =
+  {0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL,
+   0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL,
+   0xd807aa98UL, 0x12835b01UL, 0x243185beUL, 0x550c7dc3UL,
+   0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL, 0xc19bf174UL,
+   0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL,
+   0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL,
+   0x983e5152UL, 0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL,
+   0xc6e00bf3UL, 0xd5a79147UL, 0x06ca6351UL, 0x14292967UL,
+   0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL, 0x53380d13UL,
+   0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+   0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL,
+   0xd192e819UL, 0xd6990624UL, 0xf40e3585UL, 0x106aa070UL,
+   0x19a4c116UL, 0x1e376c08UL, 0x2748774cUL, 0x34b0bcb5UL,
+   0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL, 0x682e6ff3UL,
+   0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL,
+   0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL};
+
+/* Choice of message words in rounds and parallel rounds of RIPEMD-160 */
+static const int RmdR1[] =
+  { 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15,
+    7,  4, 13,  1, 10,  6, 15,  3, 12,  0,  9,  5,  2, 14, 11,  8,
+    3, 10, 14,  4,  9, 15,  8,  1,  2,  7,  0,  6, 13, 11,  5, 12,
+    1,  9, 11, 10,  0,  8, 12,  4, 13,  3,  7, 15, 14,  5,  6,  2,
+    4,  0,  5,  9,  7, 12,  2, 10, 14,  1,  3,  8, 11,  6, 15, 13};
+
+static const int RmdR2[] =
+  { 5, 14,  7,  0,  9,  2, 11,  4, 13,  6, 15,  8,  1, 10,  3, 12,
+    6, 11,  3,  7,  0, 13,  5, 10, 14, 15,  8, 12,  4,  9,  1,  2,
+   15,  5,  1,  3,  7, 14,  6,  9, 11,  8, 12,  2, 10,  0,  4, 13,
+    8,  6,  4,  1,  3, 11, 15,  0,  5, 12,  2, 13,  9,  7, 10, 14,
+   12, 15, 10,  4,  1,  5,  8,  7,  6,  2, 13, 14,  0,  3,  9, 11};
+
+/* Length of rotations in rounds and parallel rounds of RIPEMD-160 */
+static const int RmdS1[] =
+  {11, 14, 15, 12,  5,  8,  7,  9, 11, 13, 14, 15,  6,  7,  9,  8,
+    7,  6,  8, 13, 11,  9,  7, 15,  7, 12, 15,  9, 11,  7, 13, 12,
+   11, 13,  6,  7, 14,  9, 13, 15, 14,  8, 13,  6,  5, 12,  7,  5,
+   11, 12, 14, 15, 14, 15,  9,  8,  9, 14,  5,  6,  8,  6,  5, 12,
+    9, 15,  5, 11,  6,  8, 13, 12,  5, 12, 13, 14, 11,  8,  5,  6};
+
+static const int RmdS2[] =
+  { 8,  9,  9, 11, 13, 15, 15,  5,  7,  7,  8, 11, 14, 14, 12,  6,
+    9, 13, 15,  7, 12,  8,  9, 11,  7,  7, 12,  7,  6, 15, 13, 11,
+    9,  7, 15, 11,  8,  6,  6, 14, 12, 13,  5, 14, 13, 13,  7,  5,
+   15,  5,  8, 11, 14, 14,  6, 14,  6,  9, 12,  9, 12,  5, 15,  8,
+    8,  5, 12,  9, 12,  5, 14,  6,  8, 13,  6,  5, 15, 13, 11, 11};
+
+/* Additive constants of rounds and parallel rounds of RIPEMD-160 */
+static const ULONG RmdK1[] =
+  {0x00000000UL, 0x5a827999UL, 0x6ed9eba1UL, 0x8f1bbcdcUL, 0xa953fd4eUL};
+
+static const ULONG RmdK2[] =
+  {0x50a28be6UL, 0x5c4dd124UL, 0x6d703ef3UL, 0x7a6d76e9UL, 0x00000000UL};
+
+
+/* Instantiation of the kernels */
+
+/* Portable kernels, one lane */
+#define MB_V             unsigned int
+#define MB_LANES         1
+#define MB_NAME(f)       f##_x1
+#define MB_TARGET        /**/
+#define MB_LOAD(p)       (*(p))
+#define MB_STORE(p, x)   (*(p) = (x))
+#define MB_SET1(c)       ((unsigned int)(c))
+#define MB_ADD(x, y)     ((x) + (y))
+#define MB_XOR(x, y)     ((x) ^ (y))
+#define MB_AND(x, y)     ((x) & (y))
+#define MB_OR(x, y)      ((x) | (y))
+#define MB_ROL(x, n)     (((x) << (n)) | ((x) >> (32 - (n))))
+#define MB_SHR(x, n)     ((x) >> (n))
+#include "hashmbk.h"
+
+#ifdef HASHMB_SIMD
+
+/* SSE2 kernels, four lanes */
+#define MB_V             __m128i
+#define MB_LANES         4
+#define MB_NAME(f)       f##_x4
+#define MB_TARGET        SSE2_TARGET
+#define MB_LOAD(p)       _mm_loadu_si128 ((const __m128i *)(p))
+#define MB_STORE(p, x)   _mm_storeu_si128 ((__m128i *)(p), (x))
+#define MB_SET1(c)       _mm_set1_epi32 ((int)(c))
+#define MB_ADD(x, y)     _mm_add_epi32 ((x), (y))
+#define MB_XOR(x, y)     _mm_xor_si128 ((x), (y))
+#define MB_AND(x, y)     _mm_and_si128 ((x), (y))
+#define MB_OR(x, y)      _mm_or_si128 ((x), (y))
+#define MB_ROL(x, n)     _mm_or_si128 ( \
+                           _mm_sll_epi32 ((x), _mm_cvtsi32_si128 (n)), \
+                           _mm_srl_epi32 ((x), _mm_cvtsi32_si128 (32 - (n))))
+#define MB_SHR(x, n)     _mm_srli_epi32 ((x), (n))
+#include "hashmbk.h"
+
+/* AVX2 kernels, eight lanes */
+#define MB_V             __m256i
+#define MB_LANES         8
+#define MB_NAME(f)       f##_x8
+#define MB_TARGET        AVX2_TARGET
+#define MB_LOAD(p)       _mm256_loadu_si256 ((const __m256i *)(p))
+#define MB_STORE(p, x)   _mm256_storeu_si256 ((__m256i *)(p), (x))
+#define MB_SET1(c)       _mm256_set1_epi32 ((int)(c))
+#define MB_ADD(x, y)     _mm256_add_epi32 ((x), (y))
+#define MB_XOR(x, y)     _mm256_xor_si256 ((x), (y))
+#define MB_AND(x, y)     _mm256_and_si256 ((x), (y))
+#define MB_OR(x, y)      _mm256_or_si256 ((x), (y))
+#define MB_ROL(x, n)     _mm256_or_si256 ( \
+                           _mm256_sll_epi32 ((x), _mm_cvtsi32_si128 (n)), \
+                           _mm256_srl_epi32 ((x), _mm_cvtsi32_si128 (32 - (n))))
+#define MB_SHR(x, n)     _mm256_srli_epi32 ((x), (n))
+#include "hashmbk.h"
+
+/* AVX-512 kernels, sixteen lanes */
+#define MB_V             __m512i
+#define MB_LANES         16
+#define MB_NAME(f)       f##_x16
+#define MB_TARGET        AVX512_TARGET
+#define MB_LOAD(p)       _mm512_loadu_si512 ((const void *)(p))
+#define MB_STORE(p, x)   _mm512_storeu_si512 ((void *)(p), (x))
+#define MB_SET1(c)       _mm512_set1_epi32 ((int)(c))
+#define MB_ADD(x, y)     _mm512_add_epi32 ((x), (y))
+#define MB_XOR(x, y)     _mm512_xor_si512 ((x), (y))
+#define MB_AND(x, y)     _mm512_and_si512 ((x), (y))
+#define MB_OR(x, y)      _mm512_or_si512 ((x), (y))
+#define MB_ROL(x, n)     _mm512_rolv_epi32 ((x), _mm512_set1_epi32 (n))
+#define MB_SHR(x, n)     _mm512_srli_epi32 ((x), (n))
+#include "hashmbk.h"
+
+#endif /* HASHMB_SIMD? */
+
+
+/* Number of lanes in use, 0 if not yet selected */
+static int MbLanes = 0;
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Hashing of many independent messages                          */
+/*              Up to HASHMB_MAXLANES messages are hashed in lockstep in the  */
+/*              lanes of SIMD registers. Jobs are scheduled in order of       */
+/*              decreasing length, so that messages of similar length share   */
+/*              the lanes and few lanes run idle at the end.                  */
+/*  Syntax:     int hashmb_l (int Alg, HASHMBJOB *Jobs,                       */
+/*                                                  ULONG NoOfJobs);          */
+/*  Input:      int Alg (HASHMB_SHA1, HASHMB_SHA256 or HASHMB_RMD160)         */
+/*              HASHMBJOB *Jobs (Messages and buffers for hash values)        */
+/*              ULONG NoOfJobs (Number of jobs)                               */
+/*  Output:     Jobs[i].HashRes (Hash value of message Jobs[i].clear)         */
+/*  Returns:    E_CLINT_OK if everything is O.K.                              */
+/*              E_HASHMB_ALG if Alg is unknown                                */
+/*              E_HASHMB_MEM if allocation of the job list failed             */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+hashmb_l (int Alg, HASHMBJOB *Jobs, ULONG NoOfJobs)
+{
+  HASHMBJOB **Queue;
+  const MBALG *alg;
+  MBKERNEL kernel;
+  ULONG i;
+  int lanes = (MbLanes > 0) ? MbLanes : hashmblanes_l (HASHMB_MAXLANES);
+
+  switch (Alg)
+    {
+      case HASHMB_SHA1:
+        alg = &AlgSha1;
+        break;
+      case HASHMB_SHA256:
+        alg = &AlgSha256;
+        break;
+      case HASHMB_RMD160:
+        alg = &AlgRmd160;
+        break;
+      default:
+        return E_HASHMB_ALG;
+    }
+
+  /* Kernel for the number of lanes */
+  switch (lanes)
+    {
+#ifdef HASHMB_SIMD
+      case 16:
+        kernel = (Alg == HASHMB_SHA1) ? sha1_mb_x16 :
+                 (Alg == HASHMB_SHA256) ? sha256_mb_x16 : rmd160_mb_x16;
+        break;
+      case 8:
+        kernel = (Alg == HASHMB_SHA1) ? sha1_mb_x8 :
+                 (Alg == HASHMB_SHA256) ? sha256_mb_x8 : rmd160_mb_x8;
+        break;
+      case 4:
+        kernel = (Alg == HASHMB_SHA1) ? sha1_mb_x4 :
+                 (Alg == HASHMB_SHA256) ? sha256_mb_x4 : rmd160_mb_x4;
+        break;
+#endif /* HASHMB_SIMD? */
+      default:
+        lanes = 1;
+        kernel = (Alg == HASHMB_SHA1) ? sha1_mb_x1 :
+                 (Alg == HASHMB_SHA256) ? sha256_mb_x1 : rmd160_mb_x1;
+        break;
+    }
+
+  if (NoOfJobs == 0)
+    {
+      return E_CLINT_OK;
+    }
+
+  /* Schedule of jobs by decreasing length */
+  if ((Queue = (HASHMBJOB **)malloc (NoOfJobs * sizeof (HASHMBJOB *))) == NULL)
+    {
+      return E_HASHMB_MEM;
+    }
+
+  for (i = 0; i < NoOfJobs; i++)
+    {
+      Queue[i] = &Jobs[i];
+    }
+
+  qsort (Queue, NoOfJobs, sizeof (HASHMBJOB *), CmpLength);
+
+  HashLanes (Queue, NoOfJobs, alg, kernel, lanes);
+
+  free (Queue);
+  return E_CLINT_OK;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Selection of the number of lanes for multi-buffer hashing     */
+/*              The largest number of lanes up to Lanes available on the      */
+/*              processor is selected. Without a call of hashmblanes_l the    */
+/*              largest number available is used                              */
+/*  Syntax:     int hashmblanes_l (int Lanes);                                */
+/*  Input:      int Lanes (Maximum number of lanes: 1, 4, 8 or 16)            */
+/*  Output:     -                                                             */
+/*  Returns:    Number of lanes selected                                      */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+hashmblanes_l (int Lanes)
+{
+  int lanes = CpuLanes ();
+
+  while (lanes > Lanes && lanes > 1)
+    {
+      lanes = (lanes == 4) ? 1 : lanes >> 1;
+    }
+
+  MbLanes = lanes;
+  return lanes;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Processing of scheduled jobs in the lanes                     */
+/*              If the message in a lane is complete, its hash value is       */
+/*              output and the lane is refilled with the next job             */
+/*  Syntax:     static void HashLanes (HASHMBJOB **Queue, ULONG NoOfJobs,     */
+/*                      const MBALG *alg, MBKERNEL kernel, int Lanes);        */
+/*  Input:      HASHMBJOB **Queue (Scheduled jobs)                            */
+/*              ULONG NoOfJobs (Number of jobs)                               */
+/*              const MBALG *alg (Parameters of hash algorithm)               */
+/*              MBKERNEL kernel (Block function for Lanes lanes)              */
+/*              int Lanes (Number of lanes)                                   */
+/*  Output:     Hash values of the jobs                                       */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+static void
+HashLanes (HASHMBJOB **Queue, ULONG NoOfJobs, const MBALG *alg,
+           MBKERNEL kernel, int Lanes)
+{
+  MBLANE lane[HASHMB_MAXLANES];
+  unsigned int State[8 * HASHMB_MAXLANES];
+  unsigned int W[16 * HASHMB_MAXLANES];
+  UCHAR *block, *res;
+  ULONG next = 0, word;
+  int active = 0, l, t, i;
+
+  for (l = 0; l < Lanes; l++)
+    {
+      lane[l].Job = NULL;
+      if (next < NoOfJobs)
+        {
+          StartLane (&lane[l], Queue[next++], alg, State, l, Lanes);
+          active++;
+        }
+    }
+
+  while (active > 0)
+    {
+      /* Message words of the next block in each lane */
+      for (l = 0; l < Lanes; l++)
+        {
+          if (lane[l].Job == NULL)
+            {
+              for (t = 0; t < 16; t++)
+                {
+                  W[t * Lanes + l] = 0;
+                }
+              continue;
+            }
+
+          block = (lane[l].Blocks > 0) ? lane[l].Next : lane[l].PadNext;
+
+          for (t = 0; t < 16; t++, block += 4)
+            {
+              if (alg->BigEndian)
+                {
+                  W[t * Lanes + l] = ((unsigned int)block[0] << 24) |
+                                     ((unsigned int)block[1] << 16) |
+                                     ((unsigned int)block[2] <<  8) |
+                                     ((unsigned int)block[3]);
+                }
+              else
+                {
+                  W[t * Lanes + l] = ((unsigned int)block[3] << 24) |
+                                     ((unsigned int)block[2] << 16) |
+                                     ((unsigned int)block[1] <<  8) |
+                                     ((unsigned int)block[0]);
+                }
+            }
+        }
+
+      kernel (State, W);
+
+      /* Advance lanes, output hash values of completed messages */
+      for (l = 0; l < Lanes; l++)
+        {
+          if (lane[l].Job == NULL)
+            {
+              continue;
+            }
+
+          if (lane[l].Blocks > 0)
+            {
+              lane[l].Blocks--;
+              lane[l].Next += 64;
+              continue;
+            }
+
+          lane[l].PadNext += 64;
+          if (--lane[l].Tail > 0)
+            {
+              continue;
+            }
+
+          res = lane[l].Job->HashRes;
+          for (i = 0; i < alg->HashLen >> 2; i++, res += 4)
+            {
+              word = State[i * Lanes + l];
+              if (alg->BigEndian)
+                {
+                  res[0] = (UCHAR)(word >> 24);
+                  res[1] = (UCHAR)(word >> 16);
+                  res[2] = (UCHAR)(word >>  8);
+                  res[3] = (UCHAR)(word      );
+                }
+              else
+                {
+                  res[3] = (UCHAR)(word >> 24);
+                  res[2] = (UCHAR)(word >> 16);
+                  res[1] = (UCHAR)(word >>  8);
+                  res[0] = (UCHAR)(word      );
+                }
+            }
+
+          lane[l].Job = NULL;
+          active--;
+
+          if (next < NoOfJobs)
+            {
+              StartLane (&lane[l], Queue[next++], alg, State, l, Lanes);
+              active++;
+            }
+        }
+    }
+
+#ifdef FLINT_SECURE
+  /* Overwrite temporary variables */
+  memset (lane, 0, sizeof (lane));
+  memset (State, 0, sizeof (State));
+  memset (W, 0, sizeof (W));
+  word = 0;
+#endif
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Assignment of a job to a lane                                 */
+/*              The chaining value of the lane is initialized and the last    */
+/*              bytes of the message are padded with 0x80, zeros and the      */
+/*              length of the message in bit                                  */
+/*  Syntax:     static void StartLane (MBLANE *lane, HASHMBJOB *Job,          */
+/*                                     const MBALG *alg, unsigned int *State, */
+/*                                     int l, int Lanes);                     */
+/*  Input:      HASHMBJOB *Job (Job to be processed)                          */
+/*              const MBALG *alg (Parameters of hash algorithm)               */
+/*              int l (Number of lane)                                        */
+/*              int Lanes (Number of lanes)                                   */
+/*  Output:     MBLANE *lane (Lane processing Job)                            */
+/*              unsigned int *State (Chaining values of all lanes)            */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+static void
+StartLane (MBLANE *lane, HASHMBJOB *Job, const MBALG *alg,
+           unsigned int *State, int l, int Lanes)
+{
+  ULONG rest = Job->length & 63;
+  ULONG lo = (Job->length << 3) & 0xffffffffUL;
+  ULONG hi = (Job->length >> 29) & 0xffffffffUL;
+  UCHAR *end;
+  int i;
+
+  for (i = 0; i < alg->Words; i++)
+    {
+      State[i * Lanes + l] = (unsigned int)alg->IV[i];
+    }
+
+  lane->Job = Job;
+  lane->Next = Job->clear;
+  lane->Blocks = Job->length >> 6;
+  lane->PadNext = lane->Pad;
+
+  /* At least one byte for 0x80 and eight bytes for the length are needed */
+  lane->Tail = (rest > 55) ? 2 : 1;
+
+  memset (lane->Pad, 0, sizeof (lane->Pad));
+  if (rest > 0)
+    {
+      memcpy (lane->Pad, Job->clear + (Job->length - rest), (size_t)rest);
+    }
+  lane->Pad[rest] = 0x80;
+
+  end = lane->Pad + (lane->Tail << 6) - 8;
+  if (alg->BigEndian)
+    {
+      end[0] = (UCHAR)(hi >> 24);
+      end[1] = (UCHAR)(hi >> 16);
+      end[2] = (UCHAR)(hi >>  8);
+      end[3] = (UCHAR)(hi      );
+      end[4] = (UCHAR)(lo >> 24);
+      end[5] = (UCHAR)(lo >> 16);
+      end[6] = (UCHAR)(lo >>  8);
+      end[7] = (UCHAR)(lo      );
+    }
+  else
+    {
+      end[0] = (UCHAR)(lo      );
+      end[1] = (UCHAR)(lo >>  8);
+      end[2] = (UCHAR)(lo >> 16);
+      end[3] = (UCHAR)(lo >> 24);
+      end[4] = (UCHAR)(hi      );
+      end[5] = (UCHAR)(hi >>  8);
+      end[6] = (UCHAR)(hi >> 16);
+      end[7] = (UCHAR)(hi >> 24);
+    }
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Comparison of jobs by length for qsort                        */
+/*              Jobs with more blocks are sorted to the front                 */
+/*  Syntax:     static int CmpLength (const void *a, const void *b);          */
+/*  Input:      const void *a, *b (Pointers to elements of type HASHMBJOB *)  */
+/*  Output:     -                                                             */
+/*  Returns:    < 0, 0, > 0 if job a has more, as many, fewer blocks than b   */
+/*                                                                            */
+/******************************************************************************/
+static int
+CmpLength (const void *a, const void *b)
+{
+  ULONG la = ((*(HASHMBJOB * const *)a)->length + 72) >> 6;
+  ULONG lb = ((*(HASHMBJOB * const *)b)->length + 72) >> 6;
+
+  return (la > lb) ? -1 : (la < lb) ? 1 : 0;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Number of lanes supported by the processor                    */
+/*              AVX2 and AVX-512 also require support of the operating system */
+/*              for saving the extended registers                             */
+/*  Syntax:     static int CpuLanes (void);                                   */
+/*  Input:      -                                                             */
+/*  Output:     -                                                             */
+/*  Returns:    16 (AVX-512F), 8 (AVX2), 4 (SSE2) or 1                        */
+/*                                                                            */
+/******************************************************************************/
+static int
+CpuLanes (void)
+{
+#if defined HASHMB_SIMD && defined __GNUC__
+  unsigned int a, b, c, d, xcr0 = 0;
+  int lanes = 1;
+
+  if (!__get_cpuid (1, &a, &b, &c, &d))
+    {
+      return 1;
+    }
+  if (d & 0x04000000)
+    {
+      lanes = 4;
+    }
+  if (c & 0x08000000)
+    {
+      __asm__ ("xgetbv" : "=a" (xcr0), "=d" (d) : "c" (0));
+    }
+  if (__get_cpuid_max (0, NULL) < 7)
+    {
+      return lanes;
+    }
+  __cpuid_count (7, 0, a, b, c, d);
+  if ((xcr0 & 0x06) == 0x06 && (b & 0x20))
+    {
+      lanes = 8;
+    }
+  if ((xcr0 & 0xe6) == 0xe6 && (b & 0x10000))
+    {
+      lanes = 16;
+    }
+  return lanes;
+#elif defined HASHMB_SIMD
+  int info[4], lanes = 1;
+  unsigned __int64 xcr0 = 0;
+
+  __cpuid (info, 0);
+  if (info[0] < 1)
+    {
+      return 1;
+    }
+  __cpuid (info, 1);
+  if (info[3] & 0x04000000)
+    {
+      lanes = 4;
+    }
+  if (info[2] & 0x08000000)
+    {
+      xcr0 = _xgetbv (0);
+    }
+  __cpuid (info, 0);
+  if (info[0] < 7)
+    {
+      return lanes;
+    }
+  __cpuidex (info, 7, 0);
+  if ((xcr0 & 0x06) == 0x06 && (info[1] & 0x20))
+    {
+      lanes = 8;
+    }
+  if ((xcr0 & 0xe6) == 0xe6 && (info[1] & 0x10000))
+    {
+      lanes = 16;
+    }
+  return lanes;
+#else
+  return 1;
+#endif
+}
@@ -0,0 +1,104 @@
+/******************************************************************************/
+/*                                                                            */
+/* Functions for arithmetic and number theory with large integers in C        */
+/* Software supplement to the book "Cryptography in C and C++"                */
+/* by Michael Welschenbach                                                    */
+/*                                                                            */
+/* Module hashmb.h         Revision: 19.10.2026                               */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 1998-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+
+#ifndef __HASHMBH__
+#define __HASHMBH__
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/* Macros */
+
+#define HASHMB_SHA1          1  /* SHA-1, hash value of 20 bytes */
+#define HASHMB_SHA256        2  /* SHA-256, hash value of 32 bytes */
+#define HASHMB_RMD160        3  /* RIPEMD-160, hash value of 20 bytes */
+
+#define HASHMB_MAXLANES     16  /* Maximum number of messages in lockstep */
+
+#define E_HASHMB_ALG        -1  /* Unknown hash algorithm */
+#define E_HASHMB_MEM        -2  /* Allocation of job list failed */
+
+/* Macros maintaining FLINT/C namespace */
+
+#define hashmb               hashmb_l
+#define hashmblanes          hashmblanes_l
+
+
+/* Job for multi-buffer hashing: message and buffer for the hash value */
+
+typedef struct
+{
+  unsigned char *clear;        /* Message */
+  unsigned long length;        /* Length of message in bytes */
+  unsigned char *HashRes;      /* Hash value of message */
+} HASHMBJOB;
+
+
+/******************************************************************************/
+/* Multi-buffer hashing API: Public Functions */
+
+#ifndef __FLINT_API
+#ifdef FLINT_USEDLL
+#define __FLINT_API                   __cdecl
+#else
+#define __FLINT_API                   /**/
+#endif /* FLINT_USEDLL */
+#endif /* !defined __FLINT_API */
+
+extern int __FLINT_API
+hashmb_l (int Alg, HASHMBJOB *Jobs, unsigned long NoOfJobs);
+extern int __FLINT_API
+hashmblanes_l (int Lanes);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* __HASHMBH__ */
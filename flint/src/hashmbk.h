@@ -0,0 +1,361 @@
+/******************************************************************************/
+/*                                                                            */
+/* Functions for arithmetic and number theory with large integers in C        */
+/* Software supplement to the book "Cryptography in C and C++"                */
+/* by Michael Welschenbach                                                    */
+/*                                                                            */
+/* Module hashmbk.h        Revision: 19.10.2026                               */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 1998-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+
+/******************************************************************************/
+/* Kernel functions of multi-buffer hashing for internal use by hashmb.c      */
+/*                                                                            */
+/* This file is included by hashmb.c once per lane width. Before inclusion    */
+/* the following macros must be defined:                                      */
+/*                                                                            */
+/*  MB_V             Type of a vector holding one 32 bit word per lane        */
+/*  MB_LANES         Number of lanes of MB_V                                  */
+/*  MB_NAME(f)       Name of function f for this lane width                   */
+/*  MB_TARGET        Function attribute enabling the instruction set          */
+/*  MB_LOAD(p)       Load of MB_LANES words from p                            */
+/*  MB_STORE(p, x)   Store of x to MB_LANES words at p                        */
+/*  MB_SET1(c)       Constant c in all lanes                                  */
+/*  MB_ADD, MB_XOR, MB_AND, MB_OR (x, y)  Lane-wise operations                */
+/*  MB_ROL(x, n), MB_SHR(x, n)  Lane-wise rotation and shift by n bits        */
+/*                                                                            */
+/* The kernels process one 64 byte message block per lane. The chaining      */
+/* values are stored in state[i*MB_LANES + l], message word t of lane l in    */
+/* W[t*MB_LANES + l], already converted to host byte order. All macros MB_*   */
+/* are undefined at the end of this file.                                     */
+/*                                                                            */
+/******************************************************************************/
+
+#define MB_ROR(x, n)        MB_ROL ((x), 32 - (n))
+#define MB_NOT(x)           MB_XOR ((x), MB_SET1 (0xffffffffUL))
+#define MB_ADD3(x, y, z)    MB_ADD (MB_ADD ((x), (y)), (z))
+
+
+/* The round macros operate on the working variables in the order given.   */
+/* The following round is called with the variables rotated by one place,  */
+/* which avoids moving the variables between the rounds.                    */
+
+/* Round i of SHA-1 with boolean function value f and constant k */
+#define MB_SHA1_ROUND(a, b, c, d, e, f, k, i) \
+  if ((i) >= 16) \
+    { \
+      x = MB_XOR (MB_XOR (w[((i) - 3) & 15], w[((i) - 8) & 15]), \
+                  MB_XOR (w[((i) - 14) & 15], w[(i) & 15])); \
+      w[(i) & 15] = MB_ROL (x, 1); \
+    } \
+  (e) = MB_ADD (MB_ADD3 ((e), MB_ROL ((a), 5), f), \
+                MB_ADD ((k), w[(i) & 15])); \
+  (b) = MB_ROL ((b), 30)
+
+#define MB_SHA1_F1(b, c, d)  MB_XOR ((d), MB_AND ((b), MB_XOR ((c), (d))))
+#define MB_SHA1_F2(b, c, d)  MB_XOR (MB_XOR ((b), (c)), (d))
+#define MB_SHA1_F3(b, c, d)  MB_OR (MB_AND ((b), (c)), \
+                                    MB_AND ((d), MB_OR ((b), (c))))
+
+/* Five rounds of SHA-1 starting with round i */
+#define MB_SHA1_ROUND5(F, k, i) \
+  MB_SHA1_ROUND (a, b, c, d, e, F (b, c, d), k, (i)); \
+  MB_SHA1_ROUND (e, a, b, c, d, F (a, b, c), k, (i) + 1); \
+  MB_SHA1_ROUND (d, e, a, b, c, F (e, a, b), k, (i) + 2); \
+  MB_SHA1_ROUND (c, d, e, a, b, F (d, e, a), k, (i) + 3); \
+  MB_SHA1_ROUND (b, c, d, e, a, F (c, d, e), k, (i) + 4)
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   SHA-1 block function for MB_LANES messages                    */
+/*  Syntax:     static void sha1_mb_xN (unsigned int *state,                  */
+/*                                               const unsigned int *W);      */
+/*  Input:      unsigned int *state (Chaining values)                         */
+/*              const unsigned int *W (Message words)                         */
+/*  Output:     unsigned int *state (Updated chaining values)                 */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+MB_TARGET static void
+MB_NAME (sha1_mb) (unsigned int *state, const unsigned int *W)
+{
+  MB_V a, b, c, d, e, k, x, w[16];
+  int t;
+
+  for (t = 0; t < 16; t++)
+    {
+      w[t] = MB_LOAD (W + t * MB_LANES);
+    }
+
+  a = MB_LOAD (state);
+  b = MB_LOAD (state + MB_LANES);
+  c = MB_LOAD (state + 2 * MB_LANES);
+  d = MB_LOAD (state + 3 * MB_LANES);
+  e = MB_LOAD (state + 4 * MB_LANES);
+
+  k = MB_SET1 (0x5a827999UL);
+  for (t = 0; t < 20; t += 5)
+    {
+      MB_SHA1_ROUND5 (MB_SHA1_F1, k, t);
+    }
+
+  k = MB_SET1 (0x6ed9eba1UL);
+  for (t = 20; t < 40; t += 5)
+    {
+      MB_SHA1_ROUND5 (MB_SHA1_F2, k, t);
+    }
+
+  k = MB_SET1 (0x8f1bbcdcUL);
+  for (t = 40; t < 60; t += 5)
+    {
+      MB_SHA1_ROUND5 (MB_SHA1_F3, k, t);
+    }
+
+  k = MB_SET1 (0xca62c1d6UL);
+  for (t = 60; t < 80; t += 5)
+    {
+      MB_SHA1_ROUND5 (MB_SHA1_F2, k, t);
+    }
+
+  MB_STORE (state, MB_ADD (a, MB_LOAD (state)));
+  MB_STORE (state + MB_LANES, MB_ADD (b, MB_LOAD (state + MB_LANES)));
+  MB_STORE (state + 2 * MB_LANES, MB_ADD (c, MB_LOAD (state + 2 * MB_LANES)));
+  MB_STORE (state + 3 * MB_LANES, MB_ADD (d, MB_LOAD (state + 3 * MB_LANES)));
+  MB_STORE (state + 4 * MB_LANES, MB_ADD (e, MB_LOAD (state + 4 * MB_LANES)));
+}
+
+
+/* Round i of SHA-256 */
+#define MB_SHA256_ROUND(a, b, c, d, e, f, g, h, i) \
+  if ((i) >= 16) \
+    { \
+      x = w[((i) - 15) & 15]; \
+      x = MB_XOR (MB_XOR (MB_ROR (x, 7), MB_ROR (x, 18)), MB_SHR (x, 3)); \
+      y = w[((i) - 2) & 15]; \
+      y = MB_XOR (MB_XOR (MB_ROR (y, 17), MB_ROR (y, 19)), MB_SHR (y, 10)); \
+      w[(i) & 15] = MB_ADD (MB_ADD3 (w[(i) & 15], x, y), w[((i) - 7) & 15]); \
+    } \
+  x = MB_XOR (MB_XOR (MB_ROR ((e), 6), MB_ROR ((e), 11)), MB_ROR ((e), 25)); \
+  y = MB_XOR ((g), MB_AND ((e), MB_XOR ((f), (g)))); \
+  t1 = MB_ADD (MB_ADD3 ((h), x, y), \
+               MB_ADD (MB_SET1 (K256[i]), w[(i) & 15])); \
+  x = MB_XOR (MB_XOR (MB_ROR ((a), 2), MB_ROR ((a), 13)), MB_ROR ((a), 22)); \
+  y = MB_OR (MB_AND ((a), (b)), MB_AND ((c), MB_OR ((a), (b)))); \
+  (d) = MB_ADD ((d), t1); \
+  (h) = MB_ADD3 (t1, x, y)
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   SHA-256 block function for MB_LANES messages                  */
+/*  Syntax:     static void sha256_mb_xN (unsigned int *state,                */
+/*                                               const unsigned int *W);      */
+/*  Input:      unsigned int *state (Chaining values)                         */
+/*              const unsigned int *W (Message words)                         */
+/*  Output:     unsigned int *state (Updated chaining values)                 */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+MB_TARGET static void
+MB_NAME (sha256_mb) (unsigned int *state, const unsigned int *W)
+{
+  MB_V a, b, c, d, e, f, g, h, t1, x, y, w[16];
+  int t;
+
+  for (t = 0; t < 16; t++)
+    {
+      w[t] = MB_LOAD (W + t * MB_LANES);
+    }
+
+  a = MB_LOAD (state);
+  b = MB_LOAD (state + MB_LANES);
+  c = MB_LOAD (state + 2 * MB_LANES);
+  d = MB_LOAD (state + 3 * MB_LANES);
+  e = MB_LOAD (state + 4 * MB_LANES);
+  f = MB_LOAD (state + 5 * MB_LANES);
+  g = MB_LOAD (state + 6 * MB_LANES);
+  h = MB_LOAD (state + 7 * MB_LANES);
+
+  for (t = 0; t < 64; t += 8)
+    {
+      MB_SHA256_ROUND (a, b, c, d, e, f, g, h, t);
+      MB_SHA256_ROUND (h, a, b, c, d, e, f, g, t + 1);
+      MB_SHA256_ROUND (g, h, a, b, c, d, e, f, t + 2);
+      MB_SHA256_ROUND (f, g, h, a, b, c, d, e, t + 3);
+      MB_SHA256_ROUND (e, f, g, h, a, b, c, d, t + 4);
+      MB_SHA256_ROUND (d, e, f, g, h, a, b, c, t + 5);
+      MB_SHA256_ROUND (c, d, e, f, g, h, a, b, t + 6);
+      MB_SHA256_ROUND (b, c, d, e, f, g, h, a, t + 7);
+    }
+
+  MB_STORE (state, MB_ADD (a, MB_LOAD (state)));
+  MB_STORE (state + MB_LANES, MB_ADD (b, MB_LOAD (state + MB_LANES)));
+  MB_STORE (state + 2 * MB_LANES, MB_ADD (c, MB_LOAD (state + 2 * MB_LANES)));
+  MB_STORE (state + 3 * MB_LANES, MB_ADD (d, MB_LOAD (state + 3 * MB_LANES)));
+  MB_STORE (state + 4 * MB_LANES, MB_ADD (e, MB_LOAD (state + 4 * MB_LANES)));
+  MB_STORE (state + 5 * MB_LANES, MB_ADD (f, MB_LOAD (state + 5 * MB_LANES)));
+  MB_STORE (state + 6 * MB_LANES, MB_ADD (g, MB_LOAD (state + 6 * MB_LANES)));
+  MB_STORE (state + 7 * MB_LANES, MB_ADD (h, MB_LOAD (state + 7 * MB_LANES)));
+}
+
+
+/* Round of a line of RIPEMD-160 with boolean function value f, constant k, */
+/* message word w[r] and rotation by s bits                                 */
+#define MB_RMD_ROUND(a, b, c, d, e, f, k, r, s) \
+  (a) = MB_ADD (MB_ROL (MB_ADD3 ((a), f, MB_ADD (w[r], (k))), (s)), (e)); \
+  (c) = MB_ROL ((c), 10)
+
+/* Round i of both lines, left line with function F, right line with G */
+#define MB_RMD_ROUND2(a, b, c, d, e, F, G, i) \
+  MB_RMD_ROUND (a##1, b##1, c##1, d##1, e##1, F (b##1, c##1, d##1), \
+                k1, RmdR1[i], RmdS1[i]); \
+  MB_RMD_ROUND (a##2, b##2, c##2, d##2, e##2, G (b##2, c##2, d##2), \
+                k2, RmdR2[i], RmdS2[i])
+
+/* Sequence of 16 rounds of both lines starting with round i */
+#define MB_RMD_ROUND16(a, b, c, d, e, F, G, i) \
+  k1 = MB_SET1 (RmdK1[(i) >> 4]); \
+  k2 = MB_SET1 (RmdK2[(i) >> 4]); \
+  MB_RMD_ROUND2 (a, b, c, d, e, F, G, (i)); \
+  MB_RMD_ROUND2 (e, a, b, c, d, F, G, (i) + 1); \
+  MB_RMD_ROUND2 (d, e, a, b, c, F, G, (i) + 2); \
+  MB_RMD_ROUND2 (c, d, e, a, b, F, G, (i) + 3); \
+  MB_RMD_ROUND2 (b, c, d, e, a, F, G, (i) + 4); \
+  MB_RMD_ROUND2 (a, b, c, d, e, F, G, (i) + 5); \
+  MB_RMD_ROUND2 (e, a, b, c, d, F, G, (i) + 6); \
+  MB_RMD_ROUND2 (d, e, a, b, c, F, G, (i) + 7); \
+  MB_RMD_ROUND2 (c, d, e, a, b, F, G, (i) + 8); \
+  MB_RMD_ROUND2 (b, c, d, e, a, F, G, (i) + 9); \
+  MB_RMD_ROUND2 (a, b, c, d, e, F, G, (i) + 10); \
+  MB_RMD_ROUND2 (e, a, b, c, d, F, G, (i) + 11); \
+  MB_RMD_ROUND2 (d, e, a, b, c, F, G, (i) + 12); \
+  MB_RMD_ROUND2 (c, d, e, a, b, F, G, (i) + 13); \
+  MB_RMD_ROUND2 (b, c, d, e, a, F, G, (i) + 14); \
+  MB_RMD_ROUND2 (a, b, c, d, e, F, G, (i) + 15)
+
+#define MB_RMD_F1(b, c, d)  MB_XOR (MB_XOR ((b), (c)), (d))
+#define MB_RMD_F2(b, c, d)  MB_XOR ((d), MB_AND ((b), MB_XOR ((c), (d))))
+#define MB_RMD_F3(b, c, d)  MB_XOR (MB_OR ((b), MB_NOT (c)), (d))
+#define MB_RMD_F4(b, c, d)  MB_XOR ((c), MB_AND ((d), MB_XOR ((b), (c))))
+#define MB_RMD_F5(b, c, d)  MB_XOR ((b), MB_OR ((c), MB_NOT (d)))
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   RIPEMD-160 block function for MB_LANES messages               */
+/*              After each sequence of 16 rounds the working variables are    */
+/*              rotated by one place, after 80 rounds they are back in place  */
+/*  Syntax:     static void rmd160_mb_xN (unsigned int *state,                */
+/*                                               const unsigned int *W);      */
+/*  Input:      unsigned int *state (Chaining values)                         */
+/*              const unsigned int *W (Message words)                         */
+/*  Output:     unsigned int *state (Updated chaining values)                 */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+MB_TARGET static void
+MB_NAME (rmd160_mb) (unsigned int *state, const unsigned int *W)
+{
+  MB_V a1, b1, c1, d1, e1, a2, b2, c2, d2, e2, k1, k2, x, w[16];
+  int t;
+
+  for (t = 0; t < 16; t++)
+    {
+      w[t] = MB_LOAD (W + t * MB_LANES);
+    }
+
+  a1 = a2 = MB_LOAD (state);
+  b1 = b2 = MB_LOAD (state + MB_LANES);
+  c1 = c2 = MB_LOAD (state + 2 * MB_LANES);
+  d1 = d2 = MB_LOAD (state + 3 * MB_LANES);
+  e1 = e2 = MB_LOAD (state + 4 * MB_LANES);
+
+  MB_RMD_ROUND16 (a, b, c, d, e, MB_RMD_F1, MB_RMD_F5, 0);
+  MB_RMD_ROUND16 (e, a, b, c, d, MB_RMD_F2, MB_RMD_F4, 16);
+  MB_RMD_ROUND16 (d, e, a, b, c, MB_RMD_F3, MB_RMD_F3, 32);
+  MB_RMD_ROUND16 (c, d, e, a, b, MB_RMD_F4, MB_RMD_F2, 48);
+  MB_RMD_ROUND16 (b, c, d, e, a, MB_RMD_F5, MB_RMD_F1, 64);
+
+  /* Combination of both lines with previous chaining value */
+  x = MB_ADD3 (MB_LOAD (state + MB_LANES), c1, d2);
+  MB_STORE (state + MB_LANES,
+            MB_ADD3 (MB_LOAD (state + 2 * MB_LANES), d1, e2));
+  MB_STORE (state + 2 * MB_LANES,
+            MB_ADD3 (MB_LOAD (state + 3 * MB_LANES), e1, a2));
+  MB_STORE (state + 3 * MB_LANES,
+            MB_ADD3 (MB_LOAD (state + 4 * MB_LANES), a1, b2));
+  MB_STORE (state + 4 * MB_LANES, MB_ADD3 (MB_LOAD (state), b1, c2));
+  MB_STORE (state, x);
+}
+
+#undef MB_ROR
+#undef MB_NOT
+#undef MB_ADD3
+#undef MB_SHA1_ROUND
+#undef MB_SHA1_ROUND5
+#undef MB_SHA1_F1
+#undef MB_SHA1_F2
+#undef MB_SHA1_F3
+#undef MB_SHA256_ROUND
+#undef MB_RMD_ROUND
+#undef MB_RMD_ROUND2
+#undef MB_RMD_ROUND16
+#undef MB_RMD_F1
+#undef MB_RMD_F2
+#undef MB_RMD_F3
+#undef MB_RMD_F4
+#undef MB_RMD_F5
+
+#undef MB_V
+#undef MB_LANES
+#undef MB_NAME
+#undef MB_TARGET
+#undef MB_LOAD
+#undef MB_STORE
+#undef MB_SET1
+#undef MB_ADD
+#undef MB_XOR
+#undef MB_AND
+#undef MB_OR
+#undef MB_ROL
+#undef MB_SHR
@@ -0,0 +1,779 @@
+/******************************************************************************/
+/*                                                                            */
+/* Functions for arithmetic and number theory with large integers in C        */
+/* Software supplement to the book "Cryptography in C and C++"                */
+/* by Michael Welschenbach                                                    */
+/*                                                                            */
+/* Module hashtree.c       Revision: 19.10.2026                               */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 2001-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+
+/* POSIX interfaces for positioned reads and threads, 64-bit file offsets */
+#define _XOPEN_SOURCE 600
+#define _FILE_OFFSET_BITS 64
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "flint.h"
+#include "sha256.h"
+#include "hashtree.h"
+
+
+/* Macros */
+
+#define LEAFTAG   0x00  /* Trailing byte of leaf input */
+#define NODETAG   0x01  /* Trailing byte of inner node input */
+
+#define NOLEAF    ((ULONG)-1)  /* No short leaf received yet */
+
+#define HLEN      HASHTREE_HASHLEN
+
+
+/* Types */
+
+/* State shared by the threads hashing the leaves of a message */
+typedef struct
+{
+  HASHTREE *ht;                /* Tree with slots for all leaves */
+  UCHAR *clear;                /* Message in memory, or NULL */
+  int fd;                      /* File descriptor if clear == NULL */
+  off_t Size;                  /* Length of the message */
+  ULONG NoOfLeaves;            /* Number of leaves of the message */
+  ULONG Next;                  /* Next leaf to be hashed */
+  int Error;                   /* Error code of the first failure */
+  pthread_mutex_t Lock;
+} TREEPOOL;
+
+
+/* Prototypes */
+
+static void TaggedHash (UCHAR *HashRes, UCHAR *clear, ULONG length, int Tag);
+static int RunPool (TREEPOOL *pl, int Threads);
+static void *Worker (void *arg);
+static int ReadAt (int fd, UCHAR *Buf, size_t Len, off_t Offset);
+static int Grow (HASHTREE *ht, ULONG Cap);
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Tree hash of a message in memory                              */
+/*              The leaves are hashed in parallel by a pool of threads        */
+/*  Syntax:     int hashtree_l (UCHAR *Root, UCHAR *clear, ULONG length,      */
+/*                           ULONG LeafSize, int FanOut, int Threads);        */
+/*  Input:      UCHAR *clear (Message)                                        */
+/*              ULONG length (Length of message in bytes)                     */
+/*              ULONG LeafSize (Bytes per leaf, multiple of 64)               */
+/*              int FanOut (Children per node, 2 <= FanOut <= 256)            */
+/*              int Threads (Number of threads, 0: number of processors)      */
+/*  Output:     UCHAR *Root (Root hash of HASHTREE_HASHLEN bytes)             */
+/*  Returns:    0 if everything is O.K.                                       */
+/*              E_HASHTREE_ARG if LeafSize or FanOut are invalid              */
+/*              E_HASHTREE_MEM if allocation of memory failed                 */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+hashtree_l (UCHAR *Root, UCHAR *clear, ULONG length, ULONG LeafSize,
+            int FanOut, int Threads)
+{
+  TREEPOOL pl;
+  HASHTREE ht;
+  int error;
+
+  if (clear == NULL && length > 0)
+    {
+      return E_HASHTREE_ARG;
+    }
+
+  if ((error = hashtreeinit_l (&ht, LeafSize, FanOut)) != 0)
+    {
+      return error;
+    }
+
+  memset (&pl, 0, sizeof (pl));
+  pl.ht = &ht;
+  pl.clear = clear;
+  pl.fd = -1;
+  pl.Size = (off_t)length;
+  pl.NoOfLeaves = HASHTREE_LEAVES (length, LeafSize);
+
+  if ((error = RunPool (&pl, Threads)) != 0)
+    {
+      hashtreepurge_l (&ht);
+      return error;
+    }
+
+  return hashtreefinish_l (Root, &ht, pl.NoOfLeaves);
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Tree hash of a file                                           */
+/*              For regular files each thread of the pool reads its leaves    */
+/*              with positioned reads and hashes them. Other files (pipes,    */
+/*              sockets) are read and hashed sequentially                     */
+/*  Syntax:     int hashtreefd_l (UCHAR *Root, int fd, ULONG LeafSize,        */
+/*                                          int FanOut, int Threads);         */
+/*  Input:      int fd (File descriptor opened for reading, regular files     */
+/*                      are hashed from offset 0 regardless of the position)  */
+/*              ULONG LeafSize (Bytes per leaf, multiple of 64)               */
+/*              int FanOut (Children per node, 2 <= FanOut <= 256)            */
+/*              int Threads (Number of threads, 0: number of processors)      */
+/*  Output:     UCHAR *Root (Root hash of HASHTREE_HASHLEN bytes)             */
+/*  Returns:    0 if everything is O.K.                                       */
+/*              E_HASHTREE_ARG if LeafSize, FanOut or fd are invalid          */
+/*              E_HASHTREE_MEM if allocation of memory failed                 */
+/*              E_HASHTREE_IO if reading the file failed                      */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+hashtreefd_l (UCHAR *Root, int fd, ULONG LeafSize, int FanOut, int Threads)
+{
+  struct stat st;
+  TREEPOOL pl;
+  HASHTREE ht;
+  UCHAR *Buf;
+  ULONG i;
+  int error;
+
+  if (fd < 0 || fstat (fd, &st) != 0)
+    {
+      return E_HASHTREE_ARG;
+    }
+
+  if ((error = hashtreeinit_l (&ht, LeafSize, FanOut)) != 0)
+    {
+      return error;
+    }
+
+  if (S_ISREG (st.st_mode))
+    {
+      if ((st.st_size - 1) / (off_t)LeafSize >= (off_t)(NOLEAF - 1))
+        {
+          hashtreepurge_l (&ht);
+          return E_HASHTREE_ARG;
+        }
+
+      memset (&pl, 0, sizeof (pl));
+      pl.ht = &ht;
+      pl.fd = fd;
+      pl.Size = st.st_size;
+      pl.NoOfLeaves = HASHTREE_LEAVES (st.st_size, LeafSize);
+
+      if ((error = RunPool (&pl, Threads)) != 0)
+        {
+          hashtreepurge_l (&ht);
+          return error;
+        }
+
+      return hashtreefinish_l (Root, &ht, pl.NoOfLeaves);
+    }
+
+  /* Sequential input: leaf i is complete when LeafSize bytes are read */
+  if ((Buf = (UCHAR *)malloc (LeafSize)) == NULL)
+    {
+      hashtreepurge_l (&ht);
+      return E_HASHTREE_MEM;
+    }
+
+  for (i = 0;; i++)
+    {
+      ssize_t n;
+      size_t len = 0;
+
+      while (len < LeafSize)
+        {
+          n = read (fd, Buf + len, LeafSize - len);
+          if (n < 0 && errno == EINTR)
+            {
+              continue;
+            }
+          if (n <= 0)
+            {
+              break;
+            }
+          len += (size_t)n;
+        }
+
+      if (n < 0)
+        {
+          error = E_HASHTREE_IO;
+          break;
+        }
+
+      /* After the first leaf, an empty read marks the end of the message */
+      if (len == 0 && i > 0)
+        {
+          break;
+        }
+
+      if ((error = hashtreeleaf_l (&ht, i, Buf, (ULONG)len)) != 0 ||
+          len < LeafSize)
+        {
+          i++;
+          break;
+        }
+    }
+
+  free (Buf);
+
+  if (error != 0)
+    {
+      hashtreepurge_l (&ht);
+      return error;
+    }
+
+  return hashtreefinish_l (Root, &ht, i);
+}
+
+
+/******************************************************************************/
+/* Functions for hashing the leaves of a message in arbitrary order          */
+/* Procedure: Initialization with hashtreeinit_l                              */
+/*            Hashing of the leaves with hashtreeleaf_l, in any order and     */
+/*            from any number of threads                                      */
+/*            Computation of the root with hashtreefinish_l                   */
+/******************************************************************************/
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Initialization of a tree hash                                 */
+/*  Syntax:     int hashtreeinit_l (HASHTREE *ht, ULONG LeafSize,             */
+/*                                                     int FanOut);           */
+/*  Input:      ULONG LeafSize (Bytes per leaf, multiple of 64)               */
+/*              int FanOut (Children per node, 2 <= FanOut <= 256)            */
+/*  Output:     HASHTREE *ht (Initialized state)                              */
+/*  Returns:    0 if everything is O.K.                                       */
+/*              E_HASHTREE_ARG if LeafSize or FanOut are invalid              */
+/*              E_HASHTREE_MEM if allocation of memory failed                 */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+hashtreeinit_l (HASHTREE *ht, ULONG LeafSize, int FanOut)
+{
+  if (ht == NULL || LeafSize == 0 || (LeafSize & 63) ||
+      FanOut < 2 || FanOut > HASHTREE_MAXFANOUT)
+    {
+      return E_HASHTREE_ARG;
+    }
+
+  memset (ht, 0, sizeof (HASHTREE));
+  ht->LeafSize = LeafSize;
+  ht->FanOut = FanOut;
+  ht->Short = NOLEAF;
+
+  if ((ht->Lock = malloc (sizeof (pthread_mutex_t))) == NULL)
+    {
+      return E_HASHTREE_MEM;
+    }
+  pthread_mutex_init ((pthread_mutex_t *)ht->Lock, NULL);
+
+  return 0;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Hashing of a leaf                                             */
+/*              Leaves may be given in any order and by concurrent threads.   */
+/*              All leaves but the last one must have LeafSize bytes. The     */
+/*              only leaf of an empty message is given with length 0          */
+/*  Syntax:     int hashtreeleaf_l (HASHTREE *ht, ULONG Index, UCHAR *clear,  */
+/*                                                        ULONG length);      */
+/*  Input:      HASHTREE *ht (Initialized state)                              */
+/*              ULONG Index (Number of the leaf, leaf 0 starts the message)   */
+/*              UCHAR *clear (Data of the leaf)                               */
+/*              ULONG length (Length of the leaf in bytes)                    */
+/*  Output:     HASHTREE *ht (Updated state)                                  */
+/*  Returns:    0 if everything is O.K.                                       */
+/*              E_HASHTREE_ARG if ht or clear are invalid                     */
+/*              E_HASHTREE_LEAF if the leaf was given before, if its length   */
+/*                              exceeds LeafSize or if a short leaf is not    */
+/*                              the last one of the message                   */
+/*              E_HASHTREE_MEM if allocation of memory failed                 */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+hashtreeleaf_l (HASHTREE *ht, ULONG Index, UCHAR *clear, ULONG length)
+{
+  UCHAR HashRes[HLEN];
+  ULONG Cap;
+  int error = 0;
+
+  if (ht == NULL || ht->Lock == NULL || (clear == NULL && length > 0) ||
+      Index == NOLEAF)
+    {
+      return E_HASHTREE_ARG;
+    }
+
+  if (length > ht->LeafSize || (length == 0 && Index > 0))
+    {
+      return E_HASHTREE_LEAF;
+    }
+
+  /* Hashing outside of the lock, concurrent leaves proceed in parallel */
+  TaggedHash (HashRes, clear, length, LEAFTAG);
+
+  pthread_mutex_lock ((pthread_mutex_t *)ht->Lock);
+
+  if (Index >= ht->Cap)
+    {
+      for (Cap = (ht->Cap > 0) ? ht->Cap : 64; Cap <= Index;)
+        {
+          Cap = (Cap > NOLEAF / 2) ? NOLEAF : Cap << 1;
+        }
+      error = Grow (ht, Cap);
+    }
+
+  if (error == 0)
+    {
+      /* Duplicates and leaves after the short leaf are rejected */
+      if (ht->Have[Index] ||
+          (ht->Short != NOLEAF && Index > ht->Short) ||
+          (length < ht->LeafSize &&
+           (ht->Short != NOLEAF || Index + 1 < ht->Count)))
+        {
+          error = E_HASHTREE_LEAF;
+        }
+      else
+        {
+          memcpy (ht->Hashes + Index * HLEN, HashRes, HLEN);
+          ht->Have[Index] = 1;
+          if (Index >= ht->Count)
+            {
+              ht->Count = Index + 1;
+            }
+          if (length < ht->LeafSize)
+            {
+              ht->Short = Index;
+            }
+        }
+    }
+
+  pthread_mutex_unlock ((pthread_mutex_t *)ht->Lock);
+
+  return error;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Computation of the root of a tree hash                        */
+/*              The state is purged afterwards, also in case of an error      */
+/*  Syntax:     int hashtreefinish_l (UCHAR *Root, HASHTREE *ht,              */
+/*                                               ULONG NoOfLeaves);           */
+/*  Input:      HASHTREE *ht (State after hashing all leaves)                 */
+/*              ULONG NoOfLeaves (Number of leaves of the message, see        */
+/*                                HASHTREE_LEAVES)                            */
+/*  Output:     UCHAR *Root (Root hash of HASHTREE_HASHLEN bytes)             */
+/*  Returns:    0 if everything is O.K.                                       */
+/*              E_HASHTREE_ARG if ht is invalid or NoOfLeaves == 0            */
+/*              E_HASHTREE_MISSING if leaves 0, ..., NoOfLeaves - 1 were not  */
+/*                                 all given or further leaves were given     */
+/*              E_HASHTREE_LEAF if a short leaf is not the last leaf          */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+hashtreefinish_l (UCHAR *Root, HASHTREE *ht, ULONG NoOfLeaves)
+{
+  ULONG n, i, j, k;
+  int error = 0;
+
+  if (ht == NULL || ht->Lock == NULL || NoOfLeaves == 0)
+    {
+      return E_HASHTREE_ARG;
+    }
+
+  if (ht->Count != NoOfLeaves)
+    {
+      error = E_HASHTREE_MISSING;
+    }
+  else if (ht->Short != NOLEAF && ht->Short != NoOfLeaves - 1)
+    {
+      error = E_HASHTREE_LEAF;
+    }
+
+  for (i = 0; i < NoOfLeaves && error == 0; i++)
+    {
+      if (!ht->Have[i])
+        {
+          error = E_HASHTREE_MISSING;
+        }
+    }
+
+  /* Each level replaces groups of FanOut hashes by their node hash in */
+  /* place; the input of a node is read before its hash is stored      */
+  for (n = NoOfLeaves; n > 1 && error == 0; n = j)
+    {
+      for (i = 0, j = 0; i < n; i += k, j++)
+        {
+          k = (n - i < (ULONG)ht->FanOut) ? n - i : (ULONG)ht->FanOut;
+          TaggedHash (ht->Hashes + j * HLEN, ht->Hashes + i * HLEN,
+                      k * HLEN, NODETAG);
+        }
+    }
+
+  if (error == 0)
+    {
+      memcpy (Root, ht->Hashes, HLEN);
+    }
+
+  hashtreepurge_l (ht);
+
+  return error;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Release of the memory of a tree hash state                    */
+/*  Syntax:     void hashtreepurge_l (HASHTREE *ht);                          */
+/*  Input:      HASHTREE *ht (State)                                          */
+/*  Output:     HASHTREE *ht (Purged state)                                   */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+void __FLINT_API
+hashtreepurge_l (HASHTREE *ht)
+{
+  if (ht == NULL)
+    {
+      return;
+    }
+
+  if (ht->Lock != NULL)
+    {
+      pthread_mutex_destroy ((pthread_mutex_t *)ht->Lock);
+      free (ht->Lock);
+    }
+
+  if (ht->Hashes != NULL)
+    {
+#ifdef FLINT_SECURE
+      memset (ht->Hashes, 0, ht->Cap * HLEN);
+#endif
+      free (ht->Hashes);
+    }
+  free (ht->Have);
+
+  memset (ht, 0, sizeof (HASHTREE));
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   SHA-256 of a message followed by a tag byte                   */
+/*  Syntax:     static void TaggedHash (UCHAR *HashRes, UCHAR *clear,         */
+/*                                           ULONG length, int Tag);          */
+/*  Input:      UCHAR *clear (Message)                                        */
+/*              ULONG length (Length of message in bytes)                     */
+/*              int Tag (LEAFTAG or NODETAG)                                  */
+/*  Output:     UCHAR *HashRes (SHA-256 (clear || Tag)), may overlap clear    */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+static void
+TaggedHash (UCHAR *HashRes, UCHAR *clear, ULONG length, int Tag)
+{
+  SHA256STAT hws;
+  UCHAR Tail[64];
+  ULONG blength = (length >> 6) << 6;
+
+  sha256init_l (&hws);
+  sha256hash_l (&hws, clear, blength);
+
+  memcpy (Tail, clear + blength, length - blength);
+  Tail[length - blength] = (UCHAR)Tag;
+  sha256finish_l (HashRes, &hws, Tail, length - blength + 1);
+
+#ifdef FLINT_SECURE
+  memset (Tail, 0, sizeof (Tail));
+  memset (&hws, 0, sizeof (hws));
+#endif
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Hashing of all leaves of a message by a pool of threads       */
+/*              The calling thread takes part as one of the workers. If       */
+/*              fewer threads can be started, the others do their work        */
+/*  Syntax:     static int RunPool (TREEPOOL *pl, int Threads);               */
+/*  Input:      TREEPOOL *pl (Message and tree state)                         */
+/*              int Threads (Number of threads, 0: number of processors)      */
+/*  Output:     Leaf hashes stored in pl->ht                                  */
+/*  Returns:    0 if everything is O.K.                                       */
+/*              E_HASHTREE_MEM if allocation of memory failed                 */
+/*              E_HASHTREE_IO if reading the file failed                      */
+/*                                                                            */
+/******************************************************************************/
+static int
+RunPool (TREEPOOL *pl, int Threads)
+{
+  pthread_t Tid[HASHTREE_MAXTHREADS];
+  int i, started;
+
+  if (Grow (pl->ht, pl->NoOfLeaves) != 0)
+    {
+      return E_HASHTREE_MEM;
+    }
+
+  if (Threads <= 0)
+    {
+#ifdef _SC_NPROCESSORS_ONLN
+      Threads = (int)sysconf (_SC_NPROCESSORS_ONLN);
+#endif
+      if (Threads <= 0)
+        {
+          Threads = 1;
+        }
+    }
+  if (Threads > HASHTREE_MAXTHREADS)
+    {
+      Threads = HASHTREE_MAXTHREADS;
+    }
+  if ((ULONG)Threads > pl->NoOfLeaves)
+    {
+      Threads = (int)pl->NoOfLeaves;
+    }
+
+  pthread_mutex_init (&pl->Lock, NULL);
+
+  for (started = 0; started < Threads - 1; started++)
+    {
+      if (pthread_create (&Tid[started], NULL, Worker, pl) != 0)
+        {
+          break;
+        }
+    }
+
+  Worker (pl);
+
+  for (i = 0; i < started; i++)
+    {
+      pthread_join (Tid[i], NULL);
+    }
+
+  pthread_mutex_destroy (&pl->Lock);
+
+  /* Bookkeeping of the state as if the leaves were given one by one */
+  if (pl->Error == 0)
+    {
+      memset (pl->ht->Have, 1, pl->NoOfLeaves);
+      pl->ht->Count = pl->NoOfLeaves;
+    }
+
+  return pl->Error;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Worker of the thread pool                                     */
+/*              Takes the next leaf not yet taken until all leaves are done.  */
+/*              Each leaf is written to its own slot in pl->ht->Hashes        */
+/*  Syntax:     static void *Worker (void *arg);                              */
+/*  Input:      void *arg (Pointer to TREEPOOL)                               */
+/*  Output:     Leaf hashes                                                   */
+/*  Returns:    NULL                                                          */
+/*                                                                            */
+/******************************************************************************/
+static void *
+Worker (void *arg)
+{
+  TREEPOOL *pl = (TREEPOOL *)arg;
+  ULONG LeafSize = pl->ht->LeafSize;
+  UCHAR *Buf = NULL;
+  UCHAR *Leaf;
+  off_t Offset;
+  size_t len;
+  ULONG i;
+  int error = 0;
+
+  if (pl->clear == NULL && (Buf = (UCHAR *)malloc (LeafSize)) == NULL)
+    {
+      error = E_HASHTREE_MEM;
+    }
+
+  while (error == 0)
+    {
+      pthread_mutex_lock (&pl->Lock);
+      i = pl->Next++;
+      if (pl->Error != 0)
+        {
+          i = pl->NoOfLeaves;
+        }
+      pthread_mutex_unlock (&pl->Lock);
+
+      if (i >= pl->NoOfLeaves)
+        {
+          break;
+        }
+
+      Offset = (off_t)i * (off_t)LeafSize;
+      len = (pl->Size - Offset < (off_t)LeafSize) ?
+            (size_t)(pl->Size - Offset) : (size_t)LeafSize;
+
+      if (pl->clear != NULL)
+        {
+          Leaf = pl->clear + (size_t)Offset;
+        }
+      else
+        {
+          if (ReadAt (pl->fd, Buf, len, Offset) != 0)
+            {
+              error = E_HASHTREE_IO;
+              break;
+            }
+          Leaf = Buf;
+        }
+
+      TaggedHash (pl->ht->Hashes + i * HLEN, Leaf, (ULONG)len, LEAFTAG);
+    }
+
+  if (error != 0)
+    {
+      pthread_mutex_lock (&pl->Lock);
+      if (pl->Error == 0)
+        {
+          pl->Error = error;
+        }
+      pthread_mutex_unlock (&pl->Lock);
+    }
+
+  if (Buf != NULL)
+    {
+#ifdef FLINT_SECURE
+      memset (Buf, 0, LeafSize);
+#endif
+      free (Buf);
+    }
+
+  return NULL;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Positioned read of an exact number of bytes                   */
+/*  Syntax:     static int ReadAt (int fd, UCHAR *Buf, size_t Len,            */
+/*                                                   off_t Offset);           */
+/*  Input:      int fd (File descriptor)                                      */
+/*              size_t Len (Number of bytes to be read)                       */
+/*              off_t Offset (Position in the file)                           */
+/*  Output:     UCHAR *Buf (Bytes read)                                       */
+/*  Returns:    0 if Len bytes were read, -1 otherwise                        */
+/*                                                                            */
+/******************************************************************************/
+static int
+ReadAt (int fd, UCHAR *Buf, size_t Len, off_t Offset)
+{
+  ssize_t n;
+
+  while (Len > 0)
+    {
+      n = pread (fd, Buf, Len, Offset);
+      if (n < 0 && errno == EINTR)
+        {
+          continue;
+        }
+      if (n <= 0)
+        {
+          return -1;
+        }
+      Buf += n;
+      Len -= (size_t)n;
+      Offset += n;
+    }
+
+  return 0;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Enlargement of the leaf slots of a tree hash state            */
+/*  Syntax:     static int Grow (HASHTREE *ht, ULONG Cap);                    */
+/*  Input:      HASHTREE *ht (State)                                          */
+/*              ULONG Cap (Number of leaf slots required)                     */
+/*  Output:     HASHTREE *ht (State with at least Cap slots)                  */
+/*  Returns:    0 if everything is O.K.                                       */
+/*              E_HASHTREE_MEM if allocation of memory failed                 */
+/*                                                                            */
+/******************************************************************************/
+static int
+Grow (HASHTREE *ht, ULONG Cap)
+{
+  UCHAR *Hashes, *Have;
+
+  if (Cap <= ht->Cap)
+    {
+      return 0;
+    }
+
+  if (Cap > ((size_t)-1) / HLEN)
+    {
+      return E_HASHTREE_MEM;
+    }
+
+  if ((Hashes = (UCHAR *)realloc (ht->Hashes, (size_t)Cap * HLEN)) == NULL)
+    {
+      return E_HASHTREE_MEM;
+    }
+  ht->Hashes = Hashes;
+
+  if ((Have = (UCHAR *)realloc (ht->Have, (size_t)Cap)) == NULL)
+    {
+      return E_HASHTREE_MEM;
+    }
+  ht->Have = Have;
+
+  memset (ht->Have + ht->Cap, 0, (size_t)(Cap - ht->Cap));
+  ht->Cap = Cap;
+
+  return 0;
+}
@@ -0,0 +1,142 @@
+/******************************************************************************/
+/*                                                                            */
+/* Functions for arithmetic and number theory with large integers in C        */
+/* Software supplement to the book "Cryptography in C and C++"                */
+/* by Michael Welschenbach                                                    */
+/*                                                                            */
+/* Module hashtree.h       Revision: 19.10.2026                               */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 1998-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+
+#ifndef __HASHTREEH__
+#define __HASHTREEH__
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/* Macros */
+
+/* The message is split into leaves of LeafSize bytes, the last leaf may be */
+/* shorter. An empty message consists of one empty leaf. Leaves and inner   */
+/* nodes are hashed with SHA-256, separated by a trailing tag byte:         */
+/*   leaf = SHA-256 (data || 0x00)                                          */
+/*   node = SHA-256 (child_1 || ... || child_k || 0x01), k <= FanOut        */
+/* Each level combines FanOut consecutive hashes of the level below, until  */
+/* a single hash, the root, remains. The root depends on the message,       */
+/* LeafSize and FanOut only, not on the number of threads or the order in   */
+/* which the leaves are hashed.                                             */
+
+#define HASHTREE_LEAF      (1L << 20)  /* Default leaf size in bytes */
+#define HASHTREE_FANOUT          16    /* Default fan-out of inner nodes */
+#define HASHTREE_MAXFANOUT      256    /* Maximum fan-out of inner nodes */
+#define HASHTREE_MAXTHREADS      64    /* Maximum number of threads */
+#define HASHTREE_HASHLEN         32    /* Length of leaf, node and root hash */
+
+/* Number of leaves of a message of len bytes */
+#define HASHTREE_LEAVES(len, LeafSize) \
+  (((len) == 0) ? 1UL : (unsigned long)(((len) - 1) / (LeafSize) + 1))
+
+#define E_HASHTREE_ARG      -1  /* Invalid leaf size, fan-out or argument */
+#define E_HASHTREE_MEM      -2  /* Allocation of memory failed */
+#define E_HASHTREE_LEAF     -3  /* Leaf of invalid length or given twice */
+#define E_HASHTREE_MISSING  -4  /* Leaves missing at finish */
+#define E_HASHTREE_IO       -5  /* Reading the file failed */
+
+/* Macros maintaining FLINT/C namespace */
+
+#define hashtree             hashtree_l
+#define hashtreefd           hashtreefd_l
+#define hashtreeinit         hashtreeinit_l
+#define hashtreeleaf         hashtreeleaf_l
+#define hashtreefinish       hashtreefinish_l
+#define hashtreepurge        hashtreepurge_l
+
+
+/* State of a tree hash fed by hashtreeleaf_l in arbitrary order */
+
+typedef struct
+{
+  unsigned long LeafSize;      /* Bytes per leaf, multiple of 64 */
+  int FanOut;                  /* Children per inner node */
+  unsigned long Count;         /* 1 + highest index of a leaf received */
+  unsigned long Cap;           /* Number of leaves with allocated slots */
+  unsigned long Short;         /* Index of a leaf shorter than LeafSize */
+  unsigned char *Hashes;       /* Hash values of leaves, 32 bytes each */
+  unsigned char *Have;         /* Have[i] != 0 if leaf i was received */
+  void *Lock;                  /* Mutex protecting the fields above */
+} HASHTREE;
+
+
+/******************************************************************************/
+/* Tree hashing API: Public Functions */
+
+#ifndef __FLINT_API
+#ifdef FLINT_USEDLL
+#define __FLINT_API                   __cdecl
+#else
+#define __FLINT_API                   /**/
+#endif /* FLINT_USEDLL */
+#endif /* !defined __FLINT_API */
+
+extern int __FLINT_API
+hashtree_l (unsigned char *Root, unsigned char *clear, unsigned long length,
+            unsigned long LeafSize, int FanOut, int Threads);
+extern int __FLINT_API
+hashtreefd_l (unsigned char *Root, int fd, unsigned long LeafSize,
+              int FanOut, int Threads);
+extern int __FLINT_API
+hashtreeinit_l (HASHTREE *ht, unsigned long LeafSize, int FanOut);
+extern int __FLINT_API
+hashtreeleaf_l (HASHTREE *ht, unsigned long Index, unsigned char *clear,
+                unsigned long length);
+extern int __FLINT_API
+hashtreefinish_l (unsigned char *Root, HASHTREE *ht,
+                  unsigned long NoOfLeaves);
+extern void __FLINT_API
+hashtreepurge_l (HASHTREE *ht);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* __HASHTREEH__ */
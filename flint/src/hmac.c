@@ -0,0 +1,505 @@
+/******************************************************************************/
+/*                                                                            */
+/* Functions for arithmetic and number theory with large integers in C        */
+/* Software supplement to the book "Cryptography in C and C++"                */
+/* by Michael Welschenbach                                                    */
+/*                                                                            */
+/* Module hmac.c           Revision: 19.10.2026                               */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 2001-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+
+#include <string.h>
+#include "flint.h"
+#include "hmac.h"
+
+
+/* Prototypes of local functions */
+
+static int MacLength (int Alg);
+static void HashInit (int Alg, HMACSTAT *st);
+static void HashBlocks (int Alg, HMACSTAT *st, UCHAR *clear, ULONG length);
+static void HashFinish (int Alg, UCHAR *HashRes, HMACSTAT *st, UCHAR *clear,
+                        ULONG length);
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Keying of HMAC                                                */
+/*              The key pads are hashed once; the resulting states are        */
+/*              reused for every message MACed with the keyed context         */
+/*  Syntax:     int hmackey_l (HMACKEY *hk, int Alg, UCHAR *Key,              */
+/*                                                   ULONG KeyLen);           */
+/*  Input:      int Alg (HMAC_SHA1, HMAC_SHA256 or HMAC_RMD160)               */
+/*              UCHAR *Key (Key)                                              */
+/*              ULONG KeyLen (Length of key in bytes, keys longer than        */
+/*                            HMAC_BLOCKLEN bytes are hashed first)           */
+/*  Output:     HMACKEY *hk (Keyed context)                                   */
+/*  Returns:    0 if everything is O.K.                                       */
+/*              E_HMAC_ALG if Alg is unknown                                  */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+hmackey_l (HMACKEY *hk, int Alg, UCHAR *Key, ULONG KeyLen)
+{
+  UCHAR Pad[HMAC_BLOCKLEN];
+  HMACSTAT st;
+  int i;
+
+  if ((hk->MacLen = MacLength (Alg)) == 0)
+    {
+      return E_HMAC_ALG;
+    }
+  hk->Alg = Alg;
+
+  /* K0: key padded with zeros, or hash value of a long key */
+  memset (Pad, 0, HMAC_BLOCKLEN);
+  if (KeyLen > HMAC_BLOCKLEN)
+    {
+      HashInit (Alg, &st);
+      HashFinish (Alg, Pad, &st, Key, KeyLen);
+    }
+  else if (KeyLen > 0)
+    {
+      memcpy (Pad, Key, KeyLen);
+    }
+
+  /* Inner state after K0 ^ ipad */
+  for (i = 0; i < HMAC_BLOCKLEN; i++)
+    {
+      Pad[i] ^= 0x36;
+    }
+  HashInit (Alg, &hk->Inner);
+  HashBlocks (Alg, &hk->Inner, Pad, HMAC_BLOCKLEN);
+
+  /* Outer state after K0 ^ opad */
+  for (i = 0; i < HMAC_BLOCKLEN; i++)
+    {
+      Pad[i] ^= 0x36 ^ 0x5c;
+    }
+  HashInit (Alg, &hk->Outer);
+  HashBlocks (Alg, &hk->Outer, Pad, HMAC_BLOCKLEN);
+
+#ifdef FLINT_SECURE
+  /* Overwrite temporary variables */
+  memset (Pad, 0, sizeof (Pad));
+  memset (&st, 0, sizeof (st));
+#endif
+
+  return 0;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Purging of a keyed HMAC context                               */
+/*  Syntax:     void hmacpurge_l (HMACKEY *hk);                               */
+/*  Input:      HMACKEY *hk (Keyed context)                                   */
+/*  Output:     HMACKEY *hk (Overwritten by 0)                                */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+void __FLINT_API
+hmacpurge_l (HMACKEY *hk)
+{
+  memset (hk, 0, sizeof (HMACKEY));
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   HMAC of a message in a single step                            */
+/*              Costs the message blocks and two finalizations only           */
+/*  Syntax:     void hmac_l (UCHAR *Mac, HMACKEY *hk, UCHAR *clear,           */
+/*                                                   ULONG length);           */
+/*  Input:      HMACKEY *hk (Keyed context)                                   */
+/*              UCHAR *clear (Message)                                        */
+/*              ULONG length (Length of message in bytes)                     */
+/*  Output:     UCHAR *Mac (MAC of hk->MacLen bytes)                          */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+void __FLINT_API
+hmac_l (UCHAR *Mac, HMACKEY *hk, UCHAR *clear, ULONG length)
+{
+  HMACSTAT st;
+  UCHAR Inner[HMAC_MAXLEN];
+
+  st = hk->Inner;
+  HashFinish (hk->Alg, Inner, &st, clear, length);
+
+  st = hk->Outer;
+  HashFinish (hk->Alg, Mac, &st, Inner, (ULONG)hk->MacLen);
+
+#ifdef FLINT_SECURE
+  /* Overwrite temporary variables */
+  memset (Inner, 0, sizeof (Inner));
+  memset (&st, 0, sizeof (st));
+#endif
+}
+
+
+/******************************************************************************/
+/* Functions for MACing a message given in several pieces                     */
+/* Procedure: Initialization with hmacinit_l                                  */
+/*            Pieces of any length with function hmacupdate_l                 */
+/*            Finish operation with function hmacfinish_l                     */
+/******************************************************************************/
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Initialization of an HMAC computation                         */
+/*  Syntax:     void hmacinit_l (HMACCTX *ctx, HMACKEY *hk);                  */
+/*  Input:      HMACKEY *hk (Keyed context, must stay valid until             */
+/*                           hmacfinish_l)                                    */
+/*  Output:     HMACCTX *ctx (Initialized context)                            */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+void __FLINT_API
+hmacinit_l (HMACCTX *ctx, HMACKEY *hk)
+{
+  ctx->Key = hk;
+  ctx->State = hk->Inner;
+  ctx->BufLen = 0;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   MACing of a piece of a message                                */
+/*  Syntax:     void hmacupdate_l (HMACCTX *ctx, UCHAR *clear, ULONG length); */
+/*  Input:      HMACCTX *ctx (Context)                                        */
+/*              UCHAR *clear (Piece of the message)                           */
+/*              ULONG length (Length of the piece in bytes, arbitrary)        */
+/*  Output:     HMACCTX *ctx (Updated context)                                */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+void __FLINT_API
+hmacupdate_l (HMACCTX *ctx, UCHAR *clear, ULONG length)
+{
+  ULONG n;
+
+  if (length == 0)
+    {
+      return;
+    }
+
+  /* Complete a partial block from earlier pieces */
+  if (ctx->BufLen > 0)
+    {
+      n = HMAC_BLOCKLEN - ctx->BufLen;
+      if (n > length)
+        {
+          n = length;
+        }
+      memcpy (ctx->Buf + ctx->BufLen, clear, n);
+      ctx->BufLen += n;
+      clear += n;
+      length -= n;
+
+      if (ctx->BufLen < HMAC_BLOCKLEN)
+        {
+          return;
+        }
+      HashBlocks (ctx->Key->Alg, &ctx->State, ctx->Buf, HMAC_BLOCKLEN);
+      ctx->BufLen = 0;
+    }
+
+  /* Complete blocks directly from the piece, the rest into the buffer */
+  n = length & ~((ULONG)HMAC_BLOCKLEN - 1);
+  HashBlocks (ctx->Key->Alg, &ctx->State, clear, n);
+  memcpy (ctx->Buf, clear + n, length - n);
+  ctx->BufLen = length - n;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Finish of an HMAC computation                                 */
+/*  Syntax:     void hmacfinish_l (UCHAR *Mac, HMACCTX *ctx);                 */
+/*  Input:      HMACCTX *ctx (Context)                                        */
+/*  Output:     UCHAR *Mac (MAC of ctx->Key->MacLen bytes)                    */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+void __FLINT_API
+hmacfinish_l (UCHAR *Mac, HMACCTX *ctx)
+{
+  UCHAR Inner[HMAC_MAXLEN];
+  int Alg = ctx->Key->Alg;
+
+  HashFinish (Alg, Inner, &ctx->State, ctx->Buf, ctx->BufLen);
+
+  ctx->State = ctx->Key->Outer;
+  HashFinish (Alg, Mac, &ctx->State, Inner, (ULONG)ctx->Key->MacLen);
+
+#ifdef FLINT_SECURE
+  /* Overwrite temporary variables */
+  memset (Inner, 0, sizeof (Inner));
+  memset (ctx, 0, sizeof (HMACCTX));
+#endif
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   HKDF-Extract (RFC 5869)                                       */
+/*  Syntax:     int hkdfextract_l (UCHAR *PRK, int Alg, UCHAR *Salt,          */
+/*                   ULONG SaltLen, UCHAR *IKM, ULONG IKMLen);                */
+/*  Input:      int Alg (HMAC_SHA1, HMAC_SHA256 or HMAC_RMD160)               */
+/*              UCHAR *Salt (Salt, may be NULL if SaltLen == 0)               */
+/*              ULONG SaltLen (Length of salt in bytes; if 0, a string of     */
+/*                             zeros of the length of a MAC is used)          */
+/*              UCHAR *IKM (Input keying material)                            */
+/*              ULONG IKMLen (Length of IKM in bytes)                         */
+/*  Output:     UCHAR *PRK (Pseudorandom key of the length of a MAC)          */
+/*  Returns:    0 if everything is O.K.                                       */
+/*              E_HMAC_ALG if Alg is unknown                                  */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+hkdfextract_l (UCHAR *PRK, int Alg, UCHAR *Salt, ULONG SaltLen,
+               UCHAR *IKM, ULONG IKMLen)
+{
+  HMACKEY hk;
+  UCHAR Zeros[HMAC_MAXLEN];
+  int error;
+
+  memset (Zeros, 0, sizeof (Zeros));
+
+  /* A salt of zeros of MAC length equals the empty salt as HMAC key */
+  if ((error = hmackey_l (&hk, Alg, (SaltLen > 0) ? Salt : Zeros, SaltLen))
+      != 0)
+    {
+      return error;
+    }
+
+  hmac_l (PRK, &hk, IKM, IKMLen);
+
+  hmacpurge_l (&hk);
+
+  return 0;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   HKDF-Expand (RFC 5869)                                        */
+/*              The HMAC key PRK is processed once for all output blocks      */
+/*  Syntax:     int hkdfexpand_l (UCHAR *OKM, ULONG OKMLen, int Alg,          */
+/*                   UCHAR *PRK, ULONG PRKLen, UCHAR *Info, ULONG InfoLen);   */
+/*  Input:      ULONG OKMLen (Length of output in bytes)                      */
+/*              int Alg (HMAC_SHA1, HMAC_SHA256 or HMAC_RMD160)               */
+/*              UCHAR *PRK (Pseudorandom key)                                 */
+/*              ULONG PRKLen (Length of PRK in bytes)                         */
+/*              UCHAR *Info (Context information, may be NULL if InfoLen 0)   */
+/*              ULONG InfoLen (Length of Info in bytes)                       */
+/*  Output:     UCHAR *OKM (Output keying material of OKMLen bytes)           */
+/*  Returns:    0 if everything is O.K.                                       */
+/*              E_HMAC_ALG if Alg is unknown                                  */
+/*              E_HMAC_LEN if OKMLen exceeds 255 times the length of a MAC    */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+hkdfexpand_l (UCHAR *OKM, ULONG OKMLen, int Alg, UCHAR *PRK, ULONG PRKLen,
+              UCHAR *Info, ULONG InfoLen)
+{
+  HMACKEY hk;
+  HMACCTX ctx;
+  UCHAR T[HMAC_MAXLEN];
+  UCHAR Counter;
+  ULONG n;
+  int error;
+
+  if ((error = hmackey_l (&hk, Alg, PRK, PRKLen)) != 0)
+    {
+      return error;
+    }
+
+  if (OKMLen > 255 * (ULONG)hk.MacLen)
+    {
+      hmacpurge_l (&hk);
+      return E_HMAC_LEN;
+    }
+
+  /* T(i) = HMAC (PRK, T(i - 1) || Info || i), T(0) empty */
+  for (Counter = 1; OKMLen > 0; Counter++)
+    {
+      hmacinit_l (&ctx, &hk);
+      if (Counter > 1)
+        {
+          hmacupdate_l (&ctx, T, (ULONG)hk.MacLen);
+        }
+      hmacupdate_l (&ctx, Info, InfoLen);
+      hmacupdate_l (&ctx, &Counter, 1);
+      hmacfinish_l (T, &ctx);
+
+      n = (OKMLen < (ULONG)hk.MacLen) ? OKMLen : (ULONG)hk.MacLen;
+      memcpy (OKM, T, n);
+      OKM += n;
+      OKMLen -= n;
+    }
+
+  hmacpurge_l (&hk);
+
+#ifdef FLINT_SECURE
+  /* Overwrite temporary variables */
+  memset (T, 0, sizeof (T));
+#endif
+
+  return 0;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   HKDF (RFC 5869): Extract followed by Expand                   */
+/*  Syntax:     int hkdf_l (UCHAR *OKM, ULONG OKMLen, int Alg,                */
+/*                   UCHAR *Salt, ULONG SaltLen, UCHAR *IKM, ULONG IKMLen,    */
+/*                   UCHAR *Info, ULONG InfoLen);                             */
+/*  Input:      See hkdfextract_l and hkdfexpand_l                            */
+/*  Output:     UCHAR *OKM (Output keying material of OKMLen bytes)           */
+/*  Returns:    0 if everything is O.K.                                       */
+/*              E_HMAC_ALG if Alg is unknown                                  */
+/*              E_HMAC_LEN if OKMLen exceeds 255 times the length of a MAC    */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+hkdf_l (UCHAR *OKM, ULONG OKMLen, int Alg, UCHAR *Salt, ULONG SaltLen,
+        UCHAR *IKM, ULONG IKMLen, UCHAR *Info, ULONG InfoLen)
+{
+  UCHAR PRK[HMAC_MAXLEN];
+  int error;
+
+  if ((error = hkdfextract_l (PRK, Alg, Salt, SaltLen, IKM, IKMLen)) == 0)
+    {
+      error = hkdfexpand_l (OKM, OKMLen, Alg, PRK, (ULONG)MacLength (Alg),
+                            Info, InfoLen);
+    }
+
+  memset (PRK, 0, sizeof (PRK));
+
+  return error;
+}
+
+
+/******************************************************************************/
+/* Dispatching to the hash functions                                          */
+/******************************************************************************/
+
+/* Length of the MAC in bytes, 0 for unknown algorithms */
+static int
+MacLength (int Alg)
+{
+  switch (Alg)
+    {
+      case HMAC_SHA1:
+      case HMAC_RMD160:
+        return 20;
+      case HMAC_SHA256:
+        return 32;
+      default:
+        return 0;
+    }
+}
+
+
+static void
+HashInit (int Alg, HMACSTAT *st)
+{
+  switch (Alg)
+    {
+      case HMAC_SHA1:
+        sha1init_l (&st->sha1);
+        break;
+      case HMAC_SHA256:
+        sha256init_l (&st->sha256);
+        break;
+      default:
+        ripeinit_l (&st->rmd160);
+        break;
+    }
+}
+
+
+/* length must be a multiple of HMAC_BLOCKLEN */
+static void
+HashBlocks (int Alg, HMACSTAT *st, UCHAR *clear, ULONG length)
+{
+  if (length == 0)
+    {
+      return;
+    }
+
+  switch (Alg)
+    {
+      case HMAC_SHA1:
+        sha1hash_l (&st->sha1, clear, length);
+        break;
+      case HMAC_SHA256:
+        sha256hash_l (&st->sha256, clear, length);
+        break;
+      default:
+        ripehash_l (&st->rmd160, clear, length);
+        break;
+    }
+}
+
+
+static void
+HashFinish (int Alg, UCHAR *HashRes, HMACSTAT *st, UCHAR *clear,
+            ULONG length)
+{
+  switch (Alg)
+    {
+      case HMAC_SHA1:
+        sha1finish_l (HashRes, &st->sha1, clear, length);
+        break;
+      case HMAC_SHA256:
+        sha256finish_l (HashRes, &st->sha256, clear, length);
+        break;
+      default:
+        ripefinish_l (HashRes, &st->rmd160, clear, length);
+        break;
+    }
+}
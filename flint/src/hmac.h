@@ -0,0 +1,158 @@
+/******************************************************************************/
+/*                                                                            */
+/* Functions for arithmetic and number theory with large integers in C        */
+/* Software supplement to the book "Cryptography in C and C++"                */
+/* by Michael Welschenbach                                                    */
+/*                                                                            */
+/* Module hmac.h           Revision: 19.10.2026                               */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 1998-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+
+#ifndef __HMACH__
+#define __HMACH__
+
+#include "sha256.h"
+#include "ripemd.h"
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/* Macros */
+
+#define HMAC_SHA1            1  /* HMAC-SHA-1, MAC of 20 bytes */
+#define HMAC_SHA256          2  /* HMAC-SHA-256, MAC of 32 bytes */
+#define HMAC_RMD160          3  /* HMAC-RIPEMD-160, MAC of 20 bytes */
+
+#define HMAC_MAXLEN         32  /* Maximum length of a MAC in bytes */
+#define HMAC_BLOCKLEN       64  /* Block length of the hash functions */
+
+#define E_HMAC_ALG          -1  /* Unknown hash algorithm */
+#define E_HMAC_LEN          -2  /* HKDF output longer than 255 hash values */
+
+/* Macros maintaining FLINT/C namespace */
+
+#define hmackey              hmackey_l
+#define hmacpurge            hmacpurge_l
+#define hmac                 hmac_l
+#define hmacinit             hmacinit_l
+#define hmacupdate           hmacupdate_l
+#define hmacfinish           hmacfinish_l
+#define hkdfextract          hkdfextract_l
+#define hkdfexpand           hkdfexpand_l
+#define hkdf                 hkdf_l
+
+
+/* Intermediate state of one of the hash functions */
+
+typedef union
+{
+  SHASTAT sha1;
+  SHA256STAT sha256;
+  RMDSTAT rmd160;
+} HMACSTAT;
+
+/* Keyed context: states after hashing the inner and the outer key pad,   */
+/* computed once by hmackey_l and copied for each message                 */
+
+typedef struct
+{
+  int Alg;                     /* HMAC_SHA1, HMAC_SHA256 or HMAC_RMD160 */
+  int MacLen;                  /* Length of the MAC in bytes */
+  HMACSTAT Inner;              /* State after K ^ ipad */
+  HMACSTAT Outer;              /* State after K ^ opad */
+} HMACKEY;
+
+/* Context for a message given in pieces of arbitrary length */
+
+typedef struct
+{
+  HMACKEY *Key;                /* Keyed context */
+  HMACSTAT State;              /* Inner hash of the message so far */
+  unsigned char Buf[HMAC_BLOCKLEN]; /* Bytes not yet forming a block */
+  unsigned long BufLen;        /* Number of bytes in Buf */
+} HMACCTX;
+
+
+/******************************************************************************/
+/* HMAC and HKDF API: Public Functions */
+
+#ifndef __FLINT_API
+#ifdef FLINT_USEDLL
+#define __FLINT_API                   __cdecl
+#else
+#define __FLINT_API                   /**/
+#endif /* FLINT_USEDLL */
+#endif /* !defined __FLINT_API */
+
+extern int __FLINT_API
+hmackey_l (HMACKEY *hk, int Alg, unsigned char *Key, unsigned long KeyLen);
+extern void __FLINT_API
+hmacpurge_l (HMACKEY *hk);
+extern void __FLINT_API
+hmac_l (unsigned char *Mac, HMACKEY *hk, unsigned char *clear,
+        unsigned long length);
+extern void __FLINT_API
+hmacinit_l (HMACCTX *ctx, HMACKEY *hk);
+extern void __FLINT_API
+hmacupdate_l (HMACCTX *ctx, unsigned char *clear, unsigned long length);
+extern void __FLINT_API
+hmacfinish_l (unsigned char *Mac, HMACCTX *ctx);
+extern int __FLINT_API
+hkdfextract_l (unsigned char *PRK, int Alg, unsigned char *Salt,
+               unsigned long SaltLen, unsigned char *IKM,
+               unsigned long IKMLen);
+extern int __FLINT_API
+hkdfexpand_l (unsigned char *OKM, unsigned long OKMLen, int Alg,
+              unsigned char *PRK, unsigned long PRKLen,
+              unsigned char *Info, unsigned long InfoLen);
+extern int __FLINT_API
+hkdf_l (unsigned char *OKM, unsigned long OKMLen, int Alg,
+        unsigned char *Salt, unsigned long SaltLen,
+        unsigned char *IKM, unsigned long IKMLen,
+        unsigned char *Info, unsigned long InfoLen);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* __HMACH__ */
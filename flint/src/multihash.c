@@ -0,0 +1,213 @@
+/******************************************************************************/
+/*                                                                            */
+/* Functions for arithmetic and number theory with large integers in C        */
+/* Software supplement to the book "Cryptography in C and C++"                */
+/* by Michael Welschenbach                                                    */
+/*                                                                            */
+/* Module multihash.c      Revision: 19.10.2026                               */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 2001-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+
+
+#include <string.h>
+#include "flint.h"
+#include "multihash.h"
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Hashing of a message with several hash functions in one pass  */
+/*  Syntax:     int multihash_l (MULTIHASHDIG *Dig, int Algs, UCHAR *clear,   */
+/*                                                   ULONG length);           */
+/*  Input:      int Algs (Hash functions, MULTIHASH_SHA1, MULTIHASH_SHA256    */
+/*                        and MULTIHASH_RMD160 combined by |)                 */
+/*              UCHAR *clear (Message)                                        */
+/*              ULONG length (Length of message in bytes)                     */
+/*  Output:     MULTIHASHDIG *Dig (Digests of the hash functions selected)    */
+/*  Returns:    0 if everything is O.K.                                       */
+/*              E_MULTIHASH_ARG if Algs is invalid                            */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+multihash_l (MULTIHASHDIG *Dig, int Algs, UCHAR *clear, ULONG length)
+{
+  MULTIHASH mh;
+  int error;
+
+  if ((error = multihashinit_l (&mh, Algs)) != 0)
+    {
+      return error;
+    }
+  multihashupdate_l (&mh, clear, length);
+  multihashfinish_l (Dig, &mh);
+
+  return 0;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Initialization of a multi-digest context                      */
+/*  Syntax:     int multihashinit_l (MULTIHASH *mh, int Algs);                */
+/*  Input:      int Algs (Hash functions, MULTIHASH_SHA1, MULTIHASH_SHA256    */
+/*                        and MULTIHASH_RMD160 combined by |)                 */
+/*  Output:     MULTIHASH *mh (Context)                                       */
+/*  Returns:    0 if everything is O.K.                                       */
+/*              E_MULTIHASH_ARG if Algs is invalid                            */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+multihashinit_l (MULTIHASH *mh, int Algs)
+{
+  if (Algs <= 0 || (Algs & ~MULTIHASH_ALL) != 0)
+    {
+      return E_MULTIHASH_ARG;
+    }
+
+  mh->Algs = Algs;
+  sha1init_l (&mh->Sha1);
+  sha256init_l (&mh->Sha256);
+  ripeinit_l (&mh->Rmd160);
+  mh->BufLen = 0;
+
+  return 0;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Hashing of a piece of a message with all hash functions of    */
+/*              the context. The message is scheduled block by block: each    */
+/*              complete block is passed to all selected hash functions in    */
+/*              turn, so it is read from memory once and found in the L1      */
+/*              cache by the later functions. Complete blocks are taken from  */
+/*              the piece without copying                                     */
+/*  Syntax:     void multihashupdate_l (MULTIHASH *mh, UCHAR *clear,          */
+/*                                                      ULONG length);        */
+/*  Input:      MULTIHASH *mh (Context)                                       */
+/*              UCHAR *clear (Piece of the message)                           */
+/*              ULONG length (Length of the piece in bytes, arbitrary)        */
+/*  Output:     MULTIHASH *mh (Context)                                       */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+void __FLINT_API
+multihashupdate_l (MULTIHASH *mh, UCHAR *clear, ULONG length)
+{
+  UCHAR *block;
+  ULONG n;
+
+  while (length > 0)
+    {
+      if (mh->BufLen == 0 && length >= 64)
+        {
+          /* Complete block directly from the piece */
+          block = clear;
+          n = 64;
+        }
+      else
+        {
+          /* Partial block collected in the buffer */
+          n = 64 - mh->BufLen;
+          if (n > length)
+            {
+              n = length;
+            }
+          memcpy (mh->Buf + mh->BufLen, clear, n);
+          mh->BufLen += n;
+          if (mh->BufLen < 64)
+            {
+              return;
+            }
+          block = mh->Buf;
+          mh->BufLen = 0;
+        }
+      clear += n;
+      length -= n;
+
+      if (mh->Algs & MULTIHASH_SHA1)
+        {
+          sha1hash_l (&mh->Sha1, block, 64);
+        }
+      if (mh->Algs & MULTIHASH_SHA256)
+        {
+          sha256hash_l (&mh->Sha256, block, 64);
+        }
+      if (mh->Algs & MULTIHASH_RMD160)
+        {
+          ripehash_l (&mh->Rmd160, block, 64);
+        }
+    }
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Output of the digests of a multi-digest context               */
+/*  Syntax:     void multihashfinish_l (MULTIHASHDIG *Dig, MULTIHASH *mh);    */
+/*  Input:      MULTIHASH *mh (Context)                                       */
+/*  Output:     MULTIHASHDIG *Dig (Digests, zero if not selected)             */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+void __FLINT_API
+multihashfinish_l (MULTIHASHDIG *Dig, MULTIHASH *mh)
+{
+  memset (Dig, 0, sizeof (MULTIHASHDIG));
+
+  if (mh->Algs & MULTIHASH_SHA1)
+    {
+      sha1finish_l (Dig->Sha1, &mh->Sha1, mh->Buf, mh->BufLen);
+    }
+  if (mh->Algs & MULTIHASH_SHA256)
+    {
+      sha256finish_l (Dig->Sha256, &mh->Sha256, mh->Buf, mh->BufLen);
+    }
+  if (mh->Algs & MULTIHASH_RMD160)
+    {
+      ripefinish_l (Dig->Rmd160, &mh->Rmd160, mh->Buf, mh->BufLen);
+    }
+
+#ifdef FLINT_SECURE
+  memset (mh, 0, sizeof (MULTIHASH));
+#endif
+}
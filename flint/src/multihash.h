@@ -0,0 +1,126 @@
+/******************************************************************************/
+/*                                                                            */
+/* Functions for arithmetic and number theory with large integers in C        */
+/* Software supplement to the book "Cryptography in C and C++"                */
+/* by Michael Welschenbach                                                    */
+/*                                                                            */
+/* Module multihash.h      Revision: 19.10.2026                               */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 1998-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+
+#ifndef __MULTIHASHH__
+#define __MULTIHASHH__
+
+#include "sha256.h"
+#include "ripemd.h"
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/* Macros */
+
+/* Hash functions computed together, to be combined by | */
+
+#define MULTIHASH_SHA1       0x01
+#define MULTIHASH_SHA256     0x02
+#define MULTIHASH_RMD160     0x04
+#define MULTIHASH_ALL        0x07
+
+#define E_MULTIHASH_ARG     -1  /* No or unknown hash function */
+
+/* Macros maintaining FLINT/C namespace */
+
+#define multihash            multihash_l
+#define multihashinit        multihashinit_l
+#define multihashupdate      multihashupdate_l
+#define multihashfinish      multihashfinish_l
+
+
+/* Digests, digests of hash functions not selected are zero */
+
+typedef struct
+{
+  unsigned char Sha1[20];
+  unsigned char Sha256[32];
+  unsigned char Rmd160[20];
+} MULTIHASHDIG;
+
+/* Context for a message given in pieces of arbitrary length */
+
+typedef struct
+{
+  int Algs;                    /* Hash functions selected */
+  SHASTAT Sha1;
+  SHA256STAT Sha256;
+  RMDSTAT Rmd160;
+  unsigned char Buf[64];       /* Bytes not yet forming a block */
+  unsigned long BufLen;        /* Number of bytes in Buf */
+} MULTIHASH;
+
+
+/******************************************************************************/
+/* Multi-digest API: Public Functions */
+
+#ifndef __FLINT_API
+#ifdef FLINT_USEDLL
+#define __FLINT_API                   __cdecl
+#else
+#define __FLINT_API                   /**/
+#endif /* FLINT_USEDLL */
+#endif /* !defined __FLINT_API */
+
+extern int __FLINT_API
+multihash_l (MULTIHASHDIG *Dig, int Algs, unsigned char *clear,
+             unsigned long length);
+extern int __FLINT_API
+multihashinit_l (MULTIHASH *mh, int Algs);
+extern void __FLINT_API
+multihashupdate_l (MULTIHASH *mh, unsigned char *clear, unsigned long length);
+extern void __FLINT_API
+multihashfinish_l (MULTIHASHDIG *Dig, MULTIHASH *mh);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* __MULTIHASHH__ */
@@ -0,0 +1,730 @@
+/******************************************************************************/
+/*                                                                            */
+/* Functions for arithmetic and number theory with large integers in C        */
+/* Software supplement to the book "Cryptography in C and C++"                */
+/* by Michael Welschenbach                                                    */
+/*                                                                            */
+/* Module primepar.c       Revision: 19.10.2026                               */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 1998-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+
+/* POSIX threads */
+#define _XOPEN_SOURCE 600
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "flint.h"
+#include "primepar.h"
+
+
+/* Macros */
+
+/* Odd small primes used for sieving, the largest one is 65521 */
+#define SIEVEPRIMES   (NOOFSMALLPRIMES - 1)
+
+/* Length of the seed taken from the caller's PRNG */
+#define SEEDLEN       32
+
+#define NOATTEMPT     ((ULONG)-1)  /* No attempt succeeded yet */
+
+
+/* Types */
+
+/* State shared by the threads searching a prime p with pmin <= p <= pmax,  */
+/* p = c mod m and gcd (p - 1, f) = 1, where m = 2q and c is odd. The       */
+/* candidates are First + j*m, 0 <= j <= Last.                              */
+typedef struct
+{
+  CLINT First_l;               /* Smallest candidate >= pmin */
+  CLINT Last_l;                /* Number of candidates - 1 */
+  CLINT m_l;                   /* Distance of consecutive candidates */
+  CLINT f_l;                   /* Number coprime to p - 1 */
+  CLINT p_l;                   /* Prime found */
+  USHORT q[SIEVEPRIMES];       /* Odd small primes */
+  USHORT minv[SIEVEPRIMES];    /* m^-1 mod q[i], 0 if q[i] divides m */
+  UCHAR Seed[SEEDLEN];         /* Seed taken from the caller's PRNG */
+  int Sieve;                   /* Candidates are sieved by q[] */
+  int Cover;                   /* One window covers all candidates */
+  int Mode;                    /* PRIMEPAR_FIRST or PRIMEPAR_DETERMINISTIC */
+  ULONG Next;                  /* Next attempt to be taken */
+  ULONG Limit;                 /* Number of attempts */
+  ULONG Best;                  /* Successful attempt, NOATTEMPT if none */
+  pthread_mutex_t Lock;
+} SEARCH;
+
+
+/* Prototypes */
+
+static int Prepare (SEARCH *s, STATEPRNG *xrstate, CLINT pmin_l,
+                    CLINT pmax_l, CLINT a_l, CLINT q_l, CLINT f_l, int Mode);
+static int RunSearch (SEARCH *s, int Threads);
+static void *Worker (void *arg);
+static void Attempt (SEARCH *s, ULONG k, UCHAR *sieve);
+static int Cancelled (SEARCH *s, ULONG k);
+static USHORT InvMod (USHORT a, USHORT q);
+static void *local_memset (void *ptr, int val, size_t len);
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Parallel search of a random prime p_l w/ 2^(l-1) <= p_l < 2^l */
+/*  Syntax:     int FindPrimePar_l (CLINT p_l, STATEPRNG *xrstate, USHORT l,  */
+/*                                                  int Threads, int Mode);   */
+/*  Input:      STATEPRNG *xrstate (Initialized state of PRNG)                */
+/*              USHORT l (Number of binary digits of p_l)                     */
+/*              int Threads (Number of threads, 0: number of processors)      */
+/*              int Mode (PRIMEPAR_FIRST or PRIMEPAR_DETERMINISTIC)           */
+/*  Output:     CLINT p_l (Random prime, determined with MR-Test)             */
+/*              STATEPRNG *xrstate (State of PRNG)                            */
+/*  Returns:    E_CLINT_OK if everything is OK                                */
+/*              E_CLINT_RGE if l = 0 or l > CLINTMAXBIT or Mode is invalid    */
+/*              E_CLINT_RNG if choice of generator in xrstate is invalid      */
+/*              E_CLINT_RIN if PRNG is not initialized                        */
+/*              E_CLINT_MAL if allocation of memory failed                    */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+FindPrimePar_l (CLINT p_l, STATEPRNG *xrstate, USHORT l, int Threads,
+                int Mode)
+{
+  CLINT rmin_l, rmax_l;
+
+  if (0 == l || l > CLINTMAXBIT)
+    {
+      return E_CLINT_RGE;
+    }
+
+  /* rmin_l <- 2^(l-1), rmax_l <- 2^l - 1 */
+  SETZERO_L (rmin_l);
+  setbit_l (rmin_l, l - 1);
+  cpy_l (rmax_l, rmin_l);
+  dec_l (rmax_l);
+  add_l (rmax_l, rmin_l, rmax_l);
+
+  return ExtendPrimePar_l (p_l, xrstate, rmin_l, rmax_l, one_l, one_l, one_l,
+                           Threads, Mode);
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Parallel search of a random prime p_l w/ rmin_l <= p_l <=     */
+/*              rmax_l and gcd (p_l - 1, f_l) = 1                             */
+/*  Syntax:     int FindPrimeMinMaxGcdPar_l (CLINT p_l, STATEPRNG *xrstate,   */
+/*                          CLINT rmin_l, CLINT rmax_l, CLINT f_l,            */
+/*                          int Threads, int Mode);                           */
+/*  Input:      STATEPRNG *xrstate (Initialized state of PRNG)                */
+/*              CLINT rmin_l, rmax_l (Bounds for p_l)                         */
+/*              CLINT f_l (Odd number coprime to p_l - 1)                     */
+/*              int Threads (Number of threads, 0: number of processors)      */
+/*              int Mode (PRIMEPAR_FIRST or PRIMEPAR_DETERMINISTIC)           */
+/*  Output:     CLINT p_l (Random prime, determined with MR-Test)             */
+/*              STATEPRNG *xrstate (State of PRNG)                            */
+/*  Returns:    E_CLINT_OK if everything is OK                                */
+/*              E_CLINT_RGE if rmin_l > rmax_l or f_l is even or Mode is      */
+/*                          invalid or no prime could be found                */
+/*              E_CLINT_RNG if choice of generator in xrstate is invalid      */
+/*              E_CLINT_RIN if PRNG is not initialized                        */
+/*              E_CLINT_MAL if allocation of memory failed                    */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+FindPrimeMinMaxGcdPar_l (CLINT p_l, STATEPRNG *xrstate, CLINT rmin_l,
+                         CLINT rmax_l, CLINT f_l, int Threads, int Mode)
+{
+  return ExtendPrimePar_l (p_l, xrstate, rmin_l, rmax_l, one_l, one_l, f_l,
+                           Threads, Mode);
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Parallel search of a random prime p_l w/ pmin_l <= p_l <=     */
+/*              pmax_l, p_l = a_l mod q_l and gcd (p_l - 1, f_l) = 1          */
+/*  Syntax:     int ExtendPrimePar_l (CLINT p_l, STATEPRNG *xrstate,          */
+/*                          CLINT pmin_l, CLINT pmax_l, CLINT a_l,            */
+/*                          CLINT q_l, CLINT f_l, int Threads, int Mode);     */
+/*  Input:      STATEPRNG *xrstate (Initialized state of PRNG)                */
+/*              CLINT pmin_l, pmax_l (Bounds for p_l)                         */
+/*              CLINT a_l, q_l (Odd q_l, a_l mod q_l != 0 unless q_l = 1)     */
+/*              CLINT f_l (Odd number coprime to p_l - 1)                     */
+/*              int Threads (Number of threads, 0: number of processors)      */
+/*              int Mode (PRIMEPAR_FIRST or PRIMEPAR_DETERMINISTIC)           */
+/*  Output:     CLINT p_l (Random prime, determined with MR-Test)             */
+/*              STATEPRNG *xrstate (State of PRNG)                            */
+/*  Returns:    E_CLINT_OK if everything is OK                                */
+/*              E_CLINT_RGE if the parameters are invalid or no prime could   */
+/*                          be found                                          */
+/*              E_CLINT_RNG if choice of generator in xrstate is invalid      */
+/*              E_CLINT_RIN if PRNG is not initialized                        */
+/*              E_CLINT_MAL if allocation of memory failed                    */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+ExtendPrimePar_l (CLINT p_l, STATEPRNG *xrstate, CLINT pmin_l, CLINT pmax_l,
+                  CLINT a_l, CLINT q_l, CLINT f_l, int Threads, int Mode)
+{
+  SEARCH *s;
+  int error;
+
+  if ((s = (SEARCH *)malloc (sizeof (SEARCH))) == NULL)
+    {
+      return E_CLINT_MAL;
+    }
+
+  error = Prepare (s, xrstate, pmin_l, pmax_l, a_l, q_l, f_l, Mode);
+  if (E_CLINT_OK == error)
+    {
+      error = RunSearch (s, Threads);
+    }
+  if (E_CLINT_OK == error)
+    {
+      cpy_l (p_l, s->p_l);
+    }
+
+  local_memset (s, 0, sizeof (SEARCH));
+  free (s);
+
+  return error;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Parallel search of a strong prime p_l w/ pmin_l <= p_l <=     */
+/*              pmax_l and gcd (p_l - 1, f_l) = 1 and primes r, s, t with     */
+/*              r | p_l - 1, t | r - 1, s | p_l + 1, as StrongPrime ()        */
+/*  Syntax:     int StrongPrimePar_l (CLINT p_l, STATEPRNG *xrstate,          */
+/*                          CLINT pmin_l, CLINT pmax_l, USHORT lt, USHORT lr, */
+/*                          USHORT ls, CLINT f_l, int Threads, int Mode);     */
+/*  Input:      STATEPRNG *xrstate (Initialized state of PRNG)                */
+/*              CLINT pmin_l, pmax_l (Bounds for p_l)                         */
+/*              USHORT lt, lr, ls (Lengths of t, r and s)                     */
+/*              CLINT f_l (Odd number coprime to p_l - 1)                     */
+/*              int Threads (Number of threads, 0: number of processors)      */
+/*              int Mode (PRIMEPAR_FIRST or PRIMEPAR_DETERMINISTIC)           */
+/*  Output:     CLINT p_l (Random strong prime, determined with MR-Test)      */
+/*              STATEPRNG *xrstate (State of PRNG)                            */
+/*  Returns:    E_CLINT_OK if everything is OK                                */
+/*              E_CLINT_RGE if the parameters are invalid or no prime could   */
+/*                          be found                                          */
+/*              E_CLINT_RNG if choice of generator in xrstate is invalid      */
+/*              E_CLINT_RIN if PRNG is not initialized                        */
+/*              E_CLINT_MAL if allocation of memory failed                    */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+StrongPrimePar_l (CLINT p_l, STATEPRNG *xrstate, CLINT pmin_l, CLINT pmax_l,
+                  USHORT lt, USHORT lr, USHORT ls, CLINT f_l, int Threads,
+                  int Mode)
+{
+  CLINT t_l, r_l, s_l, rs_l, x_l, g_l, rmin_l, rmax_l;
+  int error;
+
+  if (0 == lt || 0 == lr || 0 == ls ||
+      lt > CLINTMAXBIT || lr > CLINTMAXBIT || ls > CLINTMAXBIT)
+    {
+      return E_CLINT_RGE;
+    }
+
+  SETZERO_L (rmin_l);
+  setbit_l (rmin_l, lr - 1);
+  cpy_l (rmax_l, rmin_l);
+  dec_l (rmax_l);
+  add_l (rmax_l, rmin_l, rmax_l);
+
+  /* t prime, r = 1 mod 2t prime, s prime */
+  error = FindPrimePar_l (t_l, xrstate, lt, Threads, Mode);
+  if (E_CLINT_OK == error)
+    {
+      error = ExtendPrimePar_l (r_l, xrstate, rmin_l, rmax_l, one_l, t_l,
+                                one_l, Threads, Mode);
+    }
+  if (E_CLINT_OK == error)
+    {
+      error = FindPrimePar_l (s_l, xrstate, ls, Threads, Mode);
+    }
+
+  if (E_CLINT_OK == error)
+    {
+      /* x_l <- 1 - 2*(r^-1 mod s)*r mod rs, hence x_l = 1 mod r and */
+      /* x_l = -1 mod s                                              */
+      inv_l (r_l, s_l, g_l, x_l);
+      if (!EQONE_L (g_l))
+        {
+          error = E_CLINT_RGE;
+        }
+      else
+        {
+          mul_l (x_l, r_l, x_l);
+          shl_l (x_l);
+          mul_l (r_l, s_l, rs_l);
+          msub_l (one_l, x_l, x_l, rs_l);
+
+          error = ExtendPrimePar_l (p_l, xrstate, pmin_l, pmax_l, x_l, rs_l,
+                                    f_l, Threads, Mode);
+        }
+    }
+
+  /* Purging of variables */
+  local_memset (t_l, 0, sizeof (t_l));
+  local_memset (r_l, 0, sizeof (r_l));
+  local_memset (s_l, 0, sizeof (s_l));
+  local_memset (rs_l, 0, sizeof (rs_l));
+  local_memset (x_l, 0, sizeof (x_l));
+
+  return error;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Preparation of a search: candidates, small primes, number of  */
+/*              attempts and the seed for the attempts' PRNG streams          */
+/*  Syntax:     static int Prepare (SEARCH *s, STATEPRNG *xrstate,            */
+/*                          CLINT pmin_l, CLINT pmax_l, CLINT a_l, CLINT q_l, */
+/*                          CLINT f_l, int Mode);                             */
+/*  Input:      Parameters of ExtendPrimePar_l                                */
+/*  Output:     SEARCH *s (State of the search)                               */
+/*              STATEPRNG *xrstate (State of PRNG)                            */
+/*  Returns:    E_CLINT_OK if everything is OK                                */
+/*              E_CLINT_RGE if the parameters are invalid                     */
+/*              E_CLINT_RNG, E_CLINT_RIN errors of the PRNG                   */
+/*                                                                            */
+/******************************************************************************/
+static int
+Prepare (SEARCH *s, STATEPRNG *xrstate, CLINT pmin_l, CLINT pmax_l,
+         CLINT a_l, CLINT q_l, CLINT f_l, int Mode)
+{
+  CLINT c_l, t_l, junk_l, Pi_min_l, Pi_max_l;
+  USHORT qv, e;
+  unsigned int i;
+
+  if ((Mode != PRIMEPAR_FIRST && Mode != PRIMEPAR_DETERMINISTIC) ||
+      GT_L (pmin_l, pmax_l) || ISEVEN_L (q_l) || ISEVEN_L (f_l))
+    {
+      return E_CLINT_RGE;
+    }
+
+  /* c_l <- odd representative of a_l mod q_l modulo m = 2*q_l */
+  mod_l (a_l, q_l, c_l);
+  if (EQZ_L (c_l) && !EQONE_L (q_l))
+    {
+      return E_CLINT_RGE;
+    }
+  if (ISEVEN_L (c_l))
+    {
+      add_l (c_l, q_l, c_l);
+    }
+  cpy_l (s->m_l, q_l);
+  shl_l (s->m_l);
+
+  /* First_l <- smallest c_l + j*m >= pmin_l */
+  if (GT_L (pmin_l, c_l))
+    {
+      sub_l (pmin_l, c_l, t_l);
+      div_l (t_l, s->m_l, t_l, junk_l);
+      if (GTZ_L (junk_l))
+        {
+          inc_l (t_l);
+        }
+      mul_l (t_l, s->m_l, t_l);
+      add_l (c_l, t_l, s->First_l);
+    }
+  else
+    {
+      cpy_l (s->First_l, c_l);
+    }
+
+  if (GT_L (s->First_l, pmax_l))
+    {
+      return E_CLINT_RGE;
+    }
+
+  sub_l (pmax_l, s->First_l, t_l);
+  div_l (t_l, s->m_l, s->Last_l, junk_l);
+  cpy_l (s->f_l, f_l);
+
+  /* One attempt if a window covers all candidates, else the estimated */
+  /* number of primes between pmin_l and pmax_l, cf. FindPrimeMinMaxGcd_l */
+  u2clint_l (t_l, PRIMEPAR_WINDOW);
+  s->Cover = LT_L (s->Last_l, t_l);
+  if (s->Cover)
+    {
+      s->Limit = 1;
+    }
+  else
+    {
+      udiv_l (pmin_l, (USHORT)MAX (ld_l (pmin_l), 1), Pi_min_l, junk_l);
+      udiv_l (pmax_l, (USHORT)ld_l (pmax_l), Pi_max_l, junk_l);
+      sub_l (Pi_max_l, Pi_min_l, t_l);
+      ul2clint_l (junk_l, PRIMEPAR_MAXATTEMPTS);
+      if (GT_L (t_l, junk_l))
+        {
+          s->Limit = PRIMEPAR_MAXATTEMPTS;
+        }
+      else
+        {
+          for (s->Limit = 0, i = DIGITS_L (t_l); i > 0; i--)
+            {
+              s->Limit = (s->Limit << BITPERDGT) + t_l[i];
+            }
+          s->Limit = MAX (s->Limit, 1);
+        }
+    }
+
+  /* Odd small primes and inverses of m modulo these */
+  for (qv = 2, i = 0; i < SIEVEPRIMES; i++)
+    {
+      qv += smallprimes[i + 1];
+      s->q[i] = qv;
+      e = umod_l (s->m_l, qv);
+      s->minv[i] = (0 == e) ? 0 : InvMod (e, qv);
+    }
+
+  /* Sieving requires that no candidate equals one of the primes q[i] */
+  u2clint_l (t_l, s->q[SIEVEPRIMES - 1]);
+  s->Sieve = GT_L (s->First_l, t_l);
+
+  s->Mode = Mode;
+  s->Next = 0;
+  s->Best = NOATTEMPT;
+
+  return RandBytes_l (s->Seed, SEEDLEN, xrstate);
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Run of a search by a pool of threads                          */
+/*              The calling thread takes part as one of the workers. If       */
+/*              fewer threads can be started, the others do their work        */
+/*  Syntax:     static int RunSearch (SEARCH *s, int Threads);                */
+/*  Input:      SEARCH *s (State of the search)                               */
+/*              int Threads (Number of threads, 0: number of processors)      */
+/*  Output:     s->p_l (Prime found)                                          */
+/*  Returns:    E_CLINT_OK if a prime was found                               */
+/*              E_CLINT_RGE if no prime was found                             */
+/*                                                                            */
+/******************************************************************************/
+static int
+RunSearch (SEARCH *s, int Threads)
+{
+  pthread_t Tid[PRIMEPAR_MAXTHREADS];
+  int i, started;
+
+  if (Threads <= 0)
+    {
+#ifdef _SC_NPROCESSORS_ONLN
+      Threads = (int)sysconf (_SC_NPROCESSORS_ONLN);
+#endif
+      if (Threads <= 0)
+        {
+          Threads = 1;
+        }
+    }
+  if (Threads > PRIMEPAR_MAXTHREADS)
+    {
+      Threads = PRIMEPAR_MAXTHREADS;
+    }
+  if ((ULONG)Threads > s->Limit)
+    {
+      Threads = (int)s->Limit;
+    }
+
+  pthread_mutex_init (&s->Lock, NULL);
+
+  for (started = 0; started < Threads - 1; started++)
+    {
+      if (pthread_create (&Tid[started], NULL, Worker, s) != 0)
+        {
+          break;
+        }
+    }
+
+  Worker (s);
+
+  for (i = 0; i < started; i++)
+    {
+      pthread_join (Tid[i], NULL);
+    }
+
+  pthread_mutex_destroy (&s->Lock);
+
+  return (NOATTEMPT == s->Best) ? E_CLINT_RGE : E_CLINT_OK;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Worker of the thread pool                                     */
+/*              Takes the next attempt until the attempts are used up or an   */
+/*              attempt succeeded. All attempts below a successful one have   */
+/*              been taken before, so they are done when all workers return   */
+/*  Syntax:     static void *Worker (void *arg);                              */
+/*  Input:      void *arg (Pointer to SEARCH)                                 */
+/*  Output:     Result of the successful attempt in SEARCH                    */
+/*  Returns:    NULL                                                          */
+/*                                                                            */
+/******************************************************************************/
+static void *
+Worker (void *arg)
+{
+  SEARCH *s = (SEARCH *)arg;
+  UCHAR sieve[PRIMEPAR_WINDOW];
+  ULONG k;
+
+  for (;;)
+    {
+      pthread_mutex_lock (&s->Lock);
+      k = s->Next;
+      if (k >= s->Limit || s->Best != NOATTEMPT)
+        {
+          pthread_mutex_unlock (&s->Lock);
+          break;
+        }
+      s->Next++;
+      pthread_mutex_unlock (&s->Lock);
+
+      Attempt (s, k, sieve);
+    }
+
+  local_memset (sieve, 0, sizeof (sieve));
+
+  return NULL;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Attempt k of a search: Up to PRIMEPAR_WINDOW candidates from  */
+/*              a random start are sieved by the small primes and the         */
+/*              remaining ones tested in ascending order. The random start    */
+/*              depends on the seed of the search and on k only               */
+/*  Syntax:     static void Attempt (SEARCH *s, ULONG k, UCHAR *sieve);       */
+/*  Input:      SEARCH *s (State of the search)                               */
+/*              ULONG k (Number of the attempt)                               */
+/*              UCHAR *sieve (Buffer of PRIMEPAR_WINDOW bytes)                */
+/*  Output:     s->p_l and s->Best, if a prime was found                      */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+static void
+Attempt (SEARCH *s, ULONG k, UCHAR *sieve)
+{
+  STATEPRNG S;
+  UCHAR Seed[SEEDLEN + 4];
+  CLINT base_l, t_l, p_l, g_l;
+  USHORT r, q;
+  ULONG j, n;
+  unsigned int i;
+  int found = 0;
+
+  memcpy (Seed, s->Seed, SEEDLEN);
+  Seed[SEEDLEN] = (UCHAR)(k >> 24);
+  Seed[SEEDLEN + 1] = (UCHAR)(k >> 16);
+  Seed[SEEDLEN + 2] = (UCHAR)(k >> 8);
+  Seed[SEEDLEN + 3] = (UCHAR)k;
+  S.Generator = FLINT_RNDRMDSHA1;
+  SeedRandRMDSHA1_l (&S.StateRMDSHA1, Seed, SEEDLEN + 4);
+
+  /* Random offset 0 <= t_l <= Last_l, 64 surplus bits keep the bias of */
+  /* the reduction negligible                                           */
+  if (s->Cover)
+    {
+      SETZERO_L (t_l);
+    }
+  else
+    {
+      Rand_l (t_l, &S, MIN (ld_l (s->Last_l) + 64, (int)CLINTMAXBIT));
+      cpy_l (g_l, s->Last_l);
+      inc_l (g_l);
+      mod_l (t_l, g_l, t_l);
+    }
+
+  /* base_l <- First_l + t_l*m, n <- number of candidates from base_l on */
+  mul_l (t_l, s->m_l, g_l);
+  add_l (s->First_l, g_l, base_l);
+  sub_l (s->Last_l, t_l, t_l);
+  if (DIGITS_L (t_l) > 1 ||
+      (DIGITS_L (t_l) == 1 && *LSDPTR_L (t_l) >= PRIMEPAR_WINDOW))
+    {
+      n = PRIMEPAR_WINDOW;
+    }
+  else
+    {
+      n = EQZ_L (t_l) ? 1 : (ULONG)*LSDPTR_L (t_l) + 1;
+    }
+
+  /* Mark base_l + j*m if it is divisible by q: j = -r*m^-1 mod q, */
+  /* if q divides m all candidates have the same residue r         */
+  memset (sieve, 0, n);
+  for (i = 0; i < SIEVEPRIMES && s->Sieve; i++)
+    {
+      q = s->q[i];
+      r = umod_l (base_l, q);
+      if (0 == s->minv[i])
+        {
+          if (0 == r)
+            {
+              memset (sieve, 1, n);
+            }
+          continue;
+        }
+      for (j = (0 == r) ? 0 : ((ULONG)(q - r) * s->minv[i]) % q; j < n; j += q)
+        {
+          sieve[j] = 1;
+        }
+    }
+
+  for (j = 0; j < n && !found; j++)
+    {
+      if (sieve[j])
+        {
+          continue;
+        }
+
+      if (Cancelled (s, k))
+        {
+          break;
+        }
+
+      umul_l (s->m_l, (USHORT)j, t_l);
+      add_l (base_l, t_l, p_l);
+
+      cpy_l (g_l, p_l);
+      dec_l (g_l);
+      gcd_l (g_l, s->f_l, g_l);
+
+      /* Trial division is already done if the candidates were sieved */
+      found = EQONE_L (g_l) && prime_l (p_l, s->Sieve ? 1 : 302, 0);
+    }
+
+  if (found)
+    {
+      pthread_mutex_lock (&s->Lock);
+      if (k < s->Best)
+        {
+          s->Best = k;
+          cpy_l (s->p_l, p_l);
+        }
+      pthread_mutex_unlock (&s->Lock);
+    }
+
+  /* Purging of variables */
+  PurgeRand_l (&S);
+  local_memset (Seed, 0, sizeof (Seed));
+  local_memset (base_l, 0, sizeof (base_l));
+  local_memset (t_l, 0, sizeof (t_l));
+  local_memset (p_l, 0, sizeof (p_l));
+  local_memset (g_l, 0, sizeof (g_l));
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Test whether attempt k is obsolete: in mode PRIMEPAR_FIRST if */
+/*              any attempt succeeded, in mode PRIMEPAR_DETERMINISTIC if an   */
+/*              attempt with a lower number succeeded                         */
+/*  Syntax:     static int Cancelled (SEARCH *s, ULONG k);                    */
+/*  Input:      SEARCH *s (State of the search)                               */
+/*              ULONG k (Number of the attempt)                               */
+/*  Output:     -                                                             */
+/*  Returns:    1 if attempt k is obsolete, 0 else                            */
+/*                                                                            */
+/******************************************************************************/
+static int
+Cancelled (SEARCH *s, ULONG k)
+{
+  int c;
+
+  pthread_mutex_lock (&s->Lock);
+  c = (s->Best != NOATTEMPT) &&
+      (PRIMEPAR_FIRST == s->Mode || s->Best < k);
+  pthread_mutex_unlock (&s->Lock);
+
+  return c;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Inverse of a modulo an odd prime q by the extended Euclidean  */
+/*              algorithm                                                     */
+/*  Syntax:     static USHORT InvMod (USHORT a, USHORT q);                    */
+/*  Input:      USHORT a (0 < a < q), USHORT q (Prime)                        */
+/*  Output:     -                                                             */
+/*  Returns:    a^-1 mod q                                                    */
+/*                                                                            */
+/******************************************************************************/
+static USHORT
+InvMod (USHORT a, USHORT q)
+{
+  long u = 1, v = 0, t, x = a, y = q, w;
+
+  while (y != 0)
+    {
+      w = x / y;
+      t = u - w * v;
+      u = v;
+      v = t;
+      t = x - w * y;
+      x = y;
+      y = t;
+    }
+
+  return (USHORT)((u < 0) ? u + q : u);
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/* Local memset-Function, does the same as memset()                           */
+/* Needed to make compiler purge variables in spite of optimization.          */
+/*                                                                            */
+/******************************************************************************/
+static void *
+local_memset (void *ptr, int val, size_t len)
+{
+  return memset (ptr, val, len);
+}
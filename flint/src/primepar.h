@@ -0,0 +1,107 @@
+/******************************************************************************/
+/*                                                                            */
+/* Functions for arithmetic and number theory with large integers in C        */
+/* Software supplement to the book "Cryptography in C and C++"                */
+/* by Michael Welschenbach                                                    */
+/*                                                                            */
+/* Module primepar.h       Revision: 19.10.2026                               */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 1998-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+
+#ifndef __PRIMEPARH__
+#define __PRIMEPARH__
+
+#include "random.h"
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/* Macros */
+
+/* A parallel prime search is divided into attempts 0, 1, 2, ... Attempt k  */
+/* starts at a random point in the range, drawn from a RandRMDSHA1 stream   */
+/* seeded with k and with a seed taken once from the caller's PRNG, and     */
+/* sieves up to PRIMEPAR_WINDOW candidates. The threads take the attempts   */
+/* in ascending order. In mode PRIMEPAR_FIRST the prime of the attempt that */
+/* succeeds first is returned and all other attempts are cancelled. In mode */
+/* PRIMEPAR_DETERMINISTIC the prime of the successful attempt with the      */
+/* lowest number is returned; it depends on the state of the caller's PRNG  */
+/* only, not on the number of threads or on their timing.                   */
+
+#define PRIMEPAR_FIRST           0  /* First prime found by any thread */
+#define PRIMEPAR_DETERMINISTIC   1  /* Reproducible result */
+
+#define PRIMEPAR_WINDOW       1024  /* Candidates per attempt */
+#define PRIMEPAR_MAXTHREADS     64  /* Maximum number of threads */
+#define PRIMEPAR_MAXATTEMPTS  (1UL << 20)  /* Maximum number of attempts */
+
+
+/******************************************************************************/
+/* Parallel prime search API: Public Functions */
+
+#ifndef __FLINT_API
+#ifdef FLINT_USEDLL
+#define __FLINT_API                   __cdecl
+#else
+#define __FLINT_API                   /**/
+#endif /* FLINT_USEDLL */
+#endif /* !defined __FLINT_API */
+
+extern int __FLINT_API
+FindPrimePar_l (CLINT p_l, STATEPRNG *xrstate, USHORT l, int Threads,
+                int Mode);
+extern int __FLINT_API
+FindPrimeMinMaxGcdPar_l (CLINT p_l, STATEPRNG *xrstate, CLINT rmin_l,
+                         CLINT rmax_l, CLINT f_l, int Threads, int Mode);
+extern int __FLINT_API
+ExtendPrimePar_l (CLINT p_l, STATEPRNG *xrstate, CLINT pmin_l, CLINT pmax_l,
+                  CLINT a_l, CLINT q_l, CLINT f_l, int Threads, int Mode);
+extern int __FLINT_API
+StrongPrimePar_l (CLINT p_l, STATEPRNG *xrstate, CLINT pmin_l, CLINT pmax_l,
+                  USHORT lt, USHORT lr, USHORT ls, CLINT f_l, int Threads,
+                  int Mode);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* __PRIMEPARH__ */
@@ -0,0 +1,245 @@
+//*****************************************************************************/
+//                                                                            */
+// Software supplement to the book "Cryptography in C and C++"                */
+// by Michael Welschenbach, published by Apress Berkeley CA, 2001,2005        */
+//                                                                            */
+// Module primeparpp.cpp   Revision: 19.10.2026                               */
+//                                                                            */
+//  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+//  Copyright (C) 1998-2005 by Springer-Verlag Berlin, Heidelberg             */
+//  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+//  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+//  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+//  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+//  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+//                                                                            */
+//  All Rights Reserved                                                       */
+//                                                                            */
+//  The software may be used for noncommercial purposes and may be altered,   */
+//  as long as the following conditions are accepted without any              */
+//  qualification:                                                            */
+//                                                                            */
+//  (1) All changes to the sources must be identified in such a way that the  */
+//      changed software cannot be misinterpreted as the original software.   */
+//                                                                            */
+//  (2) The statements of copyright may not be removed or altered.            */
+//                                                                            */
+//  (3) The following DISCLAIMER is accepted:                                 */
+//                                                                            */
+//  DISCLAIMER:                                                               */
+//                                                                            */
+//  There is no warranty for the software contained in this distribution, to  */
+//  the extent permitted by applicable law. The copyright holders provide the */
+//  software `as is' without warranty of any kind, either expressed or        */
+//  implied, including, but not limited to, the implied warranty of fitness   */
+//  for a particular purpose. The entire risk as to the quality and           */
+//  performance of the program is with you.                                   */
+//                                                                            */
+//  In no event unless required by applicable law or agreed to in writing     */
+//  will the copyright holders, or any of the individual authors named in     */
+//  the source files, be liable to you for damages, including any general,    */
+//  special, incidental or consequential damages arising out of any use of    */
+//  the software or out of inability to use the software (including but not   */
+//  limited to any financial losses, loss of data or data being rendered      */
+//  inaccurate or losses sustained by you or by third parties as a result of  */
+//  a failure of the software to operate with any other programs), even if    */
+//  such holder or other party has been advised of the possibility of such    */
+//  damages.                                                                  */
+//                                                                            */
+//*****************************************************************************/
+
+#include "flintpp.h"
+#include "primepar.h"
+
+
+// Parallel search of a random prime p with 2^(l-1) <= p < 2^l
+// and gcd (p - 1, f) = 1 by Threads threads (0: number of processors).
+// Mode PRIMEPAR_FIRST returns the first prime found by any thread,
+// PRIMEPAR_DETERMINISTIC a prime depending on xrstate only
+
+LINT FindPrimePar (USHORT l, const LINT& f, STATEPRNG& xrstate, int Threads, int Mode)
+{
+  if (0 == l || l > CLINTMAXBIT) 
+    LINT::panic (E_LINT_OFL, "FindPrimePar", 1, __LINE__, __FILE__);
+  if (f.status == E_LINT_INV) 
+    LINT::panic (E_LINT_INV, "FindPrimePar", 2, __LINE__, __FILE__);
+
+  LINT pmin (0);
+  pmin.setbit (l - 1);
+  LINT pmax = ((LINT(0).setbit (l - 1) - 1) << 1) + 1; // max number with l bit
+
+  return FindPrimePar (pmin, pmax, f, xrstate, Threads, Mode);
+}
+
+
+// Parallel search of a random prime p with pmin <= p <= pmax
+// and gcd (p - 1, f) = 1
+
+LINT FindPrimePar (const LINT& pmin, const LINT& pmax, const LINT& f, STATEPRNG& xrstate, int Threads, int Mode)
+{
+  if (pmin.status == E_LINT_INV) 
+    LINT::panic (E_LINT_INV, "FindPrimePar", 1, __LINE__, __FILE__);
+  if (pmax.status == E_LINT_INV) 
+    LINT::panic (E_LINT_INV, "FindPrimePar", 2, __LINE__, __FILE__);
+  if (f.status == E_LINT_INV) 
+    LINT::panic (E_LINT_INV, "FindPrimePar", 3, __LINE__, __FILE__);
+
+  if (pmin > pmax) 
+    LINT::panic (E_LINT_INV, "FindPrimePar", 1, __LINE__, __FILE__);
+
+  // 0 < f has to be odd
+  if (f.iseven ()) 
+    LINT::panic (E_LINT_INV, "FindPrimePar", 3, __LINE__, __FILE__);
+
+  LINT rndprime;
+
+  int error = FindPrimeMinMaxGcdPar_l (rndprime.n_l, &xrstate, pmin.n_l,
+                                       pmax.n_l, f.n_l, Threads, Mode);
+
+  if (E_CLINT_OK != error)
+    {
+      LINT::panic (E_LINT_RIN, "FindPrimePar", 0, __LINE__, __FILE__);
+    }
+  else
+    {
+      rndprime.status = E_LINT_OK;
+    }
+
+  return rndprime;
+}
+
+
+// Parallel search of a random prime p with pmin <= p <= pmax
+// with p = a mod q and gcd (p - 1, f) = 1.
+// Input parameter: 2 < q prime, a mod q != 0, 0 < f odd
+
+LINT ExtendPrimePar (const LINT& pmin,
+                     const LINT& pmax,
+                     const LINT& a,
+                     const LINT& q,
+                     const LINT& f,
+                     STATEPRNG& xrstate,
+                     int Threads,
+                     int Mode)
+{
+  if (pmin.status == E_LINT_INV) 
+    LINT::panic (E_LINT_INV, "ExtendPrimePar", 1, __LINE__, __FILE__);
+  if (pmax.status == E_LINT_INV) 
+    LINT::panic (E_LINT_INV, "ExtendPrimePar", 2, __LINE__, __FILE__);
+  if (a.status == E_LINT_INV) 
+    LINT::panic (E_LINT_INV, "ExtendPrimePar", 3, __LINE__, __FILE__);
+  if (q.status == E_LINT_INV) 
+    LINT::panic (E_LINT_INV, "ExtendPrimePar", 4, __LINE__, __FILE__);
+  if (f.status == E_LINT_INV) 
+    LINT::panic (E_LINT_INV, "ExtendPrimePar", 5, __LINE__, __FILE__);
+
+  if (pmin > pmax) 
+    LINT::panic (E_LINT_INV, "ExtendPrimePar", 1, __LINE__, __FILE__);
+
+  // q has to be odd
+  if (q.iseven ()) 
+    LINT::panic (E_LINT_INV, "ExtendPrimePar", 3, __LINE__, __FILE__);
+
+  // a must not be divided by q 
+  if (a.mequ (0,q)) 
+    LINT::panic (E_LINT_INV, "ExtendPrimePar", 2, __LINE__, __FILE__);
+
+  // 0 < f has to be odd
+  if (f.iseven ()) 
+    LINT::panic (E_LINT_INV, "ExtendPrimePar", 4, __LINE__, __FILE__);
+
+  LINT rndprime;
+
+  int error = ExtendPrimePar_l (rndprime.n_l, &xrstate, pmin.n_l, pmax.n_l,
+                                a.n_l, q.n_l, f.n_l, Threads, Mode);
+
+  if (E_CLINT_OK != error)
+    {
+      LINT::panic (E_LINT_RIN, "ExtendPrimePar", 0, __LINE__, __FILE__);
+    }
+  else
+    {
+      rndprime.status = E_LINT_OK;
+    }
+
+  return rndprime;
+}
+
+
+// Parallel search of a strong prime p of length 2^(l-1) <= p <= 2^l - 1
+// with gcd (p - 1, f) = 1 and primes r, s, t such that
+//    r divides p - 1
+//    t divides r - 1
+//    s divides p + 1
+//
+// Input parameter: Binary length l of p,
+//                  0 < f odd
+
+LINT StrongPrimePar (USHORT l, const LINT& f, STATEPRNG& xrstate, int Threads, int Mode)
+{
+  if (l >= CLINTMAXBIT) 
+    LINT::panic (E_LINT_OFL, "StrongPrimePar", 1, __LINE__, __FILE__);
+
+  LINT pmin = LINT(0).setbit (l - 1);
+  LINT pmax = LINT(0).setbit (l);
+  --pmax;
+
+  return StrongPrimePar (pmin, pmax, (l>>2)-8, (l>>1)-8, (l>>1)-8, f, xrstate, Threads, Mode);
+}
+
+
+// Parallel search of a strong prime p with pmin <= p <= pmax
+// with gcd (p - 1, f) = 1 and primes r, s, t such that
+//    r divides p - 1
+//    t divides r - 1
+//    s divides p + 1
+//
+// Input parameters: pmin, pmax,
+//                   Lengths lt, lr and ls of primes t, r and s resp.
+//                     lt <~ l/4, lr ~ ls <~ l/2 of l
+//                   <~ means: smaller than, close to
+//                   0 < f odd
+
+LINT StrongPrimePar (const LINT& pmin,
+                     const LINT& pmax,
+                     USHORT lt,
+                     USHORT lr,
+                     USHORT ls,
+                     const LINT& f,
+                     STATEPRNG& xrstate,
+                     int Threads,
+                     int Mode)
+{
+  if (pmin.status == E_LINT_INV) 
+    LINT::panic (E_LINT_INV, "StrongPrimePar", 1, __LINE__, __FILE__);
+  if (pmax.status == E_LINT_INV) 
+    LINT::panic (E_LINT_INV, "StrongPrimePar", 2, __LINE__, __FILE__);
+  if (lt >= CLINTMAXBIT) 
+    LINT::panic (E_LINT_OFL, "StrongPrimePar", 3, __LINE__, __FILE__);
+  if (lr >= CLINTMAXBIT) 
+    LINT::panic (E_LINT_OFL, "StrongPrimePar", 4, __LINE__, __FILE__);
+  if (ls >= CLINTMAXBIT) 
+    LINT::panic (E_LINT_OFL, "StrongPrimePar", 5, __LINE__, __FILE__);
+  if (f.status == E_LINT_INV) 
+    LINT::panic (E_LINT_INV, "StrongPrimePar", 6, __LINE__, __FILE__);
+
+  // 0 < f has to be odd
+  if (f.iseven ()) 
+    LINT::panic (E_LINT_INV, "StrongPrimePar", 5, __LINE__, __FILE__);
+
+  LINT rndprime;
+
+  int error = StrongPrimePar_l (rndprime.n_l, &xrstate, pmin.n_l, pmax.n_l,
+                                lt, lr, ls, f.n_l, Threads, Mode);
+
+  if (E_CLINT_OK != error)
+    {
+      LINT::panic (E_LINT_RIN, "StrongPrimePar", 0, __LINE__, __FILE__);
+    }
+  else
+    {
+      rndprime.status = E_LINT_OK;
+    }
+
+  return rndprime;
+}
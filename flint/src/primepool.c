@@ -0,0 +1,643 @@
+/******************************************************************************/
+/*                                                                            */
+/* Functions for arithmetic and number theory with large integers in C        */
+/* Software supplement to the book "Cryptography in C and C++"                */
+/* by Michael Welschenbach                                                    */
+/*                                                                            */
+/* Module primepool.c      Revision: 19.10.2026                               */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 2001-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+
+
+/* POSIX threads, memory locking and fork handlers */
+#define _XOPEN_SOURCE 600
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "flint.h"
+#include "primepar.h"
+#include "threadrand.h"
+#include "primepool.h"
+
+
+/* Macros */
+
+/* Leading 16 bits of the lower bound of the primes, 0xb505/2^15 > sqrt(2) */
+#define SQRT2MSB      0xb505
+
+
+/* Types */
+
+/* Pool of primes of Bits binary digits with gcd (p - 1, f) = 1. The     */
+/* primes are stored in Primes[0], ..., Primes[Count - 1], Pending is    */
+/* the number of primes being generated for the pool by the threads.     */
+
+typedef struct
+{
+  USHORT Bits;
+  CLINT f_l;
+  int Kind;
+  unsigned int Size;
+  unsigned int Count;
+  unsigned int Pending;
+  CLINT *Primes;
+  size_t Len;          /* Length of the memory area Primes in bytes */
+} POOL;
+
+
+/* State of the module. Control serializes starting and stopping of the   */
+/* threads, Lock protects the pools and is held by Refill waiters.        */
+
+static pthread_once_t Once = PTHREAD_ONCE_INIT;
+static int OnceError = 0;
+static pthread_mutex_t Control = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t Lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t Refill = PTHREAD_COND_INITIALIZER;
+static POOL Pools[PRIMEPOOL_MAXPOOLS];
+static int NoofPools = 0;
+static pthread_t Tid[PRIMEPOOL_MAXTHREADS];
+static int NoofThreads = 0;
+static int Stopping = 0;
+
+
+/* Prototypes */
+
+static void InitOnce (void);
+static void PrepareAtFork (void);
+static void ParentAtFork (void);
+static void ChildAtFork (void);
+static void *Worker (void *arg);
+static int Generate (CLINT p_l, USHORT Bits, CLINT f_l, int Kind);
+static POOL *FindPool (USHORT Bits, CLINT f_l);
+static int Neediest (void);
+static CLINT *AllocPrimes (unsigned int Size, size_t *Len);
+static void FreePrimes (CLINT *Primes, size_t Len);
+static void *local_memset (void *ptr, int val, size_t len);
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Definition of a pool of primes p with Bits binary digits,     */
+/*              sqrt(2) * 2^(Bits - 1) < p < 2^Bits and gcd (p - 1, f) = 1.   */
+/*              The pool is filled as soon as threads are running.            */
+/*  Syntax:     int PrimePoolAdd_l (USHORT Bits, CLINT f_l, unsigned int Size,*/
+/*                                  int Kind);                                */
+/*  Input:      USHORT Bits (Length of the primes, PRIMEPOOL_MINBITS <= Bits  */
+/*                           <= CLINTMAXBIT/2)                                */
+/*              CLINT f_l (Odd number f > 0, e.g. an RSA public exponent)     */
+/*              unsigned int Size (Number of primes kept in the pool,         */
+/*                                 0 < Size <= PRIMEPOOL_MAXSIZE)             */
+/*              int Kind (PRIMEPOOL_PLAIN or PRIMEPOOL_STRONG)                */
+/*  Output:     -                                                             */
+/*  Returns:    0 if everything is O.K.                                       */
+/*              E_PRIMEPOOL_ARG if an argument is invalid or a pool for Bits  */
+/*                              and f already exists                          */
+/*              E_PRIMEPOOL_FULL if PRIMEPOOL_MAXPOOLS pools exist            */
+/*              E_PRIMEPOOL_MEM if allocation of memory failed                */
+/*              E_PRIMEPOOL_INI if the fork handler cannot be registered      */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+PrimePoolAdd_l (USHORT Bits, CLINT f_l, unsigned int Size, int Kind)
+{
+  POOL *pool;
+  int error = 0;
+
+  if (Bits < PRIMEPOOL_MINBITS || Bits > CLINTMAXBIT/2 ||
+      Size == 0 || Size > PRIMEPOOL_MAXSIZE ||
+      (Kind != PRIMEPOOL_PLAIN && Kind != PRIMEPOOL_STRONG) ||
+      f_l == NULL || EQZ_L (f_l) || ISEVEN_L (f_l))
+    {
+      return E_PRIMEPOOL_ARG;
+    }
+
+  pthread_once (&Once, InitOnce);
+  if (OnceError)
+    {
+      return OnceError;
+    }
+
+  pthread_mutex_lock (&Lock);
+
+  if (FindPool (Bits, f_l) != NULL)
+    {
+      error = E_PRIMEPOOL_ARG;
+    }
+  else if (NoofPools == PRIMEPOOL_MAXPOOLS)
+    {
+      error = E_PRIMEPOOL_FULL;
+    }
+  else
+    {
+      pool = &Pools[NoofPools];
+      if ((pool->Primes = AllocPrimes (Size, &pool->Len)) == NULL)
+        {
+          error = E_PRIMEPOOL_MEM;
+        }
+      else
+        {
+          pool->Bits = Bits;
+          cpy_l (pool->f_l, f_l);
+          pool->Kind = Kind;
+          pool->Size = Size;
+          pool->Count = 0;
+          pool->Pending = 0;
+          NoofPools++;
+          pthread_cond_broadcast (&Refill);
+        }
+    }
+
+  pthread_mutex_unlock (&Lock);
+
+  return error;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Start of the threads filling the pools in the background      */
+/*  Syntax:     int PrimePoolStart_l (int Threads);                           */
+/*  Input:      int Threads (Number of threads, number of online processors   */
+/*                           if Threads <= 0, at most PRIMEPOOL_MAXTHREADS)   */
+/*  Output:     -                                                             */
+/*  Returns:    0 if everything is O.K.                                       */
+/*              E_PRIMEPOOL_INI if threads are already running, no thread     */
+/*                              could be created or the fork handler          */
+/*                              cannot be registered                          */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+PrimePoolStart_l (int Threads)
+{
+  int error = 0;
+
+  pthread_once (&Once, InitOnce);
+  if (OnceError)
+    {
+      return OnceError;
+    }
+
+  if (Threads <= 0)
+    {
+#ifdef _SC_NPROCESSORS_ONLN
+      Threads = (int)sysconf (_SC_NPROCESSORS_ONLN);
+#endif
+      if (Threads <= 0)
+        {
+          Threads = 1;
+        }
+    }
+  if (Threads > PRIMEPOOL_MAXTHREADS)
+    {
+      Threads = PRIMEPOOL_MAXTHREADS;
+    }
+
+  pthread_mutex_lock (&Control);
+  pthread_mutex_lock (&Lock);
+
+  if (NoofThreads > 0)
+    {
+      error = E_PRIMEPOOL_INI;
+    }
+  else
+    {
+      Stopping = 0;
+      while (NoofThreads < Threads &&
+             pthread_create (&Tid[NoofThreads], NULL, Worker, NULL) == 0)
+        {
+          NoofThreads++;
+        }
+      if (NoofThreads == 0)
+        {
+          error = E_PRIMEPOOL_INI;
+        }
+    }
+
+  pthread_mutex_unlock (&Lock);
+  pthread_mutex_unlock (&Control);
+
+  return error;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Removal of a prime from the pool for Bits and f. The prime is */
+/*              purged from the pool, which is then refilled.                 */
+/*  Syntax:     int PrimePoolGet_l (CLINT p_l, USHORT Bits, CLINT f_l);       */
+/*  Input:      USHORT Bits (Length of the prime)                             */
+/*              CLINT f_l (Odd number f > 0 with gcd (p - 1, f) = 1)          */
+/*  Output:     CLINT p_l (Prime)                                             */
+/*  Returns:    0 if everything is O.K.                                       */
+/*              E_PRIMEPOOL_EMPTY if there is no pool for Bits and f or the   */
+/*                                pool is empty                               */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+PrimePoolGet_l (CLINT p_l, USHORT Bits, CLINT f_l)
+{
+  POOL *pool;
+  int error = E_PRIMEPOOL_EMPTY;
+
+  pthread_mutex_lock (&Lock);
+
+  if ((pool = FindPool (Bits, f_l)) != NULL && pool->Count > 0)
+    {
+      pool->Count--;
+      cpy_l (p_l, pool->Primes[pool->Count]);
+      local_memset (pool->Primes[pool->Count], 0, sizeof (CLINT));
+      pthread_cond_signal (&Refill);
+      error = 0;
+    }
+
+  pthread_mutex_unlock (&Lock);
+
+  return error;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Number of primes available in the pool for Bits and f         */
+/*  Syntax:     unsigned int PrimePoolCount_l (USHORT Bits, CLINT f_l);       */
+/*  Input:      USHORT Bits (Length of the primes)                            */
+/*              CLINT f_l (Odd number f > 0)                                  */
+/*  Output:     -                                                             */
+/*  Returns:    Number of primes, 0 if there is no pool for Bits and f        */
+/*                                                                            */
+/******************************************************************************/
+unsigned int __FLINT_API
+PrimePoolCount_l (USHORT Bits, CLINT f_l)
+{
+  POOL *pool;
+  unsigned int count = 0;
+
+  pthread_mutex_lock (&Lock);
+
+  if ((pool = FindPool (Bits, f_l)) != NULL)
+    {
+      count = pool->Count;
+    }
+
+  pthread_mutex_unlock (&Lock);
+
+  return count;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Termination of the threads, purging and release of all pools  */
+/*  Syntax:     void PrimePoolStop_l (void);                                  */
+/*  Input:      -                                                             */
+/*  Output:     -                                                             */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+void __FLINT_API
+PrimePoolStop_l (void)
+{
+  int i;
+
+  pthread_mutex_lock (&Control);
+
+  pthread_mutex_lock (&Lock);
+  Stopping = 1;
+  pthread_cond_broadcast (&Refill);
+  pthread_mutex_unlock (&Lock);
+
+  for (i = 0; i < NoofThreads; i++)
+    {
+      pthread_join (Tid[i], NULL);
+    }
+
+  pthread_mutex_lock (&Lock);
+
+  for (i = 0; i < NoofPools; i++)
+    {
+      FreePrimes (Pools[i].Primes, Pools[i].Len);
+      local_memset (&Pools[i], 0, sizeof (POOL));
+    }
+  NoofPools = 0;
+  NoofThreads = 0;
+  Stopping = 0;
+
+  pthread_mutex_unlock (&Lock);
+  pthread_mutex_unlock (&Control);
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Registration of the fork handlers, called once                */
+/*  Syntax:     static void InitOnce (void);                                  */
+/*  Input:      -                                                             */
+/*  Output:     -                                                             */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+static void
+InitOnce (void)
+{
+  if (pthread_atfork (PrepareAtFork, ParentAtFork, ChildAtFork) != 0)
+    {
+      OnceError = E_PRIMEPOOL_INI;
+    }
+}
+
+
+/* Fork handlers: No pool is modified during fork. The child process has  */
+/* no threads, its copies of the primes are purged.                        */
+
+static void
+PrepareAtFork (void)
+{
+  pthread_mutex_lock (&Control);
+  pthread_mutex_lock (&Lock);
+}
+
+
+static void
+ParentAtFork (void)
+{
+  pthread_mutex_unlock (&Lock);
+  pthread_mutex_unlock (&Control);
+}
+
+
+static void
+ChildAtFork (void)
+{
+  int i;
+
+  for (i = 0; i < NoofPools; i++)
+    {
+      local_memset (Pools[i].Primes, 0, Pools[i].Size * sizeof (CLINT));
+      Pools[i].Count = 0;
+      Pools[i].Pending = 0;
+    }
+  NoofThreads = 0;
+  Stopping = 0;
+
+  pthread_cond_init (&Refill, NULL);
+  pthread_mutex_unlock (&Lock);
+  pthread_mutex_unlock (&Control);
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Thread refilling the pools. The prime is generated without    */
+/*              holding the lock, the neediest pool is served first.          */
+/*  Syntax:     static void *Worker (void *arg);                              */
+/*  Input:      void *arg (unused)                                            */
+/*  Output:     -                                                             */
+/*  Returns:    NULL                                                          */
+/*                                                                            */
+/******************************************************************************/
+static void *
+Worker (void *arg)
+{
+  CLINT p_l, f_l;
+  POOL *pool;
+  USHORT Bits;
+  int Kind, i, error = 0;
+
+  pthread_mutex_lock (&Lock);
+
+  while (!error)
+    {
+      while (!Stopping && (i = Neediest ()) < 0)
+        {
+          pthread_cond_wait (&Refill, &Lock);
+        }
+      if (Stopping)
+        {
+          break;
+        }
+
+      pool = &Pools[i];
+      pool->Pending++;
+      Bits = pool->Bits;
+      cpy_l (f_l, pool->f_l);
+      Kind = pool->Kind;
+
+      pthread_mutex_unlock (&Lock);
+      error = Generate (p_l, Bits, f_l, Kind);
+      pthread_mutex_lock (&Lock);
+
+      /* Pools are released only after all threads are joined */
+      pool->Pending--;
+      if (!error && pool->Count < pool->Size)
+        {
+          cpy_l (pool->Primes[pool->Count], p_l);
+          pool->Count++;
+        }
+      local_memset (p_l, 0, sizeof (p_l));
+    }
+
+  pthread_mutex_unlock (&Lock);
+
+  (void)arg;
+  return NULL;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Generation of a prime for a pool with the PRNG of the calling */
+/*              thread, sqrt(2) * 2^(Bits - 1) < p < 2^Bits                   */
+/*  Syntax:     static int Generate (CLINT p_l, USHORT Bits, CLINT f_l,       */
+/*                                   int Kind);                               */
+/*  Input:      USHORT Bits (Length of the prime)                             */
+/*              CLINT f_l (Odd number f > 0 with gcd (p - 1, f) = 1)          */
+/*              int Kind (PRIMEPOOL_PLAIN or PRIMEPOOL_STRONG)                */
+/*  Output:     CLINT p_l (Prime)                                             */
+/*  Returns:    0 if everything is O.K.                                       */
+/*              E_PRIMEPOOL_MEM if the PRNG of the thread cannot be created   */
+/*              Error code of FindPrimeMinMaxGcd_l or StrongPrimePar_l        */
+/*                                                                            */
+/******************************************************************************/
+static int
+Generate (CLINT p_l, USHORT Bits, CLINT f_l, int Kind)
+{
+  CLINT rmin_l, rmax_l;
+  STATEPRNG *xrstate;
+  int error;
+
+  if ((xrstate = ThreadRandState_l ()) == NULL)
+    {
+      return E_PRIMEPOOL_MEM;
+    }
+
+  u2clint_l (rmin_l, SQRT2MSB);
+  shift_l (rmin_l, (long int)Bits - 16);
+  SETZERO_L (rmax_l);
+  setbit_l (rmax_l, Bits);
+  dec_l (rmax_l);
+
+  if (PRIMEPOOL_STRONG == Kind)
+    {
+      error = StrongPrimePar_l (p_l, xrstate, rmin_l, rmax_l,
+                                (USHORT)((Bits >> 2) - 8),
+                                (USHORT)((Bits >> 1) - 8),
+                                (USHORT)((Bits >> 1) - 8),
+                                f_l, 1, PRIMEPAR_FIRST);
+    }
+  else
+    {
+      error = FindPrimeMinMaxGcd_l (p_l, xrstate, rmin_l, rmax_l, f_l);
+    }
+
+  return error;
+}
+
+
+/* Pool for Bits and f, NULL if there is none. Lock must be held. */
+static POOL *
+FindPool (USHORT Bits, CLINT f_l)
+{
+  int i;
+
+  for (i = 0; i < NoofPools; i++)
+    {
+      if (Pools[i].Bits == Bits && equ_l (Pools[i].f_l, f_l))
+        {
+          return &Pools[i];
+        }
+    }
+
+  return NULL;
+}
+
+
+/* Index of the pool missing most primes, -1 if all pools are full or being */
+/* filled. Lock must be held.                                               */
+static int
+Neediest (void)
+{
+  unsigned int need, most = 0;
+  int i, index = -1;
+
+  for (i = 0; i < NoofPools; i++)
+    {
+      need = Pools[i].Size - Pools[i].Count;
+      need = (need > Pools[i].Pending) ? need - Pools[i].Pending : 0;
+      if (need > most)
+        {
+          most = need;
+          index = i;
+        }
+    }
+
+  return index;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Allocation of page aligned memory for Size primes, locked     */
+/*              against swapping if the system allows it                      */
+/*  Syntax:     static CLINT *AllocPrimes (unsigned int Size, size_t *Len);   */
+/*  Input:      unsigned int Size (Number of primes)                          */
+/*  Output:     size_t *Len (Length of the memory area in bytes)              */
+/*  Returns:    Pointer to the zeroized memory area                           */
+/*              NULL if allocation of memory failed                           */
+/*                                                                            */
+/******************************************************************************/
+static CLINT *
+AllocPrimes (unsigned int Size, size_t *Len)
+{
+  void *ptr;
+  long page = 4096;
+
+#ifdef _SC_PAGESIZE
+  if ((page = sysconf (_SC_PAGESIZE)) <= 0)
+    {
+      page = 4096;
+    }
+#endif
+
+  *Len = ((Size * sizeof (CLINT) + page - 1) / page) * page;
+  if (posix_memalign (&ptr, (size_t)page, *Len) != 0)
+    {
+      return NULL;
+    }
+
+  memset (ptr, 0, *Len);
+#ifdef _POSIX_MEMLOCK_RANGE
+  mlock (ptr, *Len);
+#endif
+
+  return (CLINT *)ptr;
+}
+
+
+/* Purging, unlocking and release of memory from AllocPrimes */
+static void
+FreePrimes (CLINT *Primes, size_t Len)
+{
+  if (Primes != NULL)
+    {
+      local_memset (Primes, 0, Len);
+#ifdef _POSIX_MEMLOCK_RANGE
+      munlock (Primes, Len);
+#endif
+      free (Primes);
+    }
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/* Local memset-Function, does the same as memset()                           */
+/* Needed to make compiler purge variables in spite of optimization.          */
+/*                                                                            */
+/******************************************************************************/
+static void *
+local_memset (void *ptr, int val, size_t len)
+{
+  return memset (ptr, val, len);
+}
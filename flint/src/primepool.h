@@ -0,0 +1,117 @@
+/******************************************************************************/
+/*                                                                            */
+/* Functions for arithmetic and number theory with large integers in C        */
+/* Software supplement to the book "Cryptography in C and C++"                */
+/* by Michael Welschenbach                                                    */
+/*                                                                            */
+/* Module primepool.h      Revision: 19.10.2026                               */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 1998-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+
+#ifndef __PRIMEPOOLH__
+#define __PRIMEPOOLH__
+
+#include "random.h"
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/* Macros */
+
+/* A pool keeps pre-generated primes p of Bits binary digits with          */
+/* gcd (p - 1, f) = 1 and p > sqrt(2) * 2^(Bits - 1), so the product of    */
+/* two of them has exactly 2*Bits digits as needed for an RSA modulus.     */
+/* Background threads refill the pools, each one with its own PRNG from    */
+/* threadrand.c. The primes are kept in memory locked against swapping if  */
+/* the system allows it, and are zeroized when taken or freed. A child     */
+/* process created by fork () starts with empty pools and no threads.      */
+
+#define PRIMEPOOL_MAXPOOLS      16  /* Maximum number of pools */
+#define PRIMEPOOL_MAXSIZE     4096  /* Maximum number of primes per pool */
+#define PRIMEPOOL_MAXTHREADS    64  /* Maximum number of threads */
+#define PRIMEPOOL_MINBITS       64  /* Minimum length of the primes */
+
+#define PRIMEPOOL_PLAIN          0  /* Primes by FindPrimeMinMaxGcd_l */
+#define PRIMEPOOL_STRONG         1  /* Strong primes by StrongPrimePar_l */
+
+#define E_PRIMEPOOL_ARG         -1  /* Invalid argument or pool exists */
+#define E_PRIMEPOOL_MEM         -2  /* Allocation of memory failed */
+#define E_PRIMEPOOL_FULL        -3  /* Maximum number of pools reached */
+#define E_PRIMEPOOL_EMPTY       -4  /* No such pool or no prime available */
+#define E_PRIMEPOOL_INI         -5  /* Threads already running, or none */
+
+/* Macros maintaining FLINT/C namespace */
+
+#define PrimePoolAdd         PrimePoolAdd_l
+#define PrimePoolStart       PrimePoolStart_l
+#define PrimePoolGet         PrimePoolGet_l
+#define PrimePoolCount       PrimePoolCount_l
+#define PrimePoolStop        PrimePoolStop_l
+
+
+/******************************************************************************/
+/* Prime pool API: Public Functions */
+
+#ifndef __FLINT_API
+#ifdef FLINT_USEDLL
+#define __FLINT_API                   __cdecl
+#else
+#define __FLINT_API                   /**/
+#endif /* FLINT_USEDLL */
+#endif /* !defined __FLINT_API */
+
+extern int __FLINT_API
+PrimePoolAdd_l (USHORT Bits, CLINT f_l, unsigned int Size, int Kind);
+extern int __FLINT_API
+PrimePoolStart_l (int Threads);
+extern int __FLINT_API
+PrimePoolGet_l (CLINT p_l, USHORT Bits, CLINT f_l);
+extern unsigned int __FLINT_API
+PrimePoolCount_l (USHORT Bits, CLINT f_l);
+extern void __FLINT_API
+PrimePoolStop_l (void);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* __PRIMEPOOLH__ */
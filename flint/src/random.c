@@ -76,6 +76,23 @@
 static void *
 local_memset (void *ptr, int val, size_t len);
 
+static void
+StepRMDSHA1 (STATERMDSHA1 *rstate);
+
+static void
+StepAES (STATEAES *rstate);
+
+static void
+StepBBS (STATEBBS *rstate);
+
+static ULONG
+GetBitsBBS (STATEBBS *rstate, int k);
+
+
+/* Parameters of the incremental prime search in FindPrimeMinMaxGcd_l ():    */
+/* number of odd small primes used for sieving and candidates per window     */
+#define SIEVEPRIMES (NOOFSMALLPRIMES - 1)
+#define SIEVEWINDOW 1024
 
 static int Rand64Init = 0;
 
@@ -146,8 +163,9 @@ InitRandRMDSHA1_l (STATERMDSHA1 *rstate, char *UsrStr, int LenUsrStr, int AddEnt
   /* Switch internal state */
   ripemd160_l (rstate->XRMDSHA1, rstate->XRMDSHA1, 20);
 
-  /* Initialize RoundRMDSHA1 for picking single bytes out of random stream */
-  rstate->RoundRMDSHA1 = 1;
+  /* Initialize step counter, output buffer is empty */
+  rstate->RoundRMDSHA1 = 0;
+  rstate->PosRMDSHA1 = RANDRMDSHA1BLOCKLEN;
 
   /* Set Flag: PRNG is initialized */
   rstate->RandRMDSHA1Init = 1;
@@ -158,8 +176,72 @@ InitRandRMDSHA1_l (STATERMDSHA1 *rstate, char *UsrStr, int LenUsrStr, int AddEnt
 
 /******************************************************************************/
 /*                                                                            */
-/*  Function:  Switching of RandRMDSHA1 to next state, generating one         */
-/*             random byte                                                    */
+/*  Function:  Deterministic initialisation of RandRMDSHA1 from a seed only,  */
+/*             neither entropy nor the system time are added. Equal seeds     */
+/*             yield equal output, e.g. for reproducible substreams           */
+/*  Syntax:    int SeedRandRMDSHA1_l (STATERMDSHA1 *rstate, UCHAR *Seed,      */
+/*                                                       int LenSeed);        */
+/*  Input:     Seed (Byte vector for initialization of RandRMDSHA1)           */
+/*             LenSeed (Length of Seed in byte)                               */
+/*  Output:    rstate (Initialized internal state of PRNG)                    */
+/*  Returns:   E_CLINT_OK if everything is OK                                 */
+/*             E_CLINT_NPT if Seed is the NULL pointer                        */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+SeedRandRMDSHA1_l (STATERMDSHA1 *rstate, UCHAR *Seed, int LenSeed)
+{
+  if (NULL == Seed)
+    {
+      return E_CLINT_NPT;
+    }
+
+  ripemd160_l (rstate->XRMDSHA1, Seed, (ULONG)LenSeed);
+
+  /* Switch internal state */
+  ripemd160_l (rstate->XRMDSHA1, rstate->XRMDSHA1, 20);
+
+  /* Initialize step counter, output buffer is empty */
+  rstate->RoundRMDSHA1 = 0;
+  rstate->PosRMDSHA1 = RANDRMDSHA1BLOCKLEN;
+
+  /* Set Flag: PRNG is initialized */
+  rstate->RandRMDSHA1Init = 1;
+
+  return E_CLINT_OK;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:  One step of RandRMDSHA1: The SHA-1 digest of the internal      */
+/*             state fills the output buffer, then the state is switched by   */
+/*             RIPEMD-160. Since both functions are one-way, neither the      */
+/*             output nor the new state reveal previous states or outputs     */
+/*  Syntax:    void StepRMDSHA1 (STATERMDSHA1 *rstate)                        */
+/*  Input:     rstate (Initialized state of PRNG)                             */
+/*  Output:    rstate (New internal state of PRNG, output buffer refilled)    */
+/*  Returns:   -                                                              */
+/*                                                                            */
+/******************************************************************************/
+static void
+StepRMDSHA1 (STATERMDSHA1 *rstate)
+{
+  /* Generate random values */
+  sha1_l (rstate->SRMDSHA1, rstate->XRMDSHA1, 20);
+  rstate->PosRMDSHA1 = 0;
+  ++(rstate->RoundRMDSHA1);
+
+  /* Switch internal state */
+  ripemd160_l (rstate->XRMDSHA1, rstate->XRMDSHA1, 20);
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:  Generation of one random byte by RandRMDSHA1. The bytes of     */
+/*             each SHA-1 digest are delivered one after the other, the       */
+/*             state is switched after RANDRMDSHA1BLOCKLEN bytes              */
 /*  Syntax:    UCHAR SwitchRandRMDSHA1_l (STATERMDSHA1 *rstate)               */
 /*  Input:     rstate (Initialized State)                                     */
 /*  Output:    rstate (Internal State)                                        */
@@ -170,23 +252,114 @@ UCHAR __FLINT_API
 SwitchRandRMDSHA1_l (STATERMDSHA1 *rstate)
 {
   UCHAR rbyte;
-  
-  /* Generate random value */
-  sha1_l (rstate->SRMDSHA1, rstate->XRMDSHA1, 20);
-  rbyte = rstate->SRMDSHA1[(rstate->RoundRMDSHA1)++ & 15]; /* RoundRMDSHA1 mod 16 */
 
-  /* Switch internal state */
-  ripemd160_l (rstate->XRMDSHA1, rstate->XRMDSHA1, 20);
+  if (rstate->PosRMDSHA1 >= RANDRMDSHA1BLOCKLEN)
+    {
+      StepRMDSHA1 (rstate);
+    }
+
+  rbyte = rstate->SRMDSHA1[rstate->PosRMDSHA1];
 
 #ifdef FLINT_SECURE
-  /* Security: Purge random variable SRMDSHA1 */
-  local_memset (rstate->SRMDSHA1, 0, sizeof (rstate->SRMDSHA1));
+  /* Security: Purge delivered random byte */
+  rstate->SRMDSHA1[rstate->PosRMDSHA1] = 0;
 #endif
 
+  ++(rstate->PosRMDSHA1);
   return rbyte;
 }
 
 
+/******************************************************************************/
+/*                                                                            */
+/*  Function:  Generation of 8, 16 and 32 bit random values by RandRMDSHA1    */
+/*             Bytes are taken from the output buffer in big-endian order     */
+/*  Syntax:    UCHAR bRandRMDSHA1_l (STATERMDSHA1 *rstate);                   */
+/*             USHORT sRandRMDSHA1_l (STATERMDSHA1 *rstate);                  */
+/*             ULONG lRandRMDSHA1_l (STATERMDSHA1 *rstate);                   */
+/*  Input:     rstate (Initialized state of PRNG)                             */
+/*  Output:    rstate (New internal state of PRNG)                            */
+/*  Returns:   Random value                                                   */
+/*                                                                            */
+/******************************************************************************/
+UCHAR __FLINT_API
+bRandRMDSHA1_l (STATERMDSHA1 *rstate)
+{
+  return SwitchRandRMDSHA1_l (rstate);
+}
+
+
+USHORT __FLINT_API
+sRandRMDSHA1_l (STATERMDSHA1 *rstate)
+{
+  UCHAR b[2];
+
+  RandRMDSHA1Bytes_l (b, 2, rstate);
+  return (USHORT)(((USHORT)b[0] << 8) | (USHORT)b[1]);
+}
+
+
+ULONG __FLINT_API
+lRandRMDSHA1_l (STATERMDSHA1 *rstate)
+{
+  UCHAR b[4];
+
+  RandRMDSHA1Bytes_l (b, 4, rstate);
+  return ((ULONG)b[0] << 24) | ((ULONG)b[1] << 16) |
+         ((ULONG)b[2] <<  8) |  (ULONG)b[3];
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:  Generation of a sequence of random bytes by RandRMDSHA1        */
+/*             (Preceding Initialization by InitRandRMDSHA1() required)       */
+/*             The output is the same byte stream as by repeated calls of     */
+/*             SwitchRandRMDSHA1_l, whole digests are copied at once          */
+/*  Syntax:    int RandRMDSHA1Bytes_l (UCHAR *Buf, ULONG Len,                 */
+/*                                                 STATERMDSHA1 *rstate);     */
+/*  Input:     Len (Number of bytes to be generated)                          */
+/*             rstate (Initialized state of PRNG)                             */
+/*  Output:    Buf (Random bytes)                                             */
+/*             rstate (New internal state of PRNG)                            */
+/*  Returns:   E_CLINT_OK  if everything is OK                                */
+/*             E_CLINT_RIN if generator is not initialized                    */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+RandRMDSHA1Bytes_l (UCHAR *Buf, ULONG Len, STATERMDSHA1 *rstate)
+{
+  ULONG n;
+
+  if (!rstate->RandRMDSHA1Init)
+    {
+      return E_CLINT_RIN;
+    }
+
+  while (Len > 0)
+    {
+      if (rstate->PosRMDSHA1 >= RANDRMDSHA1BLOCKLEN)
+        {
+          StepRMDSHA1 (rstate);
+        }
+
+      n = MIN (Len, (ULONG)(RANDRMDSHA1BLOCKLEN - rstate->PosRMDSHA1));
+      memcpy (Buf, rstate->SRMDSHA1 + rstate->PosRMDSHA1, (size_t)n);
+
+#ifdef FLINT_SECURE
+      /* Security: Purge delivered random bytes */
+      local_memset (rstate->SRMDSHA1 + rstate->PosRMDSHA1, 0, (size_t)n);
+#endif
+
+      rstate->PosRMDSHA1 += (unsigned)n;
+      Buf += n;
+      Len -= n;
+    }
+
+  return E_CLINT_OK;
+}
+
+
 /******************************************************************************/
 /*                                                                            */
 /*  Function:  Generation of pseudorandom number of CLINT-Type                */
@@ -205,6 +378,7 @@ RandRMDSHA1_l (CLINT r_l, STATERMDSHA1 *rstate, int l)
 {
   USHORT i, j;
   USHORT ls, lr;
+  UCHAR *p;
 
   if (!rstate->RandRMDSHA1Init)
     {
@@ -215,13 +389,17 @@ RandRMDSHA1_l (CLINT r_l, STATERMDSHA1 *rstate, int l)
   ls = (USHORT) l >> LDBITPERDGT;
   lr = (USHORT) l & ((USHORT)BITPERDGT - 1);
 
-  for (i = 1; i <= ls; i++)
+  /* Fill digits with random bytes in one pass, then arrange each pair of */
+  /* bytes in big-endian order as done by sRandRMDSHA1_l                  */
+  RandRMDSHA1Bytes_l ((UCHAR*)(r_l + 1), (ULONG)(ls + (lr > 0)) << 1, rstate);
+  for (i = 1; i <= ls + (lr > 0); i++)
     {
-      r_l[i] = sRandRMDSHA1_l (rstate);
+      p = (UCHAR*)(r_l + i);
+      r_l[i] = (USHORT)(((USHORT)p[0] << 8) | (USHORT)p[1]);
     }
   if (lr > 0)
     {
-      r_l[++ls] = sRandRMDSHA1_l (rstate);
+      ++ls;
       j = 1U << (lr - 1);                         /* j <- 2^(lr - 1) */
       r_l[ls] = (r_l[ls] | j) & ((j << 1) - 1);   /* Bit lr set to 1, higher bits to 0 */
     }
@@ -251,6 +429,7 @@ PurgeRandRMDSHA1_l (STATERMDSHA1 *rstate)
   memset (rstate->XRMDSHA1, 0, sizeof (rstate->XRMDSHA1));
   memset (rstate->SRMDSHA1, 0, sizeof (rstate->SRMDSHA1));
   rstate->RoundRMDSHA1 = 0;
+  rstate->PosRMDSHA1 = 0;
 
   /* Reset initialization flag */
   rstate->RandRMDSHA1Init = 0;
@@ -259,26 +438,29 @@ PurgeRandRMDSHA1_l (STATERMDSHA1 *rstate)
 
 /************************* AES based PRNG with key update *********************/
 
-static const unsigned char RandAESKey[] =
-{0x0f, 0x1e, 0x2d, 0x3c, 0x4b, 0x5a, 0x69, 0x78,
- 0x87, 0x96, 0xa5, 0xb4, 0xc3, 0xd2, 0xe1, 0xf0, 
- 0x12, 0x23, 0x34, 0x45, 0x56, 0x78, 0x89, 0x9a,
- 0xab, 0xbc, 0xcd, 0xde, 0xef, 0xf0, 0x01, 0x12};
+static void
+IncAES (AESBLOCK X);
 
 /******************************************************************************/
 /*                                                                            */
 /*  Function:  Initialisation of the AES based Pseudorandom-                  */
 /*             numbergenerator (RandAES)                                      */
-/*  Syntax:    int InitRandRMDSHA1_l (STATEAES *rstate, char *UsrStr,         */
-/*                                    int LenUsrStr, int AddEntropy);         */
+/*             The secret 256 bit key and the secret initial value of the     */
+/*             counter are derived from the entropy by RIPEMD-160. RandAES    */
+/*             outputs the encryptions of the counter (CTR mode); neither     */
+/*             key nor counter are ever output.                               */
+/*  Syntax:    int InitRandAES_l (STATEAES *rstate, char *UsrStr,             */
+/*                           int LenUsrStr, int AddEntropy, int update);      */
 /*  Input:     UsrStr (User supplied byte vector for initialization of        */
 /*                     RandAES)                                               */
 /*             LenUsrStr (Length of UsrString in byte)                        */
 /*             AddEntropy (Number of additionally required entropy bytes)     */
-/*             update (Frequency AES-key-update by XORing with output value:  */
+/*             update (Frequency of the AES-key-update by XORing with the     */
+/*                     encryptions of two further counter values, which are   */
+/*                     not output:                                            */
 /*                     update = 0: Never update key, fastest                  */
 /*                     update = 1: Always update key, slowest, most secure    */
-/*                     update = 1 < n: Update key every n'th call to RandAES  */
+/*                     update = 1 < n: Update key every n'th AES step         */
 /*  Output:    rstate (Initialized internal state of PRNG)                    */
 /*  Returns:   Number of requested entropy bytes missing                      */
 /*             0: OK                                                          */
@@ -287,72 +469,271 @@ static const unsigned char RandAESKey[] =
 int __FLINT_API
 InitRandAES_l (STATEAES *rstate, char *UsrStr, int LenUsrStr, int AddEntropy, int update)
 {
+  UCHAR Seed[21], Hash[3][20];
   int MissingEntropy, i;
+
   /* Get Required Entropy and Seed */
-  MissingEntropy = GetEntropy_l (NULL, rstate->XAES, AddEntropy, UsrStr, LenUsrStr);
+  MissingEntropy = GetEntropy_l (NULL, Seed, AddEntropy, UsrStr, LenUsrStr);
 
-  /* Initialize AES */
-  for (i = 0; i < 32; i++)
+  /* Key and counter from RIPEMD-160 (Seed || i), i = 1, 2, 3 */
+  for (i = 0; i < 3; i++)
     {
-      rstate->RandAESKey[i] ^= RandAESKey[i];
+      Seed[20] = (UCHAR)(i + 1);
+      ripemd160_l (Hash[i], Seed, 21);
     }
 
-  AESInit_l (&rstate->RandAESWorksp, AES_ECB, 192, NULL, &rstate->RandAESSched, rstate->RandAESKey, 256, AES_ENC);
+  memcpy (rstate->RandAESKey, Hash[0], 20);
+  memcpy (rstate->RandAESKey + 20, Hash[1], 12);
+  memcpy (rstate->XAES, Hash[2], 20);
+  memcpy (rstate->XAES + 20, Hash[1] + 12, 4);
 
-  /* Switch internal state */
-  AESCrypt_l (rstate->XAES, &rstate->RandAESWorksp, &rstate->RandAESSched, rstate->XAES, 24); 
+  /* Initialize AES */
+  AESInit_l (&rstate->RandAESWorksp, AES_ECB, 192, NULL, &rstate->RandAESSched, rstate->RandAESKey, 256, AES_ENC);
 
   /* Set parameter for frequency of key update */
   rstate->UpdateKeyAES = update;
   
-  /* Initialize RoundAES for picking single bytes out of random stream */
-  rstate->RoundAES = 1;
+  /* Initialize step counter, output buffer is empty */
+  rstate->RoundAES = 0;
+  rstate->PosAES = RANDAESBLOCKLEN;
 
   /* Set Flag: PRNG is initialized */
   rstate->RandAESInit = 1;
 
+  /* Purging of variables */
+  memset (Seed, 0, sizeof (Seed));
+  memset (Hash, 0, sizeof (Hash));
+
   return MissingEntropy;
 }
 
 
 /******************************************************************************/
 /*                                                                            */
-/*  Function:  Switching of RandAES to the next state, generating one         */
-/*             random byte                                                    */
-/*  Syntax:    UCHAR SwitchRandAES_l (STATEAES *rstate)                       */
+/*  Function:  One step of RandAES: Encryption of the counter into the output */
+/*             buffer, increment of the counter and key update according to   */
+/*             the parameter update of InitRandAES_l. The new key is the      */
+/*             old key XOR the encryptions of the next two counter values,    */
+/*             which are not output.                                          */
+/*             The new state provides RANDAESBLOCKLEN bytes of output         */
+/*  Syntax:    void StepAES (STATEAES *rstate)                                */
 /*  Input:     rstate (Initialized state of PRNG)                             */
-/*  Output:    rstate (New internal state of PRNG)                            */
-/*  Returns:   One byte random value                                          */
+/*  Output:    rstate (New internal state of PRNG, output buffer refilled)    */
+/*  Returns:   -                                                              */
 /*                                                                            */
 /******************************************************************************/
-UCHAR __FLINT_API
-SwitchRandAES_l (STATEAES *rstate)
+static void
+StepAES (STATEAES *rstate)
 {
+  AESBLOCK K[2];
   int i;
-  UCHAR rbyte;
 
-  AESCrypt_l (rstate->XAES, &rstate->RandAESWorksp, &rstate->RandAESSched, rstate->XAES, 24); 
+  AESCrypt_l (rstate->OutAES, &rstate->RandAESWorksp, &rstate->RandAESSched, rstate->XAES, RANDAESBLOCKLEN); 
+  IncAES (rstate->XAES);
+  rstate->PosAES = 0;
 
-  rbyte = rstate->XAES[(rstate->RoundAES)++ & 15]; /* RoundAES mod 16 */
-  
   if (rstate->UpdateKeyAES)
     {
-      if (0 == (rstate->RoundAES % rstate->UpdateKeyAES))
+      if (0 == (++(rstate->RoundAES) % rstate->UpdateKeyAES))
         {
+          for (i = 0; i < 2; i++)
+            {
+              AESCrypt_l (K[i], &rstate->RandAESWorksp, &rstate->RandAESSched,
+                                                    rstate->XAES, RANDAESBLOCKLEN);
+              IncAES (rstate->XAES);
+            }
+
           for (i = 0; i < 32; i++)
             {
-              rstate->RandAESKey[i] ^= rstate->XAES[i];
+              rstate->RandAESKey[i] ^= (i < RANDAESBLOCKLEN) ? K[0][i] :
+                                                 K[1][i - RANDAESBLOCKLEN];
             }
 
           AESInit_l (&rstate->RandAESWorksp, AES_ECB, 192, NULL, &rstate->RandAESSched, 
                                                 rstate->RandAESKey, 256, AES_ENC);
+          memset (K, 0, sizeof (K));
         }
     }
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:  Increment of the counter of RandAES, big-endian modulo 2^192   */
+/*  Syntax:    void IncAES (AESBLOCK X)                                       */
+/*  Input:     X (Counter)                                                    */
+/*  Output:    X (Counter + 1)                                                */
+/*  Returns:   -                                                              */
+/*                                                                            */
+/******************************************************************************/
+static void
+IncAES (AESBLOCK X)
+{
+  int i;
+
+  for (i = RANDAESBLOCKLEN - 1; i >= 0 && 0 == ++X[i]; i--)
+    {
+      ;
+    }
+}
+
 
+/******************************************************************************/
+/*                                                                            */
+/*  Function:  Generation of one random byte by RandAES. The bytes of each    */
+/*             AES step are delivered one after the other, the state is       */
+/*             switched after RANDAESBLOCKLEN bytes                           */
+/*  Syntax:    UCHAR SwitchRandAES_l (STATEAES *rstate)                       */
+/*  Input:     rstate (Initialized state of PRNG)                             */
+/*  Output:    rstate (New internal state of PRNG)                            */
+/*  Returns:   One byte random value                                          */
+/*                                                                            */
+/******************************************************************************/
+UCHAR __FLINT_API
+SwitchRandAES_l (STATEAES *rstate)
+{
+  UCHAR rbyte;
+
+  if (rstate->PosAES >= RANDAESBLOCKLEN)
+    {
+      StepAES (rstate);
+    }
+
+  rbyte = rstate->OutAES[rstate->PosAES];
+
+#ifdef FLINT_SECURE
+  /* Security: Purge delivered random byte */
+  rstate->OutAES[rstate->PosAES] = 0;
+#endif
+
+  ++(rstate->PosAES);
   return rbyte;
 }
 
 
+/******************************************************************************/
+/*                                                                            */
+/*  Function:  Generation of 8, 16 and 32 bit random values by RandAES        */
+/*             Bytes are taken from the output buffer in big-endian order     */
+/*  Syntax:    UCHAR bRandAES_l (STATEAES *rstate);                           */
+/*             USHORT sRandAES_l (STATEAES *rstate);                          */
+/*             ULONG lRandAES_l (STATEAES *rstate);                           */
+/*  Input:     rstate (Initialized state of PRNG)                             */
+/*  Output:    rstate (New internal state of PRNG)                            */
+/*  Returns:   Random value                                                   */
+/*                                                                            */
+/******************************************************************************/
+UCHAR __FLINT_API
+bRandAES_l (STATEAES *rstate)
+{
+  return SwitchRandAES_l (rstate);
+}
+
+
+USHORT __FLINT_API
+sRandAES_l (STATEAES *rstate)
+{
+  USHORT r;
+  UCHAR *p;
+
+  if (rstate->PosAES + 2 > RANDAESBLOCKLEN)
+    {
+      r = (USHORT)SwitchRandAES_l (rstate) << 8;
+      return r | (USHORT)SwitchRandAES_l (rstate);
+    }
+
+  p = rstate->OutAES + rstate->PosAES;
+  rstate->PosAES += 2;
+  r = (USHORT)(((USHORT)p[0] << 8) | (USHORT)p[1]);
+
+#ifdef FLINT_SECURE
+  /* Security: Purge delivered random bytes */
+  local_memset (p, 0, 2);
+#endif
+
+  return r;
+}
+
+
+ULONG __FLINT_API
+lRandAES_l (STATEAES *rstate)
+{
+  ULONG r;
+  UCHAR *p;
+  int i;
+
+  if (rstate->PosAES + 4 > RANDAESBLOCKLEN)
+    {
+      for (r = 0, i = 0; i < 4; i++)
+        {
+          r = (r << 8) | (ULONG)SwitchRandAES_l (rstate);
+        }
+      return r;
+    }
+
+  p = rstate->OutAES + rstate->PosAES;
+  rstate->PosAES += 4;
+  r = ((ULONG)p[0] << 24) | ((ULONG)p[1] << 16) |
+      ((ULONG)p[2] <<  8) |  (ULONG)p[3];
+
+#ifdef FLINT_SECURE
+  /* Security: Purge delivered random bytes */
+  local_memset (p, 0, 4);
+#endif
+
+  return r;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:  Generation of a sequence of random bytes by RandAES            */
+/*             (Preceding Initialization by InitRandAES() required)           */
+/*             The output is the same byte stream as by repeated calls of     */
+/*             SwitchRandAES_l, whole AES steps are copied at once            */
+/*  Syntax:    int RandAESBytes_l (UCHAR *Buf, ULONG Len, STATEAES *rstate);  */
+/*  Input:     Len (Number of bytes to be generated)                          */
+/*             rstate (Initialized state of PRNG)                             */
+/*  Output:    Buf (Random bytes)                                             */
+/*             rstate (New internal state of PRNG)                            */
+/*  Returns:   E_CLINT_OK  if everything is OK                                */
+/*             E_CLINT_RIN if generator is not initialized                    */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+RandAESBytes_l (UCHAR *Buf, ULONG Len, STATEAES *rstate)
+{
+  ULONG n;
+
+  if (!rstate->RandAESInit)
+    {
+      return E_CLINT_RIN;
+    }
+
+  while (Len > 0)
+    {
+      if (rstate->PosAES >= RANDAESBLOCKLEN)
+        {
+          StepAES (rstate);
+        }
+
+      n = MIN (Len, (ULONG)(RANDAESBLOCKLEN - rstate->PosAES));
+      memcpy (Buf, rstate->OutAES + rstate->PosAES, (size_t)n);
+
+#ifdef FLINT_SECURE
+      /* Security: Purge delivered random bytes */
+      local_memset (rstate->OutAES + rstate->PosAES, 0, (size_t)n);
+#endif
+
+      rstate->PosAES += (unsigned)n;
+      Buf += n;
+      Len -= n;
+    }
+
+  return E_CLINT_OK;
+}
+
+
 /******************************************************************************/
 /*                                                                            */
 /*  Function:  Generation of pseudorandom number of CLINT-Type                */
@@ -370,6 +751,7 @@ RandAES_l (CLINT r_l, STATEAES *rstate, int l)
 {
   USHORT i, j;
   USHORT ls, lr;
+  UCHAR *p;
 
   if (!rstate->RandAESInit)
     {
@@ -380,13 +762,17 @@ RandAES_l (CLINT r_l, STATEAES *rstate, int l)
   ls = (USHORT) l >> LDBITPERDGT;
   lr = (USHORT) l & ((USHORT)BITPERDGT - 1);
 
-  for (i = 1; i <= ls; i++)
+  /* Fill digits with random bytes in one pass, then arrange each pair of */
+  /* bytes in big-endian order as done by sRandAES_l                      */
+  RandAESBytes_l ((UCHAR*)(r_l + 1), (ULONG)(ls + (lr > 0)) << 1, rstate);
+  for (i = 1; i <= ls + (lr > 0); i++)
     {
-      r_l[i] = sRandAES_l(rstate);
+      p = (UCHAR*)(r_l + i);
+      r_l[i] = (USHORT)(((USHORT)p[0] << 8) | (USHORT)p[1]);
     }
   if (lr > 0)
     {
-      r_l[++ls] = sRandAES_l(rstate);
+      ++ls;
       j = 1U << (lr - 1);                         /* j <- 2^(lr - 1) */
       r_l[ls] = (r_l[ls] | j) & ((j << 1) - 1);   /* Bit lr set to 1, higher bits to 0 */
     }
@@ -415,9 +801,11 @@ PurgeRandAES_l (STATEAES *rstate)
   /* Purge status of AES based PRNG */
   memset (rstate->RandAESKey, 0, sizeof (rstate->RandAESKey));
   memset (rstate->XAES, 0, sizeof (rstate->XAES));
+  memset (rstate->OutAES, 0, sizeof (rstate->OutAES));
   memset (&rstate->RandAESWorksp, 0, sizeof (rstate->RandAESWorksp));
   memset (&rstate->RandAESSched, 0, sizeof (rstate->RandAESSched));
   rstate->RoundAES = 0;
+  rstate->PosAES = 0;
 
   /* Reset initialization flag */
   rstate->RandAESInit = 0;
@@ -495,6 +883,8 @@ InitRandBBS_l (STATEBBS *rstate, char *UsrStr, int LenUsrStr, int AddEntropy)
 /******************************************************************************/
 /*                                                                            */
 /*  Function:  Initialization of BLUM-BLUM-SHUB-PRNG with seed of type CLINT  */
+/*             The state is kept in Montgomery form, the parameters of the    */
+/*             Montgomery reduction mod MODBBS are stored with the state      */
 /*  Syntax:    int SeedBBS_l (STATEBBS *rstate, CLINT seed_l);                */
 /*  Input:     seed_l (Seed)                                                  */
 /*  Output:    rstate (Internal state of PRNG)                                */
@@ -505,7 +895,8 @@ InitRandBBS_l (STATEBBS *rstate, char *UsrStr, int LenUsrStr, int AddEntropy)
 int __FLINT_API
 SeedBBS_l (STATEBBS *rstate, CLINT seed_l)
 {
-  CLINT g_l;
+  CLINT g_l, r_l;
+  unsigned int t;
 
   str2clint_l (rstate->MODBBS, (char*)MODBBSSTR, 16);
   gcd_l (rstate->MODBBS, seed_l, g_l);
@@ -515,15 +906,99 @@ SeedBBS_l (STATEBBS *rstate, CLINT seed_l)
       return E_CLINT_RCP;
     }
 
+  /* Parameters of Montgomery reduction mod MODBBS */
+  rstate->LogBRBBS = DIGITS_L (rstate->MODBBS);
+  rstate->NPrimeBBS = invmon_l (rstate->MODBBS);
+  SETZERO_L (r_l);
+  setbit_l (r_l, rstate->LogBRBBS << LDBITPERDGT);
+  if (DIGITS_L (r_l) > CLINTMAXDIGIT)
+    {
+      mod_l (r_l, rstate->MODBBS, r_l);
+    }
+
+  /* Number of bits per squaring: floor (log2 (log2 MODBBS)) */
+  for (rstate->BitsBBS = 0, t = ld_l (rstate->MODBBS); t > 1; t >>= 1)
+    {
+      ++(rstate->BitsBBS);
+    }
+
+  /* x0 = seed^2 mod MODBBS, transformed into Montgomery form */
   msqr_l (seed_l, rstate->XBBS, rstate->MODBBS);
+  mmul_l (rstate->XBBS, r_l, rstate->XBBS, rstate->MODBBS);
+
+  rstate->BitBufBBS = 0;
+  rstate->BitCntBBS = 0;
 
   /* Set Flag: PRNG is initialized */
   rstate->RandBBSInit = 1;
 
+  /* Security: Purge variables */
+  local_memset (g_l, 0, sizeof (g_l));
+
   return E_CLINT_OK;
 }
 
 
+/******************************************************************************/
+/*                                                                            */
+/*  Function:  One step of RandBBS: Squaring of the state by Montgomery       */
+/*             squaring, the BitsBBS least significant bits of the state      */
+/*             are appended to the bit buffer                                 */
+/*  Syntax:    void StepBBS (STATEBBS *rstate);                               */
+/*  Input:     rstate (Initialized internal state of PRNG)                    */
+/*  Output:    rstate (Internal state of PRNG)                                */
+/*  Returns:   -                                                              */
+/*                                                                            */
+/******************************************************************************/
+static void
+StepBBS (STATEBBS *rstate)
+{
+  CLINT x_l;
+
+  sqrmon_l (rstate->XBBS, rstate->MODBBS, rstate->NPrimeBBS, rstate->LogBRBBS, rstate->XBBS);
+
+  /* Output bits are taken from x = XBBS * r^(-1) mod MODBBS */
+  mulmon_l (rstate->XBBS, one_l, rstate->MODBBS, rstate->NPrimeBBS, rstate->LogBRBBS, x_l);
+
+  rstate->BitBufBBS = (rstate->BitBufBBS << rstate->BitsBBS) |
+                      ((ULONG)(EQZ_L (x_l) ? 0 : *LSDPTR_L (x_l)) & (((ULONG)1 << rstate->BitsBBS) - 1));
+  rstate->BitCntBBS += rstate->BitsBBS;
+
+  /* Security: Purge variables */
+  local_memset (x_l, 0, sizeof (x_l));
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:  Delivery of k <= 16 bits of the output stream of RandBBS       */
+/*  Syntax:    ULONG GetBitsBBS (STATEBBS *rstate, int k);                    */
+/*  Input:     rstate (Initialized internal state of PRNG)                    */
+/*             k (Number of bits)                                             */
+/*  Output:    rstate (Internal state of PRNG)                                */
+/*  Returns:   Next k bits, the first bit of the stream as most significant   */
+/*                                                                            */
+/******************************************************************************/
+static ULONG
+GetBitsBBS (STATEBBS *rstate, int k)
+{
+  ULONG r;
+
+  while (rstate->BitCntBBS < k)
+    {
+      StepBBS (rstate);
+    }
+
+  rstate->BitCntBBS -= k;
+  r = (rstate->BitBufBBS >> rstate->BitCntBBS) & (((ULONG)1 << k) - 1);
+
+  /* Keep only the bits not yet delivered */
+  rstate->BitBufBBS &= ((ULONG)1 << rstate->BitCntBBS) - 1;
+
+  return r;
+}
+
+
 /******************************************************************************/
 /*                                                                            */
 /*  Function:  Generation of a random bit acc. to Blum-Blum-Shub              */
@@ -536,10 +1011,7 @@ SeedBBS_l (STATEBBS *rstate, CLINT seed_l)
 int __FLINT_API
 SwitchRandBBS_l (STATEBBS * rstate)
 {
-  msqr_l (rstate->XBBS, rstate->XBBS, rstate->MODBBS);
-
-  /* Output least significant bit of rstate->XBBS */
-  return (*LSDPTR_L (rstate->XBBS) & 1);
+  return (int)GetBitsBBS (rstate, 1);
 }
 
 
@@ -555,14 +1027,7 @@ SwitchRandBBS_l (STATEBBS * rstate)
 UCHAR __FLINT_API
 bRandBBS_l (STATEBBS * rstate)
 {
-  int i;
-  UCHAR r = SwitchRandBBS_l(rstate);
-  for (i = 1; i < (sizeof (UCHAR) << 3); i++)
-    {
-      r = (r << 1) + SwitchRandBBS_l(rstate);
-    }
-
-  return r;
+  return (UCHAR)GetBitsBBS (rstate, 8);
 }
 
 
@@ -578,14 +1043,7 @@ bRandBBS_l (STATEBBS * rstate)
 USHORT __FLINT_API
 sRandBBS_l (STATEBBS * rstate)
 {
-  int i;
-  USHORT r = SwitchRandBBS_l(rstate);
-  for (i = 1; i < (sizeof (USHORT) << 3); i++)
-    {
-      r = (r << 1) + SwitchRandBBS_l(rstate);
-    }
-
-  return r;
+  return (USHORT)GetBitsBBS (rstate, 16);
 }
 
 
@@ -601,14 +1059,40 @@ sRandBBS_l (STATEBBS * rstate)
 ULONG __FLINT_API
 lRandBBS_l (STATEBBS * rstate)
 {
-  int i;
-  ULONG r = SwitchRandBBS_l(rstate);
-  for (i = 1; i < (sizeof (ULONG) << 3); i++)
+  ULONG r = GetBitsBBS (rstate, 16);
+  return (r << 16) | GetBitsBBS (rstate, 16);
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:  Generation of a sequence of random bytes by RandBBS            */
+/*             (Preceding Initialization by InitRandBBS() required)           */
+/*  Syntax:    int RandBBSBytes_l (UCHAR *Buf, ULONG Len, STATEBBS *rstate);  */
+/*  Input:     Len (Number of bytes to be generated)                          */
+/*             rstate (Initialized internal state of PRNG)                    */
+/*  Output:    Buf (Random bytes)                                             */
+/*             rstate (Internal state of PRNG)                                */
+/*  Returns:   E_CLINT_OK  if everything is OK                                */
+/*             E_CLINT_RIN if generator is not initialized                    */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+RandBBSBytes_l (UCHAR *Buf, ULONG Len, STATEBBS *rstate)
+{
+  ULONG i;
+
+  if (!rstate->RandBBSInit)
     {
-      r = (r << 1) + SwitchRandBBS_l (rstate);
+      return E_CLINT_RIN;
     }
 
-  return r;
+  for (i = 0; i < Len; i++)
+    {
+      Buf[i] = (UCHAR)GetBitsBBS (rstate, 8);
+    }
+
+  return E_CLINT_OK;
 }
 
 
@@ -642,13 +1126,13 @@ RandBBS_l (CLINT r_l, STATEBBS * rstate, int l)
 
   for (i = 1; i <= ls; i++)
     {
-      r_l[i] = sRandBBS_l (rstate);
+      r_l[i] = (USHORT)GetBitsBBS (rstate, 16);
     }
 
   if (lr > 0)
     {
       ++ls;
-      r_l[ls] = sRandBBS_l (rstate);
+      r_l[ls] = (USHORT)GetBitsBBS (rstate, 16);
       j = 1U << (lr - 1);                         /* j <- 2^(lr - 1) */
       r_l[ls] = (r_l[ls] | j) & ((j << 1) - 1);   /* bt lr to 1, higher bits to */
     }
@@ -683,6 +1167,8 @@ PurgeRandBBS_l (STATEBBS * rstate)
 {
   /* Purge status of BBS-PRNG */
   memset (rstate->XBBS, 0, sizeof (CLINT));
+  rstate->BitBufBBS = 0;
+  rstate->BitCntBBS = 0;
 
   /* Reset initialization flag */
   rstate->RandBBSInit = 0;
@@ -896,6 +1382,55 @@ Rand_l (CLINT r_l, STATEPRNG *xrstate, int l)
 }
 
 
+/******************************************************************************/
+/*                                                                            */
+/*  Function:  Generation of a sequence of pseudorandom bytes                 */
+/*             (Preceding Initialization by InitRand_l() required)            */
+/*  Syntax:    int RandBytes_l (UCHAR *Buf, ULONG Len, STATEPRNG *xrstate);   */
+/*  Input:     Len (Number of bytes to be generated)                          */
+/*             xrstate (Choice and initialized state of PRNG)                 */
+/*  Output:    Buf (Pseudorandom bytes)                                       */
+/*             xrstate (State of chosen PRNG)                                 */
+/*  Returns:   E_CLINT_OK  if everything is OK                                */
+/*             E_CLINT_RIN if requested generator is not initialized or       */
+/*                         invalid choice                                     */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+RandBytes_l (UCHAR *Buf, ULONG Len, STATEPRNG *xrstate)
+{
+  int error = E_CLINT_OK;
+  ULONG i;
+
+  switch (xrstate->Generator)
+    {
+      case FLINT_RNDAES:
+        error = RandAESBytes_l (Buf, Len, &xrstate->StateAES);
+        break;
+      case FLINT_RNDRMDSHA1:
+        error = RandRMDSHA1Bytes_l (Buf, Len, &xrstate->StateRMDSHA1);
+        break;
+      case FLINT_RNDBBS:
+        error = RandBBSBytes_l (Buf, Len, &xrstate->StateBBS);
+        break;
+      case FLINT_RND64:
+        for (i = 0; i < Len; i++)
+          {
+            Buf[i] = ucrand64_l ();
+          }
+        break;
+      default:
+        for (i = 0; i < Len; i++)
+          {
+            Buf[i] = ucrand64_l ();
+          }
+        error = E_CLINT_RIN;
+    }
+
+  return error;
+}
+
+
 /******************************************************************************/
 /*                                                                            */
 /*  Function:  Purging of the internal state of a chosen PRNG                 */
@@ -1087,6 +1622,9 @@ FindPrimeGcd_l (CLINT p_l, STATEPRNG *xrstate, USHORT l, CLINT f_l)
 /*  Function:  Generation of a random prime p_l of type CLINT                 */
 /*             w/ rmin_l <= p_l <= rmax_l und ggT (p_l - 1, f_l) = 1, using   */
 /*             one of the FLINT/C PRNG, preceeding initialization required!   */
+/*             Starting from a random odd number, intervals of consecutive    */
+/*             odd candidates are sieved by small primes, only the remaining  */
+/*             candidates are subjected to the MR-Test.                       */
 /*  Syntax:    int FindPrimeMinMaxGcd_l (CLINT p_l, STATEPRNG *xrstate,       */
 /*                                    CLINT rmin_l, CLINT rmax_l, CLINT f_l); */
 /*  Input:     xrstate (Choice and initialized state of PRNG)                 */
@@ -1106,9 +1644,13 @@ int __FLINT_API
 FindPrimeMinMaxGcd_l (CLINT p_l, STATEPRNG *xrstate, CLINT rmin_l, 
                                                      CLINT rmax_l, CLINT f_l)
 {
-  CLINT t_l, rmin1_l, g_l;
+  CLINT lo_l, hi_l, base_l, t_l, rmin1_l, g_l;
   CLINT Pi_rmin_l, Pi_rmax_l, NoofCandidates_l, junk_l;
-  int error;
+  USHORT q[SIEVEPRIMES], r[SIEVEPRIMES], d[SIEVEPRIMES];
+  UCHAR sieve[SIEVEWINDOW];
+  USHORT qv, s;
+  unsigned int i, j, n;
+  int sieving, last, found = 0, error;
 
   /* 0 < f_l has to be uneven */
   if (ISEVEN_L (f_l))
@@ -1120,49 +1662,167 @@ FindPrimeMinMaxGcd_l (CLINT p_l, STATEPRNG *xrstate, CLINT rmin_l,
   udiv_l (rmax_l, (USHORT)ld_l (rmax_l), Pi_rmax_l, junk_l);
   sub_l (Pi_rmax_l, Pi_rmin_l, NoofCandidates_l);
 
-  /* rmin_l <- ceil ((rmin_l - 1)/2) */
-  dec_l (rmin_l);
-  div_l (rmin_l, two_l, rmin_l, junk_l);
+  /* Odd small primes q[i] used for sieving and 2*SIEVEWINDOW mod q[i] */
+  for (qv = 2, i = 0; i < SIEVEPRIMES; i++)
+    {
+      qv += smallprimes[i + 1];
+      q[i] = qv;
+      d[i] = (USHORT)((2 * SIEVEWINDOW) % qv);
+    }
+
+  /* Sieving requires that no candidate equals one of the primes q[i] */
+  u2clint_l (t_l, q[SIEVEPRIMES - 1]);
+  sieving = GT_L (rmin_l, t_l);
+
+  /* lo_l <- ceil ((rmin_l - 1)/2) */
+  cpy_l (lo_l, rmin_l);
+  dec_l (lo_l);
+  div_l (lo_l, two_l, lo_l, junk_l);
   if (GTZ_L (junk_l))
     {
-      inc_l (rmin_l);
-    }  
+      inc_l (lo_l);
+    }
 
-  /* rmax_l <- floor ((rmax_l - 1)/2) */
-  dec_l (rmax_l);
-  shr_l (rmax_l);
+  /* hi_l <- floor ((rmax_l - 1)/2) */
+  cpy_l (hi_l, rmax_l);
+  dec_l (hi_l);
+  shr_l (hi_l);
 
   do
     {
       /* Test if estimated number of candidates is counted back to zero */
       if (EQZ_L (NoofCandidates_l))
-	{
-          return (E_CLINT_RGE);
-	}
+        {
+          error = E_CLINT_RGE;
+          break;
+        }
 
-      if (E_CLINT_OK != (error = RandMinMax_l (p_l, xrstate, rmin_l, rmax_l)))
+      if (E_CLINT_OK != (error = RandMinMax_l (p_l, xrstate, lo_l, hi_l)))
         {
-          return error;
+          break;
         }
 
-      /* p_l <- 2*p_l + 1 hence p_l is odd */
-      shl_l (p_l);
-      inc_l (p_l);
+      if (!sieving)
+        {
+          /* p_l <- 2*p_l + 1 hence p_l is odd */
+          shl_l (p_l);
+          inc_l (p_l);
 
-      cpy_l (rmin1_l, p_l);
-      dec_l (rmin1_l);
-      gcd_l (rmin1_l, f_l, g_l);
+          cpy_l (rmin1_l, p_l);
+          dec_l (rmin1_l);
+          gcd_l (rmin1_l, f_l, g_l);
 
-      dec_l (NoofCandidates_l);
-    }
-  while (!(EQONE_L (g_l) && ISPRIME_L (p_l)));
+          dec_l (NoofCandidates_l);
+          found = EQONE_L (g_l) && ISPRIME_L (p_l);
+          continue;
+        }
+
+      /* Incremental search: candidates are the odd numbers base_l + 2*j */
+      /* starting at the random number 2*p_l + 1. The residues of base_l */
+      /* modulo the small primes are computed only once and are carried */
+      /* over from one window to the next by addition.                   */
+      sub_l (hi_l, p_l, t_l);
+      cpy_l (base_l, p_l);
+      shl_l (base_l);
+      inc_l (base_l);
+
+      for (i = 0; i < SIEVEPRIMES; i++)
+        {
+          r[i] = umod_l (base_l, q[i]);
+        }
 
+      do
+        {
+          /* Number n of odd candidates in this window up to rmax_l */
+          if (DIGITS_L (t_l) > 1 ||
+              (DIGITS_L (t_l) == 1 && *LSDPTR_L (t_l) >= SIEVEWINDOW))
+            {
+              n = SIEVEWINDOW;
+              last = 0;
+            }
+          else
+            {
+              n = EQZ_L (t_l) ? 1 : (unsigned int)*LSDPTR_L (t_l) + 1;
+              last = 1;
+            }
+
+          /* Mark base_l + 2*j if it is divisible by one of the q[i]: */
+          /* j = -r/2 mod q, with s = q - r and 1/2 = (q + 1)/2 mod q */
+          memset (sieve, 0, n);
+          for (i = 0; i < SIEVEPRIMES; i++)
+            {
+              s = (r[i] == 0) ? 0 : q[i] - r[i];
+              for (j = (s & 1) ? (s + q[i]) >> 1 : s >> 1; j < n; j += q[i])
+                {
+                  sieve[j] = 1;
+                }
+            }
+
+          for (j = 0; j < n && !found; j++)
+            {
+              if (sieve[j])
+                {
+                  continue;
+                }
+
+              if (EQZ_L (NoofCandidates_l))
+                {
+                  break;
+                }
+
+              uadd_l (base_l, (USHORT)(2 * j), p_l);
+
+              cpy_l (rmin1_l, p_l);
+              dec_l (rmin1_l);
+              gcd_l (rmin1_l, f_l, g_l);
+
+              dec_l (NoofCandidates_l);
+
+              /* Trial division is already done by the sieve */
+              found = EQONE_L (g_l) && prime_l (p_l, 1, 0);
+            }
+
+          if (found || last || EQZ_L (NoofCandidates_l))
+            {
+              break;
+            }
+
+          /* Advance base_l to the next window */
+          u2clint_l (g_l, (USHORT)(2 * SIEVEWINDOW));
+          add_l (base_l, g_l, base_l);
+          u2clint_l (g_l, SIEVEWINDOW);
+          sub_l (t_l, g_l, t_l);
+          for (i = 0; i < SIEVEPRIMES; i++)
+            {
+              if (r[i] >= q[i] - d[i])
+                {
+                  r[i] -= q[i] - d[i];
+                }
+              else
+                {
+                  r[i] += d[i];
+                }
+            }
+        }
+      while (!found);
+
+      if (!found && GTZ_L (NoofCandidates_l))
+        {
+          dec_l (NoofCandidates_l);
+        }
+    }
+  while (!found);
 
 #ifdef FLINT_SECURE
   /* Purging of variables */
+  local_memset (lo_l, 0, sizeof (lo_l));
+  local_memset (hi_l, 0, sizeof (hi_l));
+  local_memset (base_l, 0, sizeof (base_l));
   local_memset (t_l, 0, sizeof (t_l));
   local_memset (rmin1_l, 0, sizeof (rmin1_l));
   local_memset (g_l, 0, sizeof (g_l));
+  local_memset (r, 0, sizeof (r));
+  local_memset (sieve, 0, sizeof (sieve));
 #endif
 
   return error;
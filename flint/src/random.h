@@ -81,17 +81,27 @@ extern "C" {
 
 #define InitRand64           InitRand64_l
 #define InitRandRMDSHA1      InitRandRMDSHA1_l
+#define SeedRandRMDSHA1      SeedRandRMDSHA1_l
 #define SwitchRandRMDSHA1    SwitchRandRMDSHA1_l
 #define PurgeRandRMDSHA1     PurgeRandRMDSHA1_l
+#define RandRMDSHA1Bytes     RandRMDSHA1Bytes_l
+#define bRandRMDSHA1         bRandRMDSHA1_l
+#define sRandRMDSHA1         sRandRMDSHA1_l
+#define lRandRMDSHA1         lRandRMDSHA1_l
 #define InitRandAES	     InitRandAES_l
 #define SwitchRandAES	     SwitchRandAES_l    
 #define PurgeRandAES	     PurgeRandAES_l  
+#define RandAESBytes         RandAESBytes_l
+#define bRandAES             bRandAES_l
+#define sRandAES             sRandAES_l
+#define lRandAES             lRandAES_l
 #define InitRandBBS	     InitRandBBS_l   
 #define SwitchRandBBS	     SwitchRandBBS_l    
 #define bRandBBS	     bRandBBS_l  
 #define sRandBBS	     sRandBBS_l       
 #define lRandBBS	     lRandBBS_l       
 #define PurgeRandBBS         PurgeRandBBS_l
+#define RandBBSBytes         RandBBSBytes_l
 #define ulrandBBS_l          lRandBBS_l
 #define usrandBBS_l          sRandBBS_l
 #define ucrandBBS_l          bRandBBS_l
@@ -101,50 +111,13 @@ extern "C" {
 #define initrandBBS_lt()     InitRandBBS_l("", 0, 0);
 
 
-/* Macros that generate random numbers using RipeMD-160 SHA-1 based PRNG */
+/* Number of output bytes per step of RandRMDSHA1 (SHA-1 digest) */
 
-/* 8 bit unsigned */
-#define bRandRMDSHA1(S)   ((UCHAR)SwitchRandRMDSHA1_l((S)))
-#define bRandRMDSHA1_l(S) ((UCHAR)SwitchRandRMDSHA1_l((S)))
+#define RANDRMDSHA1BLOCKLEN  20
 
-/* 16 bit unsigned */
-#define sRandRMDSHA1(S)   (((USHORT)SwitchRandRMDSHA1_l((S)) << 8) | \
-                           (USHORT)SwitchRandRMDSHA1_l((S)))
-#define sRandRMDSHA1_l(S) (((USHORT)SwitchRandRMDSHA1_l((S)) << 8) | \
-                           (USHORT)SwitchRandRMDSHA1_l((S)))
-/* 32 bit unsigned */
-#define lRandRMDSHA1(S)   (((ULONG)SwitchRandRMDSHA1_l((S)) << 24) | \
-                           ((ULONG)SwitchRandRMDSHA1_l((S)) << 16) | \
-                           ((ULONG)SwitchRandRMDSHA1_l((S)) <<  8) | \
-                            (ULONG)SwitchRandRMDSHA1_l((S))      )    
+/* Number of output bytes per AES step of RandAES (block length 192 bit) */
 
-#define lRandRMDSHA1_l(S) (((ULONG)SwitchRandRMDSHA1_l((S)) << 24) | \
-                           ((ULONG)SwitchRandRMDSHA1_l((S)) << 16) | \
-                           ((ULONG)SwitchRandRMDSHA1_l((S)) <<  8) | \
-                            (ULONG)SwitchRandRMDSHA1_l((S))      )    
-
-
-/* Macros that generate random numbers using AES based PRNG */
-
-/* 8 bit unsigned */
-#define bRandAES(S)       ((UCHAR)SwitchRandAES_l((S)))
-#define bRandAES_l(S)     ((UCHAR)SwitchRandAES_l((S)))
-
-/* 16 bit unsigned */
-#define sRandAES(S)       (((USHORT)SwitchRandAES_l((S)) << 8) | \
-                            (USHORT)SwitchRandAES_l((S)))
-#define sRandAES_l(S)     (((USHORT)SwitchRandAES_l((S)) << 8) | \
-                            (USHORT)SwitchRandAES_l((S)))
-/* 32 bit unsigned */
-#define lRandAES(S)       (((ULONG)SwitchRandAES_l((S)) << 24) | \
-                           ((ULONG)SwitchRandAES_l((S)) << 16) | \
-                           ((ULONG)SwitchRandAES_l((S)) <<  8) | \
-                            (ULONG)SwitchRandAES_l((S))      )    
-
-#define lRandAES_l(S)     (((ULONG)SwitchRandAES_l((S)) << 24) | \
-                           ((ULONG)SwitchRandAES_l((S)) << 16) | \
-                           ((ULONG)SwitchRandAES_l((S)) <<  8) | \
-                            (ULONG)SwitchRandAES_l((S))      )    
+#define RANDAESBLOCKLEN      24
 
 
 struct InternalStateRMDSHA1
@@ -153,24 +126,32 @@ struct InternalStateRMDSHA1
   UCHAR XRMDSHA1[20];   
   unsigned RoundRMDSHA1;
   int RandRMDSHA1Init;
+  unsigned PosRMDSHA1;
 };
 
 struct InternalStateAES
 {
-  AESBLOCK XAES;
-  UCHAR RandAESKey[32];
+  AESBLOCK XAES;          /* Secret counter, never output */
+  AESBLOCK OutAES;        /* Output buffer, encryption of the counter */
+  UCHAR RandAESKey[32];   /* Secret key derived from the entropy */
   AESWORKSPACE RandAESWorksp;
   AESKEYSCHED RandAESSched;
   unsigned RoundAES;
   unsigned RandAESInit;
   unsigned UpdateKeyAES;
+  unsigned PosAES;
 };
 
 struct InternalStateBBS
 {
-  CLINT XBBS;           
+  CLINT XBBS;             /* State in Montgomery form XBBS = x*r mod MODBBS */
   CLINT MODBBS;       
   int RandBBSInit;
+  USHORT NPrimeBBS;       /* -MODBBS^(-1) mod B */
+  USHORT LogBRBBS;        /* r = B^LogBRBBS */
+  int BitsBBS;            /* Number of output bits per squaring */
+  ULONG BitBufBBS;        /* Output bits not yet delivered */
+  int BitCntBBS;          /* Number of bits in BitBufBBS */
 };
 
 typedef struct InternalStateRMDSHA1 STATERMDSHA1;
@@ -199,12 +180,27 @@ InitRand64_l (char *UsrStr, int LenUsrStr, int AddEntropy);
 extern int __FLINT_API
 InitRandRMDSHA1_l (STATERMDSHA1 *state, char *UsrStr, int LenUsrStr, int AddEntropy);
 
+extern int __FLINT_API
+SeedRandRMDSHA1_l (STATERMDSHA1 *state, UCHAR *Seed, int LenSeed);
+
 extern UCHAR __FLINT_API
 SwitchRandRMDSHA1_l (STATERMDSHA1 *state);
 
 extern int __FLINT_API
 RandRMDSHA1_l (CLINT a_l, STATERMDSHA1 *state, int l);
 
+extern int __FLINT_API
+RandRMDSHA1Bytes_l (UCHAR *Buf, ULONG Len, STATERMDSHA1 *state);
+
+extern UCHAR __FLINT_API
+bRandRMDSHA1_l (STATERMDSHA1 *state);
+
+extern USHORT __FLINT_API
+sRandRMDSHA1_l (STATERMDSHA1 *state);
+
+extern ULONG __FLINT_API
+lRandRMDSHA1_l (STATERMDSHA1 *state);
+
 extern void __FLINT_API
 PurgeRandRMDSHA1_l (STATERMDSHA1 *state);
 
@@ -220,6 +216,18 @@ SwitchRandAES_l (STATEAES *StateAES);
 extern int __FLINT_API
 RandAES_l (CLINT a_l, STATEAES *StateAES, int l);
 
+extern int __FLINT_API
+RandAESBytes_l (UCHAR *Buf, ULONG Len, STATEAES *StateAES);
+
+extern UCHAR __FLINT_API
+bRandAES_l (STATEAES *StateAES);
+
+extern USHORT __FLINT_API
+sRandAES_l (STATEAES *StateAES);
+
+extern ULONG __FLINT_API
+lRandAES_l (STATEAES *StateAES);
+
 extern void __FLINT_API
 PurgeRandAES_l (STATEAES *StateAES);
 
@@ -238,6 +246,9 @@ SeedBBS_l (STATEBBS *, CLINT);
 extern int __FLINT_API  
 RandBBS_l (CLINT, STATEBBS * ws, int);
 
+extern int __FLINT_API  
+RandBBSBytes_l (UCHAR *Buf, ULONG Len, STATEBBS *state);
+
 extern UCHAR __FLINT_API  
 bRandBBS_l (STATEBBS *state);
 
@@ -269,6 +280,9 @@ lRand_l (STATEPRNG *);
 int __FLINT_API
 Rand_l (CLINT r_l, STATEPRNG *, int l);
 
+int __FLINT_API
+RandBytes_l (UCHAR *, ULONG, STATEPRNG *);
+
 int __FLINT_API
 PurgeRand_l (STATEPRNG *);
 
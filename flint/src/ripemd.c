@@ -71,6 +71,8 @@ static void digest (ULONG *, UCHAR *, ULONG[]);
 static void appetize128 (ULONG *);
 static void swallow128 (ULONG *, ULONG *);
 static void digest128 (ULONG *, UCHAR *, ULONG[]);
+static void StatExport (UCHAR *, const char *, ULONG *, int, ULONG[]);
+static int StatImport (ULONG *, ULONG[], UCHAR *, ULONG, const char *, int);
 
 #ifdef FLINT_SECURE
 static inline void ZeroUlong (ULONG *);
@@ -84,15 +86,30 @@ static inline void ZeroUcharArray (void *, size_t);
 /* Rotation, simulation of assembler instruction for barrel shifting */
 #define ROL(X, N)   (((X) << (N)) | ((X) >> (32-(N))))
 
-/* RIPEMD specific chaining of intermediate values in rounds */
-#define CHAIN128(A, B, C, D, X, S) { \
-          (A) = (D); (D) = (C); (C) = (B); \
-          (B) = ROL((X), (S)); \
+/* Boolean functions of the rounds. The left line uses F1, ..., F5 and  */
+/* the right line F5, ..., F1 (RIPEMD-128: F1, ..., F4 and F4, ..., F1) */
+#define F1(X, Y, Z)  ((X) ^ (Y) ^ (Z))
+#define F2(X, Y, Z)  ((Z) ^ ((X) & ((Y) ^ (Z))))
+#define F3(X, Y, Z)  (((X) | ~(Y)) ^ (Z))
+#define F4(X, Y, Z)  ((Y) ^ ((Z) & ((X) ^ (Y))))
+#define F5(X, Y, Z)  ((X) ^ ((Y) | ~(Z)))
+
+/* RIPEMD specific steps. Instead of moving the chaining variables, the */
+/* roles of the variables rotate from step to step: STEP160 (F, a, b,   */
+/* c, d, e, ...) is followed by STEP160 (F, e, a, b, c, d, ...), and    */
+/* STEP128 (F, a, b, c, d, ...) by STEP128 (F, d, a, b, c, ...). The    */
+/* steps are unrolled with constant message words and rotations, and    */
+/* the steps of the left and right lines alternate, so that the         */
+/* processor executes both independent lines in parallel.               */
+#define STEP160(F, A, B, C, D, E, X, K, S) { \
+          (A) += F ((B), (C), (D)) + (X) + (K); \
+          (A) = ROL ((A), (S)) + (E); \
+          (C) = ROL ((C), 10); \
         }
 
-#define CHAIN160(A, B, C, D, E, X, S) { \
-          (A) = (E); (E) = (D); (D) = ROL((C), 10); (C) = (B); \
-          (B) = ROL((X), (S)) + (A); \
+#define STEP128(F, A, B, C, D, X, K, S) { \
+          (A) += F ((B), (C), (D)) + (X) + (K); \
+          (A) = ROL ((A), (S)); \
         }
 
 /* Conversion of an array of type UCHAR into a value of type ULONG */
@@ -107,6 +124,24 @@ static inline void ZeroUcharArray (void *, size_t);
 #endif
 
 
+/* Conversion of an array of type UCHAR into a value of type ULONG */
+/* in Big-Endian representation as used by the exported status */
+#define UC2ULBE(ucptr) \
+          (((unsigned long) *((ucptr)+3)      ) | \
+           ((unsigned long) *((ucptr)+2) <<  8) | \
+           ((unsigned long) *((ucptr)+1) << 16) | \
+           ((unsigned long) *(ucptr)     << 24))
+
+/* Conversion of a value of type ULONG into an array of type UCHAR in */
+/* Big-Endian representation, inverse of UC2ULBE */
+#define UL2UCBE(ucptr, ul) { \
+          *(ucptr)     = (UCHAR)((ul) >> 24); \
+          *((ucptr)+1) = (UCHAR)((ul) >> 16); \
+          *((ucptr)+2) = (UCHAR)((ul) >>  8); \
+          *((ucptr)+3) = (UCHAR) (ul);        \
+        }
+
+
 /* Addition of a single-digit number b to a double-digit number represented */
 /* by an array (a[1],a[0]). A carry in a[0]+=b is handled by increasing a[1]. */
 #define ADDC(a, b) { \
@@ -114,40 +149,6 @@ static inline void ZeroUcharArray (void *, size_t);
           (a)[0] += (b); \
         }
 
-/* Constants */
-/* Choice of message words... */
-static const int
-r1[] = { 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15,
-         7,  4, 13,  1, 10,  6, 15,  3, 12,  0,  9,  5,  2, 14, 11,  8,
-         3, 10, 14,  4,  9, 15,  8,  1,  2,  7,  0,  6, 13, 11,  5, 12,
-         1,  9, 11, 10,  0,  8, 12,  4, 13,  3,  7, 15, 14,  5,  6,  2,
-         4,  0,  5,  9,  7, 12,  2, 10, 14,  1,  3,  8, 11,  6, 15, 13};
-
-/* ... for parallel rounds */
-static const int
-r2[] = { 5, 14,  7,  0,  9,  2, 11,  4, 13,  6, 15,  8,  1, 10,  3, 12,
-         6, 11,  3,  7,  0, 13,  5, 10, 14, 15,  8, 12,  4,  9,  1,  2,
-        15,  5,  1,  3,  7, 14,  6,  9, 11,  8, 12,  2, 10,  0,  4, 13,
-         8,  6,  4,  1,  3, 11, 15,  0,  5, 12,  2, 13,  9,  7, 10, 14,
-        12, 15, 10,  4,  1,  5,  8,  7,  6,  2, 13, 14,  0,  3,  9, 11};
-
-/* Length of rotations... */
-static const int
-s1[] = {11, 14, 15, 12,  5,  8,  7,  9, 11, 13, 14, 15,  6,  7,  9,  8,
-         7,  6,  8, 13, 11,  9,  7, 15,  7, 12, 15,  9, 11,  7, 13, 12,
-        11, 13,  6,  7, 14,  9, 13, 15, 14,  8, 13,  6,  5, 12,  7,  5,
-        11, 12, 14, 15, 14, 15,  9,  8,  9, 14,  5,  6,  8,  6,  5, 12,
-         9, 15,  5, 11,  6,  8, 13, 12,  5, 12, 13, 14, 11,  8,  5,  6};
-
-/* ... for parallel rounds */
-static const int
-s2[] = { 8,  9,  9, 11, 13, 15, 15,  5,  7,  7,  8, 11, 14, 14, 12,  6,
-         9, 13, 15,  7, 12,  8,  9, 11,  7,  7, 12,  7,  6, 15, 13, 11,
-         9,  7, 15, 11,  8,  6,  6, 14, 12, 13,  5, 14, 13, 13,  7,  5,
-        15,  5,  8, 11, 14, 14,  6, 14,  6,  9, 12,  9, 12,  5, 15,  8,
-         8,  5, 12,  9, 12,  5, 14,  6,  8, 13,  6,  5, 15, 13, 11, 11};
-
-
 /*****************************************************************************/
 /* RIPEMD-160 API                                                            */
 /*****************************************************************************/
@@ -450,6 +451,108 @@ ripefinish128_l (UCHAR *HashRes, RMDSTAT *hws, UCHAR *clear, ULONG length)
 }
 
 
+/******************************************************************************/
+/* Functions for cloning, exporting and importing the status between the      */
+/* blockwise hashing steps of RIPEMD-160 and RIPEMD-128. A status exported    */
+/* with ripeexport or ripeexport128 can be hashed further after ripeimport    */
+/* or ripeimport128, also in another process or on another platform.        */
+/******************************************************************************/
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Copy of a RIPEMD-160 or RIPEMD-128 status, e.g. to continue   */
+/*              a common prefix with different messages                       */
+/*  Syntax:     void ripeclone_l (RMDSTAT *dst, RMDSTAT *src);                */
+/*  Input:      RMDSTAT *src (RIPEMD status buffer)                           */
+/*  Output:     RMDSTAT *dst (Copy of the status buffer)                      */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+void __FLINT_API
+ripeclone_l (RMDSTAT *dst, RMDSTAT *src)
+{
+  *dst = *src;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Export of a RIPEMD-160 status in portable byte format         */
+/*  Syntax:     void ripeexport_l (UCHAR *Buf, RMDSTAT *hws);                 */
+/*  Input:      RMDSTAT *hws (RIPEMD-160 status buffer)                       */
+/*  Output:     UCHAR *Buf (Exported status, RMDSTATLEN bytes)                */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+void __FLINT_API
+ripeexport_l (UCHAR *Buf, RMDSTAT *hws)
+{
+  StatExport (Buf, "R160", hws->stomach, 5, hws->total);
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Import of a RIPEMD-160 status exported by ripeexport_l        */
+/*  Syntax:     int ripeimport_l (RMDSTAT *hws, UCHAR *Buf, ULONG Len);       */
+/*  Input:      UCHAR *Buf (Exported status)                                  */
+/*              ULONG Len (Length of Buf in bytes)                            */
+/*  Output:     RMDSTAT *hws (RIPEMD-160 status buffer)                       */
+/*  Returns:    E_CLINT_OK if everything is O.K.                              */
+/*              E_CLINT_RMD if Buf does not hold a RIPEMD-160 status          */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+ripeimport_l (RMDSTAT *hws, UCHAR *Buf, ULONG Len)
+{
+  if (StatImport (hws->stomach, hws->total, Buf, Len, "R160", 5))
+    {
+      return E_CLINT_RMD;
+    }
+
+  return 0;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Export of a RIPEMD-128 status in portable byte format         */
+/*  Syntax:     void ripeexport128_l (UCHAR *Buf, RMDSTAT *hws);              */
+/*  Input:      RMDSTAT *hws (RIPEMD-128 status buffer)                       */
+/*  Output:     UCHAR *Buf (Exported status, RMD128STATLEN bytes)             */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+void __FLINT_API
+ripeexport128_l (UCHAR *Buf, RMDSTAT *hws)
+{
+  StatExport (Buf, "R128", hws->stomach, 4, hws->total);
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Import of a RIPEMD-128 status exported by ripeexport128_l     */
+/*  Syntax:     int ripeimport128_l (RMDSTAT *hws, UCHAR *Buf, ULONG Len);    */
+/*  Input:      UCHAR *Buf (Exported status)                                  */
+/*              ULONG Len (Length of Buf in bytes)                            */
+/*  Output:     RMDSTAT *hws (RIPEMD-128 status buffer)                       */
+/*  Returns:    E_CLINT_OK if everything is O.K.                              */
+/*              E_CLINT_RMD if Buf does not hold a RIPEMD-128 status          */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+ripeimport128_l (RMDSTAT *hws, UCHAR *Buf, ULONG Len)
+{
+  if (StatImport (hws->stomach, hws->total, Buf, Len, "R128", 4))
+    {
+      return E_CLINT_RMD;
+    }
+
+  return 0;
+}
+
+
 /******************************************************************************/
 /* RIPEMD-160 kernel functions                                                */
 /******************************************************************************/
@@ -470,9 +573,6 @@ appetize (ULONG *stomach)
 static void
 swallow (ULONG *stomach, ULONG *ULBlock)
 {
-  int round, rol;
-  ULONG x;
-
   ULONG a1 = stomach[0];
   ULONG b1 = stomach[1];
   ULONG c1 = stomach[2];
@@ -485,67 +585,175 @@ swallow (ULONG *stomach, ULONG *ULBlock)
   ULONG d2 = stomach[3];
   ULONG e2 = stomach[4];
 
-  /*lint -e123 Don't complain about "Macros ... defined with arguments" */
-
   /* Rounds and parallel rounds 0-15 */
-  for (round = 0; round < 16; round++)
-    {
-      rol = s1[round];
-      x = a1 + (b1 ^ c1 ^ d1) + ULBlock[round];
-      CHAIN160 (a1, b1, c1, d1, e1, x, rol);
-
-      rol = s2[round];
-      x = a2 + (b2 ^ (c2 | ~d2)) + ULBlock[r2[round]] + 0x50a28BE6UL;
-      CHAIN160 (a2, b2, c2, d2, e2, x, rol);
-    }
+  STEP160 (F1, a1, b1, c1, d1, e1, ULBlock[ 0], 0x00000000UL, 11);
+  STEP160 (F5, a2, b2, c2, d2, e2, ULBlock[ 5], 0x50a28be6UL,  8);
+  STEP160 (F1, e1, a1, b1, c1, d1, ULBlock[ 1], 0x00000000UL, 14);
+  STEP160 (F5, e2, a2, b2, c2, d2, ULBlock[14], 0x50a28be6UL,  9);
+  STEP160 (F1, d1, e1, a1, b1, c1, ULBlock[ 2], 0x00000000UL, 15);
+  STEP160 (F5, d2, e2, a2, b2, c2, ULBlock[ 7], 0x50a28be6UL,  9);
+  STEP160 (F1, c1, d1, e1, a1, b1, ULBlock[ 3], 0x00000000UL, 12);
+  STEP160 (F5, c2, d2, e2, a2, b2, ULBlock[ 0], 0x50a28be6UL, 11);
+  STEP160 (F1, b1, c1, d1, e1, a1, ULBlock[ 4], 0x00000000UL,  5);
+  STEP160 (F5, b2, c2, d2, e2, a2, ULBlock[ 9], 0x50a28be6UL, 13);
+  STEP160 (F1, a1, b1, c1, d1, e1, ULBlock[ 5], 0x00000000UL,  8);
+  STEP160 (F5, a2, b2, c2, d2, e2, ULBlock[ 2], 0x50a28be6UL, 15);
+  STEP160 (F1, e1, a1, b1, c1, d1, ULBlock[ 6], 0x00000000UL,  7);
+  STEP160 (F5, e2, a2, b2, c2, d2, ULBlock[11], 0x50a28be6UL, 15);
+  STEP160 (F1, d1, e1, a1, b1, c1, ULBlock[ 7], 0x00000000UL,  9);
+  STEP160 (F5, d2, e2, a2, b2, c2, ULBlock[ 4], 0x50a28be6UL,  5);
+  STEP160 (F1, c1, d1, e1, a1, b1, ULBlock[ 8], 0x00000000UL, 11);
+  STEP160 (F5, c2, d2, e2, a2, b2, ULBlock[13], 0x50a28be6UL,  7);
+  STEP160 (F1, b1, c1, d1, e1, a1, ULBlock[ 9], 0x00000000UL, 13);
+  STEP160 (F5, b2, c2, d2, e2, a2, ULBlock[ 6], 0x50a28be6UL,  7);
+  STEP160 (F1, a1, b1, c1, d1, e1, ULBlock[10], 0x00000000UL, 14);
+  STEP160 (F5, a2, b2, c2, d2, e2, ULBlock[15], 0x50a28be6UL,  8);
+  STEP160 (F1, e1, a1, b1, c1, d1, ULBlock[11], 0x00000000UL, 15);
+  STEP160 (F5, e2, a2, b2, c2, d2, ULBlock[ 8], 0x50a28be6UL, 11);
+  STEP160 (F1, d1, e1, a1, b1, c1, ULBlock[12], 0x00000000UL,  6);
+  STEP160 (F5, d2, e2, a2, b2, c2, ULBlock[ 1], 0x50a28be6UL, 14);
+  STEP160 (F1, c1, d1, e1, a1, b1, ULBlock[13], 0x00000000UL,  7);
+  STEP160 (F5, c2, d2, e2, a2, b2, ULBlock[10], 0x50a28be6UL, 14);
+  STEP160 (F1, b1, c1, d1, e1, a1, ULBlock[14], 0x00000000UL,  9);
+  STEP160 (F5, b2, c2, d2, e2, a2, ULBlock[ 3], 0x50a28be6UL, 12);
+  STEP160 (F1, a1, b1, c1, d1, e1, ULBlock[15], 0x00000000UL,  8);
+  STEP160 (F5, a2, b2, c2, d2, e2, ULBlock[12], 0x50a28be6UL,  6);
 
   /* Rounds and parallel rounds 16-31 */
-  for (round = 16; round < 32; round++)
-    {
-      rol = s1[round];
-      x = a1 + (d1 ^ (b1 & (c1 ^ d1))) + ULBlock[r1[round]] + 0x5A827999UL;
-      CHAIN160 (a1, b1, c1, d1, e1, x, rol);
-
-      rol = s2[round];
-      x = a2 + (c2 ^ (d2 & (b2 ^ c2))) + ULBlock[r2[round]] + 0x5C4Dd124UL;
-      CHAIN160 (a2, b2, c2, d2, e2, x, rol);
-    }
+  STEP160 (F2, e1, a1, b1, c1, d1, ULBlock[ 7], 0x5a827999UL,  7);
+  STEP160 (F4, e2, a2, b2, c2, d2, ULBlock[ 6], 0x5c4dd124UL,  9);
+  STEP160 (F2, d1, e1, a1, b1, c1, ULBlock[ 4], 0x5a827999UL,  6);
+  STEP160 (F4, d2, e2, a2, b2, c2, ULBlock[11], 0x5c4dd124UL, 13);
+  STEP160 (F2, c1, d1, e1, a1, b1, ULBlock[13], 0x5a827999UL,  8);
+  STEP160 (F4, c2, d2, e2, a2, b2, ULBlock[ 3], 0x5c4dd124UL, 15);
+  STEP160 (F2, b1, c1, d1, e1, a1, ULBlock[ 1], 0x5a827999UL, 13);
+  STEP160 (F4, b2, c2, d2, e2, a2, ULBlock[ 7], 0x5c4dd124UL,  7);
+  STEP160 (F2, a1, b1, c1, d1, e1, ULBlock[10], 0x5a827999UL, 11);
+  STEP160 (F4, a2, b2, c2, d2, e2, ULBlock[ 0], 0x5c4dd124UL, 12);
+  STEP160 (F2, e1, a1, b1, c1, d1, ULBlock[ 6], 0x5a827999UL,  9);
+  STEP160 (F4, e2, a2, b2, c2, d2, ULBlock[13], 0x5c4dd124UL,  8);
+  STEP160 (F2, d1, e1, a1, b1, c1, ULBlock[15], 0x5a827999UL,  7);
+  STEP160 (F4, d2, e2, a2, b2, c2, ULBlock[ 5], 0x5c4dd124UL,  9);
+  STEP160 (F2, c1, d1, e1, a1, b1, ULBlock[ 3], 0x5a827999UL, 15);
+  STEP160 (F4, c2, d2, e2, a2, b2, ULBlock[10], 0x5c4dd124UL, 11);
+  STEP160 (F2, b1, c1, d1, e1, a1, ULBlock[12], 0x5a827999UL,  7);
+  STEP160 (F4, b2, c2, d2, e2, a2, ULBlock[14], 0x5c4dd124UL,  7);
+  STEP160 (F2, a1, b1, c1, d1, e1, ULBlock[ 0], 0x5a827999UL, 12);
+  STEP160 (F4, a2, b2, c2, d2, e2, ULBlock[15], 0x5c4dd124UL,  7);
+  STEP160 (F2, e1, a1, b1, c1, d1, ULBlock[ 9], 0x5a827999UL, 15);
+  STEP160 (F4, e2, a2, b2, c2, d2, ULBlock[ 8], 0x5c4dd124UL, 12);
+  STEP160 (F2, d1, e1, a1, b1, c1, ULBlock[ 5], 0x5a827999UL,  9);
+  STEP160 (F4, d2, e2, a2, b2, c2, ULBlock[12], 0x5c4dd124UL,  7);
+  STEP160 (F2, c1, d1, e1, a1, b1, ULBlock[ 2], 0x5a827999UL, 11);
+  STEP160 (F4, c2, d2, e2, a2, b2, ULBlock[ 4], 0x5c4dd124UL,  6);
+  STEP160 (F2, b1, c1, d1, e1, a1, ULBlock[14], 0x5a827999UL,  7);
+  STEP160 (F4, b2, c2, d2, e2, a2, ULBlock[ 9], 0x5c4dd124UL, 15);
+  STEP160 (F2, a1, b1, c1, d1, e1, ULBlock[11], 0x5a827999UL, 13);
+  STEP160 (F4, a2, b2, c2, d2, e2, ULBlock[ 1], 0x5c4dd124UL, 13);
+  STEP160 (F2, e1, a1, b1, c1, d1, ULBlock[ 8], 0x5a827999UL, 12);
+  STEP160 (F4, e2, a2, b2, c2, d2, ULBlock[ 2], 0x5c4dd124UL, 11);
 
   /* Rounds and parallel rounds 32-47 */
-  for (round = 32; round < 48; round++)
-    {
-      rol = s1[round];
-      x = a1 + ((b1 | ~c1) ^ d1) + ULBlock[r1[round]] + 0x6ED9EBA1UL;
-      CHAIN160 (a1, b1, c1, d1, e1, x, rol);
-
-      rol = s2[round];
-      x = a2 + ((b2 | ~c2) ^ d2) + ULBlock[r2[round]] + 0x6D703EF3UL;
-      CHAIN160 (a2, b2, c2, d2, e2, x, rol);
-    }
+  STEP160 (F3, d1, e1, a1, b1, c1, ULBlock[ 3], 0x6ed9eba1UL, 11);
+  STEP160 (F3, d2, e2, a2, b2, c2, ULBlock[15], 0x6d703ef3UL,  9);
+  STEP160 (F3, c1, d1, e1, a1, b1, ULBlock[10], 0x6ed9eba1UL, 13);
+  STEP160 (F3, c2, d2, e2, a2, b2, ULBlock[ 5], 0x6d703ef3UL,  7);
+  STEP160 (F3, b1, c1, d1, e1, a1, ULBlock[14], 0x6ed9eba1UL,  6);
+  STEP160 (F3, b2, c2, d2, e2, a2, ULBlock[ 1], 0x6d703ef3UL, 15);
+  STEP160 (F3, a1, b1, c1, d1, e1, ULBlock[ 4], 0x6ed9eba1UL,  7);
+  STEP160 (F3, a2, b2, c2, d2, e2, ULBlock[ 3], 0x6d703ef3UL, 11);
+  STEP160 (F3, e1, a1, b1, c1, d1, ULBlock[ 9], 0x6ed9eba1UL, 14);
+  STEP160 (F3, e2, a2, b2, c2, d2, ULBlock[ 7], 0x6d703ef3UL,  8);
+  STEP160 (F3, d1, e1, a1, b1, c1, ULBlock[15], 0x6ed9eba1UL,  9);
+  STEP160 (F3, d2, e2, a2, b2, c2, ULBlock[14], 0x6d703ef3UL,  6);
+  STEP160 (F3, c1, d1, e1, a1, b1, ULBlock[ 8], 0x6ed9eba1UL, 13);
+  STEP160 (F3, c2, d2, e2, a2, b2, ULBlock[ 6], 0x6d703ef3UL,  6);
+  STEP160 (F3, b1, c1, d1, e1, a1, ULBlock[ 1], 0x6ed9eba1UL, 15);
+  STEP160 (F3, b2, c2, d2, e2, a2, ULBlock[ 9], 0x6d703ef3UL, 14);
+  STEP160 (F3, a1, b1, c1, d1, e1, ULBlock[ 2], 0x6ed9eba1UL, 14);
+  STEP160 (F3, a2, b2, c2, d2, e2, ULBlock[11], 0x6d703ef3UL, 12);
+  STEP160 (F3, e1, a1, b1, c1, d1, ULBlock[ 7], 0x6ed9eba1UL,  8);
+  STEP160 (F3, e2, a2, b2, c2, d2, ULBlock[ 8], 0x6d703ef3UL, 13);
+  STEP160 (F3, d1, e1, a1, b1, c1, ULBlock[ 0], 0x6ed9eba1UL, 13);
+  STEP160 (F3, d2, e2, a2, b2, c2, ULBlock[12], 0x6d703ef3UL,  5);
+  STEP160 (F3, c1, d1, e1, a1, b1, ULBlock[ 6], 0x6ed9eba1UL,  6);
+  STEP160 (F3, c2, d2, e2, a2, b2, ULBlock[ 2], 0x6d703ef3UL, 14);
+  STEP160 (F3, b1, c1, d1, e1, a1, ULBlock[13], 0x6ed9eba1UL,  5);
+  STEP160 (F3, b2, c2, d2, e2, a2, ULBlock[10], 0x6d703ef3UL, 13);
+  STEP160 (F3, a1, b1, c1, d1, e1, ULBlock[11], 0x6ed9eba1UL, 12);
+  STEP160 (F3, a2, b2, c2, d2, e2, ULBlock[ 0], 0x6d703ef3UL, 13);
+  STEP160 (F3, e1, a1, b1, c1, d1, ULBlock[ 5], 0x6ed9eba1UL,  7);
+  STEP160 (F3, e2, a2, b2, c2, d2, ULBlock[ 4], 0x6d703ef3UL,  7);
+  STEP160 (F3, d1, e1, a1, b1, c1, ULBlock[12], 0x6ed9eba1UL,  5);
+  STEP160 (F3, d2, e2, a2, b2, c2, ULBlock[13], 0x6d703ef3UL,  5);
 
   /* Rounds and parallel rounds 48-63 */
-  for (round = 48; round < 64; round++)
-    {
-      rol = s1[round];
-      x = a1 + (c1 ^ (d1 & (b1 ^ c1))) + ULBlock[r1[round]] + 0x8F1BBCDCUL;
-      CHAIN160 (a1, b1, c1, d1, e1, x, rol);
-
-      rol = s2[round];
-      x = a2 + (d2 ^ (b2 & (c2 ^ d2))) + ULBlock[r2[round]] + 0x7A6D76E9UL;
-      CHAIN160 (a2, b2, c2, d2, e2, x, rol);
-    }
+  STEP160 (F4, c1, d1, e1, a1, b1, ULBlock[ 1], 0x8f1bbcdcUL, 11);
+  STEP160 (F2, c2, d2, e2, a2, b2, ULBlock[ 8], 0x7a6d76e9UL, 15);
+  STEP160 (F4, b1, c1, d1, e1, a1, ULBlock[ 9], 0x8f1bbcdcUL, 12);
+  STEP160 (F2, b2, c2, d2, e2, a2, ULBlock[ 6], 0x7a6d76e9UL,  5);
+  STEP160 (F4, a1, b1, c1, d1, e1, ULBlock[11], 0x8f1bbcdcUL, 14);
+  STEP160 (F2, a2, b2, c2, d2, e2, ULBlock[ 4], 0x7a6d76e9UL,  8);
+  STEP160 (F4, e1, a1, b1, c1, d1, ULBlock[10], 0x8f1bbcdcUL, 15);
+  STEP160 (F2, e2, a2, b2, c2, d2, ULBlock[ 1], 0x7a6d76e9UL, 11);
+  STEP160 (F4, d1, e1, a1, b1, c1, ULBlock[ 0], 0x8f1bbcdcUL, 14);
+  STEP160 (F2, d2, e2, a2, b2, c2, ULBlock[ 3], 0x7a6d76e9UL, 14);
+  STEP160 (F4, c1, d1, e1, a1, b1, ULBlock[ 8], 0x8f1bbcdcUL, 15);
+  STEP160 (F2, c2, d2, e2, a2, b2, ULBlock[11], 0x7a6d76e9UL, 14);
+  STEP160 (F4, b1, c1, d1, e1, a1, ULBlock[12], 0x8f1bbcdcUL,  9);
+  STEP160 (F2, b2, c2, d2, e2, a2, ULBlock[15], 0x7a6d76e9UL,  6);
+  STEP160 (F4, a1, b1, c1, d1, e1, ULBlock[ 4], 0x8f1bbcdcUL,  8);
+  STEP160 (F2, a2, b2, c2, d2, e2, ULBlock[ 0], 0x7a6d76e9UL, 14);
+  STEP160 (F4, e1, a1, b1, c1, d1, ULBlock[13], 0x8f1bbcdcUL,  9);
+  STEP160 (F2, e2, a2, b2, c2, d2, ULBlock[ 5], 0x7a6d76e9UL,  6);
+  STEP160 (F4, d1, e1, a1, b1, c1, ULBlock[ 3], 0x8f1bbcdcUL, 14);
+  STEP160 (F2, d2, e2, a2, b2, c2, ULBlock[12], 0x7a6d76e9UL,  9);
+  STEP160 (F4, c1, d1, e1, a1, b1, ULBlock[ 7], 0x8f1bbcdcUL,  5);
+  STEP160 (F2, c2, d2, e2, a2, b2, ULBlock[ 2], 0x7a6d76e9UL, 12);
+  STEP160 (F4, b1, c1, d1, e1, a1, ULBlock[15], 0x8f1bbcdcUL,  6);
+  STEP160 (F2, b2, c2, d2, e2, a2, ULBlock[13], 0x7a6d76e9UL,  9);
+  STEP160 (F4, a1, b1, c1, d1, e1, ULBlock[14], 0x8f1bbcdcUL,  8);
+  STEP160 (F2, a2, b2, c2, d2, e2, ULBlock[ 9], 0x7a6d76e9UL, 12);
+  STEP160 (F4, e1, a1, b1, c1, d1, ULBlock[ 5], 0x8f1bbcdcUL,  6);
+  STEP160 (F2, e2, a2, b2, c2, d2, ULBlock[ 7], 0x7a6d76e9UL,  5);
+  STEP160 (F4, d1, e1, a1, b1, c1, ULBlock[ 6], 0x8f1bbcdcUL,  5);
+  STEP160 (F2, d2, e2, a2, b2, c2, ULBlock[10], 0x7a6d76e9UL, 15);
+  STEP160 (F4, c1, d1, e1, a1, b1, ULBlock[ 2], 0x8f1bbcdcUL, 12);
+  STEP160 (F2, c2, d2, e2, a2, b2, ULBlock[14], 0x7a6d76e9UL,  8);
 
   /* Rounds and parallel rounds 64-79 */
-  for (round = 64; round < 80; round++)
-    {
-      rol = s1[round];
-      x = a1 + (b1 ^ (c1 | ~d1)) + ULBlock[r1[round]] + 0xA953FD4EUL;
-      CHAIN160 (a1, b1, c1, d1, e1, x, rol);
-
-      rol = s2[round];
-      x = a2 + (b2 ^ c2 ^ d2) + ULBlock[r2[round]];
-      CHAIN160 (a2, b2, c2, d2, e2, x, rol);
-    }
+  STEP160 (F5, b1, c1, d1, e1, a1, ULBlock[ 4], 0xa953fd4eUL,  9);
+  STEP160 (F1, b2, c2, d2, e2, a2, ULBlock[12], 0x00000000UL,  8);
+  STEP160 (F5, a1, b1, c1, d1, e1, ULBlock[ 0], 0xa953fd4eUL, 15);
+  STEP160 (F1, a2, b2, c2, d2, e2, ULBlock[15], 0x00000000UL,  5);
+  STEP160 (F5, e1, a1, b1, c1, d1, ULBlock[ 5], 0xa953fd4eUL,  5);
+  STEP160 (F1, e2, a2, b2, c2, d2, ULBlock[10], 0x00000000UL, 12);
+  STEP160 (F5, d1, e1, a1, b1, c1, ULBlock[ 9], 0xa953fd4eUL, 11);
+  STEP160 (F1, d2, e2, a2, b2, c2, ULBlock[ 4], 0x00000000UL,  9);
+  STEP160 (F5, c1, d1, e1, a1, b1, ULBlock[ 7], 0xa953fd4eUL,  6);
+  STEP160 (F1, c2, d2, e2, a2, b2, ULBlock[ 1], 0x00000000UL, 12);
+  STEP160 (F5, b1, c1, d1, e1, a1, ULBlock[12], 0xa953fd4eUL,  8);
+  STEP160 (F1, b2, c2, d2, e2, a2, ULBlock[ 5], 0x00000000UL,  5);
+  STEP160 (F5, a1, b1, c1, d1, e1, ULBlock[ 2], 0xa953fd4eUL, 13);
+  STEP160 (F1, a2, b2, c2, d2, e2, ULBlock[ 8], 0x00000000UL, 14);
+  STEP160 (F5, e1, a1, b1, c1, d1, ULBlock[10], 0xa953fd4eUL, 12);
+  STEP160 (F1, e2, a2, b2, c2, d2, ULBlock[ 7], 0x00000000UL,  6);
+  STEP160 (F5, d1, e1, a1, b1, c1, ULBlock[14], 0xa953fd4eUL,  5);
+  STEP160 (F1, d2, e2, a2, b2, c2, ULBlock[ 6], 0x00000000UL,  8);
+  STEP160 (F5, c1, d1, e1, a1, b1, ULBlock[ 1], 0xa953fd4eUL, 12);
+  STEP160 (F1, c2, d2, e2, a2, b2, ULBlock[ 2], 0x00000000UL, 13);
+  STEP160 (F5, b1, c1, d1, e1, a1, ULBlock[ 3], 0xa953fd4eUL, 13);
+  STEP160 (F1, b2, c2, d2, e2, a2, ULBlock[13], 0x00000000UL,  6);
+  STEP160 (F5, a1, b1, c1, d1, e1, ULBlock[ 8], 0xa953fd4eUL, 14);
+  STEP160 (F1, a2, b2, c2, d2, e2, ULBlock[14], 0x00000000UL,  5);
+  STEP160 (F5, e1, a1, b1, c1, d1, ULBlock[11], 0xa953fd4eUL, 11);
+  STEP160 (F1, e2, a2, b2, c2, d2, ULBlock[ 0], 0x00000000UL, 15);
+  STEP160 (F5, d1, e1, a1, b1, c1, ULBlock[ 6], 0xa953fd4eUL,  8);
+  STEP160 (F1, d2, e2, a2, b2, c2, ULBlock[ 3], 0x00000000UL, 13);
+  STEP160 (F5, c1, d1, e1, a1, b1, ULBlock[15], 0xa953fd4eUL,  5);
+  STEP160 (F1, c2, d2, e2, a2, b2, ULBlock[ 9], 0x00000000UL, 11);
+  STEP160 (F5, b1, c1, d1, e1, a1, ULBlock[13], 0xa953fd4eUL,  6);
+  STEP160 (F1, b2, c2, d2, e2, a2, ULBlock[11], 0x00000000UL, 11);
 
   /* Result in stomach */
   d2 += c1 + stomach[1];
@@ -559,7 +767,7 @@ swallow (ULONG *stomach, ULONG *ULBlock)
   /* Overwrite temporary variables */
   Zero4Ulong (&a1, &b1, &c1, &d1);
   Zero4Ulong (&e1, &a2, &b2, &c2);
-  Zero4Ulong (&d2, &e2, &x, &a1);
+  Zero2Ulong (&d2, &e2);
 #endif
   
   return;
@@ -648,9 +856,6 @@ appetize128 (ULONG *stomach)
 static void
 swallow128 (ULONG *stomach, ULONG *ULBlock)
 {
-  int round, rol;
-  ULONG x;
-
   ULONG a1 = stomach[0];
   ULONG b1 = stomach[1];
   ULONG c1 = stomach[2];
@@ -661,56 +866,141 @@ swallow128 (ULONG *stomach, ULONG *ULBlock)
   ULONG c2 = stomach[2];
   ULONG d2 = stomach[3];
 
-  /*lint -e123 Don't complain about "Macros ... defined with arguments" */
-
   /* Rounds and parallel rounds 0-15 */
-  for (round = 0; round < 16; round++)
-    {
-      rol = s1[round];
-      x = a1 + (b1 ^ c1 ^ d1) + ULBlock[round];
-      CHAIN128 (a1, b1, c1, d1, x, rol);
-
-      rol = s2[round];
-      x = a2 + (c2 ^ (d2 & (b2 ^ c2))) + ULBlock[r2[round]] + 0x50a28be6UL;
-      CHAIN128 (a2, b2, c2, d2, x, rol);
-    }
+  STEP128 (F1, a1, b1, c1, d1, ULBlock[ 0], 0x00000000UL, 11);
+  STEP128 (F4, a2, b2, c2, d2, ULBlock[ 5], 0x50a28be6UL,  8);
+  STEP128 (F1, d1, a1, b1, c1, ULBlock[ 1], 0x00000000UL, 14);
+  STEP128 (F4, d2, a2, b2, c2, ULBlock[14], 0x50a28be6UL,  9);
+  STEP128 (F1, c1, d1, a1, b1, ULBlock[ 2], 0x00000000UL, 15);
+  STEP128 (F4, c2, d2, a2, b2, ULBlock[ 7], 0x50a28be6UL,  9);
+  STEP128 (F1, b1, c1, d1, a1, ULBlock[ 3], 0x00000000UL, 12);
+  STEP128 (F4, b2, c2, d2, a2, ULBlock[ 0], 0x50a28be6UL, 11);
+  STEP128 (F1, a1, b1, c1, d1, ULBlock[ 4], 0x00000000UL,  5);
+  STEP128 (F4, a2, b2, c2, d2, ULBlock[ 9], 0x50a28be6UL, 13);
+  STEP128 (F1, d1, a1, b1, c1, ULBlock[ 5], 0x00000000UL,  8);
+  STEP128 (F4, d2, a2, b2, c2, ULBlock[ 2], 0x50a28be6UL, 15);
+  STEP128 (F1, c1, d1, a1, b1, ULBlock[ 6], 0x00000000UL,  7);
+  STEP128 (F4, c2, d2, a2, b2, ULBlock[11], 0x50a28be6UL, 15);
+  STEP128 (F1, b1, c1, d1, a1, ULBlock[ 7], 0x00000000UL,  9);
+  STEP128 (F4, b2, c2, d2, a2, ULBlock[ 4], 0x50a28be6UL,  5);
+  STEP128 (F1, a1, b1, c1, d1, ULBlock[ 8], 0x00000000UL, 11);
+  STEP128 (F4, a2, b2, c2, d2, ULBlock[13], 0x50a28be6UL,  7);
+  STEP128 (F1, d1, a1, b1, c1, ULBlock[ 9], 0x00000000UL, 13);
+  STEP128 (F4, d2, a2, b2, c2, ULBlock[ 6], 0x50a28be6UL,  7);
+  STEP128 (F1, c1, d1, a1, b1, ULBlock[10], 0x00000000UL, 14);
+  STEP128 (F4, c2, d2, a2, b2, ULBlock[15], 0x50a28be6UL,  8);
+  STEP128 (F1, b1, c1, d1, a1, ULBlock[11], 0x00000000UL, 15);
+  STEP128 (F4, b2, c2, d2, a2, ULBlock[ 8], 0x50a28be6UL, 11);
+  STEP128 (F1, a1, b1, c1, d1, ULBlock[12], 0x00000000UL,  6);
+  STEP128 (F4, a2, b2, c2, d2, ULBlock[ 1], 0x50a28be6UL, 14);
+  STEP128 (F1, d1, a1, b1, c1, ULBlock[13], 0x00000000UL,  7);
+  STEP128 (F4, d2, a2, b2, c2, ULBlock[10], 0x50a28be6UL, 14);
+  STEP128 (F1, c1, d1, a1, b1, ULBlock[14], 0x00000000UL,  9);
+  STEP128 (F4, c2, d2, a2, b2, ULBlock[ 3], 0x50a28be6UL, 12);
+  STEP128 (F1, b1, c1, d1, a1, ULBlock[15], 0x00000000UL,  8);
+  STEP128 (F4, b2, c2, d2, a2, ULBlock[12], 0x50a28be6UL,  6);
 
   /* Rounds and parallel rounds 16-31 */
-  for (round = 16; round < 32; round++)
-    {
-      rol = s1[round];
-      x = a1 + (d1 ^ (b1 & (c1 ^ d1))) + ULBlock[r1[round]] + 0x5A827999UL;
-      CHAIN128 (a1, b1, c1, d1, x, rol);
-
-      rol = s2[round];
-      x = a2 + ((b2 | ~c2) ^ d2) + ULBlock[r2[round]] + 0x5c4dd124UL;
-      CHAIN128 (a2, b2, c2, d2, x, rol);
-    }
+  STEP128 (F2, a1, b1, c1, d1, ULBlock[ 7], 0x5a827999UL,  7);
+  STEP128 (F3, a2, b2, c2, d2, ULBlock[ 6], 0x5c4dd124UL,  9);
+  STEP128 (F2, d1, a1, b1, c1, ULBlock[ 4], 0x5a827999UL,  6);
+  STEP128 (F3, d2, a2, b2, c2, ULBlock[11], 0x5c4dd124UL, 13);
+  STEP128 (F2, c1, d1, a1, b1, ULBlock[13], 0x5a827999UL,  8);
+  STEP128 (F3, c2, d2, a2, b2, ULBlock[ 3], 0x5c4dd124UL, 15);
+  STEP128 (F2, b1, c1, d1, a1, ULBlock[ 1], 0x5a827999UL, 13);
+  STEP128 (F3, b2, c2, d2, a2, ULBlock[ 7], 0x5c4dd124UL,  7);
+  STEP128 (F2, a1, b1, c1, d1, ULBlock[10], 0x5a827999UL, 11);
+  STEP128 (F3, a2, b2, c2, d2, ULBlock[ 0], 0x5c4dd124UL, 12);
+  STEP128 (F2, d1, a1, b1, c1, ULBlock[ 6], 0x5a827999UL,  9);
+  STEP128 (F3, d2, a2, b2, c2, ULBlock[13], 0x5c4dd124UL,  8);
+  STEP128 (F2, c1, d1, a1, b1, ULBlock[15], 0x5a827999UL,  7);
+  STEP128 (F3, c2, d2, a2, b2, ULBlock[ 5], 0x5c4dd124UL,  9);
+  STEP128 (F2, b1, c1, d1, a1, ULBlock[ 3], 0x5a827999UL, 15);
+  STEP128 (F3, b2, c2, d2, a2, ULBlock[10], 0x5c4dd124UL, 11);
+  STEP128 (F2, a1, b1, c1, d1, ULBlock[12], 0x5a827999UL,  7);
+  STEP128 (F3, a2, b2, c2, d2, ULBlock[14], 0x5c4dd124UL,  7);
+  STEP128 (F2, d1, a1, b1, c1, ULBlock[ 0], 0x5a827999UL, 12);
+  STEP128 (F3, d2, a2, b2, c2, ULBlock[15], 0x5c4dd124UL,  7);
+  STEP128 (F2, c1, d1, a1, b1, ULBlock[ 9], 0x5a827999UL, 15);
+  STEP128 (F3, c2, d2, a2, b2, ULBlock[ 8], 0x5c4dd124UL, 12);
+  STEP128 (F2, b1, c1, d1, a1, ULBlock[ 5], 0x5a827999UL,  9);
+  STEP128 (F3, b2, c2, d2, a2, ULBlock[12], 0x5c4dd124UL,  7);
+  STEP128 (F2, a1, b1, c1, d1, ULBlock[ 2], 0x5a827999UL, 11);
+  STEP128 (F3, a2, b2, c2, d2, ULBlock[ 4], 0x5c4dd124UL,  6);
+  STEP128 (F2, d1, a1, b1, c1, ULBlock[14], 0x5a827999UL,  7);
+  STEP128 (F3, d2, a2, b2, c2, ULBlock[ 9], 0x5c4dd124UL, 15);
+  STEP128 (F2, c1, d1, a1, b1, ULBlock[11], 0x5a827999UL, 13);
+  STEP128 (F3, c2, d2, a2, b2, ULBlock[ 1], 0x5c4dd124UL, 13);
+  STEP128 (F2, b1, c1, d1, a1, ULBlock[ 8], 0x5a827999UL, 12);
+  STEP128 (F3, b2, c2, d2, a2, ULBlock[ 2], 0x5c4dd124UL, 11);
 
   /* Rounds and parallel rounds 32-47 */
-  for (round = 32; round < 48; round++)
-    {
-      rol = s1[round];
-      x = a1 + ((b1 | ~c1) ^ d1) + ULBlock[r1[round]] + 0x6ed9eba1UL;
-      CHAIN128 (a1, b1, c1, d1, x, rol);
-
-      rol = s2[round];
-      x = a2 + (d2 ^ (b2 & (c2 ^ d2))) + ULBlock[r2[round]] + 0x6d703ef3UL;
-      CHAIN128 (a2, b2, c2, d2, x, rol);
-    }
+  STEP128 (F3, a1, b1, c1, d1, ULBlock[ 3], 0x6ed9eba1UL, 11);
+  STEP128 (F2, a2, b2, c2, d2, ULBlock[15], 0x6d703ef3UL,  9);
+  STEP128 (F3, d1, a1, b1, c1, ULBlock[10], 0x6ed9eba1UL, 13);
+  STEP128 (F2, d2, a2, b2, c2, ULBlock[ 5], 0x6d703ef3UL,  7);
+  STEP128 (F3, c1, d1, a1, b1, ULBlock[14], 0x6ed9eba1UL,  6);
+  STEP128 (F2, c2, d2, a2, b2, ULBlock[ 1], 0x6d703ef3UL, 15);
+  STEP128 (F3, b1, c1, d1, a1, ULBlock[ 4], 0x6ed9eba1UL,  7);
+  STEP128 (F2, b2, c2, d2, a2, ULBlock[ 3], 0x6d703ef3UL, 11);
+  STEP128 (F3, a1, b1, c1, d1, ULBlock[ 9], 0x6ed9eba1UL, 14);
+  STEP128 (F2, a2, b2, c2, d2, ULBlock[ 7], 0x6d703ef3UL,  8);
+  STEP128 (F3, d1, a1, b1, c1, ULBlock[15], 0x6ed9eba1UL,  9);
+  STEP128 (F2, d2, a2, b2, c2, ULBlock[14], 0x6d703ef3UL,  6);
+  STEP128 (F3, c1, d1, a1, b1, ULBlock[ 8], 0x6ed9eba1UL, 13);
+  STEP128 (F2, c2, d2, a2, b2, ULBlock[ 6], 0x6d703ef3UL,  6);
+  STEP128 (F3, b1, c1, d1, a1, ULBlock[ 1], 0x6ed9eba1UL, 15);
+  STEP128 (F2, b2, c2, d2, a2, ULBlock[ 9], 0x6d703ef3UL, 14);
+  STEP128 (F3, a1, b1, c1, d1, ULBlock[ 2], 0x6ed9eba1UL, 14);
+  STEP128 (F2, a2, b2, c2, d2, ULBlock[11], 0x6d703ef3UL, 12);
+  STEP128 (F3, d1, a1, b1, c1, ULBlock[ 7], 0x6ed9eba1UL,  8);
+  STEP128 (F2, d2, a2, b2, c2, ULBlock[ 8], 0x6d703ef3UL, 13);
+  STEP128 (F3, c1, d1, a1, b1, ULBlock[ 0], 0x6ed9eba1UL, 13);
+  STEP128 (F2, c2, d2, a2, b2, ULBlock[12], 0x6d703ef3UL,  5);
+  STEP128 (F3, b1, c1, d1, a1, ULBlock[ 6], 0x6ed9eba1UL,  6);
+  STEP128 (F2, b2, c2, d2, a2, ULBlock[ 2], 0x6d703ef3UL, 14);
+  STEP128 (F3, a1, b1, c1, d1, ULBlock[13], 0x6ed9eba1UL,  5);
+  STEP128 (F2, a2, b2, c2, d2, ULBlock[10], 0x6d703ef3UL, 13);
+  STEP128 (F3, d1, a1, b1, c1, ULBlock[11], 0x6ed9eba1UL, 12);
+  STEP128 (F2, d2, a2, b2, c2, ULBlock[ 0], 0x6d703ef3UL, 13);
+  STEP128 (F3, c1, d1, a1, b1, ULBlock[ 5], 0x6ed9eba1UL,  7);
+  STEP128 (F2, c2, d2, a2, b2, ULBlock[ 4], 0x6d703ef3UL,  7);
+  STEP128 (F3, b1, c1, d1, a1, ULBlock[12], 0x6ed9eba1UL,  5);
+  STEP128 (F2, b2, c2, d2, a2, ULBlock[13], 0x6d703ef3UL,  5);
 
   /* Rounds and parallel rounds 48-63 */
-  for (round = 48; round < 64; round++)
-    {
-      rol = s1[round];
-      x = a1 + (c1 ^ (d1 & (b1 ^ c1))) + ULBlock[r1[round]] + 0x8f1bbcdcUL;
-      CHAIN128 (a1, b1, c1, d1, x, rol);
-
-      rol = s2[round];
-      x = a2 + (b2 ^ c2 ^ d2) + ULBlock[r2[round]];
-      CHAIN128 (a2, b2, c2, d2, x, rol);
-    }
-
+  STEP128 (F4, a1, b1, c1, d1, ULBlock[ 1], 0x8f1bbcdcUL, 11);
+  STEP128 (F1, a2, b2, c2, d2, ULBlock[ 8], 0x00000000UL, 15);
+  STEP128 (F4, d1, a1, b1, c1, ULBlock[ 9], 0x8f1bbcdcUL, 12);
+  STEP128 (F1, d2, a2, b2, c2, ULBlock[ 6], 0x00000000UL,  5);
+  STEP128 (F4, c1, d1, a1, b1, ULBlock[11], 0x8f1bbcdcUL, 14);
+  STEP128 (F1, c2, d2, a2, b2, ULBlock[ 4], 0x00000000UL,  8);
+  STEP128 (F4, b1, c1, d1, a1, ULBlock[10], 0x8f1bbcdcUL, 15);
+  STEP128 (F1, b2, c2, d2, a2, ULBlock[ 1], 0x00000000UL, 11);
+  STEP128 (F4, a1, b1, c1, d1, ULBlock[ 0], 0x8f1bbcdcUL, 14);
+  STEP128 (F1, a2, b2, c2, d2, ULBlock[ 3], 0x00000000UL, 14);
+  STEP128 (F4, d1, a1, b1, c1, ULBlock[ 8], 0x8f1bbcdcUL, 15);
+  STEP128 (F1, d2, a2, b2, c2, ULBlock[11], 0x00000000UL, 14);
+  STEP128 (F4, c1, d1, a1, b1, ULBlock[12], 0x8f1bbcdcUL,  9);
+  STEP128 (F1, c2, d2, a2, b2, ULBlock[15], 0x00000000UL,  6);
+  STEP128 (F4, b1, c1, d1, a1, ULBlock[ 4], 0x8f1bbcdcUL,  8);
+  STEP128 (F1, b2, c2, d2, a2, ULBlock[ 0], 0x00000000UL, 14);
+  STEP128 (F4, a1, b1, c1, d1, ULBlock[13], 0x8f1bbcdcUL,  9);
+  STEP128 (F1, a2, b2, c2, d2, ULBlock[ 5], 0x00000000UL,  6);
+  STEP128 (F4, d1, a1, b1, c1, ULBlock[ 3], 0x8f1bbcdcUL, 14);
+  STEP128 (F1, d2, a2, b2, c2, ULBlock[12], 0x00000000UL,  9);
+  STEP128 (F4, c1, d1, a1, b1, ULBlock[ 7], 0x8f1bbcdcUL,  5);
+  STEP128 (F1, c2, d2, a2, b2, ULBlock[ 2], 0x00000000UL, 12);
+  STEP128 (F4, b1, c1, d1, a1, ULBlock[15], 0x8f1bbcdcUL,  6);
+  STEP128 (F1, b2, c2, d2, a2, ULBlock[13], 0x00000000UL,  9);
+  STEP128 (F4, a1, b1, c1, d1, ULBlock[14], 0x8f1bbcdcUL,  8);
+  STEP128 (F1, a2, b2, c2, d2, ULBlock[ 9], 0x00000000UL, 12);
+  STEP128 (F4, d1, a1, b1, c1, ULBlock[ 5], 0x8f1bbcdcUL,  6);
+  STEP128 (F1, d2, a2, b2, c2, ULBlock[ 7], 0x00000000UL,  5);
+  STEP128 (F4, c1, d1, a1, b1, ULBlock[ 6], 0x8f1bbcdcUL,  5);
+  STEP128 (F1, c2, d2, a2, b2, ULBlock[10], 0x00000000UL, 15);
+  STEP128 (F4, b1, c1, d1, a1, ULBlock[ 2], 0x8f1bbcdcUL, 12);
+  STEP128 (F1, b2, c2, d2, a2, ULBlock[14], 0x00000000UL,  8);
 
   /* Result in stomach */
   d2 += c1 + stomach[1];
@@ -723,7 +1013,6 @@ swallow128 (ULONG *stomach, ULONG *ULBlock)
   /* Overwrite temporary variables */
   Zero4Ulong (&a1, &b1, &c1, &d1);
   Zero4Ulong (&a2, &b2, &c2, &d2);
-  ZeroUlong (&x);
 #endif  
 
   return;
@@ -782,6 +1071,82 @@ digest128 (ULONG *stomach, UCHAR *clear, ULONG total[])
 }
 
 
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Export of a hash status into the portable byte format:        */
+/*              4 byte tag, the chaining words as 32 bit Big-Endian values,   */
+/*              the number of bytes hashed so far as 64 bit Big-Endian value  */
+/*  Syntax:     void StatExport (UCHAR *Buf, const char *Tag, ULONG *stomach, */
+/*                               int Words, ULONG total[]);                   */
+/*  Input:      Tag (Identifier of the hash function, 4 characters)           */
+/*              stomach (Chaining words)                                      */
+/*              Words (Number of chaining words)                              */
+/*              total (Number of bytes hashed so far, total[1] high part)     */
+/*  Output:     Buf (Exported status, 4 * Words + 12 bytes)                   */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+static void
+StatExport (UCHAR *Buf, const char *Tag, ULONG *stomach, int Words,
+            ULONG total[])
+{
+  int i;
+
+  memcpy (Buf, Tag, 4);
+  Buf += 4;
+
+  for (i = 0; i < Words; i++)
+    {
+      UL2UCBE (Buf, stomach[i]);
+      Buf += 4;
+    }
+
+  UL2UCBE (Buf, total[1]);
+  UL2UCBE (Buf + 4, total[0]);
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Import of a hash status exported by StatExport                */
+/*  Syntax:     int StatImport (ULONG *stomach, ULONG total[], UCHAR *Buf,    */
+/*                              ULONG Len, const char *Tag, int Words);       */
+/*  Input:      Buf (Exported status)                                         */
+/*              Len (Length of Buf in bytes)                                  */
+/*              Tag (Expected identifier of the hash function)                */
+/*              Words (Number of chaining words)                              */
+/*  Output:     stomach, total (Imported status, unchanged on error)          */
+/*  Returns:    0 if everything is O.K.                                       */
+/*              -1 if Len, the tag or the number of bytes is not valid        */
+/*                                                                            */
+/******************************************************************************/
+static int
+StatImport (ULONG *stomach, ULONG total[], UCHAR *Buf, ULONG Len,
+            const char *Tag, int Words)
+{
+  int i;
+
+  /* A status only exists at a block boundary */
+  if (Len != (ULONG)(4 * Words + 12) || memcmp (Buf, Tag, 4) != 0
+      || (Buf[Len - 1] & 63) != 0)
+    {
+      return -1;
+    }
+  Buf += 4;
+
+  for (i = 0; i < Words; i++)
+    {
+      stomach[i] = UC2ULBE (Buf);
+      Buf += 4;
+    }
+
+  total[1] = UC2ULBE (Buf);
+  total[0] = UC2ULBE (Buf + 4);
+
+  return 0;
+}
+
+
 #ifdef FLINT_SECURE
 
 /******************************************************************************/
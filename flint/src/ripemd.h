@@ -59,6 +59,10 @@ extern "C" {
 #define RMDVER 160
 #define E_CLINT_RMD -20
 
+/* Length of a status exported by ripeexport_l, ripeexport128_l in bytes */
+#define RMDSTATLEN    32
+#define RMD128STATLEN 28
+
 /* Macros maintaining FLINT/C namespace */
 
 #define ripeinit        ripeinit_l
@@ -69,6 +73,11 @@ extern "C" {
 #define ripehash128	ripehash128_l
 #define ripefinish128	ripefinish128_l
 #define ripemd128     	ripemd128_l
+#define ripeclone	ripeclone_l
+#define ripeexport	ripeexport_l
+#define ripeimport	ripeimport_l
+#define ripeexport128	ripeexport128_l
+#define ripeimport128	ripeimport128_l
 
 
 struct ripemd_stat {
@@ -133,6 +142,18 @@ ripefinish128_l (unsigned char *, RMDSTAT *, unsigned char *, unsigned long);
 extern void __FLINT_API 
 ripemd128_l (unsigned char *, unsigned char *, unsigned long);
 
+/* Status handling */
+extern void __FLINT_API
+ripeclone_l (RMDSTAT *, RMDSTAT *);
+extern void __FLINT_API
+ripeexport_l (unsigned char *, RMDSTAT *);
+extern int  __FLINT_API
+ripeimport_l (RMDSTAT *, unsigned char *, unsigned long);
+extern void __FLINT_API
+ripeexport128_l (unsigned char *, RMDSTAT *);
+extern int  __FLINT_API
+ripeimport128_l (RMDSTAT *, unsigned char *, unsigned long);
+
 #ifdef  __cplusplus
 }
 #endif
@@ -54,6 +54,28 @@
 #include "flint.h"
 #include "sha1.h"
 
+/* Block functions using instruction set extensions of x86 processors,      */
+/* selected at runtime: SSSE3 or AVX2 for the message schedule, SHA         */
+/* extensions (SHA-NI) for the complete block function. Compile with        */
+/* -DFLINT_NO_SHASIMD to use the portable C implementation only.            */
+#if !defined FLINT_NO_SHASIMD
+#if defined __GNUC__ && (defined __x86_64__ || defined __i386__)
+#define SHA_SIMD
+#include <cpuid.h>
+#include <immintrin.h>
+#define SHANI_TARGET __attribute__ ((target ("sha,sse4.1,ssse3")))
+#define SSSE3_TARGET __attribute__ ((target ("ssse3")))
+#define AVX2_TARGET  __attribute__ ((target ("avx2")))
+#elif defined _MSC_VER && (_MSC_VER >= 1900) && (defined _M_X64 || defined _M_IX86)
+#define SHA_SIMD
+#include <intrin.h>
+#include <immintrin.h>
+#define SHANI_TARGET /**/
+#define SSSE3_TARGET /**/
+#define AVX2_TARGET  /**/
+#endif
+#endif /* !FLINT_NO_SHASIMD */
+
 
 #ifndef inline
 #if (_MSC_VER >= 1100) || defined __GNUC__
@@ -68,6 +90,22 @@
 static void sha1_appetize (ULONG *);
 static void sha1_swallow (ULONG *, ULONG *);
 static void sha1_digest (ULONG *, UCHAR *, ULONG[]);
+static void sha1_block (ULONG *, ULONG *);
+static void StatExport (UCHAR *, const char *, ULONG *, int, ULONG[]);
+static int StatImport (ULONG *, ULONG[], UCHAR *, ULONG, const char *, int);
+
+#ifdef SHA_SIMD
+static int ShaCpuSupport (int);
+static int sha1_simd (ULONG *, UCHAR *, ULONG);
+static void sha1_swallow_ni (ULONG *, UCHAR *, ULONG);
+static void sha1_swallow_avx2 (ULONG *, UCHAR *, ULONG);
+static void sha1_swallow_ssse3 (ULONG *, UCHAR *, ULONG);
+static void sha1_rounds (ULONG *, const unsigned int *);
+#endif
+
+/* Implementation of the block functions in use, -1 if not yet selected */
+static int ShaImpl = -1;
+#define SHAIMPL() ((ShaImpl < 0) ? shaimpl_l (SHA_IMPL_BEST) : ShaImpl)
 
 #ifdef FLINT_SECURE
 static inline void ZeroUlong (ULONG *);
@@ -106,6 +144,16 @@ static inline void ZeroUcharArray (void *, size_t);
    ((unsigned long) *(ucptr)     << 24))
 
 
+/* Conversion of a value of type ULONG into an array of type UCHAR in */
+/* Big-Endian representation, inverse of UC2ULBE */
+#define UL2UCBE(ucptr, ul) { \
+  *(ucptr)     = (UCHAR)((ul) >> 24); \
+  *((ucptr)+1) = (UCHAR)((ul) >> 16); \
+  *((ucptr)+2) = (UCHAR)((ul) >>  8); \
+  *((ucptr)+3) = (UCHAR) (ul);        \
+}
+
+
 /* Addition of a single-digit number b to a double-digit number represented */
 /* by an array (a[1],a[0]). A carry in a[0]+=b is handled by increasing a[1]. */
 #define ADDC(a, b) { \
@@ -195,6 +243,13 @@ sha1hash_l (SHASTAT *hws, UCHAR *clear, ULONG length)
   /* Number of 64 byte message blocks in clear */
   noofblocks = length >> 6;
 
+#ifdef SHA_SIMD
+  if (sha1_simd (hws->stomach, clear, noofblocks))
+    {
+      noofblocks = 0;
+    }
+#endif
+
   /* Process 64 byte message blocks in clear */
   for (i = 0; i < noofblocks; i++)
     {
@@ -264,6 +319,103 @@ sha1finish_l (UCHAR *HashRes, SHASTAT *hws, UCHAR *clear, ULONG length)
 }
 
 
+/******************************************************************************/
+/* Functions for cloning, exporting and importing the status between the      */
+/* blockwise hashing steps. A status exported with sha1export can be hashed   */
+/* further with sha1hash and sha1finish after sha1import, also in another     */
+/* process or on another platform.                                            */
+/******************************************************************************/
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Copy of a SHA-1 status, e.g. to continue a common prefix      */
+/*              with different messages                                       */
+/*  Syntax:     void sha1clone_l (SHASTAT *dst, SHASTAT *src);                */
+/*  Input:      SHASTAT *src (SHA-1 status buffer)                            */
+/*  Output:     SHASTAT *dst (Copy of the status buffer)                      */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+void __FLINT_API
+sha1clone_l (SHASTAT *dst, SHASTAT *src)
+{
+  *dst = *src;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Export of a SHA-1 status in portable byte format              */
+/*  Syntax:     void sha1export_l (UCHAR *Buf, SHASTAT *hws);                 */
+/*  Input:      SHASTAT *hws (SHA-1 status buffer)                            */
+/*  Output:     UCHAR *Buf (Exported status, SHASTATLEN bytes)                */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+void __FLINT_API
+sha1export_l (UCHAR *Buf, SHASTAT *hws)
+{
+  StatExport (Buf, "SHA1", hws->stomach, 5, hws->total);
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Import of a SHA-1 status exported by sha1export_l             */
+/*  Syntax:     int sha1import_l (SHASTAT *hws, UCHAR *Buf, ULONG Len);       */
+/*  Input:      UCHAR *Buf (Exported status)                                  */
+/*              ULONG Len (Length of Buf in bytes)                            */
+/*  Output:     SHASTAT *hws (SHA-1 status buffer)                            */
+/*  Returns:    E_CLINT_OK if everything is O.K.                              */
+/*              E_CLINT_SHA if Buf does not hold a SHA-1 status               */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+sha1import_l (SHASTAT *hws, UCHAR *Buf, ULONG Len)
+{
+  if (StatImport (hws->stomach, hws->total, Buf, Len, "SHA1", 5))
+    {
+      return E_CLINT_SHA;
+    }
+
+  return 0;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Selection of the implementation of the block functions        */
+/*              The fastest implementation available on the processor up to   */
+/*              Impl is selected. Without a call of shaimpl_l the fastest     */
+/*              implementation available is used                              */
+/*  Syntax:     int shaimpl_l (int Impl);                                     */
+/*  Input:      int Impl (SHA_IMPL_C, SHA_IMPL_SSSE3, SHA_IMPL_AVX2,          */
+/*                        SHA_IMPL_SHANI or SHA_IMPL_BEST)                    */
+/*  Output:     -                                                             */
+/*  Returns:    Implementation selected                                       */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+shaimpl_l (int Impl)
+{
+  int impl = SHA_IMPL_C;
+
+#ifdef SHA_SIMD
+  if (Impl > SHA_IMPL_C)
+    {
+      impl = (Impl < SHA_IMPL_BEST) ? Impl : SHA_IMPL_BEST;
+    }
+  while (impl > SHA_IMPL_C && !ShaCpuSupport (impl))
+    {
+      impl--;
+    }
+#endif
+
+  ShaImpl = impl;
+  return impl;
+}
+
+
 /******************************************************************************/
 /* SHA-1 kernel functions                                                     */
 /******************************************************************************/
@@ -386,7 +538,7 @@ sha1_digest (ULONG *stomach, UCHAR *clear, ULONG total[])
 
   if (rest > 55) /* No space left for appending the message length (8 Byte), */
     {            /* therefore store length into the following block          */
-      sha1_swallow (stomach, ULBlock);
+      sha1_block (stomach, ULBlock);
       memset (ULBlock, 0, sizeof (ULONG) << 4);
     }
 
@@ -394,7 +546,7 @@ sha1_digest (ULONG *stomach, UCHAR *clear, ULONG total[])
   ULBlock[14] = (total[0] >> 29) | (total[1] << 3);
   ULBlock[15] = total[0] << 3;
 
-  sha1_swallow (stomach, ULBlock);
+  sha1_block (stomach, ULBlock);
 
 #ifdef FLINT_SECURE
   /* Overwrite temporary variables */
@@ -408,6 +560,558 @@ sha1_digest (ULONG *stomach, UCHAR *clear, ULONG total[])
 }
 
 
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   SHA-1 block function dispatching to the selected              */
+/*              implementation                                                */
+/*  Syntax:     static void sha1_block (ULONG *stomach, ULONG *ULBlock);      */
+/*  Input:      ULONG *stomach (Chaining value)                               */
+/*              ULONG *ULBlock (Message block of 16 words)                    */
+/*  Output:     ULONG *stomach (Updated chaining value)                       */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+static void
+sha1_block (ULONG *stomach, ULONG *ULBlock)
+{
+#ifdef SHA_SIMD
+  UCHAR block[64];
+  int i;
+
+  if (SHAIMPL () != SHA_IMPL_C)
+    {
+      for (i = 0; i < 16; i++)
+        {
+          block[4*i]     = (UCHAR)(ULBlock[i] >> 24);
+          block[4*i + 1] = (UCHAR)(ULBlock[i] >> 16);
+          block[4*i + 2] = (UCHAR)(ULBlock[i] >>  8);
+          block[4*i + 3] = (UCHAR)(ULBlock[i]      );
+        }
+
+      sha1_simd (stomach, block, 1);
+
+#ifdef FLINT_SECURE
+      ZeroUcharArray (block, sizeof (block));
+#endif
+      return;
+    }
+#endif /* SHA_SIMD? */
+
+  sha1_swallow (stomach, ULBlock);
+}
+
+
+#ifdef SHA_SIMD
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Test of processor support of an implementation                */
+/*              SHA-NI requires SHA extensions, SSSE3 and SSE4.1, AVX2 also   */
+/*              requires support of the operating system for saving the       */
+/*              AVX registers                                                 */
+/*  Syntax:     static int ShaCpuSupport (int Impl);                          */
+/*  Input:      int Impl (SHA_IMPL_SSSE3, SHA_IMPL_AVX2 or SHA_IMPL_SHANI)    */
+/*  Output:     -                                                             */
+/*  Returns:    1 if Impl is available, 0 else                                */
+/*                                                                            */
+/******************************************************************************/
+static int
+ShaCpuSupport (int Impl)
+{
+  unsigned int ecx1, ebx7 = 0, xcr0 = 0;
+#if defined __GNUC__
+  unsigned int a, b, c, d;
+
+  if (!__get_cpuid (1, &a, &b, &c, &d))
+    {
+      return 0;
+    }
+  ecx1 = c;
+  if (c & 0x08000000)
+    {
+      __asm__ ("xgetbv" : "=a" (xcr0), "=d" (d) : "c" (0));
+    }
+  if (__get_cpuid_max (0, NULL) >= 7)
+    {
+      __cpuid_count (7, 0, a, b, c, d);
+      ebx7 = b;
+    }
+#else
+  int info[4];
+
+  __cpuid (info, 0);
+  if (info[0] < 1)
+    {
+      return 0;
+    }
+  if (info[0] >= 7)
+    {
+      __cpuidex (info, 7, 0);
+      ebx7 = (unsigned int)info[1];
+    }
+  __cpuid (info, 1);
+  ecx1 = (unsigned int)info[2];
+  if (ecx1 & 0x08000000)
+    {
+      xcr0 = (unsigned int)_xgetbv (0);
+    }
+#endif
+
+  switch (Impl)
+    {
+      case SHA_IMPL_SSSE3:
+        return (ecx1 & 0x200) != 0;
+      case SHA_IMPL_AVX2:
+        return (ecx1 & 0x200) && (xcr0 & 0x06) == 0x06 && (ebx7 & 0x20);
+      case SHA_IMPL_SHANI:
+        return (ecx1 & 0x200) && (ecx1 & 0x80000) && (ebx7 & 0x20000000);
+      default:
+        return 0;
+    }
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   SHA-1 block functions using instruction set extensions        */
+/*  Syntax:     static int sha1_simd (ULONG *stomach, UCHAR *clear,           */
+/*                                               ULONG noofblocks);           */
+/*  Input:      ULONG *stomach (Chaining value)                               */
+/*              UCHAR *clear (Message blocks)                                 */
+/*              ULONG noofblocks (Number of 64 byte blocks in clear)          */
+/*  Output:     ULONG *stomach (Updated chaining value)                       */
+/*  Returns:    1 if the blocks are processed, 0 if the C implementation is   */
+/*              selected                                                      */
+/*                                                                            */
+/******************************************************************************/
+static int
+sha1_simd (ULONG *stomach, UCHAR *clear, ULONG noofblocks)
+{
+  switch (SHAIMPL ())
+    {
+      case SHA_IMPL_SHANI:
+        sha1_swallow_ni (stomach, clear, noofblocks);
+        return 1;
+      case SHA_IMPL_AVX2:
+        sha1_swallow_avx2 (stomach, clear, noofblocks);
+        return 1;
+      case SHA_IMPL_SSSE3:
+        sha1_swallow_ssse3 (stomach, clear, noofblocks);
+        return 1;
+      default:
+        return 0;
+    }
+}
+
+
+/* Four rounds of SHA-1 by SHA extensions with computation of the message   */
+/* schedule: Mcur holds the message words of the rounds, Mnext, Mnext2 and  */
+/* Mprev are prepared for the following rounds                              */
+#define SHA1NI_4ROUNDS(F, Mcur, Mnext, Mnext2, Mprev, Ein, Eout) \
+  (Ein) = _mm_sha1nexte_epu32 ((Ein), (Mcur)); \
+  (Eout) = abcd; \
+  (Mnext) = _mm_sha1msg2_epu32 ((Mnext), (Mcur)); \
+  abcd = _mm_sha1rnds4_epu32 (abcd, (Ein), (F)); \
+  (Mprev) = _mm_sha1msg1_epu32 ((Mprev), (Mcur)); \
+  (Mnext2) = _mm_xor_si128 ((Mnext2), (Mcur))
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   SHA-1 block function by SHA extensions                        */
+/*              Register usage follows the sample code in Intel's "New        */
+/*              Instructions Supporting the Secure Hash Algorithm on Intel    */
+/*              Architecture Processors"                                      */
+/*  Syntax:     static void sha1_swallow_ni (ULONG *stomach, UCHAR *clear,    */
+/*                                                    ULONG noofblocks);      */
+/*  Input:      ULONG *stomach (Chaining value)                               */
+/*              UCHAR *clear (Message blocks)                                 */
+/*              ULONG noofblocks (Number of 64 byte blocks in clear)          */
+/*  Output:     ULONG *stomach (Updated chaining value)                       */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+SHANI_TARGET static void
+sha1_swallow_ni (ULONG *stomach, UCHAR *clear, ULONG noofblocks)
+{
+  __m128i abcd, abcd_save, e0, e1, e_save, m0, m1, m2, m3, mask;
+  unsigned int res[4];
+
+  /* Conversion of big-endian message words, reversal of word order */
+  mask = _mm_set_epi8 (0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+  abcd = _mm_set_epi32 ((int)stomach[0], (int)stomach[1],
+                        (int)stomach[2], (int)stomach[3]);
+  e0 = _mm_set_epi32 ((int)stomach[4], 0, 0, 0);
+
+  for (; noofblocks > 0; noofblocks--, clear += 64)
+    {
+      abcd_save = abcd;
+      e_save = e0;
+
+      /* Rounds 0-15 */
+      m0 = _mm_shuffle_epi8 (_mm_loadu_si128 ((__m128i *)clear), mask);
+      e0 = _mm_add_epi32 (e0, m0);
+      e1 = abcd;
+      abcd = _mm_sha1rnds4_epu32 (abcd, e0, 0);
+
+      m1 = _mm_shuffle_epi8 (_mm_loadu_si128 ((__m128i *)(clear + 16)), mask);
+      e1 = _mm_sha1nexte_epu32 (e1, m1);
+      e0 = abcd;
+      abcd = _mm_sha1rnds4_epu32 (abcd, e1, 0);
+      m0 = _mm_sha1msg1_epu32 (m0, m1);
+
+      m2 = _mm_shuffle_epi8 (_mm_loadu_si128 ((__m128i *)(clear + 32)), mask);
+      e0 = _mm_sha1nexte_epu32 (e0, m2);
+      e1 = abcd;
+      abcd = _mm_sha1rnds4_epu32 (abcd, e0, 0);
+      m1 = _mm_sha1msg1_epu32 (m1, m2);
+      m0 = _mm_xor_si128 (m0, m2);
+
+      m3 = _mm_shuffle_epi8 (_mm_loadu_si128 ((__m128i *)(clear + 48)), mask);
+      SHA1NI_4ROUNDS (0, m3, m0, m1, m2, e1, e0);
+
+      /* Rounds 16-79 */
+      SHA1NI_4ROUNDS (0, m0, m1, m2, m3, e0, e1);
+      SHA1NI_4ROUNDS (1, m1, m2, m3, m0, e1, e0);
+      SHA1NI_4ROUNDS (1, m2, m3, m0, m1, e0, e1);
+      SHA1NI_4ROUNDS (1, m3, m0, m1, m2, e1, e0);
+      SHA1NI_4ROUNDS (1, m0, m1, m2, m3, e0, e1);
+      SHA1NI_4ROUNDS (1, m1, m2, m3, m0, e1, e0);
+      SHA1NI_4ROUNDS (2, m2, m3, m0, m1, e0, e1);
+      SHA1NI_4ROUNDS (2, m3, m0, m1, m2, e1, e0);
+      SHA1NI_4ROUNDS (2, m0, m1, m2, m3, e0, e1);
+      SHA1NI_4ROUNDS (2, m1, m2, m3, m0, e1, e0);
+      SHA1NI_4ROUNDS (2, m2, m3, m0, m1, e0, e1);
+      SHA1NI_4ROUNDS (3, m3, m0, m1, m2, e1, e0);
+      SHA1NI_4ROUNDS (3, m0, m1, m2, m3, e0, e1);
+
+      e1 = _mm_sha1nexte_epu32 (e1, m1);
+      e0 = abcd;
+      m2 = _mm_sha1msg2_epu32 (m2, m1);
+      abcd = _mm_sha1rnds4_epu32 (abcd, e1, 3);
+      m3 = _mm_xor_si128 (m3, m1);
+
+      e0 = _mm_sha1nexte_epu32 (e0, m2);
+      e1 = abcd;
+      m3 = _mm_sha1msg2_epu32 (m3, m2);
+      abcd = _mm_sha1rnds4_epu32 (abcd, e0, 3);
+
+      e1 = _mm_sha1nexte_epu32 (e1, m3);
+      e0 = abcd;
+      abcd = _mm_sha1rnds4_epu32 (abcd, e1, 3);
+
+      /* Addition of previous chaining value */
+      e0 = _mm_sha1nexte_epu32 (e0, e_save);
+      abcd = _mm_add_epi32 (abcd, abcd_save);
+    }
+
+  _mm_storeu_si128 ((__m128i *)res, abcd);
+  stomach[0] = (ULONG)res[3];
+  stomach[1] = (ULONG)res[2];
+  stomach[2] = (ULONG)res[1];
+  stomach[3] = (ULONG)res[0];
+  stomach[4] = (ULONG)(unsigned int)_mm_extract_epi32 (e0, 3);
+
+#ifdef FLINT_SECURE
+  abcd = abcd_save = e0 = e1 = e_save = m0 = m1 = m2 = m3 = _mm_setzero_si128 ();
+  ZeroUcharArray (res, sizeof (res));
+#endif
+}
+
+/* Vector operations for the message schedule: V128 processes one block in */
+/* an SSE register, V256 two consecutive blocks in the halves of an AVX2   */
+/* register. V##_STORE (t, x) stores the words t ... t+3 of the schedule   */
+/* to W and, for V256, of the second block to W2.                          */
+#define V128_ADD(x, y)      _mm_add_epi32 ((x), (y))
+#define V128_XOR(x, y)      _mm_xor_si128 ((x), (y))
+#define V128_OR(x, y)       _mm_or_si128 ((x), (y))
+#define V128_SRLI(x, n)     _mm_srli_epi32 ((x), (n))
+#define V128_SLLI(x, n)     _mm_slli_epi32 ((x), (n))
+#define V128_SRLB(x, n)     _mm_srli_si128 ((x), (n))
+#define V128_SLLB(x, n)     _mm_slli_si128 ((x), (n))
+#define V128_ALIGNR(x, y, n) _mm_alignr_epi8 ((x), (y), (n))
+#define V128_STORE(t, x)    _mm_storeu_si128 ((__m128i *)(W + (t)), (x))
+
+#define V256_ADD(x, y)      _mm256_add_epi32 ((x), (y))
+#define V256_XOR(x, y)      _mm256_xor_si256 ((x), (y))
+#define V256_OR(x, y)       _mm256_or_si256 ((x), (y))
+#define V256_SRLI(x, n)     _mm256_srli_epi32 ((x), (n))
+#define V256_SLLI(x, n)     _mm256_slli_epi32 ((x), (n))
+#define V256_SRLB(x, n)     _mm256_srli_si256 ((x), (n))
+#define V256_SLLB(x, n)     _mm256_slli_si256 ((x), (n))
+#define V256_ALIGNR(x, y, n) _mm256_alignr_epi8 ((x), (y), (n))
+#define V256_STORE(t, x) \
+  _mm_storeu_si128 ((__m128i *)(W + (t)), _mm256_castsi256_si128 (x)); \
+  _mm_storeu_si128 ((__m128i *)(W2 + (t)), _mm256_extracti128_si256 ((x), 1))
+
+/* Loading of big-endian message words of the blocks at p and p + 64 */
+#define V128_LOAD(p) \
+  _mm_shuffle_epi8 (_mm_loadu_si128 ((__m128i *)(p)), mask)
+#define V256_LOAD(p) \
+  _mm256_shuffle_epi8 (_mm256_inserti128_si256 (_mm256_castsi128_si256 ( \
+    _mm_loadu_si128 ((__m128i *)(p))), \
+    _mm_loadu_si128 ((__m128i *)((p) + 64)), 1), mask)
+
+#define VROL(V, x, n)       V##_OR (V##_SLLI ((x), (n)), V##_SRLI ((x), 32 - (n)))
+#define VROR(V, x, n)       V##_OR (V##_SRLI ((x), (n)), V##_SLLI ((x), 32 - (n)))
+
+/* Four words W[t] ... W[t+3] of the SHA-1 message schedule in X0 from     */
+/* X0 ... X3 = W[t-16] ... W[t-1]. W[t+3] depends on W[t], which is added  */
+/* after the rotation of the other terms.                                  */
+#define SHA1_SCHED4(V, X0, X1, X2, X3) \
+  t0 = V##_XOR (V##_XOR ((X0), V##_ALIGNR ((X1), (X0), 8)), (X2)); \
+  t0 = V##_XOR (t0, V##_SRLB ((X3), 4)); \
+  (X0) = VROL (V, t0, 1); \
+  t0 = V##_SLLB ((X0), 12); \
+  (X0) = V##_XOR ((X0), VROL (V, t0, 1))
+
+/* Complete SHA-1 message schedule of 80 words */
+#define SHA1_SCHEDULE(V) \
+  V##_STORE (0, X0); \
+  V##_STORE (4, X1); \
+  V##_STORE (8, X2); \
+  V##_STORE (12, X3); \
+  for (t = 16; t < 80; t += 16) \
+    { \
+      SHA1_SCHED4 (V, X0, X1, X2, X3); \
+      V##_STORE (t, X0); \
+      SHA1_SCHED4 (V, X1, X2, X3, X0); \
+      V##_STORE (t + 4, X1); \
+      SHA1_SCHED4 (V, X2, X3, X0, X1); \
+      V##_STORE (t + 8, X2); \
+      SHA1_SCHED4 (V, X3, X0, X1, X2); \
+      V##_STORE (t + 12, X3); \
+    }
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   SHA-1 block function with SSSE3 message schedule              */
+/*  Syntax:     static void sha1_swallow_ssse3 (ULONG *stomach, UCHAR *clear, */
+/*                                                    ULONG noofblocks);      */
+/*  Input:      ULONG *stomach (Chaining value)                               */
+/*              UCHAR *clear (Message blocks)                                 */
+/*              ULONG noofblocks (Number of 64 byte blocks in clear)          */
+/*  Output:     ULONG *stomach (Updated chaining value)                       */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+SSSE3_TARGET static void
+sha1_swallow_ssse3 (ULONG *stomach, UCHAR *clear, ULONG noofblocks)
+{
+  __m128i X0, X1, X2, X3, t0, mask;
+  unsigned int W[80];
+  int t;
+
+  mask = _mm_set_epi8 (12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+
+  for (; noofblocks > 0; noofblocks--, clear += 64)
+    {
+      X0 = V128_LOAD (clear);
+      X1 = V128_LOAD (clear + 16);
+      X2 = V128_LOAD (clear + 32);
+      X3 = V128_LOAD (clear + 48);
+
+      SHA1_SCHEDULE (V128);
+
+      sha1_rounds (stomach, W);
+    }
+
+#ifdef FLINT_SECURE
+  X0 = X1 = X2 = X3 = t0 = _mm_setzero_si128 ();
+  ZeroUcharArray (W, sizeof (W));
+#endif
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   SHA-1 block function with AVX2 message schedule               */
+/*              The schedules of two blocks are computed in parallel          */
+/*  Syntax:     static void sha1_swallow_avx2 (ULONG *stomach, UCHAR *clear,  */
+/*                                                    ULONG noofblocks);      */
+/*  Input:      ULONG *stomach (Chaining value)                               */
+/*              UCHAR *clear (Message blocks)                                 */
+/*              ULONG noofblocks (Number of 64 byte blocks in clear)          */
+/*  Output:     ULONG *stomach (Updated chaining value)                       */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+AVX2_TARGET static void
+sha1_swallow_avx2 (ULONG *stomach, UCHAR *clear, ULONG noofblocks)
+{
+  __m256i X0, X1, X2, X3, t0, mask;
+  unsigned int W[80], W2[80];
+  int t;
+
+  mask = _mm256_set_epi8 (12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+                          12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+
+  for (; noofblocks > 1; noofblocks -= 2, clear += 128)
+    {
+      X0 = V256_LOAD (clear);
+      X1 = V256_LOAD (clear + 16);
+      X2 = V256_LOAD (clear + 32);
+      X3 = V256_LOAD (clear + 48);
+
+      SHA1_SCHEDULE (V256);
+
+      /* Clean upper halves avoid AVX-SSE transition stalls in the rounds */
+      _mm256_zeroupper ();
+      sha1_rounds (stomach, W);
+      sha1_rounds (stomach, W2);
+    }
+
+  if (noofblocks > 0)
+    {
+      sha1_swallow_ssse3 (stomach, clear, 1);
+    }
+
+#ifdef FLINT_SECURE
+  _mm256_zeroall ();
+  ZeroUcharArray (W, sizeof (W));
+  ZeroUcharArray (W2, sizeof (W2));
+#endif
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Rounds of SHA-1 on a precomputed message schedule             */
+/*  Syntax:     static void sha1_rounds (ULONG *stomach,                      */
+/*                                                 const unsigned int *W);    */
+/*  Input:      ULONG *stomach (Chaining value)                               */
+/*              const unsigned int *W (Message schedule of 80 words)          */
+/*  Output:     ULONG *stomach (Updated chaining value)                       */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+static void
+sha1_rounds (ULONG *stomach, const unsigned int *W)
+{
+  int round;
+  unsigned int x;
+
+  unsigned int a = (unsigned int)stomach[0];
+  unsigned int b = (unsigned int)stomach[1];
+  unsigned int c = (unsigned int)stomach[2];
+  unsigned int d = (unsigned int)stomach[3];
+  unsigned int e = (unsigned int)stomach[4];
+
+  for (round = 0; round < 20; round++)
+    {
+      x = ROL((a), 5) + (d^(b&(c^d))) + e + W[round] + 0x5A827999UL;
+      CHAIN (a, b, c, d, e, x);
+    }
+
+  for (round = 20; round < 40; round++)
+    {
+      x = ROL((a), 5) + (b^c^d) + e + W[round] + 0x6ED9EBA1UL;
+      CHAIN (a, b, c, d, e, x);
+    }
+
+  for (round = 40; round < 60; round++)
+    {
+      x = ROL((a), 5) + ((b&c)|(d&(b|c))) + e + W[round] + 0x8F1BBCDCUL;
+      CHAIN (a, b, c, d, e, x);
+    }
+
+  for (round = 60; round < 80; round++)
+    {
+      x = ROL((a), 5) + (b^c^d) + e + W[round] + 0xCA62C1D6UL;
+      CHAIN (a, b, c, d, e, x);
+    }
+
+  /* Result in stomach */
+  stomach[0] += a;
+  stomach[1] += b;
+  stomach[2] += c;
+  stomach[3] += d;
+  stomach[4] += e;
+
+#ifdef FLINT_SECURE
+  a = b = c = d = e = x = 0;
+#endif
+}
+
+
+#endif /* SHA_SIMD? */
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Export of a hash status into the portable byte format:        */
+/*              4 byte tag, the chaining words as 32 bit Big-Endian values,   */
+/*              the number of bytes hashed so far as 64 bit Big-Endian value  */
+/*  Syntax:     void StatExport (UCHAR *Buf, const char *Tag, ULONG *stomach, */
+/*                               int Words, ULONG total[]);                   */
+/*  Input:      Tag (Identifier of the hash function, 4 characters)           */
+/*              stomach (Chaining words)                                      */
+/*              Words (Number of chaining words)                              */
+/*              total (Number of bytes hashed so far, total[1] high part)     */
+/*  Output:     Buf (Exported status, 4 * Words + 12 bytes)                   */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+static void
+StatExport (UCHAR *Buf, const char *Tag, ULONG *stomach, int Words,
+            ULONG total[])
+{
+  int i;
+
+  memcpy (Buf, Tag, 4);
+  Buf += 4;
+
+  for (i = 0; i < Words; i++)
+    {
+      UL2UCBE (Buf, stomach[i]);
+      Buf += 4;
+    }
+
+  UL2UCBE (Buf, total[1]);
+  UL2UCBE (Buf + 4, total[0]);
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Import of a hash status exported by StatExport                */
+/*  Syntax:     int StatImport (ULONG *stomach, ULONG total[], UCHAR *Buf,    */
+/*                              ULONG Len, const char *Tag, int Words);       */
+/*  Input:      Buf (Exported status)                                         */
+/*              Len (Length of Buf in bytes)                                  */
+/*              Tag (Expected identifier of the hash function)                */
+/*              Words (Number of chaining words)                              */
+/*  Output:     stomach, total (Imported status, unchanged on error)          */
+/*  Returns:    0 if everything is O.K.                                       */
+/*              -1 if Len, the tag or the number of bytes is not valid        */
+/*                                                                            */
+/******************************************************************************/
+static int
+StatImport (ULONG *stomach, ULONG total[], UCHAR *Buf, ULONG Len,
+            const char *Tag, int Words)
+{
+  int i;
+
+  /* A status only exists at a block boundary */
+  if (Len != (ULONG)(4 * Words + 12) || memcmp (Buf, Tag, 4) != 0
+      || (Buf[Len - 1] & 63) != 0)
+    {
+      return -1;
+    }
+  Buf += 4;
+
+  for (i = 0; i < Words; i++)
+    {
+      stomach[i] = UC2ULBE (Buf);
+      Buf += 4;
+    }
+
+  total[1] = UC2ULBE (Buf);
+  total[0] = UC2ULBE (Buf + 4);
+
+  return 0;
+}
+
+
 #ifdef FLINT_SECURE
 
 /******************************************************************************/
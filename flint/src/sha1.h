@@ -61,12 +61,27 @@ extern "C" {
 #define SHALEN 160
 #define E_CLINT_SHA -20
 
+/* Length of a SHA-1 status exported by sha1export_l in bytes */
+#define SHASTATLEN 32
+
+/* Implementations of the block functions for shaimpl_l */
+
+#define SHA_IMPL_C      0  /* Portable C */
+#define SHA_IMPL_SSSE3  1  /* Message schedule by SSSE3 */
+#define SHA_IMPL_AVX2   2  /* Message schedule of two blocks by AVX2 */
+#define SHA_IMPL_SHANI  3  /* SHA extensions */
+#define SHA_IMPL_BEST   SHA_IMPL_SHANI
+
 /* Macros maintaining FLINT/C namespace */
 
 #define sha1init     sha1init_l
 #define sha1hash     sha1hash_l
 #define sha1finish   sha1finish_l
 #define sha1         sha1_l
+#define shaimpl      shaimpl_l
+#define sha1clone    sha1clone_l
+#define sha1export   sha1export_l
+#define sha1import   sha1import_l
 
 struct sha1_stat 
 {
@@ -119,6 +134,14 @@ extern void __FLINT_API
 sha1finish_l (unsigned char *, SHASTAT *, unsigned char *, unsigned long);
 extern void __FLINT_API 
 sha1_l (unsigned char *, unsigned char *, unsigned long);
+extern int  __FLINT_API
+shaimpl_l (int);
+extern void __FLINT_API
+sha1clone_l (SHASTAT *, SHASTAT *);
+extern void __FLINT_API
+sha1export_l (unsigned char *, SHASTAT *);
+extern int  __FLINT_API
+sha1import_l (SHASTAT *, unsigned char *, unsigned long);
 
 #ifdef  __cplusplus
 }
@@ -0,0 +1,642 @@
+/******************************************************************************/
+/*                                                                            */
+/* Functions for arithmetic and number theory with large integers in C        */
+/* Software supplement to the book "Cryptography in C and C++"                */
+/* by Michael Welschenbach                                                    */
+/*                                                                            */
+/* Module sha512.c         Revision: 19.10.2026                               */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 2001-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+
+#include <string.h>
+#include "flint.h"
+#include "sha512.h"
+
+#ifndef inline
+#if (_MSC_VER >= 1100) || defined __GNUC__
+#define inline __inline
+#else
+#define inline /**/
+#endif
+#endif
+
+
+/* Prototypes of local functions */
+
+static void sha512_swallow (ULLONG *, UCHAR *, ULONG);
+static void sha512_digest (ULLONG *, UCHAR *, ULLONG[]);
+static void sha512_end (UCHAR *, SHA512STAT *, UCHAR *, ULONG, int);
+
+#ifdef FLINT_SECURE
+static inline void ZeroUcharArray (void *, size_t);
+#endif
+
+
+/* Macros */
+
+/* Constant of 64 bit, composed of two halves of 32 bit */
+#define W64(HI, LO)  (((ULLONG)(HI) << 32) | (ULLONG)(LO))
+
+/* Rotation of 64 bit values, mapped to one instruction by the compiler */
+#define ROR64(X, N)  (((X) >> (N)) | ((X) << (64 - (N))))
+
+/* SHA-512 specific macros */
+#define Ch(X, Y, Z)  ((Z)^((X)&((Y)^(Z))))
+
+#define Maj(X, Y, Z) (((X)&(Y))|((Z)&((X)|(Y))))
+
+#define SUM512_0(X)  (ROR64((X), 28) ^ ROR64((X), 34) ^ ROR64((X), 39))
+
+#define SUM512_1(X)  (ROR64((X), 14) ^ ROR64((X), 18) ^ ROR64((X), 41))
+
+#define SIG512_0(X)  (ROR64((X),  1) ^ ROR64((X),  8) ^ ((X) >> 7))
+
+#define SIG512_1(X)  (ROR64((X), 19) ^ ROR64((X), 61) ^ ((X) >> 6))
+
+/* Conversion of 8 bytes in Big-Endian representation into a 64-bit word */
+#define UC2ULLBE(ucptr) \
+  (((ULLONG) *(ucptr)     << 56) | \
+   ((ULLONG) *((ucptr)+1) << 48) | \
+   ((ULLONG) *((ucptr)+2) << 40) | \
+   ((ULLONG) *((ucptr)+3) << 32) | \
+   ((ULLONG) *((ucptr)+4) << 24) | \
+   ((ULLONG) *((ucptr)+5) << 16) | \
+   ((ULLONG) *((ucptr)+6) <<  8) | \
+   ((ULLONG) *((ucptr)+7)      ))
+
+/* Addition of a single-digit number b to a double-digit number represented */
+/* by an array (a[1],a[0]). A carry in a[0]+=b is handled by increasing a[1]. */
+#define ADDC(a, b) { \
+  if (((a)[0] + (b)) < (a)[0]) {(a)[1]++;} \
+  (a)[0] += (b); \
+}
+
+/* Round i + j of SHA-512. Instead of moving the working variables through */
+/* a, ..., h after each round, the callers rotate the roles of the variables */
+/* in the arguments, such that only d and h are written.                   */
+#define R512(a, b, c, d, e, f, g, h, j) \
+  T1 = (h) + SUM512_1 (e) + Ch ((e), (f), (g)) + K512[i + (j)] + W[j]; \
+  (d) += T1; \
+  (h) = T1 + SUM512_0 (a) + Maj ((a), (b), (c))
+
+/* Message words of rounds 0 to 15 are loaded from the message block, the */
+/* following words are expanded in place in a window of 16 words.         */
+#define LOAD512(j)   (W[j] = UC2ULLBE (clear + ((j) << 3)))
+
+#define XPND512(j)   (W[j] += SIG512_1 (W[((j) + 14) & 15]) + \
+                      W[((j) + 9) & 15] + SIG512_0 (W[((j) + 1) & 15]))
+
+/* 16 rounds i, ..., i + 15, with message words provided by MSG */
+#define ROUNDS512(MSG) \
+  MSG (0);  R512 (a, b, c, d, e, f, g, h,  0); \
+  MSG (1);  R512 (h, a, b, c, d, e, f, g,  1); \
+  MSG (2);  R512 (g, h, a, b, c, d, e, f,  2); \
+  MSG (3);  R512 (f, g, h, a, b, c, d, e,  3); \
+  MSG (4);  R512 (e, f, g, h, a, b, c, d,  4); \
+  MSG (5);  R512 (d, e, f, g, h, a, b, c,  5); \
+  MSG (6);  R512 (c, d, e, f, g, h, a, b,  6); \
+  MSG (7);  R512 (b, c, d, e, f, g, h, a,  7); \
+  MSG (8);  R512 (a, b, c, d, e, f, g, h,  8); \
+  MSG (9);  R512 (h, a, b, c, d, e, f, g,  9); \
+  MSG (10); R512 (g, h, a, b, c, d, e, f, 10); \
+  MSG (11); R512 (f, g, h, a, b, c, d, e, 11); \
+  MSG (12); R512 (e, f, g, h, a, b, c, d, 12); \
+  MSG (13); R512 (d, e, f, g, h, a, b, c, 13); \
+  MSG (14); R512 (c, d, e, f, g, h, a, b, 14); \
+  MSG (15); R512 (b, c, d, e, f, g, h, a, 15)
+
+/* SHA-512 specific constants */
+static const ULLONG K512[] =
+{
+  W64 (0x428a2f98, 0xd728ae22), W64 (0x71374491, 0x23ef65cd),
+  W64 (0xb5c0fbcf, 0xec4d3b2f), W64 (0xe9b5dba5, 0x8189dbbc),
+  W64 (0x3956c25b, 0xf348b538), W64 (0x59f111f1, 0xb605d019),
+  W64 (0x923f82a4, 0xaf194f9b), W64 (0xab1c5ed5, 0xda6d8118),
+  W64 (0xd807aa98, 0xa3030242), W64 (0x12835b01, 0x45706fbe),
+  W64 (0x243185be, 0x4ee4b28c), W64 (0x550c7dc3, 0xd5ffb4e2),
+  W64 (0x72be5d74, 0xf27b896f), W64 (0x80deb1fe, 0x3b1696b1),
+  W64 (0x9bdc06a7, 0x25c71235), W64 (0xc19bf174, 0xcf692694),
+  W64 (0xe49b69c1, 0x9ef14ad2), W64 (0xefbe4786, 0x384f25e3),
+  W64 (0x0fc19dc6, 0x8b8cd5b5), W64 (0x240ca1cc, 0x77ac9c65),
+  W64 (0x2de92c6f, 0x592b0275), W64 (0x4a7484aa, 0x6ea6e483),
+  W64 (0x5cb0a9dc, 0xbd41fbd4), W64 (0x76f988da, 0x831153b5),
+  W64 (0x983e5152, 0xee66dfab), W64 (0xa831c66d, 0x2db43210),
+  W64 (0xb00327c8, 0x98fb213f), W64 (0xbf597fc7, 0xbeef0ee4),
+  W64 (0xc6e00bf3, 0x3da88fc2), W64 (0xd5a79147, 0x930aa725),
+  W64 (0x06ca6351, 0xe003826f), W64 (0x14292967, 0x0a0e6e70),
+  W64 (0x27b70a85, 0x46d22ffc), W64 (0x2e1b2138, 0x5c26c926),
+  W64 (0x4d2c6dfc, 0x5ac42aed), W64 (0x53380d13, 0x9d95b3df),
+  W64 (0x650a7354, 0x8baf63de), W64 (0x766a0abb, 0x3c77b2a8),
+  W64 (0x81c2c92e, 0x47edaee6), W64 (0x92722c85, 0x1482353b),
+  W64 (0xa2bfe8a1, 0x4cf10364), W64 (0xa81a664b, 0xbc423001),
+  W64 (0xc24b8b70, 0xd0f89791), W64 (0xc76c51a3, 0x0654be30),
+  W64 (0xd192e819, 0xd6ef5218), W64 (0xd6990624, 0x5565a910),
+  W64 (0xf40e3585, 0x5771202a), W64 (0x106aa070, 0x32bbd1b8),
+  W64 (0x19a4c116, 0xb8d2d0c8), W64 (0x1e376c08, 0x5141ab53),
+  W64 (0x2748774c, 0xdf8eeb99), W64 (0x34b0bcb5, 0xe19b48a8),
+  W64 (0x391c0cb3, 0xc5c95a63), W64 (0x4ed8aa4a, 0xe3418acb),
+  W64 (0x5b9cca4f, 0x7763e373), W64 (0x682e6ff3, 0xd6b2b8a3),
+  W64 (0x748f82ee, 0x5defb2fc), W64 (0x78a5636f, 0x43172f60),
+  W64 (0x84c87814, 0xa1f0ab72), W64 (0x8cc70208, 0x1a6439ec),
+  W64 (0x90befffa, 0x23631e28), W64 (0xa4506ceb, 0xde82bde9),
+  W64 (0xbef9a3f7, 0xb2c67915), W64 (0xc67178f2, 0xe372532b),
+  W64 (0xca273ece, 0xea26619c), W64 (0xd186b8c7, 0x21c0c207),
+  W64 (0xeada7dd6, 0xcde0eb1e), W64 (0xf57d4f7f, 0xee6ed178),
+  W64 (0x06f067aa, 0x72176fba), W64 (0x0a637dc5, 0xa2c898a6),
+  W64 (0x113f9804, 0xbef90dae), W64 (0x1b710b35, 0x131c471b),
+  W64 (0x28db77f5, 0x23047d84), W64 (0x32caab7b, 0x40c72493),
+  W64 (0x3c9ebe0a, 0x15c9bebc), W64 (0x431d67c4, 0x9c100d4c),
+  W64 (0x4cc5d4be, 0xcb3e42b6), W64 (0x597f299c, 0xfc657e2a),
+  W64 (0x5fcb6fab, 0x3ad6faec), W64 (0x6c44198c, 0x4a475817)
+};
+
+/* Initial hash values */
+static const ULLONG IV512[] =
+{
+  W64 (0x6a09e667, 0xf3bcc908), W64 (0xbb67ae85, 0x84caa73b),
+  W64 (0x3c6ef372, 0xfe94f82b), W64 (0xa54ff53a, 0x5f1d36f1),
+  W64 (0x510e527f, 0xade682d1), W64 (0x9b05688c, 0x2b3e6c1f),
+  W64 (0x1f83d9ab, 0xfb41bd6b), W64 (0x5be0cd19, 0x137e2179)
+};
+
+static const ULLONG IV384[] =
+{
+  W64 (0xcbbb9d5d, 0xc1059ed8), W64 (0x629a292a, 0x367cd507),
+  W64 (0x9159015a, 0x3070dd17), W64 (0x152fecd8, 0xf70e5939),
+  W64 (0x67332667, 0xffc00b31), W64 (0x8eb44a87, 0x68581511),
+  W64 (0xdb0c2e0d, 0x64f98fa7), W64 (0x47b5481d, 0xbefa4fa4)
+};
+
+static const ULLONG IV512_256[] =
+{
+  W64 (0x22312194, 0xfc2bf72c), W64 (0x9f555fa3, 0xc84c64c2),
+  W64 (0x2393b86b, 0x6f53b151), W64 (0x96387719, 0x5940eabd),
+  W64 (0x96283ee2, 0xa88effe3), W64 (0xbe5e1e25, 0x53863992),
+  W64 (0x2b0199fc, 0x2c85b8aa), W64 (0x0eb72ddc, 0x81c52ca2)
+};
+
+
+/*****************************************************************************/
+/* SHA-512 API                                                               */
+/*****************************************************************************/
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Hashing of a message of length byte in a single step          */
+/*  Syntax:     void sha512_l (UCHAR *HashRes, UCHAR *clear, ULONG length);   */
+/*  Input:      UCHAR *clear (Pointer to message block)                       */
+/*              ULONG length (Length of message block)                        */
+/*  Output:     UCHAR *HashRes (Hash Value of 64 bytes)                       */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+void __FLINT_API
+sha512_l (UCHAR *HashRes, UCHAR *clear, ULONG length)
+{
+  SHA512STAT hws;
+
+  sha512init_l (&hws);
+  sha512finish_l (HashRes, &hws, clear, length);
+
+#ifdef FLINT_SECURE
+  ZeroUcharArray (&hws, sizeof (hws));
+#endif
+}
+
+
+/******************************************************************************/
+/* Functions for blockwise hashing a message in several steps                 */
+/* Procedure: Initialization with sha512init_l                                */
+/*            Hashing of block1,block2,...,blockn with function sha512hash_l  */
+/*            Finish operation with function sha512finish_l                   */
+/* SHA-384 and SHA-512/256 follow the same procedure with their functions.    */
+/******************************************************************************/
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Initialization of SHA-512 function                            */
+/*  Syntax:     void sha512init_l (SHA512STAT *hws);                          */
+/*  Input:      SHA512STAT *hws (SHA-512 status buffer)                       */
+/*  Output:     -                                                             */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+void __FLINT_API
+sha512init_l (SHA512STAT *hws)
+{
+  memcpy (hws->stomach, IV512, sizeof (hws->stomach));
+  hws->total[0] = 0;
+  hws->total[1] = 0;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Hashing of a message block                                    */
+/*  Syntax:     int sha512hash_l (SHA512STAT *hws, UCHAR *clear,              */
+/*                                                   ULONG length);           */
+/*  Input:      SHA512STAT *hws (SHA-512 status buffer)                       */
+/*              UCHAR *clear (Pointer to message block)                       */
+/*              ULONG length (Length of message block in bytes = 0 mod 128)   */
+/*  Output:     -                                                             */
+/*  Returns:    E_CLINT_OK if everything is O.K.                              */
+/*              E_CLINT_SHA if length != 0 mod 128                            */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+sha512hash_l (SHA512STAT *hws, UCHAR *clear, ULONG length)
+{
+  /* If incomplete 128 byte block exists... */
+  if (length & 127)
+    {
+      return E_CLINT_SHA;  /* ...return error code  */
+    }
+
+  /* Process 128 byte message blocks in clear */
+  sha512_swallow (hws->stomach, clear, length >> 7);
+
+  ADDC (hws->total, (ULLONG)length);
+
+  return E_CLINT_OK;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Finish hash function SHA-512                                  */
+/*  Syntax:     void sha512finish_l (UCHAR *HashRes, SHA512STAT *hws,         */
+/*                                          UCHAR *clear, ULONG length);      */
+/*  Input:      SHA512STAT *hws (SHA-512 status buffer)                       */
+/*              UCHAR *clear (Pointer to the last message block)              */
+/*              ULONG length (Length of message block in bytes)               */
+/*  Output:     UCHAR HashRes (Hash value of 64 bytes)                        */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+void __FLINT_API
+sha512finish_l (UCHAR *HashRes, SHA512STAT *hws, UCHAR *clear, ULONG length)
+{
+  sha512_end (HashRes, hws, clear, length, SHALEN512 >> 3);
+}
+
+
+/*****************************************************************************/
+/* SHA-384 API                                                               */
+/*****************************************************************************/
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Hashing of a message of length byte in a single step          */
+/*  Syntax:     void sha384_l (UCHAR *HashRes, UCHAR *clear, ULONG length);   */
+/*  Input:      UCHAR *clear (Pointer to message block)                       */
+/*              ULONG length (Length of message block)                        */
+/*  Output:     UCHAR *HashRes (Hash Value of 48 bytes)                       */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+void __FLINT_API
+sha384_l (UCHAR *HashRes, UCHAR *clear, ULONG length)
+{
+  SHA512STAT hws;
+
+  sha384init_l (&hws);
+  sha384finish_l (HashRes, &hws, clear, length);
+
+#ifdef FLINT_SECURE
+  ZeroUcharArray (&hws, sizeof (hws));
+#endif
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Initialization of SHA-384 function                            */
+/*  Syntax:     void sha384init_l (SHA512STAT *hws);                          */
+/*  Input:      SHA512STAT *hws (SHA-384 status buffer)                       */
+/*  Output:     -                                                             */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+void __FLINT_API
+sha384init_l (SHA512STAT *hws)
+{
+  memcpy (hws->stomach, IV384, sizeof (hws->stomach));
+  hws->total[0] = 0;
+  hws->total[1] = 0;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Hashing of a message block                                    */
+/*  Syntax:     int sha384hash_l (SHA512STAT *hws, UCHAR *clear,              */
+/*                                                   ULONG length);           */
+/*  Input:      SHA512STAT *hws (SHA-384 status buffer)                       */
+/*              UCHAR *clear (Pointer to message block)                       */
+/*              ULONG length (Length of message block in bytes = 0 mod 128)   */
+/*  Output:     -                                                             */
+/*  Returns:    E_CLINT_OK if everything is O.K.                              */
+/*              E_CLINT_SHA if length != 0 mod 128                            */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+sha384hash_l (SHA512STAT *hws, UCHAR *clear, ULONG length)
+{
+  return sha512hash_l (hws, clear, length);
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Finish hash function SHA-384                                  */
+/*  Syntax:     void sha384finish_l (UCHAR *HashRes, SHA512STAT *hws,         */
+/*                                          UCHAR *clear, ULONG length);      */
+/*  Input:      SHA512STAT *hws (SHA-384 status buffer)                       */
+/*              UCHAR *clear (Pointer to the last message block)              */
+/*              ULONG length (Length of message block in bytes)               */
+/*  Output:     UCHAR HashRes (Hash value of 48 bytes)                        */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+void __FLINT_API
+sha384finish_l (UCHAR *HashRes, SHA512STAT *hws, UCHAR *clear, ULONG length)
+{
+  sha512_end (HashRes, hws, clear, length, SHALEN384 >> 3);
+}
+
+
+/*****************************************************************************/
+/* SHA-512/256 API                                                           */
+/*****************************************************************************/
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Hashing of a message of length byte in a single step          */
+/*  Syntax:     void sha512_256_l (UCHAR *HashRes, UCHAR *clear,              */
+/*                                                   ULONG length);           */
+/*  Input:      UCHAR *clear (Pointer to message block)                       */
+/*              ULONG length (Length of message block)                        */
+/*  Output:     UCHAR *HashRes (Hash Value of 32 bytes)                       */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+void __FLINT_API
+sha512_256_l (UCHAR *HashRes, UCHAR *clear, ULONG length)
+{
+  SHA512STAT hws;
+
+  sha512_256init_l (&hws);
+  sha512_256finish_l (HashRes, &hws, clear, length);
+
+#ifdef FLINT_SECURE
+  ZeroUcharArray (&hws, sizeof (hws));
+#endif
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Initialization of SHA-512/256 function                        */
+/*  Syntax:     void sha512_256init_l (SHA512STAT *hws);                      */
+/*  Input:      SHA512STAT *hws (SHA-512/256 status buffer)                   */
+/*  Output:     -                                                             */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+void __FLINT_API
+sha512_256init_l (SHA512STAT *hws)
+{
+  memcpy (hws->stomach, IV512_256, sizeof (hws->stomach));
+  hws->total[0] = 0;
+  hws->total[1] = 0;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Hashing of a message block                                    */
+/*  Syntax:     int sha512_256hash_l (SHA512STAT *hws, UCHAR *clear,          */
+/*                                                   ULONG length);           */
+/*  Input:      SHA512STAT *hws (SHA-512/256 status buffer)                   */
+/*              UCHAR *clear (Pointer to message block)                       */
+/*              ULONG length (Length of message block in bytes = 0 mod 128)   */
+/*  Output:     -                                                             */
+/*  Returns:    E_CLINT_OK if everything is O.K.                              */
+/*              E_CLINT_SHA if length != 0 mod 128                            */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+sha512_256hash_l (SHA512STAT *hws, UCHAR *clear, ULONG length)
+{
+  return sha512hash_l (hws, clear, length);
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Finish hash function SHA-512/256                              */
+/*  Syntax:     void sha512_256finish_l (UCHAR *HashRes, SHA512STAT *hws,     */
+/*                                          UCHAR *clear, ULONG length);      */
+/*  Input:      SHA512STAT *hws (SHA-512/256 status buffer)                   */
+/*              UCHAR *clear (Pointer to the last message block)              */
+/*              ULONG length (Length of message block in bytes)               */
+/*  Output:     UCHAR HashRes (Hash value of 32 bytes)                        */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+void __FLINT_API
+sha512_256finish_l (UCHAR *HashRes, SHA512STAT *hws, UCHAR *clear,
+                    ULONG length)
+{
+  sha512_end (HashRes, hws, clear, length, SHALEN512_256 >> 3);
+}
+
+
+/******************************************************************************/
+/* SHA-512 kernel functions                                                   */
+/******************************************************************************/
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Common finish of SHA-512, SHA-384 and SHA-512/256             */
+/*  Syntax:     static void sha512_end (UCHAR *HashRes, SHA512STAT *hws,      */
+/*                               UCHAR *clear, ULONG length, int HashLen);    */
+/*  Input:      SHA512STAT *hws (Status buffer)                               */
+/*              UCHAR *clear (Pointer to the last message block)              */
+/*              ULONG length (Length of message block in bytes)               */
+/*              int HashLen (Length of the hash value in bytes, 64, 48, 32)   */
+/*  Output:     UCHAR HashRes (Leading HashLen bytes of the chaining value)   */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+static void
+sha512_end (UCHAR *HashRes, SHA512STAT *hws, UCHAR *clear, ULONG length,
+            int HashLen)
+{
+  int i;
+
+  /* Number of bytes in complete blocks */
+  ULONG blength = (length >> 7) << 7;
+
+  /* Process complete blocks in clear */
+  sha512hash_l (hws, clear, blength);
+
+  /* Add length of message in clear to hws->total */
+  ADDC (hws->total, (ULLONG)(length - blength));
+
+  /* Process last incomplete block with padding and length of message */
+  sha512_digest (hws->stomach, clear + blength, hws->total);
+
+  /* Note: Hash result is stored in Big-Endian representation. */
+  for (i = 0; i < HashLen; i++)
+    {
+      HashRes[i] = (UCHAR)(hws->stomach[i >> 3] >> (56 - ((i & 7) << 3)));
+    }
+}
+
+
+static void
+sha512_swallow (ULLONG *stomach, UCHAR *clear, ULONG noofblocks)
+{
+  ULLONG W[16];
+  ULLONG T1;
+  ULLONG a, b, c, d, e, f, g, h;
+  int i;
+
+  for (; noofblocks > 0; noofblocks--, clear += 128)
+    {
+      a = stomach[0];
+      b = stomach[1];
+      c = stomach[2];
+      d = stomach[3];
+      e = stomach[4];
+      f = stomach[5];
+      g = stomach[6];
+      h = stomach[7];
+
+      i = 0;
+      ROUNDS512 (LOAD512);
+
+      for (i = 16; i < 80; i += 16)
+        {
+          ROUNDS512 (XPND512);
+        }
+
+      /* Result in stomach */
+      stomach[0] += a;
+      stomach[1] += b;
+      stomach[2] += c;
+      stomach[3] += d;
+      stomach[4] += e;
+      stomach[5] += f;
+      stomach[6] += g;
+      stomach[7] += h;
+    }
+
+#ifdef FLINT_SECURE
+  /* Overwrite temporary variables */
+  a = b = c = d = e = f = g = h = T1 = 0;
+  ZeroUcharArray (W, sizeof (W));
+#endif
+}
+
+
+static void
+sha512_digest (ULLONG *stomach, UCHAR *clear, ULLONG total[])
+{
+  UCHAR Block[256];
+  ULONG rest, blength;
+  ULLONG bits;
+  int i;
+
+  /* Message length modulo 128 */
+  rest = (ULONG)(total[0] & 0x7f);
+
+  /* Remaining bytes, followed by 10000000 = 0x80 and zeros */
+  memcpy (Block, clear, rest);
+  Block[rest] = 0x80;
+
+  /* If less than 16 bytes are left for the length, a second block follows */
+  blength = (rest > 111) ? 256 : 128;
+  memset (Block + rest + 1, 0, blength - rest - 1);
+
+  /* Append message length in bit as 128-bit number in Big-Endian order */
+  bits = (total[1] << 3) | (total[0] >> 61);
+  for (i = 0; i < 8; i++)
+    {
+      Block[blength - 16 + i] = (UCHAR)(bits >> (56 - (i << 3)));
+    }
+  bits = total[0] << 3;
+  for (i = 0; i < 8; i++)
+    {
+      Block[blength - 8 + i] = (UCHAR)(bits >> (56 - (i << 3)));
+    }
+
+  sha512_swallow (stomach, Block, blength >> 7);
+
+#ifdef FLINT_SECURE
+  /* Overwrite temporary variables */
+  ZeroUcharArray (Block, sizeof (Block));
+  bits = 0;
+#endif
+}
+
+
+#ifdef FLINT_SECURE
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Purging of Array                                              */
+/*  Syntax:     ZeroUcharArray (UCHAR *a, int Len);                           */
+/*  Input:      UCHAR *a (Pointer to array of UCHARs)                         */
+/*              int Len (Length of array in byte)                             */
+/*  Output:     Array overwritten by 0                                        */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+static inline void
+ZeroUcharArray (void *a, size_t Len)
+{
+  memset ((UCHAR*)a, 0, Len);
+}
+
+#endif
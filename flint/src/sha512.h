@@ -0,0 +1,159 @@
+/******************************************************************************/
+/*                                                                            */
+/* Functions for arithmetic and number theory with large integers in C        */
+/* Software supplement to the book "Cryptography in C and C++"                */
+/* by Michael Welschenbach                                                    */
+/*                                                                            */
+/* Module sha512.h         Revision: 19.10.2026                               */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 1998-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+
+#ifndef __SHA512H__
+#define __SHA512H__
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+#define SHALEN384      384
+#define SHALEN512      512
+#define SHALEN512_256  256
+#define E_CLINT_SHA    -20
+
+/* Unsigned integer type of 64 bit for the SHA-512 family */
+
+#ifndef __ULLONG_DEFINED
+#define __ULLONG_DEFINED
+#if defined _MSC_VER || defined __BORLANDC__ || defined __WATCOMC__
+typedef unsigned __int64 ULLONG;
+#else
+typedef unsigned long long ULLONG;
+#endif
+#endif /* !__ULLONG_DEFINED */
+
+/* Macros maintaining FLINT/C namespace */
+
+#define sha512init       sha512init_l
+#define sha512hash       sha512hash_l
+#define sha512finish     sha512finish_l
+#define sha512           sha512_l
+
+#define sha384init       sha384init_l
+#define sha384hash       sha384hash_l
+#define sha384finish     sha384finish_l
+#define sha384           sha384_l
+
+#define sha512_256init   sha512_256init_l
+#define sha512_256hash   sha512_256hash_l
+#define sha512_256finish sha512_256finish_l
+#define sha512_256       sha512_256_l
+
+/* Status buffer, shared by SHA-384, SHA-512 and SHA-512/256. */
+/* total holds the message length in bytes as 128 bit number. */
+
+struct sha512_stat
+{
+  ULLONG stomach[8];
+  ULLONG total[2];
+};
+
+typedef struct sha512_stat SHA512STAT;
+
+
+/***********************************************************/
+/* Function prototypes                                     */
+/***********************************************************/
+
+#ifndef __FLINT_API
+#ifdef FLINT_USEDLL
+#define __FLINT_API                   __cdecl
+#else
+#define __FLINT_API                   /**/
+#endif /* FLINT_USEDLL */
+#endif /* !defined __FLINT_API */
+
+
+/***********************************************************/
+/* Function prototypes of SHA-512 - API                    */
+/***********************************************************/
+
+extern void __FLINT_API
+sha512init_l (SHA512STAT *);
+extern int  __FLINT_API
+sha512hash_l (SHA512STAT *, unsigned char *, unsigned long);
+extern void __FLINT_API
+sha512finish_l (unsigned char *, SHA512STAT *, unsigned char *, unsigned long);
+extern void __FLINT_API
+sha512_l (unsigned char *, unsigned char *, unsigned long);
+
+/***********************************************************/
+/* Function prototypes of SHA-384 - API                    */
+/***********************************************************/
+
+extern void __FLINT_API
+sha384init_l (SHA512STAT *);
+extern int  __FLINT_API
+sha384hash_l (SHA512STAT *, unsigned char *, unsigned long);
+extern void __FLINT_API
+sha384finish_l (unsigned char *, SHA512STAT *, unsigned char *, unsigned long);
+extern void __FLINT_API
+sha384_l (unsigned char *, unsigned char *, unsigned long);
+
+/***********************************************************/
+/* Function prototypes of SHA-512/256 - API                */
+/***********************************************************/
+
+extern void __FLINT_API
+sha512_256init_l (SHA512STAT *);
+extern int  __FLINT_API
+sha512_256hash_l (SHA512STAT *, unsigned char *, unsigned long);
+extern void __FLINT_API
+sha512_256finish_l (unsigned char *, SHA512STAT *, unsigned char *,
+                    unsigned long);
+extern void __FLINT_API
+sha512_256_l (unsigned char *, unsigned char *, unsigned long);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* __SHA512H__ */
@@ -0,0 +1,521 @@
+/******************************************************************************/
+/*                                                                            */
+/* Functions for arithmetic and number theory with large integers in C        */
+/* Software supplement to the book "Cryptography in C and C++"                */
+/* by Michael Welschenbach                                                    */
+/*                                                                            */
+/* Module threadrand.c     Revision: 19.10.2026                               */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 2001-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+
+
+/* POSIX threads, process ids and fork handlers */
+#define _XOPEN_SOURCE 600
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "flint.h"
+#include "threadrand.h"
+
+
+/* Macros */
+
+/* Entropy bytes requested for the master seed and for reseeding after fork */
+#define THREADRAND_ENTROPY   32
+
+/* Length of the master seed, RIPEMD-160 value of GetEntropy_l */
+#define MASTERLEN            20
+
+
+/* PRNG of a thread */
+
+typedef struct
+{
+  STATEPRNG State;
+  ULONG Bytes;         /* Bytes delivered since the last reseed */
+  ULONG ForkGen;       /* Value of ForkGen when the state was seeded */
+} THREADSTATE;
+
+
+/* Master seed and parameters, shared read-only after initialization.     */
+/* Per-thread states are derived from the master seed and a counter, so   */
+/* deriving needs no lock. ForkGen is incremented in the child process    */
+/* after fork, states of an older generation are reseeded with entropy.   */
+
+static pthread_once_t Once = PTHREAD_ONCE_INIT;
+static pthread_key_t Key;
+static int MasterError = 0;
+static int Started = 0;
+static UCHAR MasterSeed[MASTERLEN];
+static ULONG Counter = 0;
+static volatile ULONG ForkGen = 0;
+static int Generator = FLINT_RNDAES;
+static ULONG Reseed = THREADRAND_RESEED;
+
+#ifndef __GNUC__
+static pthread_mutex_t CounterLock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+
+/* Prototypes */
+
+static void InitMaster (void);
+static void ChildAtFork (void);
+static void DestroyState (void *p);
+static ULONG NextCount (void);
+static int SeedState (THREADSTATE *t, int AddEntropy);
+static THREADSTATE *GetState (int *error);
+static void *local_memset (void *ptr, int val, size_t len);
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Choice of generator and reseed interval of the per-thread     */
+/*              PRNGs. Optional, must be called before any thread uses the    */
+/*              functions of this module.                                     */
+/*  Syntax:     int InitThreadRand_l (int Generator, ULONG Reseed);           */
+/*  Input:      int Generator (FLINT_RNDAES, FLINT_RNDRMDSHA1 or FLINT_RNDBBS */
+/*                             default FLINT_RNDAES)                          */
+/*              ULONG Reseed (Number of bytes a thread's PRNG delivers before */
+/*                            it is reseeded, default THREADRAND_RESEED)      */
+/*  Output:     -                                                             */
+/*  Returns:    0 if everything is O.K.                                       */
+/*              E_THREADRAND_ARG if Generator or Reseed is invalid            */
+/*              E_THREADRAND_INI if the per-thread PRNGs are already in use   */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+InitThreadRand_l (int Gen, ULONG Res)
+{
+  if ((Gen != FLINT_RNDAES && Gen != FLINT_RNDRMDSHA1 && Gen != FLINT_RNDBBS) ||
+      Res == 0)
+    {
+      return E_THREADRAND_ARG;
+    }
+
+  if (Started)
+    {
+      return E_THREADRAND_INI;
+    }
+
+  Generator = Gen;
+  Reseed = Res;
+
+  return 0;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   State of the PRNG of the calling thread, e.g. for use with    */
+/*              FindPrime_l. The state is created on first use and reseeded   */
+/*              if due. Output taken directly from the state is not counted   */
+/*              for the reseed interval.                                      */
+/*  Syntax:     STATEPRNG *ThreadRandState_l (void);                          */
+/*  Input:      -                                                             */
+/*  Output:     -                                                             */
+/*  Returns:    Pointer to the state of the calling thread's PRNG             */
+/*              NULL if the state cannot be created                           */
+/*                                                                            */
+/******************************************************************************/
+STATEPRNG * __FLINT_API
+ThreadRandState_l (void)
+{
+  THREADSTATE *t;
+  int error;
+
+  if ((t = GetState (&error)) == NULL)
+    {
+      return NULL;
+    }
+
+  return &t->State;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Generation of random bytes by the PRNG of the calling thread  */
+/*  Syntax:     int ThreadRandBytes_l (UCHAR *Buf, ULONG Len);                */
+/*  Input:      ULONG Len (Number of bytes)                                   */
+/*  Output:     UCHAR *Buf (Random bytes)                                     */
+/*  Returns:    0 if everything is O.K.                                       */
+/*              E_THREADRAND_INI if initialization of the master failed       */
+/*              E_THREADRAND_MEM if allocation of memory failed               */
+/*              E_THREADRAND_ENT if not enough entropy was available for the  */
+/*                               master seed or for reseeding after fork      */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+ThreadRandBytes_l (UCHAR *Buf, ULONG Len)
+{
+  THREADSTATE *t;
+  ULONG n;
+  int error = 0;
+
+  if ((t = GetState (&error)) == NULL)
+    {
+      return error;
+    }
+
+  while (Len > 0 && !error)
+    {
+      if (t->Bytes >= Reseed && (error = SeedState (t, 0)) != 0)
+        {
+          break;
+        }
+
+      n = MIN (Len, Reseed - t->Bytes);
+      error = RandBytes_l (Buf, n, &t->State);
+      t->Bytes += n;
+      Buf += n;
+      Len -= n;
+    }
+
+  return error;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Generation of 8, 16 and 32 bit random values by the PRNG of   */
+/*              the calling thread, bytes in big-endian order                 */
+/*  Syntax:     UCHAR bThreadRand_l (void);                                   */
+/*              USHORT sThreadRand_l (void);                                  */
+/*              ULONG lThreadRand_l (void);                                   */
+/*  Input:      -                                                             */
+/*  Output:     -                                                             */
+/*  Returns:    Random value, 0 if ThreadRandBytes_l reports an error         */
+/*                                                                            */
+/******************************************************************************/
+UCHAR __FLINT_API
+bThreadRand_l (void)
+{
+  UCHAR b = 0;
+
+  ThreadRandBytes_l (&b, 1);
+  return b;
+}
+
+
+USHORT __FLINT_API
+sThreadRand_l (void)
+{
+  UCHAR b[2];
+
+  if (ThreadRandBytes_l (b, 2))
+    {
+      return 0;
+    }
+  return (USHORT)(((USHORT)b[0] << 8) | (USHORT)b[1]);
+}
+
+
+ULONG __FLINT_API
+lThreadRand_l (void)
+{
+  UCHAR b[4];
+
+  if (ThreadRandBytes_l (b, 4))
+    {
+      return 0;
+    }
+  return ((ULONG)b[0] << 24) | ((ULONG)b[1] << 16) |
+         ((ULONG)b[2] <<  8) |  (ULONG)b[3];
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Generation of a random number of type CLINT by the PRNG of    */
+/*              the calling thread                                            */
+/*  Syntax:     int ThreadRand_l (CLINT r_l, int l);                          */
+/*  Input:      int l (Number of binary digits of the random number)          */
+/*  Output:     CLINT r_l (Random number)                                     */
+/*  Returns:    0 if everything is O.K.                                       */
+/*              E_THREADRAND_INI if initialization of the master failed       */
+/*              E_THREADRAND_MEM if allocation of memory failed               */
+/*              E_THREADRAND_ENT if not enough entropy was available for the  */
+/*                               master seed or for reseeding after fork      */
+/*                                                                            */
+/******************************************************************************/
+int __FLINT_API
+ThreadRand_l (CLINT r_l, int l)
+{
+  THREADSTATE *t;
+  int error = 0;
+
+  if ((t = GetState (&error)) == NULL)
+    {
+      return error;
+    }
+
+  if (t->Bytes >= Reseed && (error = SeedState (t, 0)) != 0)
+    {
+      return error;
+    }
+
+  l = (int)MIN ((unsigned int)l, CLINTMAXBIT);
+  error = Rand_l (r_l, &t->State, l);
+  t->Bytes += (ULONG)((l + BITPERDGT - 1) >> LDBITPERDGT) << 1;
+
+  return error;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Purging and release of the PRNG of the calling thread. A new  */
+/*              state is created on the next use. States of terminating       */
+/*              threads are purged automatically.                             */
+/*  Syntax:     void PurgeThreadRand_l (void);                                */
+/*  Input:      -                                                             */
+/*  Output:     -                                                             */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+void __FLINT_API
+PurgeThreadRand_l (void)
+{
+  THREADSTATE *t;
+
+  pthread_once (&Once, InitMaster);
+  if (MasterError)
+    {
+      return;
+    }
+
+  if ((t = (THREADSTATE *)pthread_getspecific (Key)) != NULL)
+    {
+      pthread_setspecific (Key, NULL);
+      DestroyState (t);
+    }
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Initialization of the master seed and the thread specific     */
+/*              key, called once. If GetEntropy_l cannot deliver the full     */
+/*              entropy, the master seed is discarded and all functions of    */
+/*              the module fail with E_THREADRAND_ENT                         */
+/*  Syntax:     static void InitMaster (void);                                */
+/*  Input:      -                                                             */
+/*  Output:     -                                                             */
+/*  Returns:    -                                                             */
+/*                                                                            */
+/******************************************************************************/
+static void
+InitMaster (void)
+{
+  int MissingEntropy;
+
+  Started = 1;
+
+  if (pthread_key_create (&Key, DestroyState) != 0 ||
+      pthread_atfork (NULL, NULL, ChildAtFork) != 0)
+    {
+      MasterError = E_THREADRAND_INI;
+      return;
+    }
+
+  MissingEntropy = GetEntropy_l (NULL, MasterSeed, THREADRAND_ENTROPY, NULL, 0);
+  if (MissingEntropy < 0)
+    {
+      MasterError = E_THREADRAND_MEM;
+    }
+  else if (MissingEntropy > 0)
+    {
+      /* A master seed without full entropy must not be used */
+      local_memset (MasterSeed, 0, MASTERLEN);
+      MasterError = E_THREADRAND_ENT;
+    }
+}
+
+
+/* Fork handler in the child process: States of the parent are outdated */
+static void
+ChildAtFork (void)
+{
+  ForkGen++;
+}
+
+
+/* Destructor of a thread's state */
+static void
+DestroyState (void *p)
+{
+  THREADSTATE *t = (THREADSTATE *)p;
+
+  PurgeRand_l (&t->State);
+  local_memset (t, 0, sizeof (*t));
+  free (t);
+}
+
+
+/* Next value of the derivation counter, atomic increment if available */
+static ULONG
+NextCount (void)
+{
+#ifdef __GNUC__
+  return __sync_fetch_and_add (&Counter, 1);
+#else
+  ULONG c;
+
+  pthread_mutex_lock (&CounterLock);
+  c = Counter++;
+  pthread_mutex_unlock (&CounterLock);
+  return c;
+#endif
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   Seeding of a thread's PRNG with the master seed, a unique     */
+/*              counter value and the process id. Entropy is added after fork */
+/*              since the parent process knows the master seed.               */
+/*  Syntax:     static int SeedState (THREADSTATE *t, int AddEntropy);        */
+/*  Input:      THREADSTATE *t (State of a thread)                            */
+/*              int AddEntropy (Number of additional entropy bytes)           */
+/*  Output:     THREADSTATE *t (Seeded state)                                 */
+/*  Returns:    0 if everything is O.K.                                       */
+/*              E_THREADRAND_MEM if allocation of memory failed               */
+/*              E_THREADRAND_ENT if less than AddEntropy bytes of entropy     */
+/*                               were available                               */
+/*                                                                            */
+/******************************************************************************/
+static int
+SeedState (THREADSTATE *t, int AddEntropy)
+{
+  UCHAR Material[MASTERLEN + sizeof (ULONG) + sizeof (pid_t)];
+  ULONG c = NextCount ();
+  pid_t pid = getpid ();
+  int error;
+
+  memcpy (Material, MasterSeed, MASTERLEN);
+  memcpy (Material + MASTERLEN, &c, sizeof (c));
+  memcpy (Material + MASTERLEN + sizeof (c), &pid, sizeof (pid));
+
+  t->ForkGen = ForkGen;
+  PurgeRand_l (&t->State);
+  memset (&t->State, 0, sizeof (t->State));
+  error = InitRand_l (&t->State, (char *)Material, (int)sizeof (Material), AddEntropy, Generator);
+  t->Bytes = 0;
+
+  /* Security: Purge seed material */
+  local_memset (Material, 0, sizeof (Material));
+
+  if (error < 0)
+    {
+      return E_THREADRAND_MEM;
+    }
+
+  return (error > 0) ? E_THREADRAND_ENT : 0;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/*  Function:   State of the calling thread, created on first use, reseeded   */
+/*              with additional entropy in a child process after fork         */
+/*  Syntax:     static THREADSTATE *GetState (int *error);                    */
+/*  Input:      -                                                             */
+/*  Output:     int *error (Error code if NULL is returned)                   */
+/*  Returns:    State of the calling thread or NULL                           */
+/*                                                                            */
+/******************************************************************************/
+static THREADSTATE *
+GetState (int *error)
+{
+  THREADSTATE *t;
+
+  pthread_once (&Once, InitMaster);
+  if ((*error = MasterError) != 0)
+    {
+      return NULL;
+    }
+
+  if ((t = (THREADSTATE *)pthread_getspecific (Key)) == NULL)
+    {
+      if ((t = (THREADSTATE *)malloc (sizeof (THREADSTATE))) == NULL)
+        {
+          *error = E_THREADRAND_MEM;
+          return NULL;
+        }
+
+      memset (t, 0, sizeof (THREADSTATE));
+      if ((*error = SeedState (t, 0)) != 0)
+        {
+          DestroyState (t);
+          return NULL;
+        }
+
+      if (pthread_setspecific (Key, t) != 0)
+        {
+          DestroyState (t);
+          *error = E_THREADRAND_MEM;
+          return NULL;
+        }
+    }
+  else if (t->ForkGen != ForkGen && (*error = SeedState (t, THREADRAND_ENTROPY)) != 0)
+    {
+      return NULL;
+    }
+
+  return t;
+}
+
+
+/******************************************************************************/
+/*                                                                            */
+/* Local memset-Function, does the same as memset()                           */
+/* Needed to make compiler purge variables in spite of optimization.          */
+/*                                                                            */
+/******************************************************************************/
+static void *
+local_memset (void *ptr, int val, size_t len)
+{
+  return memset (ptr, val, len);
+}
@@ -0,0 +1,113 @@
+/******************************************************************************/
+/*                                                                            */
+/* Functions for arithmetic and number theory with large integers in C        */
+/* Software supplement to the book "Cryptography in C and C++"                */
+/* by Michael Welschenbach                                                    */
+/*                                                                            */
+/* Module threadrand.h     Revision: 19.10.2026                               */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 1998-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+
+#ifndef __THREADRANDH__
+#define __THREADRANDH__
+
+#include "random.h"
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/* Macros */
+
+/* Default number of bytes delivered by a thread's PRNG before reseeding */
+
+#define THREADRAND_RESEED    (1UL << 20)
+
+#define E_THREADRAND_ARG    -1  /* Invalid generator or reseed interval */
+#define E_THREADRAND_INI    -2  /* Already in use, or initialization failed */
+#define E_THREADRAND_MEM    -3  /* Allocation of memory failed */
+#define E_THREADRAND_ENT    -4  /* Not enough entropy for seeding */
+
+/* Macros maintaining FLINT/C namespace */
+
+#define InitThreadRand       InitThreadRand_l
+#define ThreadRandState      ThreadRandState_l
+#define ThreadRandBytes      ThreadRandBytes_l
+#define bThreadRand          bThreadRand_l
+#define sThreadRand          sThreadRand_l
+#define lThreadRand          lThreadRand_l
+#define ThreadRand           ThreadRand_l
+#define PurgeThreadRand      PurgeThreadRand_l
+
+
+/******************************************************************************/
+/* Per-thread PRNG API: Public Functions */
+
+#ifndef __FLINT_API
+#ifdef FLINT_USEDLL
+#define __FLINT_API                   __cdecl
+#else
+#define __FLINT_API                   /**/
+#endif /* FLINT_USEDLL */
+#endif /* !defined __FLINT_API */
+
+extern int __FLINT_API
+InitThreadRand_l (int Generator, ULONG Reseed);
+extern STATEPRNG * __FLINT_API
+ThreadRandState_l (void);
+extern int __FLINT_API
+ThreadRandBytes_l (UCHAR *Buf, ULONG Len);
+extern UCHAR __FLINT_API
+bThreadRand_l (void);
+extern USHORT __FLINT_API
+sThreadRand_l (void);
+extern ULONG __FLINT_API
+lThreadRand_l (void);
+extern int __FLINT_API
+ThreadRand_l (CLINT r_l, int l);
+extern void __FLINT_API
+PurgeThreadRand_l (void);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* __THREADRANDH__ */
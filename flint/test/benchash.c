@@ -0,0 +1,205 @@
+/******************************************************************************/
+/*                                                                            */
+/*  Software supplement to the book "Cryptography in C and C++"               */
+/*  by Michael Welschenbach                                                   */
+/*                                                                            */
+/*  Module benchash.c       Revision: 19.10.2026                              */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 2001-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+
+
+/* Benchmark of the hash functions: cycles per byte and throughput of the    */
+/* one-step functions for short, medium and long messages. Cycles are read  */
+/* from the time stamp counter on x86 processors; on other platforms only   */
+/* the throughput is reported. SHA-1 and SHA-256 are measured with the      */
+/* portable block function and with the fastest one of the processor.       */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "flint.h"
+#include "sha256.h"
+#include "sha512.h"
+#include "ripemd.h"
+
+#if defined __GNUC__ && (defined __x86_64__ || defined __i386__)
+#include <x86intrin.h>
+#define TICKS() ((double)__rdtsc ())
+#elif defined _MSC_VER && (defined _M_X64 || defined _M_IX86)
+#include <intrin.h>
+#define TICKS() ((double)__rdtsc ())
+#else
+#define TICKS() 0.0
+#endif
+
+#define MAXLEN   65536L  /* Length of the longest message */
+#define MINTIME  0.25    /* Minimum measuring time per entry in seconds */
+
+typedef void (*HASHFUNC)(UCHAR *, UCHAR *, ULONG);
+
+static struct
+{
+  char *Name;
+  HASHFUNC Hash;
+  int Impl;           /* Block function of SHA-1 and SHA-256 */
+} Hashes[] =
+{
+  {"RIPEMD-160",  ripemd160_l,  SHA_IMPL_BEST},
+  {"SHA-1 (C)",   sha1_l,       SHA_IMPL_C},
+  {"SHA-1",       sha1_l,       SHA_IMPL_BEST},
+  {"SHA-256 (C)", sha256_l,     SHA_IMPL_C},
+  {"SHA-256",     sha256_l,     SHA_IMPL_BEST},
+  {"SHA-384",     sha384_l,     SHA_IMPL_BEST},
+  {"SHA-512",     sha512_l,     SHA_IMPL_BEST},
+  {"SHA-512/256", sha512_256_l, SHA_IMPL_BEST}
+};
+
+static ULONG Lengths[] = {64, 1024, MAXLEN};
+
+#define NOOFHASHES  (sizeof (Hashes) / sizeof (Hashes[0]))
+#define NOOFLENGTHS (sizeof (Lengths) / sizeof (Lengths[0]))
+
+static void measure (HASHFUNC Hash, UCHAR *data, ULONG len,
+                     double *CyclesPerByte, double *MBPerSec);
+
+
+int main ()
+{
+  UCHAR *data;
+  double cpb, mbs;
+  unsigned i, j;
+
+  if ((data = (UCHAR *)malloc (MAXLEN)) == NULL)
+    {
+      fprintf (stderr, "Error: out of memory\n");
+      return 1;
+    }
+  for (i = 0; i < MAXLEN; i++)
+    {
+      data[i] = (UCHAR)(i * 7 + 1);
+    }
+
+  printf ("Benchmark of hash functions as part of FLINT/C-Library\n");
+  printf ("cycles/byte (MB/s) for messages of the given length\n\n");
+  printf ("%-12s", "Function");
+  for (j = 0; j < NOOFLENGTHS; j++)
+    {
+      printf ("%10lu bytes     ", (unsigned long)Lengths[j]);
+    }
+  printf ("\n");
+
+  for (i = 0; i < NOOFHASHES; i++)
+    {
+      shaimpl (Hashes[i].Impl);
+      printf ("%-12s", Hashes[i].Name);
+      for (j = 0; j < NOOFLENGTHS; j++)
+        {
+          measure (Hashes[i].Hash, data, Lengths[j], &cpb, &mbs);
+          if (cpb > 0)
+            {
+              printf ("%10.2f (%6.0f)   ", cpb, mbs);
+            }
+          else
+            {
+              printf ("%10s (%6.0f)   ", "-", mbs);
+            }
+        }
+      printf ("\n");
+      fflush (stdout);
+    }
+
+  free (data);
+  return 0;
+}
+
+
+/* Best of three runs, each hashing the message repeatedly for MINTIME sec. */
+static void measure (HASHFUNC Hash, UCHAR *data, ULONG len,
+                     double *CyclesPerByte, double *MBPerSec)
+{
+  UCHAR HashRes[SHALEN512 >> 3];
+  unsigned long n, reps;
+  double ticks, secs, bytes;
+  clock_t start;
+  int run;
+
+  *CyclesPerByte = 0;
+  *MBPerSec = 0;
+
+  /* Calibration: number of repetitions filling MINTIME */
+  reps = 1;
+  do
+    {
+      reps <<= 1;
+      start = clock ();
+      for (n = 0; n < reps; n++)
+        {
+          Hash (HashRes, data, len);
+        }
+      secs = (double)(clock () - start) / CLOCKS_PER_SEC;
+    }
+  while (secs < MINTIME / 4);
+  reps = (unsigned long)(reps * (MINTIME / secs)) + 1;
+
+  for (run = 0; run < 3; run++)
+    {
+      start = clock ();
+      ticks = TICKS ();
+      for (n = 0; n < reps; n++)
+        {
+          Hash (HashRes, data, len);
+        }
+      ticks = TICKS () - ticks;
+      secs = (double)(clock () - start) / CLOCKS_PER_SEC;
+
+      bytes = (double)reps * len;
+      if (run == 0 || ticks / bytes < *CyclesPerByte)
+        {
+          *CyclesPerByte = ticks / bytes;
+        }
+      if (secs > 0 && bytes / secs / 1e6 > *MBPerSec)
+        {
+          *MBPerSec = bytes / secs / 1e6;
+        }
+    }
+}
@@ -68,6 +68,9 @@
 static int testmc (char *fname);
 static int testnkt_vkt (char *fname);
 static void testcbc (void);
+static void testctr (void);
+static void testcbcpar (void);
+static void testcache (void);
 static int scan_bytes (char *Linep, char *buffer, int noofbytes);
 static void TestCmp (char * test, char * aesres, char * ref, int Length);
 
@@ -221,6 +224,31 @@ UCHAR DCT2[] = {0x25, 0xFE, 0x2D, 0xD1, 0xC8, 0xF8, 0xB9, 0xBA,
                 0x8F, 0xB4, 0xC6, 0x6D, 0x85, 0xE1, 0xCC, 0xC8, 
                 0x97, 0xEB, 0x18, 0x1C, 0x35, 0x51, 0xAC, 0x5B};
  
+/* Test vectors from NIST SP 800-38A, F.5.1/F.5.2 CTR-AES128 */
+UCHAR CTR3[] = {0xF0, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7,
+                0xF8, 0xF9, 0xFA, 0xFB, 0xFC, 0xFD, 0xFE, 0xFF};
+
+UCHAR PT3[] =  {0x6B, 0xC1, 0xBE, 0xE2, 0x2E, 0x40, 0x9F, 0x96, 
+                0xE9, 0x3D, 0x7E, 0x11, 0x73, 0x93, 0x17, 0x2A, 
+                0xAE, 0x2D, 0x8A, 0x57, 0x1E, 0x03, 0xAC, 0x9C, 
+                0x9E, 0xB7, 0x6F, 0xAC, 0x45, 0xAF, 0x8E, 0x51, 
+                0x30, 0xC8, 0x1C, 0x46, 0xA3, 0x5C, 0xE4, 0x11, 
+                0xE5, 0xFB, 0xC1, 0x19, 0x1A, 0x0A, 0x52, 0xEF, 
+                0xF6, 0x9F, 0x24, 0x45, 0xDF, 0x4F, 0x9B, 0x17, 
+                0xAD, 0x2B, 0x41, 0x7B, 0xE6, 0x6C, 0x37, 0x10};
+
+UCHAR KEY3[] = {0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 
+                0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C};
+
+UCHAR CT3[] =  {0x87, 0x4D, 0x61, 0x91, 0xB6, 0x20, 0xE3, 0x26, 
+                0x1B, 0xEF, 0x68, 0x64, 0x99, 0x0D, 0xB6, 0xCE, 
+                0x98, 0x06, 0xF6, 0x6B, 0x79, 0x70, 0xFD, 0xFF, 
+                0x86, 0x17, 0x18, 0x7B, 0xB9, 0xFF, 0xFD, 0xFF, 
+                0x5A, 0xE4, 0xDF, 0x3E, 0xDB, 0xD5, 0xD3, 0x5E, 
+                0x5B, 0x4F, 0x09, 0x02, 0x0D, 0xB0, 0x3E, 0xAB, 
+                0x1E, 0x03, 0x1D, 0xDA, 0x2F, 0xBE, 0x03, 0xD1, 
+                0x79, 0x21, 0x70, 0xA0, 0xF3, 0x00, 0x9C, 0xEE};
+
 int TESTBLOCK = 0;
 
 int main (int argc, char *argv[])
@@ -285,6 +313,9 @@ int main (int argc, char *argv[])
     }
  
   testcbc ();
+  testctr ();
+  testcbcpar ();
+  testcache ();
 }
 
 
@@ -797,6 +828,231 @@ static void testcbc (void)
 }
 
 
+static void testctr (void)
+{
+  AESWORKSPACE ws;
+  AESKEYSCHED ks;
+  UCHAR cbuff[1024], tbuff[1024];
+  int i;
+
+  printf ("Testing CTR-Mode with multiple message blocks:\n");
+
+  AESInit (&ws, AES_CTR, 128, CTR3, &ks, KEY3, 128, AES_ENC);
+  AESCrypt (cbuff, &ws, &ks, PT3, sizeof (PT3));
+
+  TestCmp ("encctr1 (CTR)", cbuff, CT3, sizeof (PT3));
+
+  /* Portions of arbitrary length */
+  AESInit (&ws, AES_CTR, 128, CTR3, &ks, KEY3, 128, AES_ENC);
+  AESCrypt (cbuff, &ws, &ks, PT3, 5);
+  AESCrypt (cbuff+5, &ws, &ks, PT3+5, 27);
+  AESCrypt (cbuff+32, &ws, &ks, PT3+32, 1);
+  AESCrypt (cbuff+33, &ws, &ks, PT3+33, sizeof (PT3) - 33);
+
+  TestCmp ("encctr2 (CTR)", cbuff, CT3, sizeof (PT3));
+
+  /* In-place decryption */
+  memcpy (tbuff, CT3, sizeof (CT3));
+  AESInit (&ws, AES_CTR, 128, CTR3, &ks, KEY3, 128, AES_DEC);
+  AESCrypt (tbuff, &ws, &ks, tbuff, 17);
+  AESCrypt (tbuff+17, &ws, &ks, tbuff+17, sizeof (CT3) - 17);
+
+  TestCmp ("decctr1 (CTR)", tbuff, PT3, sizeof (PT3));
+
+  /* Interleaved and single block processing must yield the same result */
+  for (i = 0; i < sizeof (tbuff); i++)
+    {
+      tbuff[i] = (UCHAR)i;
+    }
+
+  AESInit (&ws, AES_CTR, 128, CTR3, &ks, KEY3, 128, AES_ENC);
+  AESCrypt (cbuff, &ws, &ks, tbuff, 1000);
+  AESInit (&ws, AES_CTR, 128, CTR3, &ks, KEY3, 128, AES_DEC);
+  for (i = 0; i < 1000; i += 16)
+    {
+      AESCrypt (cbuff+i, &ws, &ks, cbuff+i, (1000 - i < 16) ? 1000 - i : 16);
+    }
+
+  TestCmp ("decctr2 (CTR)", cbuff, tbuff, 1000);
+}
+
+
+static void testcbcpar (void)
+{
+  AESWORKSPACE ws, wsm[6], *wsp[6];
+  AESKEYSCHED ks, ksm[6], *ksp[6];
+  UCHAR cbuff[1024], tbuff[1024], mbuff[6][1024], *inp[6], *outp[6];
+  UCHAR key[32];
+  int lengths[6] = {992, 16, 512, 0, 848, 1008};
+  int i, j;
+  char test[32];
+
+  printf ("Testing interleaved CBC decryption and multi-stream CBC encryption:\n");
+
+  /* In-place decryption of several blocks at once */
+  memcpy (tbuff, CT1, sizeof (CT1));
+  AESInit (&ws, AES_CBC, 128, IV1, &ks, KEY1, 128, AES_DEC);
+  AESCrypt (tbuff, &ws, &ks, tbuff, sizeof (CT1));
+
+  TestCmp ("deccbc5 (CBC)", tbuff, PT1, sizeof (PT1));
+
+  /* Interleaved and single block decryption must yield the same result */
+  for (i = 0; i < sizeof (tbuff); i++)
+    {
+      tbuff[i] = (UCHAR)i;
+    }
+
+  for (i = 0; i < sizeof (key); i++)
+    {
+      key[i] = KEY2[i & 15] ^ (UCHAR)i;
+    }
+
+  AESInit (&ws, AES_CBC, 128, IV2, &ks, key, 256, AES_ENC);
+  AESCrypt (cbuff, &ws, &ks, tbuff, 1008);
+  AESInit (&ws, AES_CBC, 128, IV2, &ks, key, 256, AES_DEC);
+  AESCrypt (cbuff, &ws, &ks, cbuff, 80);
+  AESCrypt (cbuff+80, &ws, &ks, cbuff+80, 1008 - 80);
+
+  TestCmp ("deccbc6 (CBC)", cbuff, tbuff, 1008);
+
+  /* Streams with different keys, IVs, key lengths and message lengths */
+  for (i = 0; i < 6; i++)
+    {
+      key[0] = (UCHAR)i;
+      AESInit (&wsm[i], AES_CBC, 128, (i & 1) ? IV1 : IV2, &ksm[i],
+               key, (i % 3 == 0) ? 256 : 128, AES_ENC);
+      wsm[i].State[0] ^= i;
+      memcpy (mbuff[i], tbuff, lengths[i]);
+      wsp[i] = &wsm[i];
+      ksp[i] = &ksm[i];
+      inp[i] = outp[i] = mbuff[i];
+    }
+
+  if (AESCryptCBCMulti (outp, wsp, ksp, inp, lengths, 6) != AES_OK)
+    {
+      printf ("AES enccbc multi-stream: Error!\n");
+    }
+
+  for (i = 0; i < 6; i++)
+    {
+      key[0] = (UCHAR)i;
+      AESInit (&ws, AES_CBC, 128, (i & 1) ? IV1 : IV2, &ks,
+               key, (i % 3 == 0) ? 256 : 128, AES_ENC);
+      ws.State[0] ^= i;
+      for (j = 0; j < lengths[i]; j += 16)
+        {
+          AESCrypt (cbuff+j, &ws, &ks, tbuff+j, 16);
+        }
+
+      /* Streams are continued by AESCrypt */
+      AESCrypt (cbuff+j, &ws, &ks, tbuff+j, 16);
+      AESCrypt (mbuff[i]+j, &wsm[i], &ksm[i], tbuff+j, 16);
+
+      sprintf (test, "enccbc%d (CBC multi-stream)", i + 3);
+      TestCmp (test, mbuff[i], cbuff, lengths[i] + 16);
+    }
+
+  lengths[1] = 15;
+  if (AESCryptCBCMulti (outp, wsp, ksp, inp, lengths, 6) != AES_ERR_BLKLENGTH)
+    {
+      printf ("AES enccbc multi-stream: Error code expected!\n");
+    }
+}
+
+
+static void testcache (void)
+{
+  AESKEYCACHE key, key3;
+  AESWORKSPACE ws, ws2, *wsp[2];
+  UCHAR cbuff[1024], tbuff[1024], *inp[2], *outp[2];
+  UCHAR rkey[32];
+  int lengths[2], i;
+
+  printf ("Testing cached keys shared by several workspaces:\n");
+
+  AESKeyCacheInit (&key, KEY1, 128, 128);
+
+  AESInitCached (&ws, AES_CBC, IV1, &key, AES_ENC);
+  AESCrypt (cbuff, &ws, NULL, PT1, sizeof (PT1));
+
+  TestCmp ("enccbc9 (cached key)", cbuff, CT1, sizeof (PT1));
+
+  AESInitCached (&ws, AES_CBC, IV1, &key, AES_DEC);
+  AESCrypt (tbuff, &ws, NULL, cbuff, sizeof (CT1));
+
+  TestCmp ("deccbc7 (cached key)", tbuff, PT1, sizeof (PT1));
+
+  AESInitCached (&ws, AES_ECB, NULL, &key, AES_DEC);
+  AESCrypt (tbuff, &ws, NULL, PT1, sizeof (PT1));
+
+  TestCmp ("dececb1 (cached key)", tbuff, DCT1, sizeof (PT1));
+
+  /* Two workspaces referencing the same key */
+  AESKeyCacheInit (&key3, KEY3, 128, 128);
+  AESInitCached (&ws, AES_CTR, CTR3, &key3, AES_ENC);
+  AESInitCached (&ws2, AES_CTR, CTR3, &key3, AES_DEC);
+  AESCrypt (cbuff, &ws, NULL, PT3, 20);
+  AESCrypt (tbuff, &ws2, NULL, CT3, 40);
+  AESCrypt (cbuff+20, &ws, NULL, PT3+20, sizeof (PT3) - 20);
+  AESCrypt (tbuff+40, &ws2, NULL, CT3+40, sizeof (CT3) - 40);
+
+  TestCmp ("encctr3 (cached key)", cbuff, CT3, sizeof (PT3));
+  TestCmp ("decctr3 (cached key)", tbuff, PT3, sizeof (PT3));
+
+  /* Multi-stream encryption without key schedules */
+  AESInitCached (&ws, AES_CBC, IV1, &key, AES_ENC);
+  AESInitCached (&ws2, AES_CBC, IV1, &key, AES_ENC);
+  wsp[0] = &ws;
+  wsp[1] = &ws2;
+  inp[0] = inp[1] = PT1;
+  outp[0] = cbuff;
+  outp[1] = tbuff;
+  lengths[0] = lengths[1] = sizeof (PT1);
+  AESCryptCBCMulti (outp, wsp, NULL, inp, lengths, 2);
+
+  TestCmp ("enccbc10 (cached key)", cbuff, CT1, sizeof (PT1));
+  TestCmp ("enccbc11 (cached key)", tbuff, CT1, sizeof (PT1));
+
+  if (AESCrypt (cbuff, &ws, NULL, PT1, 15) != AES_ERR_BLKLENGTH)
+    {
+      printf ("AES cached key: Error code expected!\n");
+    }
+
+  /* Single blocks without key expansion */
+  AESEncryptBlock (tbuff, PT1, KEY1, 128, 128);
+  AESEncryptBlockCached (cbuff, PT1, &key);
+
+  TestCmp ("encblk1 (cached key)", cbuff, tbuff, 16);
+
+  AESDecryptBlockCached (tbuff, cbuff, &key);
+
+  TestCmp ("decblk1 (cached key)", tbuff, PT1, 16);
+
+  for (i = 0; i < sizeof (rkey); i++)
+    {
+      rkey[i] = KEY3[i & 15] ^ (UCHAR)i;
+    }
+
+  AESKeyCacheInit (&key3, rkey, 256, 256);
+  AESEncryptBlock (tbuff, PT3, rkey, 256, 256);
+  AESEncryptBlockCached (cbuff, PT3, &key3);
+
+  TestCmp ("encblk2 (cached key)", cbuff, tbuff, 32);
+
+  AESDecryptBlockCached (tbuff, cbuff, &key3);
+
+  TestCmp ("decblk2 (cached key)", tbuff, PT3, 32);
+
+  if (AESEncryptBlockCached (cbuff, PT1, NULL) != AES_ERR_INIT)
+    {
+      printf ("AES cached key: Error code expected!\n");
+    }
+
+  AESKeyCachePurge (&key);
+  AESKeyCachePurge (&key3);
+}
+
+
 static void
 TestCmp (char * test, char * aesres, char * ref, int Length)
 {
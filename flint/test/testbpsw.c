@@ -0,0 +1,254 @@
+/******************************************************************************/
+/*                                                                            */
+/*  Software supplement to the book "Cryptography in C and C++"               */
+/*  by Michael Welschenbach                                                   */
+/*                                                                            */
+/*  Module testbpsw.c       Revision: 19.10.2026                              */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 2001-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+/*                                                                            */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "flint.h"
+
+#define disperr_l(S,A) fprintf(stderr,"%s%s\n%u bit\n\n",(S),hexstr_l(A),ld_l(A))
+
+static int small_tests (unsigned int, ULONG);
+static int pseudoprime_tests (void);
+static int random_tests (int, unsigned int);
+static int policy_tests (void);
+static int check (CLINT, unsigned int, int, int, int);
+
+/* Strong pseudoprimes to the base 2 and to the bases 2, ..., 23 resp.   */
+/* 2, ..., 37, strong Lucas pseudoprimes acc. to Selfridge, squares of   */
+/* primes                                                                */
+static char *composites[] =
+{
+  "1373653", "1530787", "1987021", "2284453", "3116107", "25326001",
+  "3215031751", "2152302898747", "3474749660383", "341550071728321",
+  "3825123056546413051", "318665857834031151167461",
+  "75077", "97439", "100127", "113573", "115639", "130139", "155819",
+  "4295098369", "1000006000009", "340282366920938463463374607431768211457"
+};
+#define NOOFCOMPOSITES (sizeof (composites) / sizeof (composites[0]))
+
+/* 2^127 - 1, 2^521 - 1 */
+static char *primes[] =
+{
+  "170141183460469231731687303715884105727",
+  "686479766013060971498190079908139321726943530014330540939446345918554318"
+  "339765605212255964066145455497729631139148085803712198799971664381257402"
+  "8291115057151"
+};
+#define NOOFPRIMES (sizeof (primes) / sizeof (primes[0]))
+
+
+int main ()
+{
+  printf ("Testmodule %s, compiled for FLINT/C-Library Version %s\n", __FILE__, verstr_l ());
+  initrand64_lt ();
+
+  policy_tests ();
+
+  primetest_l (PRIMETEST_BPSW, 0);
+  printf ("Tests of the Baillie-PSW test ...\n");
+  small_tests (1, 200000UL);
+  small_tests (302, 200000UL);
+  pseudoprime_tests ();
+  random_tests (PRIMETEST_BPSW, 50);
+
+  primetest_l (PRIMETEST_BPSWMR, 4);
+  printf ("Tests of the Baillie-PSW test with additional MR rounds ...\n");
+  small_tests (1, 100000UL);
+  pseudoprime_tests ();
+  random_tests (PRIMETEST_BPSWMR, 25);
+
+  primetest_l (PRIMETEST_LEGACY, 0);
+
+  printf ("All tests in %s passed.\n", __FILE__);
+
+  return 0;
+}
+
+
+/* Selection of the policy */
+static int
+policy_tests (void)
+{
+  if (PRIMETEST_BPSW != primetest_l (PRIMETEST_BPSW, 0) ||
+      PRIMETEST_BPSWMR != primetest_l (PRIMETEST_BPSWMR, 3) ||
+      PRIMETEST_LEGACY != primetest_l (-1, 0) ||
+      PRIMETEST_LEGACY != primetest_l (3, 0) ||
+      PRIMETEST_LEGACY != primetest_l (PRIMETEST_LEGACY, 0))
+    {
+      fprintf (stderr, "Error in primetest_l\n");
+      exit (-1);
+    }
+
+  return 0;
+}
+
+
+/* All numbers 0 <= n <= N compared with the primes from genprimes() */
+static int
+small_tests (unsigned int no_of_smallprimes, ULONG N)
+{
+  CLINT n_l;
+  ULONG n, i = 1, *p;
+
+  if ((p = genprimes (N)) == NULL)
+    {
+      fprintf (stderr, "Error in genprimes: Memory allocation error\n");
+      exit (-1);
+    }
+
+  for (n = 0; n <= N; n++)
+    {
+      ul2clint_l (n_l, n);
+      while (i < p[0] && p[i] < n)
+        {
+          i++;
+        }
+      check (n_l, no_of_smallprimes,
+             prime_l (n_l, no_of_smallprimes, 0), (p[i] == n), __LINE__);
+    }
+
+  free (p);
+  return 0;
+}
+
+
+/* Pseudoprimes to the MR- and Lucas tests, large primes */
+static int
+pseudoprime_tests (void)
+{
+  CLINT n_l;
+  unsigned int i;
+
+  for (i = 0; i < NOOFCOMPOSITES; i++)
+    {
+      str2clint_l (n_l, composites[i], 10);
+      check (n_l, 1, prime_l (n_l, 1, 0), 0, __LINE__);
+      check (n_l, 302, prime_l (n_l, 302, 0), 0, __LINE__);
+    }
+
+  /* An explicit number of iterations selects the MR test with small */
+  /* prime bases                                                       */
+  str2clint_l (n_l, "3825123056546413051", 10);
+  check (n_l, 1, prime_l (n_l, 1, 9), 1, __LINE__);
+  str2clint_l (n_l, "318665857834031151167461", 10);
+  check (n_l, 1, prime_l (n_l, 1, 12), 1, __LINE__);
+
+  for (i = 0; i < NOOFPRIMES; i++)
+    {
+      str2clint_l (n_l, primes[i], 10);
+      check (n_l, 1, prime_l (n_l, 1, 0), 1, __LINE__);
+      check (n_l, 302, prime_l (n_l, 302, 0), 1, __LINE__);
+    }
+
+  return 0;
+}
+
+
+/* Random numbers, primes and products of two primes compared with the */
+/* MR test                                                             */
+static int
+random_tests (int policy, unsigned int nooftests)
+{
+  CLINT n_l, p_l, q_l;
+  unsigned int i, l;
+
+  for (i = 0; i < nooftests; i++)
+    {
+      l = 64 + ulrand64_l () % 448;
+      rand_l (n_l, (int)l);
+      if (ISEVEN_L (n_l))
+        {
+          inc_l (n_l);
+        }
+
+      primetest_l (PRIMETEST_LEGACY, 0);
+      while (!prime_l (n_l, 302, 0))
+        {
+          uadd_l (n_l, 2, n_l);
+        }
+      cpy_l (p_l, n_l);
+
+      rand_l (n_l, (int)(l >> 1));
+      *LSDPTR_L (n_l) |= 1;
+      while (!prime_l (n_l, 302, 0))
+        {
+          uadd_l (n_l, 2, n_l);
+        }
+      cpy_l (q_l, n_l);
+      primetest_l (policy, 4);
+
+      check (p_l, 302, prime_l (p_l, 302, 0), 1, __LINE__);
+      check (p_l, 1, prime_l (p_l, 1, 0), 1, __LINE__);
+      check (q_l, 1, prime_l (q_l, 1, 0), 1, __LINE__);
+
+      mul_l (p_l, q_l, n_l);
+      check (n_l, 1, prime_l (n_l, 1, 0), 0, __LINE__);
+      mul_l (q_l, q_l, n_l);
+      check (n_l, 1, prime_l (n_l, 1, 0), 0, __LINE__);
+    }
+
+  return 0;
+}
+
+
+static int
+check (CLINT n_l, unsigned int no_of_smallprimes, int result, int expected,
+       int line)
+{
+  if (result != expected)
+    {
+      fprintf (stderr, "Error in prime_l, line %d, %u small primes: %d instead of %d\n",
+               line, no_of_smallprimes, result, expected);
+      disperr_l ("n_l = ", n_l);
+      exit (-1);
+    }
+
+  return 0;
+}
@@ -0,0 +1,296 @@
+/******************************************************************************/
+/*                                                                            */
+/*  Software supplement to the book "Cryptography in C and C++"               */
+/*  by Michael Welschenbach                                                   */
+/*                                                                            */
+/*  Module testgcm.c        Revision: 19.10.2026                              */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 2001-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+/*                                                                            */
+/******************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "flint.h"
+#include "aes.h"
+#include "aesgcm.h"
+
+
+static void gcmtest (int test, UCHAR *Key, int KeyLength, UCHAR *IV, int IVLength,
+                     UCHAR *Aad, int AadLength, UCHAR *PT, int TextLength,
+                     UCHAR *CTRef, UCHAR *TagRef);
+static void phasetest (int test);
+static void check (UCHAR *Ref, UCHAR *Res, int Len, int error, char *what, int test);
+
+
+/* Test vectors from McGrew/Viega, "The Galois/Counter Mode of Operation" */
+
+UCHAR Key1[] = {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00};
+UCHAR IV1[]  = {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00};
+UCHAR PT1[]  = {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00};
+UCHAR CT1[]  = {0x03,0x88,0xda,0xce,0x60,0xb6,0xa3,0x92,0xf3,0x28,0xc2,0xb9,0x71,0xb2,0xfe,0x78};
+UCHAR Tag1[] = {0xab,0x6e,0x47,0xd4,0x2c,0xec,0x13,0xbd,0xf5,0x3a,0x67,0xb2,0x12,0x57,0xbd,0xdf};
+
+UCHAR Key2[] = {0xfe,0xff,0xe9,0x92,0x86,0x65,0x73,0x1c,0x6d,0x6a,0x8f,0x94,0x67,0x30,0x83,0x08};
+UCHAR IV2[]  = {0xca,0xfe,0xba,0xbe,0xfa,0xce,0xdb,0xad,0xde,0xca,0xf8,0x88};
+UCHAR PT2[]  = {0xd9,0x31,0x32,0x25,0xf8,0x84,0x06,0xe5,0xa5,0x59,0x09,0xc5,0xaf,0xf5,0x26,0x9a,
+                0x86,0xa7,0xa9,0x53,0x15,0x34,0xf7,0xda,0x2e,0x4c,0x30,0x3d,0x8a,0x31,0x8a,0x72,
+                0x1c,0x3c,0x0c,0x95,0x95,0x68,0x09,0x53,0x2f,0xcf,0x0e,0x24,0x49,0xa6,0xb5,0x25,
+                0xb1,0x6a,0xed,0xf5,0xaa,0x0d,0xe6,0x57,0xba,0x63,0x7b,0x39,0x1a,0xaf,0xd2,0x55};
+UCHAR CT2[]  = {0x42,0x83,0x1e,0xc2,0x21,0x77,0x74,0x24,0x4b,0x72,0x21,0xb7,0x84,0xd0,0xd4,0x9c,
+                0xe3,0xaa,0x21,0x2f,0x2c,0x02,0xa4,0xe0,0x35,0xc1,0x7e,0x23,0x29,0xac,0xa1,0x2e,
+                0x21,0xd5,0x14,0xb2,0x54,0x66,0x93,0x1c,0x7d,0x8f,0x6a,0x5a,0xac,0x84,0xaa,0x05,
+                0x1b,0xa3,0x0b,0x39,0x6a,0x0a,0xac,0x97,0x3d,0x58,0xe0,0x91,0x47,0x3f,0x59,0x85};
+UCHAR Tag2[] = {0x4d,0x5c,0x2a,0xf3,0x27,0xcd,0x64,0xa6,0x2c,0xf3,0x5a,0xbd,0x2b,0xa6,0xfa,0xb4};
+
+UCHAR Aad3[] = {0xfe,0xed,0xfa,0xce,0xde,0xad,0xbe,0xef,0xfe,0xed,0xfa,0xce,0xde,0xad,0xbe,0xef,
+                0xab,0xad,0xda,0xd2};
+UCHAR Tag3[] = {0x5b,0xc9,0x4f,0xbc,0x32,0x21,0xa5,0xdb,0x94,0xfa,0xe9,0x5a,0xe7,0x12,0x1a,0x47};
+
+UCHAR IV4[]  = {0x93,0x13,0x22,0x5d,0xf8,0x84,0x06,0xe5,0x55,0x90,0x9c,0x5a,0xff,0x52,0x69,0xaa,
+                0x6a,0x7a,0x95,0x38,0x53,0x4f,0x7d,0xa1,0xe4,0xc3,0x03,0xd2,0xa3,0x18,0xa7,0x28,
+                0xc3,0xc0,0xc9,0x51,0x56,0x80,0x95,0x39,0xfc,0xf0,0xe2,0x42,0x9a,0x6b,0x52,0x54,
+                0x16,0xae,0xdb,0xf5,0xa0,0xde,0x6a,0x57,0xa6,0x37,0xb3,0x9b};
+UCHAR CT4[]  = {0x8c,0xe2,0x49,0x98,0x62,0x56,0x15,0xb6,0x03,0xa0,0x33,0xac,0xa1,0x3f,0xb8,0x94,
+                0xbe,0x91,0x12,0xa5,0xc3,0xa2,0x11,0xa8,0xba,0x26,0x2a,0x3c,0xca,0x7e,0x2c,0xa7,
+                0x01,0xe4,0xa9,0xa4,0xfb,0xa4,0x3c,0x90,0xcc,0xdc,0xb2,0x81,0xd4,0x8c,0x7c,0x6f,
+                0xd6,0x28,0x75,0xd2,0xac,0xa4,0x17,0x03,0x4c,0x34,0xae,0xe5};
+UCHAR Tag4[] = {0x61,0x9c,0xc5,0xae,0xff,0xfe,0x0b,0xfa,0x46,0x2a,0xf4,0x3c,0x16,0x99,0xd0,0x50};
+
+UCHAR Key5[] = {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+                0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00};
+UCHAR CT5[]  = {0x98,0xe7,0x24,0x7c,0x07,0xf0,0xfe,0x41,0x1c,0x26,0x7e,0x43,0x84,0xb0,0xf6,0x00};
+UCHAR Tag5[] = {0x2f,0xf5,0x8d,0x80,0x03,0x39,0x27,0xab,0x8e,0xf4,0xd4,0x58,0x75,0x14,0xf0,0xfb};
+
+UCHAR Key6[] = {0xfe,0xff,0xe9,0x92,0x86,0x65,0x73,0x1c,0x6d,0x6a,0x8f,0x94,0x67,0x30,0x83,0x08,
+                0xfe,0xff,0xe9,0x92,0x86,0x65,0x73,0x1c};
+UCHAR CT6[]  = {0x39,0x80,0xca,0x0b,0x3c,0x00,0xe8,0x41,0xeb,0x06,0xfa,0xc4,0x87,0x2a,0x27,0x57,
+                0x85,0x9e,0x1c,0xea,0xa6,0xef,0xd9,0x84,0x62,0x85,0x93,0xb4,0x0c,0xa1,0xe1,0x9c,
+                0x7d,0x77,0x3d,0x00,0xc1,0x44,0xc5,0x25,0xac,0x61,0x9d,0x18,0xc8,0x4a,0x3f,0x47,
+                0x18,0xe2,0x44,0x8b,0x2f,0xe3,0x24,0xd9,0xcc,0xda,0x27,0x10,0xac,0xad,0xe2,0x56};
+UCHAR Tag6[] = {0x99,0x24,0xa7,0xc8,0x58,0x73,0x36,0xbf,0xb1,0x18,0x02,0x4d,0xb8,0x67,0x4a,0x14};
+UCHAR Tag7[] = {0x25,0x19,0x49,0x8e,0x80,0xf1,0x47,0x8f,0x37,0xba,0x55,0xbd,0x6d,0x27,0x61,0x8c};
+
+UCHAR Key8[] = {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+                0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00};
+UCHAR CT8[]  = {0xce,0xa7,0x40,0x3d,0x4d,0x60,0x6b,0x6e,0x07,0x4e,0xc5,0xd3,0xba,0xf3,0x9d,0x18};
+UCHAR Tag8[] = {0xd0,0xd1,0xc8,0xa7,0x99,0x99,0x6b,0xf0,0x26,0x5b,0x98,0xb5,0xd4,0x8a,0xb9,0x19};
+
+UCHAR Key9[] = {0xfe,0xff,0xe9,0x92,0x86,0x65,0x73,0x1c,0x6d,0x6a,0x8f,0x94,0x67,0x30,0x83,0x08,
+                0xfe,0xff,0xe9,0x92,0x86,0x65,0x73,0x1c,0x6d,0x6a,0x8f,0x94,0x67,0x30,0x83,0x08};
+UCHAR CT9[]  = {0x52,0x2d,0xc1,0xf0,0x99,0x56,0x7d,0x07,0xf4,0x7f,0x37,0xa3,0x2a,0x84,0x42,0x7d,
+                0x64,0x3a,0x8c,0xdc,0xbf,0xe5,0xc0,0xc9,0x75,0x98,0xa2,0xbd,0x25,0x55,0xd1,0xaa,
+                0x8c,0xb0,0x8e,0x48,0x59,0x0d,0xbb,0x3d,0xa7,0xb0,0x8b,0x10,0x56,0x82,0x88,0x38,
+                0xc5,0xf6,0x1e,0x63,0x93,0xba,0x7a,0x0a,0xbc,0xc9,0xf6,0x62,0x89,0x80,0x15,0xad};
+UCHAR Tag9[] = {0xb0,0x94,0xda,0xc5,0xd9,0x34,0x71,0xbd,0xec,0x1a,0x50,0x22,0x70,0xe3,0xcc,0x6c};
+UCHAR Tag10[] = {0x76,0xfc,0x6e,0xce,0x0f,0x4e,0x17,0x68,0xcd,0xdf,0x88,0x53,0xbb,0x2d,0x55,0x1b};
+
+
+int main ()
+{
+  printf ("Testmodule %s, compiled for aesgcm.c as part of FLINT/C-Library\n", __FILE__);
+
+  /* Test #1: Empty AAD, one block of zeros */
+  gcmtest (1, Key1, 128, IV1, sizeof (IV1), NULL, 0, PT1, sizeof (PT1), CT1, Tag1);
+
+  /* Test #2: Empty AAD, four blocks */
+  gcmtest (2, Key2, 128, IV2, sizeof (IV2), NULL, 0, PT2, sizeof (PT2), CT2, Tag2);
+
+  /* Test #3: AAD, text of 60 bytes */
+  gcmtest (3, Key2, 128, IV2, sizeof (IV2), Aad3, sizeof (Aad3), PT2, 60, CT2, Tag3);
+
+  /* Test #4: AAD, IV of 60 bytes */
+  gcmtest (4, Key2, 128, IV4, sizeof (IV4), Aad3, sizeof (Aad3), PT2, 60, CT4, Tag4);
+
+  /* Test #5 - #7: 192-bit keys */
+  gcmtest (5, Key5, 192, IV1, sizeof (IV1), NULL, 0, PT1, sizeof (PT1), CT5, Tag5);
+  gcmtest (6, Key6, 192, IV2, sizeof (IV2), NULL, 0, PT2, sizeof (PT2), CT6, Tag6);
+  gcmtest (7, Key6, 192, IV2, sizeof (IV2), Aad3, sizeof (Aad3), PT2, 60, CT6, Tag7);
+
+  /* Test #8 - #10: 256-bit keys */
+  gcmtest (8, Key8, 256, IV1, sizeof (IV1), NULL, 0, PT1, sizeof (PT1), CT8, Tag8);
+  gcmtest (9, Key9, 256, IV2, sizeof (IV2), NULL, 0, PT2, sizeof (PT2), CT9, Tag9);
+  gcmtest (10, Key9, 256, IV2, sizeof (IV2), Aad3, sizeof (Aad3), PT2, 60, CT9, Tag10);
+
+  /* Test #11: Calls out of order are rejected */
+  phasetest (11);
+
+  printf ("All tests in %s passed.\n", __FILE__);
+
+  return 0;
+}
+
+
+static void gcmtest (int test, UCHAR *Key, int KeyLength, UCHAR *IV, int IVLength,
+                     UCHAR *Aad, int AadLength, UCHAR *PT, int TextLength,
+                     UCHAR *CTRef, UCHAR *TagRef)
+{
+  AESGCMCTX ctx;
+  AESKEY RawKey;
+  UCHAR buff[256], Tag[AESGCM_MAXTAG];
+  int i, clmul, error;
+
+  memcpy (RawKey, Key, KeyLength/8);
+
+  /* GHASH with 4-bit table and, if available, with PCLMULQDQ */
+  for (clmul = 0; clmul < 2; clmul++)
+    {
+      /* Encryption in one step */
+      error = AESGCMInit (&ctx, RawKey, KeyLength, IV, IVLength, AES_ENC);
+      if (!clmul)
+        {
+          ctx.UseClmul = 0;
+        }
+      else if (!ctx.UseClmul)
+        {
+          break;
+        }
+
+      error |= AESGCMAad (&ctx, Aad, AadLength);
+      error |= AESGCMUpdate (&ctx, buff, PT, TextLength);
+      error |= AESGCMFinal (&ctx, Tag, AESGCM_MAXTAG);
+      check (CTRef, buff, TextLength, error, "encryption", test);
+      check (TagRef, Tag, AESGCM_MAXTAG, error, "tag", test);
+
+      /* Encryption in portions of arbitrary length */
+      error = AESGCMInit (&ctx, RawKey, KeyLength, IV, IVLength, AES_ENC);
+      ctx.UseClmul &= clmul;
+      for (i = 0; i < AadLength; i += 3)
+        {
+          error |= AESGCMAad (&ctx, Aad + i, (AadLength - i < 3) ? AadLength - i : 3);
+        }
+      for (i = 0; i < TextLength; i += 7)
+        {
+          error |= AESGCMUpdate (&ctx, buff + i, PT + i, (TextLength - i < 7) ? TextLength - i : 7);
+        }
+      error |= AESGCMFinal (&ctx, Tag, AESGCM_MAXTAG);
+      check (CTRef, buff, TextLength, error, "encryption in portions", test);
+      check (TagRef, Tag, AESGCM_MAXTAG, error, "tag in portions", test);
+
+      /* In-place decryption with verification of the tag */
+      memcpy (buff, CTRef, TextLength);
+      error = AESGCMInit (&ctx, RawKey, KeyLength, IV, IVLength, AES_DEC);
+      ctx.UseClmul &= clmul;
+      error |= AESGCMAad (&ctx, Aad, AadLength);
+      error |= AESGCMUpdate (&ctx, buff, buff, 5);
+      error |= AESGCMUpdate (&ctx, buff + 5, buff + 5, TextLength - 5);
+      memcpy (Tag, TagRef, AESGCM_MAXTAG);
+      error |= AESGCMFinal (&ctx, Tag, AESGCM_MAXTAG);
+      check (PT, buff, TextLength, error, "decryption", test);
+
+      /* Modified tag must be rejected */
+      error = AESGCMInit (&ctx, RawKey, KeyLength, IV, IVLength, AES_DEC);
+      ctx.UseClmul &= clmul;
+      error |= AESGCMAad (&ctx, Aad, AadLength);
+      error |= AESGCMUpdate (&ctx, buff, CTRef, TextLength);
+      Tag[15] ^= 1;
+      if (AESGCMFinal (&ctx, Tag, AESGCM_MAXTAG) != AES_ERR_TAG || error)
+        {
+          fprintf (stderr, "Error in AES-GCM in test %d: Invalid tag not detected\n", test);
+          exit (1);
+        }
+
+      AESGCMPurge (&ctx);
+      fprintf (stderr, "Test #%d O.K. (GHASH %s)\n", test, clmul ? "PCLMULQDQ" : "4-bit table");
+    }
+}
+
+
+static void phasetest (int test)
+{
+  AESGCMCTX ctx;
+  AESKEY RawKey;
+  UCHAR buff[64], Tag[AESGCM_MAXTAG];
+  int error;
+
+  memcpy (RawKey, Key2, sizeof (Key2));
+
+  /* AAD after text, the context stays intact */
+  error = AESGCMInit (&ctx, RawKey, 128, IV2, sizeof (IV2), AES_ENC);
+  error |= AESGCMAad (&ctx, Aad3, sizeof (Aad3));
+  error |= AESGCMUpdate (&ctx, buff, PT2, 30);
+  if (AESGCMAad (&ctx, Aad3, sizeof (Aad3)) != AES_ERR_PHASE)
+    {
+      fprintf (stderr, "Error in AES-GCM in test %d: AAD after text accepted\n", test);
+      exit (1);
+    }
+  error |= AESGCMUpdate (&ctx, buff + 30, PT2 + 30, 30);
+  error |= AESGCMFinal (&ctx, Tag, AESGCM_MAXTAG);
+  check (CT2, buff, 60, error, "encryption after rejected AAD", test);
+  check (Tag3, Tag, AESGCM_MAXTAG, error, "tag after rejected AAD", test);
+
+  /* Finished context */
+  if (AESGCMAad (&ctx, Aad3, sizeof (Aad3)) != AES_ERR_PHASE ||
+      AESGCMUpdate (&ctx, buff, PT2, 16) != AES_ERR_PHASE ||
+      AESGCMFinal (&ctx, Tag, AESGCM_MAXTAG) != AES_ERR_PHASE)
+    {
+      fprintf (stderr, "Error in AES-GCM in test %d: Finished context accepted data\n", test);
+      exit (1);
+    }
+  check (Tag3, Tag, AESGCM_MAXTAG, 0, "tag of finished context", test);
+
+  AESGCMPurge (&ctx);
+  fprintf (stderr, "Test #%d O.K.\n", test);
+}
+
+
+static void check (UCHAR *Ref, UCHAR *Res, int Len, int error, char *what, int test)
+{
+  int i;
+  if (error)
+    {
+      fprintf (stderr, "Error in AES-GCM %s in test %d: Error code %d\n", what, test, error);
+      exit (1);
+    }
+
+  if (memcmp (Ref, Res, Len))
+    {
+      fprintf (stderr, "Error in AES-GCM %s in test %d: Result invalid\n", what, test);
+      for (i = 0; i < Len; i++)
+        {
+          fprintf (stderr, "%2x ", Res[i] & 0x00ff);
+        }
+      fprintf (stderr, "\n");
+      exit (1);
+    }
+}
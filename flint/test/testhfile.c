@@ -0,0 +1,266 @@
+/******************************************************************************/
+/*                                                                            */
+/*  Software supplement to the book "Cryptography in C and C++"               */
+/*  by Michael Welschenbach                                                   */
+/*                                                                            */
+/*  Module testhfile.c      Revision: 19.10.2026                              */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 2001-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+
+
+
+/* POSIX interfaces for pipes, temporary files and threads */
+#define _XOPEN_SOURCE 600
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "flint.h"
+#include "sha256.h"
+#include "ripemd.h"
+#include "hashfile.h"
+
+/* Longer than three windows of 64 KiB if compiled as in the Makefile, */
+/* and than two read buffers */
+#define MAXLEN   ((3L << 20) + 1000)
+
+/* Message written into a pipe by a writer thread */
+typedef struct
+{
+  int fd;
+  UCHAR *data;
+  ULONG len;
+} WRITER;
+
+static void refdig (HASHFILEDIG *Ref, int Algs, UCHAR *data, ULONG len);
+static FILE *tempfile (UCHAR *data, ULONG len);
+static void *writer (void *arg);
+static int check (HASHFILEDIG *Ref, HASHFILEDIG *Dig, int error, int test);
+
+
+int main ()
+{
+  HASHFILEDIG Dig, Ref;
+  UCHAR *data;
+  WRITER wr;
+  pthread_t tid;
+  FILE *f;
+  int pfd[2], fd;
+  char Name[] = "/tmp/hfXXXXXX";
+  static ULONG Lengths[] = {0, 1, 55, 56, 63, 64, 65, 127, 128, 1000,
+                            16383, 16384, 16385, 65535, 65536, 65537,
+                            3 * 65536 + 17, (1L << 20) + 64, MAXLEN};
+  ULONG i;
+  int error = 0, l, Algs;
+
+  printf ("Testmodule %s, compiled for hashfile.c as part of FLINT/C-Library\n", __FILE__);
+
+  if ((data = (UCHAR *)malloc (MAXLEN)) == NULL)
+    {
+      fprintf (stderr, "Error: out of memory\n");
+      exit (1);
+    }
+  for (i = 0; i < MAXLEN; i++)
+    {
+      data[i] = (UCHAR)((i * 2654435761UL) >> 13);
+    }
+
+  /* Test #1: All digests of regular files agree with sha1, sha256 and */
+  /* ripemd160, also across the boundaries of chunks and windows        */
+  for (l = 0; l < (int)(sizeof (Lengths) / sizeof (ULONG)) && !error; l++)
+    {
+      f = tempfile (data, Lengths[l]);
+      refdig (&Ref, HASHFILE_ALL, data, Lengths[l]);
+      error = hashfilefd (&Dig, HASHFILE_ALL, fileno (f));
+      fclose (f);
+      if (!error && memcmp (&Ref, &Dig, sizeof (Dig)))
+        {
+          break;
+        }
+    }
+  check (&Ref, &Dig, error, 1);
+
+  /* Test #2: Each combination of hash functions, the digests of the */
+  /* functions not selected are zero. The position of fd is ignored   */
+  f = tempfile (data, 100000);
+  fseek (f, 5000, SEEK_SET);
+  for (Algs = 1; Algs <= HASHFILE_ALL && !error; Algs++)
+    {
+      refdig (&Ref, Algs, data, 100000);
+      error = hashfilefd (&Dig, Algs, fileno (f));
+      if (!error && memcmp (&Ref, &Dig, sizeof (Dig)))
+        {
+          break;
+        }
+    }
+  fclose (f);
+  check (&Ref, &Dig, error, 2);
+
+  /* Test #3: Pipe, read in blocks */
+  if (pipe (pfd) != 0)
+    {
+      fprintf (stderr, "Error: pipe could not be created\n");
+      exit (1);
+    }
+  wr.fd = pfd[1];
+  wr.data = data;
+  wr.len = MAXLEN;
+  pthread_create (&tid, NULL, writer, &wr);
+  error = hashfilefd (&Dig, HASHFILE_ALL, pfd[0]);
+  pthread_join (tid, NULL);
+  close (pfd[0]);
+  refdig (&Ref, HASHFILE_ALL, data, MAXLEN);
+  check (&Ref, &Dig, error, 3);
+
+  /* Test #4: File given by name */
+  if ((fd = mkstemp (Name)) < 0 || write (fd, data, 70000) != 70000)
+    {
+      fprintf (stderr, "Error: temporary file could not be written\n");
+      exit (1);
+    }
+  close (fd);
+  error = hashfile (&Dig, HASHFILE_SHA256 | HASHFILE_RMD160, Name);
+  unlink (Name);
+  refdig (&Ref, HASHFILE_SHA256 | HASHFILE_RMD160, data, 70000);
+  check (&Ref, &Dig, error, 4);
+
+  /* Test #5: Invalid parameters */
+  if (hashfile (&Dig, HASHFILE_SHA1, Name) != E_HASHFILE_IO ||
+      hashfile (&Dig, 0, Name) != E_HASHFILE_ARG ||
+      hashfilefd (&Dig, HASHFILE_ALL + 1, 0) != E_HASHFILE_ARG ||
+      hashfilefd (&Dig, HASHFILE_SHA1, -1) != E_HASHFILE_ARG)
+    {
+      error = 1;
+    }
+  check (&Dig, &Dig, error, 5);
+
+  free (data);
+
+  printf ("All tests in %s passed.\n", __FILE__);
+
+  return 0;
+}
+
+
+/* Digests computed by the one-step functions */
+static void refdig (HASHFILEDIG *Ref, int Algs, UCHAR *data, ULONG len)
+{
+  memset (Ref, 0, sizeof (*Ref));
+  if (Algs & HASHFILE_SHA1)
+    {
+      sha1 (Ref->Sha1, data, len);
+    }
+  if (Algs & HASHFILE_SHA256)
+    {
+      sha256 (Ref->Sha256, data, len);
+    }
+  if (Algs & HASHFILE_RMD160)
+    {
+      ripemd160 (Ref->Rmd160, data, len);
+    }
+}
+
+
+static FILE *tempfile (UCHAR *data, ULONG len)
+{
+  FILE *f;
+
+  if ((f = tmpfile ()) == NULL ||
+      fwrite (data, 1, len, f) != len || fflush (f) != 0)
+    {
+      fprintf (stderr, "Error: temporary file could not be written\n");
+      exit (1);
+    }
+
+  return f;
+}
+
+
+static void *writer (void *arg)
+{
+  WRITER *wr = (WRITER *)arg;
+  ULONG done = 0;
+  ssize_t n;
+
+  /* Irregular chunks, partial blocks arrive at the reader */
+  while (done < wr->len)
+    {
+      n = write (wr->fd, wr->data + done,
+                 (wr->len - done < 1000) ? wr->len - done : 1000);
+      if (n <= 0)
+        {
+          break;
+        }
+      done += (ULONG)n;
+    }
+  close (wr->fd);
+
+  return NULL;
+}
+
+
+static int check (HASHFILEDIG *Ref, HASHFILEDIG *Dig, int error, int test)
+{
+  int i;
+  if (error)
+    {
+      fprintf (stderr, "Error in file hash in test %d: Error code %d\n", test, error);
+      exit (1);
+    }
+
+  if (memcmp (Ref, Dig, sizeof (*Dig)))
+    {
+      fprintf (stderr, "Error in file hash in test %d: Digests invalid\n", test);
+      for (i = 0; i < (int)sizeof (*Dig); i++)
+        {
+          fprintf (stderr, "%2x ", ((UCHAR *)Dig)[i] & 0x00ff);
+        }
+      fprintf (stderr, "\n");
+      exit (1);
+    }
+
+  fprintf (stderr, "Test #%d O.K.\n", test);
+
+  return 0;
+}
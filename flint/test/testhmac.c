@@ -0,0 +1,309 @@
+/******************************************************************************/
+/*                                                                            */
+/*  Software supplement to the book "Cryptography in C and C++"               */
+/*  by Michael Welschenbach                                                   */
+/*                                                                            */
+/*  Module testhmac.c       Revision: 19.10.2026                              */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 2001-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "flint.h"
+#include "hmac.h"
+
+
+static int check (UCHAR *Ref, UCHAR *Res, int Len, int error, char *alg, int test);
+
+
+/* Keys and messages of RFC 2202 and RFC 4231, reference values of */
+/* HMAC-SHA-1, HMAC-SHA-256 and HMAC-RIPEMD-160                    */
+
+static UCHAR key1[] = {0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b};
+static UCHAR data1[] = {0x48,0x69,0x20,0x54,0x68,0x65,0x72,0x65};
+static UCHAR key2[] = {0x4a,0x65,0x66,0x65};
+static UCHAR data2[] = {0x77,0x68,0x61,0x74,0x20,0x64,0x6f,0x20,0x79,0x61,0x20,0x77,0x61,0x6e,0x74,0x20,0x66,0x6f,0x72,0x20,0x6e,0x6f,0x74,0x68,0x69,0x6e,0x67,0x3f};
+static UCHAR key3[] = {0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa};
+static UCHAR data3[] = {0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd,0xdd};
+static UCHAR key4[] = {0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x10,0x11,0x12,0x13,0x14,0x15,0x16,0x17,0x18,0x19};
+static UCHAR data4[] = {0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd,0xcd};
+static UCHAR key5[] = {0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa};
+static UCHAR data5[] = {0x54,0x65,0x73,0x74,0x20,0x55,0x73,0x69,0x6e,0x67,0x20,0x4c,0x61,0x72,0x67,0x65,0x72,0x20,0x54,0x68,0x61,0x6e,0x20,0x42,0x6c,0x6f,0x63,0x6b,0x2d,0x53,0x69,0x7a,0x65,0x20,0x4b,0x65,0x79,0x20,0x2d,0x20,0x48,0x61,0x73,0x68,0x20,0x4b,0x65,0x79,0x20,0x46,0x69,0x72,0x73,0x74};
+static UCHAR key6[] = {0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa,0xaa};
+static UCHAR data6[] = {0x54,0x68,0x69,0x73,0x20,0x69,0x73,0x20,0x61,0x20,0x74,0x65,0x73,0x74,0x20,0x75,0x73,0x69,0x6e,0x67,0x20,0x61,0x20,0x6c,0x61,0x72,0x67,0x65,0x72,0x20,0x74,0x68,0x61,0x6e,0x20,0x62,0x6c,0x6f,0x63,0x6b,0x2d,0x73,0x69,0x7a,0x65,0x20,0x6b,0x65,0x79,0x20,0x61,0x6e,0x64,0x20,0x61,0x20,0x6c,0x61,0x72,0x67,0x65,0x72,0x20,0x74,0x68,0x61,0x6e,0x20,0x62,0x6c,0x6f,0x63,0x6b,0x2d,0x73,0x69,0x7a,0x65,0x20,0x64,0x61,0x74,0x61,0x2e,0x20,0x54,0x68,0x65,0x20,0x6b,0x65,0x79,0x20,0x6e,0x65,0x65,0x64,0x73,0x20,0x74,0x6f,0x20,0x62,0x65,0x20,0x68,0x61,0x73,0x68,0x65,0x64,0x20,0x62,0x65,0x66,0x6f,0x72,0x65,0x20,0x62,0x65,0x69,0x6e,0x67,0x20,0x75,0x73,0x65,0x64,0x20,0x62,0x79,0x20,0x74,0x68,0x65,0x20,0x48,0x4d,0x41,0x43,0x20,0x61,0x6c,0x67,0x6f,0x72,0x69,0x74,0x68,0x6d,0x2e};
+
+static UCHAR mac1_sha1[] = {0xb6,0x17,0x31,0x86,0x55,0x05,0x72,0x64,0xe2,0x8b,0xc0,0xb6,0xfb,0x37,0x8c,0x8e,0xf1,0x46,0xbe,0x00};
+static UCHAR mac2_sha1[] = {0xef,0xfc,0xdf,0x6a,0xe5,0xeb,0x2f,0xa2,0xd2,0x74,0x16,0xd5,0xf1,0x84,0xdf,0x9c,0x25,0x9a,0x7c,0x79};
+static UCHAR mac3_sha1[] = {0x12,0x5d,0x73,0x42,0xb9,0xac,0x11,0xcd,0x91,0xa3,0x9a,0xf4,0x8a,0xa1,0x7b,0x4f,0x63,0xf1,0x75,0xd3};
+static UCHAR mac4_sha1[] = {0x4c,0x90,0x07,0xf4,0x02,0x62,0x50,0xc6,0xbc,0x84,0x14,0xf9,0xbf,0x50,0xc8,0x6c,0x2d,0x72,0x35,0xda};
+static UCHAR mac5_sha1[] = {0xaa,0x4a,0xe5,0xe1,0x52,0x72,0xd0,0x0e,0x95,0x70,0x56,0x37,0xce,0x8a,0x3b,0x55,0xed,0x40,0x21,0x12};
+static UCHAR mac6_sha1[] = {0x21,0x7e,0x44,0xbb,0x08,0xb6,0xe0,0x6a,0x2d,0x6c,0x30,0xf3,0xcb,0x9f,0x53,0x7f,0x97,0xc6,0x33,0x56};
+
+static UCHAR mac1_sha256[] = {0xb0,0x34,0x4c,0x61,0xd8,0xdb,0x38,0x53,0x5c,0xa8,0xaf,0xce,0xaf,0x0b,0xf1,0x2b,0x88,0x1d,0xc2,0x00,0xc9,0x83,0x3d,0xa7,0x26,0xe9,0x37,0x6c,0x2e,0x32,0xcf,0xf7};
+static UCHAR mac2_sha256[] = {0x5b,0xdc,0xc1,0x46,0xbf,0x60,0x75,0x4e,0x6a,0x04,0x24,0x26,0x08,0x95,0x75,0xc7,0x5a,0x00,0x3f,0x08,0x9d,0x27,0x39,0x83,0x9d,0xec,0x58,0xb9,0x64,0xec,0x38,0x43};
+static UCHAR mac3_sha256[] = {0x77,0x3e,0xa9,0x1e,0x36,0x80,0x0e,0x46,0x85,0x4d,0xb8,0xeb,0xd0,0x91,0x81,0xa7,0x29,0x59,0x09,0x8b,0x3e,0xf8,0xc1,0x22,0xd9,0x63,0x55,0x14,0xce,0xd5,0x65,0xfe};
+static UCHAR mac4_sha256[] = {0x82,0x55,0x8a,0x38,0x9a,0x44,0x3c,0x0e,0xa4,0xcc,0x81,0x98,0x99,0xf2,0x08,0x3a,0x85,0xf0,0xfa,0xa3,0xe5,0x78,0xf8,0x07,0x7a,0x2e,0x3f,0xf4,0x67,0x29,0x66,0x5b};
+static UCHAR mac5_sha256[] = {0x69,0x53,0x02,0x5e,0xd9,0x6f,0x0c,0x09,0xf8,0x0a,0x96,0xf7,0x8e,0x65,0x38,0xdb,0xe2,0xe7,0xb8,0x20,0xe3,0xdd,0x97,0x0e,0x7d,0xdd,0x39,0x09,0x1b,0x32,0x35,0x2f};
+static UCHAR mac6_sha256[] = {0x9b,0x09,0xff,0xa7,0x1b,0x94,0x2f,0xcb,0x27,0x63,0x5f,0xbc,0xd5,0xb0,0xe9,0x44,0xbf,0xdc,0x63,0x64,0x4f,0x07,0x13,0x93,0x8a,0x7f,0x51,0x53,0x5c,0x3a,0x35,0xe2};
+
+static UCHAR mac1_rmd160[] = {0x24,0xcb,0x4b,0xd6,0x7d,0x20,0xfc,0x1a,0x5d,0x2e,0xd7,0x73,0x2d,0xcc,0x39,0x37,0x7f,0x0a,0x56,0x68};
+static UCHAR mac2_rmd160[] = {0xdd,0xa6,0xc0,0x21,0x3a,0x48,0x5a,0x9e,0x24,0xf4,0x74,0x20,0x64,0xa7,0xf0,0x33,0xb4,0x3c,0x40,0x69};
+static UCHAR mac3_rmd160[] = {0xb0,0xb1,0x05,0x36,0x0d,0xe7,0x59,0x96,0x0a,0xb4,0xf3,0x52,0x98,0xe1,0x16,0xe2,0x95,0xd8,0xe7,0xc1};
+static UCHAR mac4_rmd160[] = {0xd5,0xca,0x86,0x2f,0x4d,0x21,0xd5,0xe6,0x10,0xe1,0x8b,0x4c,0xf1,0xbe,0xb9,0x7a,0x43,0x65,0xec,0xf4};
+static UCHAR mac5_rmd160[] = {0x64,0x66,0xca,0x07,0xac,0x5e,0xac,0x29,0xe1,0xbd,0x52,0x3e,0x5a,0xda,0x76,0x05,0xb7,0x91,0xfd,0x8b};
+static UCHAR mac6_rmd160[] = {0x1e,0xd1,0x06,0xe5,0xa8,0xef,0x0a,0x90,0xef,0xa3,0xbe,0xb0,0x6b,0x39,0x1e,0x86,0x93,0xcd,0x31,0x37};
+
+/* HKDF test cases 1, 2, 3, 4 and 7 of RFC 5869, and one for RIPEMD-160 */
+
+static UCHAR ikm1[] = {0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b};
+static UCHAR salt1[] = {0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c};
+static UCHAR info1[] = {0xf0,0xf1,0xf2,0xf3,0xf4,0xf5,0xf6,0xf7,0xf8,0xf9};
+static UCHAR prk1[] = {0x07,0x77,0x09,0x36,0x2c,0x2e,0x32,0xdf,0x0d,0xdc,0x3f,0x0d,0xc4,0x7b,0xba,0x63,0x90,0xb6,0xc7,0x3b,0xb5,0x0f,0x9c,0x31,0x22,0xec,0x84,0x4a,0xd7,0xc2,0xb3,0xe5};
+static UCHAR okm1[] = {0x3c,0xb2,0x5f,0x25,0xfa,0xac,0xd5,0x7a,0x90,0x43,0x4f,0x64,0xd0,0x36,0x2f,0x2a,0x2d,0x2d,0x0a,0x90,0xcf,0x1a,0x5a,0x4c,0x5d,0xb0,0x2d,0x56,0xec,0xc4,0xc5,0xbf,0x34,0x00,0x72,0x08,0xd5,0xb8,0x87,0x18,0x58,0x65};
+
+static UCHAR ikm2[] = {0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x10,0x11,0x12,0x13,0x14,0x15,0x16,0x17,0x18,0x19,0x1a,0x1b,0x1c,0x1d,0x1e,0x1f,0x20,0x21,0x22,0x23,0x24,0x25,0x26,0x27,0x28,0x29,0x2a,0x2b,0x2c,0x2d,0x2e,0x2f,0x30,0x31,0x32,0x33,0x34,0x35,0x36,0x37,0x38,0x39,0x3a,0x3b,0x3c,0x3d,0x3e,0x3f,0x40,0x41,0x42,0x43,0x44,0x45,0x46,0x47,0x48,0x49,0x4a,0x4b,0x4c,0x4d,0x4e,0x4f};
+static UCHAR salt2[] = {0x60,0x61,0x62,0x63,0x64,0x65,0x66,0x67,0x68,0x69,0x6a,0x6b,0x6c,0x6d,0x6e,0x6f,0x70,0x71,0x72,0x73,0x74,0x75,0x76,0x77,0x78,0x79,0x7a,0x7b,0x7c,0x7d,0x7e,0x7f,0x80,0x81,0x82,0x83,0x84,0x85,0x86,0x87,0x88,0x89,0x8a,0x8b,0x8c,0x8d,0x8e,0x8f,0x90,0x91,0x92,0x93,0x94,0x95,0x96,0x97,0x98,0x99,0x9a,0x9b,0x9c,0x9d,0x9e,0x9f,0xa0,0xa1,0xa2,0xa3,0xa4,0xa5,0xa6,0xa7,0xa8,0xa9,0xaa,0xab,0xac,0xad,0xae,0xaf};
+static UCHAR info2[] = {0xb0,0xb1,0xb2,0xb3,0xb4,0xb5,0xb6,0xb7,0xb8,0xb9,0xba,0xbb,0xbc,0xbd,0xbe,0xbf,0xc0,0xc1,0xc2,0xc3,0xc4,0xc5,0xc6,0xc7,0xc8,0xc9,0xca,0xcb,0xcc,0xcd,0xce,0xcf,0xd0,0xd1,0xd2,0xd3,0xd4,0xd5,0xd6,0xd7,0xd8,0xd9,0xda,0xdb,0xdc,0xdd,0xde,0xdf,0xe0,0xe1,0xe2,0xe3,0xe4,0xe5,0xe6,0xe7,0xe8,0xe9,0xea,0xeb,0xec,0xed,0xee,0xef,0xf0,0xf1,0xf2,0xf3,0xf4,0xf5,0xf6,0xf7,0xf8,0xf9,0xfa,0xfb,0xfc,0xfd,0xfe,0xff};
+static UCHAR prk2[] = {0x06,0xa6,0xb8,0x8c,0x58,0x53,0x36,0x1a,0x06,0x10,0x4c,0x9c,0xeb,0x35,0xb4,0x5c,0xef,0x76,0x00,0x14,0x90,0x46,0x71,0x01,0x4a,0x19,0x3f,0x40,0xc1,0x5f,0xc2,0x44};
+static UCHAR okm2[] = {0xb1,0x1e,0x39,0x8d,0xc8,0x03,0x27,0xa1,0xc8,0xe7,0xf7,0x8c,0x59,0x6a,0x49,0x34,0x4f,0x01,0x2e,0xda,0x2d,0x4e,0xfa,0xd8,0xa0,0x50,0xcc,0x4c,0x19,0xaf,0xa9,0x7c,0x59,0x04,0x5a,0x99,0xca,0xc7,0x82,0x72,0x71,0xcb,0x41,0xc6,0x5e,0x59,0x0e,0x09,0xda,0x32,0x75,0x60,0x0c,0x2f,0x09,0xb8,0x36,0x77,0x93,0xa9,0xac,0xa3,0xdb,0x71,0xcc,0x30,0xc5,0x81,0x79,0xec,0x3e,0x87,0xc1,0x4c,0x01,0xd5,0xc1,0xf3,0x43,0x4f,0x1d,0x87};
+
+static UCHAR ikm3[] = {0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b};
+static UCHAR prk3[] = {0x19,0xef,0x24,0xa3,0x2c,0x71,0x7b,0x16,0x7f,0x33,0xa9,0x1d,0x6f,0x64,0x8b,0xdf,0x96,0x59,0x67,0x76,0xaf,0xdb,0x63,0x77,0xac,0x43,0x4c,0x1c,0x29,0x3c,0xcb,0x04};
+static UCHAR okm3[] = {0x8d,0xa4,0xe7,0x75,0xa5,0x63,0xc1,0x8f,0x71,0x5f,0x80,0x2a,0x06,0x3c,0x5a,0x31,0xb8,0xa1,0x1f,0x5c,0x5e,0xe1,0x87,0x9e,0xc3,0x45,0x4e,0x5f,0x3c,0x73,0x8d,0x2d,0x9d,0x20,0x13,0x95,0xfa,0xa4,0xb6,0x1a,0x96,0xc8};
+
+static UCHAR ikm4[] = {0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b,0x0b};
+static UCHAR salt4[] = {0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c};
+static UCHAR info4[] = {0xf0,0xf1,0xf2,0xf3,0xf4,0xf5,0xf6,0xf7,0xf8,0xf9};
+static UCHAR prk4[] = {0x9b,0x6c,0x18,0xc4,0x32,0xa7,0xbf,0x8f,0x0e,0x71,0xc8,0xeb,0x88,0xf4,0xb3,0x0b,0xaa,0x2b,0xa2,0x43};
+static UCHAR okm4[] = {0x08,0x5a,0x01,0xea,0x1b,0x10,0xf3,0x69,0x33,0x06,0x8b,0x56,0xef,0xa5,0xad,0x81,0xa4,0xf1,0x4b,0x82,0x2f,0x5b,0x09,0x15,0x68,0xa9,0xcd,0xd4,0xf1,0x55,0xfd,0xa2,0xc2,0x2e,0x42,0x24,0x78,0xd3,0x05,0xf3,0xf8,0x96};
+
+static UCHAR ikm5[] = {0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c,0x0c};
+static UCHAR prk5[] = {0x2a,0xdc,0xca,0xda,0x18,0x77,0x9e,0x7c,0x20,0x77,0xad,0x2e,0xb1,0x9d,0x3f,0x3e,0x73,0x13,0x85,0xdd};
+static UCHAR okm5[] = {0x2c,0x91,0x11,0x72,0x04,0xd7,0x45,0xf3,0x50,0x0d,0x63,0x6a,0x62,0xf6,0x4f,0x0a,0xb3,0xba,0xe5,0x48,0xaa,0x53,0xd4,0x23,0xb0,0xd1,0xf2,0x7e,0xbb,0xa6,0xf5,0xe5,0x67,0x3a,0x08,0x1d,0x70,0xcc,0xe7,0xac,0xfc,0x48};
+
+static UCHAR ikm6[] = {0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x10,0x11,0x12,0x13,0x14,0x15,0x16,0x17,0x18,0x19,0x1a,0x1b,0x1c,0x1d,0x1e,0x1f,0x20,0x21,0x22,0x23,0x24,0x25,0x26,0x27,0x28,0x29,0x2a,0x2b,0x2c,0x2d,0x2e,0x2f,0x30,0x31,0x32,0x33,0x34,0x35,0x36,0x37,0x38,0x39,0x3a,0x3b,0x3c,0x3d,0x3e,0x3f,0x40,0x41,0x42,0x43,0x44,0x45,0x46,0x47,0x48,0x49,0x4a,0x4b,0x4c,0x4d,0x4e,0x4f};
+static UCHAR salt6[] = {0x60,0x61,0x62,0x63,0x64,0x65,0x66,0x67,0x68,0x69,0x6a,0x6b,0x6c,0x6d,0x6e,0x6f,0x70,0x71,0x72,0x73,0x74,0x75,0x76,0x77,0x78,0x79,0x7a,0x7b,0x7c,0x7d,0x7e,0x7f,0x80,0x81,0x82,0x83,0x84,0x85,0x86,0x87,0x88,0x89,0x8a,0x8b,0x8c,0x8d,0x8e,0x8f,0x90,0x91,0x92,0x93,0x94,0x95,0x96,0x97,0x98,0x99,0x9a,0x9b,0x9c,0x9d,0x9e,0x9f,0xa0,0xa1,0xa2,0xa3,0xa4,0xa5,0xa6,0xa7,0xa8,0xa9,0xaa,0xab,0xac,0xad,0xae,0xaf};
+static UCHAR info6[] = {0xb0,0xb1,0xb2,0xb3,0xb4,0xb5,0xb6,0xb7,0xb8,0xb9,0xba,0xbb,0xbc,0xbd,0xbe,0xbf,0xc0,0xc1,0xc2,0xc3,0xc4,0xc5,0xc6,0xc7,0xc8,0xc9,0xca,0xcb,0xcc,0xcd,0xce,0xcf,0xd0,0xd1,0xd2,0xd3,0xd4,0xd5,0xd6,0xd7,0xd8,0xd9,0xda,0xdb,0xdc,0xdd,0xde,0xdf,0xe0,0xe1,0xe2,0xe3,0xe4,0xe5,0xe6,0xe7,0xe8,0xe9,0xea,0xeb,0xec,0xed,0xee,0xef,0xf0,0xf1,0xf2,0xf3,0xf4,0xf5,0xf6,0xf7,0xf8,0xf9,0xfa,0xfb,0xfc,0xfd,0xfe,0xff};
+static UCHAR prk6[] = {0x9a,0x8d,0xe1,0x3e,0x63,0xa5,0x3e,0xf6,0x7a,0xf7,0x69,0x6e,0x89,0x0f,0xb3,0x3f,0x84,0x07,0x42,0x25};
+static UCHAR okm6[] = {0xe6,0xc6,0x68,0x89,0x90,0x7c,0x1a,0x6e,0xc1,0x8d,0x7b,0xc8,0xad,0xbe,0x2e,0xc1,0x96,0xa0,0x2d,0x23,0xa3,0xa0,0x05,0x0f,0x34,0x31,0xb2,0x56,0x6e,0x32,0xee,0x83,0x5a,0x3c,0xd3,0xf5,0x4f,0x47,0x8d,0x24,0x7a,0x4a,0x57,0x67,0x6a,0x73,0x25,0x95,0x95,0xd4,0x63,0xb8,0x1f,0x27,0x92,0xbd,0x78,0xd4,0xa3,0x34,0xf3,0x15,0x17,0xb7,0x85,0x19,0xb5,0x7e,0x85,0x60,0x7b,0x63,0x85,0x1a,0xa2,0xef,0xe5,0x16,0x13,0xa4,0x57,0xc3};
+
+#define LEN(a) ((ULONG)sizeof (a))
+
+static struct
+{
+  UCHAR *Key;
+  ULONG KeyLen;
+  UCHAR *Data;
+  ULONG DataLen;
+  UCHAR *Mac[3];
+} MacCases[] =
+{
+  {key1, LEN (key1), data1, LEN (data1), {mac1_sha1, mac1_sha256, mac1_rmd160}},
+  {key2, LEN (key2), data2, LEN (data2), {mac2_sha1, mac2_sha256, mac2_rmd160}},
+  {key3, LEN (key3), data3, LEN (data3), {mac3_sha1, mac3_sha256, mac3_rmd160}},
+  {key4, LEN (key4), data4, LEN (data4), {mac4_sha1, mac4_sha256, mac4_rmd160}},
+  {key5, LEN (key5), data5, LEN (data5), {mac5_sha1, mac5_sha256, mac5_rmd160}},
+  {key6, LEN (key6), data6, LEN (data6), {mac6_sha1, mac6_sha256, mac6_rmd160}}
+};
+
+static struct
+{
+  int Alg;
+  UCHAR *IKM;
+  ULONG IKMLen;
+  UCHAR *Salt;
+  ULONG SaltLen;
+  UCHAR *Info;
+  ULONG InfoLen;
+  UCHAR *PRK;
+  UCHAR *OKM;
+  ULONG OKMLen;
+} KdfCases[] =
+{
+  {HMAC_SHA256, ikm1, LEN (ikm1), salt1, LEN (salt1), info1, LEN (info1), prk1, okm1, LEN (okm1)},
+  {HMAC_SHA256, ikm2, LEN (ikm2), salt2, LEN (salt2), info2, LEN (info2), prk2, okm2, LEN (okm2)},
+  {HMAC_SHA256, ikm3, LEN (ikm3), NULL, 0, NULL, 0, prk3, okm3, LEN (okm3)},
+  {HMAC_SHA1, ikm4, LEN (ikm4), salt4, LEN (salt4), info4, LEN (info4), prk4, okm4, LEN (okm4)},
+  {HMAC_SHA1, ikm5, LEN (ikm5), NULL, 0, NULL, 0, prk5, okm5, LEN (okm5)},
+  {HMAC_RMD160, ikm6, LEN (ikm6), salt6, LEN (salt6), info6, LEN (info6), prk6, okm6, LEN (okm6)}
+};
+
+static int Algs[] = {HMAC_SHA1, HMAC_SHA256, HMAC_RMD160};
+static char *AlgNames[] = {"SHA-1", "SHA-256", "RIPEMD-160"};
+
+
+int main ()
+{
+  int error = 0;
+  HMACKEY hk;
+  HMACCTX ctx;
+  UCHAR Mac[HMAC_MAXLEN], Ref[HMAC_MAXLEN];
+  UCHAR PRK[HMAC_MAXLEN], OKM[255 * HMAC_MAXLEN + 1];
+  UCHAR data[1024];
+  ULONG len, pos, n;
+  unsigned i;
+  int a, c;
+
+  printf ("Testmodule %s, compiled for hmac.c as part of FLINT/C-Library\n", __FILE__);
+
+  for (i = 0; i < sizeof (data); i++)
+    {
+      data[i] = (UCHAR)(i * 7 + 1);
+    }
+
+  for (a = 0; a < 3; a++)
+    {
+      printf ("Testing HMAC-%s\n", AlgNames[a]);
+
+      /* Test #1: Reference values in a single step */
+      for (c = 0; c < 6; c++)
+        {
+          error = hmackey (&hk, Algs[a], MacCases[c].Key, MacCases[c].KeyLen);
+          hmac (Mac, &hk, MacCases[c].Data, MacCases[c].DataLen);
+          check (MacCases[c].Mac[a], Mac, hk.MacLen, error, AlgNames[a], 1);
+        }
+
+      /* Test #2: Reference values with pieces of one byte */
+      for (c = 0; c < 6; c++)
+        {
+          error = hmackey (&hk, Algs[a], MacCases[c].Key, MacCases[c].KeyLen);
+          hmacinit (&ctx, &hk);
+          for (i = 0; i < MacCases[c].DataLen; i++)
+            {
+              hmacupdate (&ctx, MacCases[c].Data + i, 1);
+            }
+          hmacfinish (Mac, &ctx);
+          check (MacCases[c].Mac[a], Mac, hk.MacLen, error, AlgNames[a], 2);
+        }
+
+      /* Test #3: Pieces of varying length agree with a single step, */
+      /* one keyed context serves all messages                       */
+      error = hmackey (&hk, Algs[a], data, 37);
+      for (len = 0; len <= 300 && !error; len++)
+        {
+          hmac (Ref, &hk, data, len);
+          hmacinit (&ctx, &hk);
+          for (pos = 0; pos < len; pos += n)
+            {
+              n = (pos * 13 + len) % 71 + 1;
+              if (n > len - pos)
+                {
+                  n = len - pos;
+                }
+              hmacupdate (&ctx, data + pos, n);
+              hmacupdate (&ctx, data, 0);
+            }
+          hmacfinish (Mac, &ctx);
+          if (memcmp (Ref, Mac, hk.MacLen))
+            {
+              break;
+            }
+        }
+      check (Ref, Mac, hk.MacLen, error, AlgNames[a], 3);
+    }
+
+  printf ("Testing HKDF\n");
+
+  /* Test #4: Reference values of Extract, Expand and both */
+  for (c = 0; c < 6; c++)
+    {
+      a = KdfCases[c].Alg - HMAC_SHA1;
+      error = hkdfextract (PRK, KdfCases[c].Alg, KdfCases[c].Salt,
+                           KdfCases[c].SaltLen, KdfCases[c].IKM,
+                           KdfCases[c].IKMLen);
+      check (KdfCases[c].PRK, PRK, (a == 1) ? 32 : 20, error, AlgNames[a], 4);
+
+      error = hkdfexpand (OKM, KdfCases[c].OKMLen, KdfCases[c].Alg, PRK,
+                          (a == 1) ? 32 : 20, KdfCases[c].Info,
+                          KdfCases[c].InfoLen);
+      check (KdfCases[c].OKM, OKM, (int)KdfCases[c].OKMLen, error, AlgNames[a], 4);
+
+      memset (OKM, 0, sizeof (OKM));
+      error = hkdf (OKM, KdfCases[c].OKMLen, KdfCases[c].Alg,
+                    KdfCases[c].Salt, KdfCases[c].SaltLen,
+                    KdfCases[c].IKM, KdfCases[c].IKMLen,
+                    KdfCases[c].Info, KdfCases[c].InfoLen);
+      check (KdfCases[c].OKM, OKM, (int)KdfCases[c].OKMLen, error, AlgNames[a], 4);
+    }
+
+  /* Test #5: Unknown algorithm and excessive output length are rejected */
+  if (hmackey (&hk, 0, data, 16) != E_HMAC_ALG ||
+      hkdf (OKM, 16, 4, NULL, 0, data, 16, NULL, 0) != E_HMAC_ALG ||
+      hkdfexpand (OKM, 255 * 32 + 1, HMAC_SHA256, data, 32, NULL, 0) != E_HMAC_LEN ||
+      hkdfexpand (OKM, 255 * 32, HMAC_SHA256, data, 32, NULL, 0) != 0)
+    {
+      error = 1;
+    }
+  check (OKM, OKM, 0, error, "HKDF", 5);
+
+  printf ("All tests in %s passed.\n", __FILE__);
+
+  return 0;
+}
+
+
+static int check (UCHAR *Ref, UCHAR *Res, int Len, int error, char *alg, int test)
+{
+  int i;
+  if (error)
+    {
+      fprintf (stderr, "Error in HMAC-%s in test %d: Error code %d\n", alg, test, error);
+      exit (1);
+    }
+
+  if (memcmp (Ref, Res, Len))
+    {
+      fprintf (stderr, "Error in HMAC-%s in test %d: Value invalid\n", alg, test);
+      for (i = 0; i < Len; i++)
+        {
+          fprintf (stderr, "%2x ", Res[i] & 0x00ff);
+        }
+      fprintf (stderr, "\n");
+      exit (1);
+    }
+
+  fprintf (stderr, "Test #%d O.K.\n", test);
+
+  return 0;
+}
@@ -0,0 +1,178 @@
+/******************************************************************************/
+/*                                                                            */
+/*  Software supplement to the book "Cryptography in C and C++"               */
+/*  by Michael Welschenbach                                                   */
+/*                                                                            */
+/*  Module testmb.c         Revision: 19.10.2026                              */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 2001-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+
+/* POSIX interfaces for file descriptors */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "flint.h"
+#include "sha256.h"
+#include "ripemd.h"
+#include "hashmb.h"
+
+#define NOOFJOBS 300
+#define MAXLEN   4500
+
+static void mbtest (int test, int Alg, int Lanes, ULONG NoOfJobs);
+
+static UCHAR *Data, *Res, *Ref;
+static HASHMBJOB Jobs[NOOFJOBS];
+
+
+int main ()
+{
+  int lanes[] = {1, 4, 8, 16};
+  int i, test = 1;
+  UCHAR HashRes[32];
+
+  printf ("Testmodule %s, compiled for hashmb.c as part of FLINT/C-Library\n", __FILE__);
+
+  Data = (UCHAR *)malloc (NOOFJOBS * MAXLEN);
+  Res = (UCHAR *)malloc (NOOFJOBS * 32);
+  Ref = (UCHAR *)malloc (NOOFJOBS * 32);
+  if (Data == NULL || Res == NULL || Ref == NULL)
+    {
+      fprintf (stderr, "Error in %s: Out of memory\n", __FILE__);
+      exit (1);
+    }
+
+  for (i = 0; i < NOOFJOBS * MAXLEN; i++)
+    {
+      Data[i] = (UCHAR)(i ^ (i >> 9));
+    }
+
+  /* Test #1 - #12: Jobs of different lengths for all numbers of lanes */
+  for (i = 0; i < 4; i++)
+    {
+      printf ("Testing %d lanes (%d available)\n", lanes[i],
+              hashmblanes (lanes[i]));
+      mbtest (test++, HASHMB_SHA1, lanes[i], NOOFJOBS);
+      mbtest (test++, HASHMB_SHA256, lanes[i], NOOFJOBS);
+      mbtest (test++, HASHMB_RMD160, lanes[i], NOOFJOBS);
+    }
+
+  /* Test #13: Fewer jobs than lanes */
+  hashmblanes (HASHMB_MAXLANES);
+  mbtest (test++, HASHMB_SHA256, HASHMB_MAXLANES, 3);
+
+  /* Test #14: Reference value of SHA-256 for "abc" */
+  Jobs[0].clear = (UCHAR *)"abc";
+  Jobs[0].length = 3;
+  Jobs[0].HashRes = HashRes;
+  if (hashmb (HASHMB_SHA256, Jobs, 1) != E_CLINT_OK ||
+      memcmp (HashRes, "\xba\x78\x16\xbf\x8f\x01\xcf\xea\x41\x41\x40\xde"
+                       "\x5d\xae\x22\x23\xb0\x03\x61\xa3\x96\x17\x7a\x9c"
+                       "\xb4\x10\xff\x61\xf2\x00\x15\xad", 32))
+    {
+      fprintf (stderr, "Error in %s in test %d\n", __FILE__, test);
+      exit (1);
+    }
+  fprintf (stderr, "Test #%d O.K.\n", test++);
+
+  /* Test #15: Unknown algorithm */
+  if (hashmb (0, Jobs, 1) != E_HASHMB_ALG)
+    {
+      fprintf (stderr, "Error in %s in test %d: Invalid algorithm not detected\n", __FILE__, test);
+      exit (1);
+    }
+  fprintf (stderr, "Test #%d O.K.\n", test);
+
+  free (Data);
+  free (Res);
+  free (Ref);
+
+  printf ("All tests in %s passed.\n", __FILE__);
+
+  return 0;
+}
+
+
+static void mbtest (int test, int Alg, int Lanes, ULONG NoOfJobs)
+{
+  ULONG i, len;
+  int hashlen = (Alg == HASHMB_SHA256) ? 32 : 20;
+  int error;
+
+  hashmblanes (Lanes);
+
+  /* Lengths 0 ... MAXLEN with all residues mod 64, unsorted */
+  for (i = 0; i < NoOfJobs; i++)
+    {
+      len = (i * 7919 + (ULONG)test) % MAXLEN;
+      Jobs[i].clear = Data + i * MAXLEN;
+      Jobs[i].length = len;
+      Jobs[i].HashRes = Res + i * 32;
+
+      switch (Alg)
+        {
+          case HASHMB_SHA1:
+            sha1 (Ref + i * 32, Jobs[i].clear, len);
+            break;
+          case HASHMB_SHA256:
+            sha256 (Ref + i * 32, Jobs[i].clear, len);
+            break;
+          default:
+            ripemd160 (Ref + i * 32, Jobs[i].clear, len);
+            break;
+        }
+    }
+
+  error = hashmb (Alg, Jobs, NoOfJobs);
+
+  for (i = 0; i < NoOfJobs; i++)
+    {
+      if (error || memcmp (Ref + i * 32, Res + i * 32, hashlen))
+        {
+          fprintf (stderr, "Error in %s in test %d: Job %d\n", __FILE__, test, (int)i);
+          exit (1);
+        }
+    }
+
+  fprintf (stderr, "Test #%d O.K.\n", test);
+}
@@ -0,0 +1,200 @@
+/******************************************************************************/
+/*                                                                            */
+/*  Software supplement to the book "Cryptography in C and C++"               */
+/*  by Michael Welschenbach                                                   */
+/*                                                                            */
+/*  Module testmhash.c      Revision: 19.10.2026                              */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 2001-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+
+
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "flint.h"
+#include "multihash.h"
+
+#define MAXLEN   (3 * 4096 + 1000)
+
+static void refdig (MULTIHASHDIG *Ref, int Algs, UCHAR *data, ULONG len);
+static int check (MULTIHASHDIG *Ref, MULTIHASHDIG *Dig, int error, int test);
+
+
+int main ()
+{
+  MULTIHASHDIG Dig, Ref;
+  MULTIHASH mh;
+  UCHAR *data;
+  ULONG len, pos, n, i;
+  int error = 0, Algs;
+
+  printf ("Testmodule %s, compiled for multihash.c as part of FLINT/C-Library\n", __FILE__);
+
+  if ((data = (UCHAR *)malloc (MAXLEN)) == NULL)
+    {
+      fprintf (stderr, "Error: out of memory\n");
+      exit (1);
+    }
+  for (i = 0; i < MAXLEN; i++)
+    {
+      data[i] = (UCHAR)((i * 2654435761UL) >> 13);
+    }
+
+  /* Test #1: Digests of multihash agree with sha1, sha256 and ripemd160 */
+  for (len = 0; len <= MAXLEN && !error; len += (len < 300) ? 1 : 997)
+    {
+      refdig (&Ref, MULTIHASH_ALL, data, len);
+      error = multihash (&Dig, MULTIHASH_ALL, data, len);
+      if (!error && memcmp (&Ref, &Dig, sizeof (Dig)))
+        {
+          break;
+        }
+    }
+  check (&Ref, &Dig, error, 1);
+
+  /* Test #2: Message given byte by byte */
+  len = 1000;
+  multihashinit (&mh, MULTIHASH_ALL);
+  for (i = 0; i < len; i++)
+    {
+      multihashupdate (&mh, data + i, 1);
+    }
+  multihashfinish (&Dig, &mh);
+  refdig (&Ref, MULTIHASH_ALL, data, len);
+  check (&Ref, &Dig, error, 2);
+
+  /* Test #3: Message given in pieces of varying length, also empty ones */
+  for (len = 0; len <= MAXLEN && !error; len += 331)
+    {
+      multihashinit (&mh, MULTIHASH_ALL);
+      for (pos = 0; pos < len; pos += n)
+        {
+          n = (pos * 13 + len) % (4096 + 71) + 1;
+          if (n > len - pos)
+            {
+              n = len - pos;
+            }
+          multihashupdate (&mh, data + pos, n);
+          multihashupdate (&mh, data, 0);
+        }
+      multihashfinish (&Dig, &mh);
+      refdig (&Ref, MULTIHASH_ALL, data, len);
+      if (memcmp (&Ref, &Dig, sizeof (Dig)))
+        {
+          break;
+        }
+    }
+  check (&Ref, &Dig, error, 3);
+
+  /* Test #4: Each combination of hash functions, the digests of the */
+  /* functions not selected are zero                                  */
+  for (Algs = 1; Algs <= MULTIHASH_ALL && !error; Algs++)
+    {
+      refdig (&Ref, Algs, data, MAXLEN);
+      error = multihash (&Dig, Algs, data, MAXLEN);
+      if (!error && memcmp (&Ref, &Dig, sizeof (Dig)))
+        {
+          break;
+        }
+    }
+  check (&Ref, &Dig, error, 4);
+
+  /* Test #5: Invalid selection of hash functions */
+  if (multihash (&Dig, 0, data, 10) != E_MULTIHASH_ARG ||
+      multihashinit (&mh, MULTIHASH_ALL + 1) != E_MULTIHASH_ARG)
+    {
+      error = 1;
+    }
+  check (&Dig, &Dig, error, 5);
+
+  free (data);
+
+  printf ("All tests in %s passed.\n", __FILE__);
+
+  return 0;
+}
+
+
+/* Digests computed by the one-step functions */
+static void refdig (MULTIHASHDIG *Ref, int Algs, UCHAR *data, ULONG len)
+{
+  memset (Ref, 0, sizeof (*Ref));
+  if (Algs & MULTIHASH_SHA1)
+    {
+      sha1 (Ref->Sha1, data, len);
+    }
+  if (Algs & MULTIHASH_SHA256)
+    {
+      sha256 (Ref->Sha256, data, len);
+    }
+  if (Algs & MULTIHASH_RMD160)
+    {
+      ripemd160 (Ref->Rmd160, data, len);
+    }
+}
+
+
+static int check (MULTIHASHDIG *Ref, MULTIHASHDIG *Dig, int error, int test)
+{
+  int i;
+  if (error)
+    {
+      fprintf (stderr, "Error in multihash in test %d: Error code %d\n", test, error);
+      exit (1);
+    }
+
+  if (memcmp (Ref, Dig, sizeof (*Dig)))
+    {
+      fprintf (stderr, "Error in multihash in test %d: Digests invalid\n", test);
+      for (i = 0; i < (int)sizeof (*Dig); i++)
+        {
+          fprintf (stderr, "%2x ", ((UCHAR *)Dig)[i] & 0x00ff);
+        }
+      fprintf (stderr, "\n");
+      exit (1);
+    }
+
+  fprintf (stderr, "Test #%d O.K.\n", test);
+
+  return 0;
+}
@@ -0,0 +1,255 @@
+/******************************************************************************/
+/*                                                                            */
+/*  Software supplement to the book "Cryptography in C and C++"               */
+/*  by Michael Welschenbach                                                   */
+/*                                                                            */
+/*  Module testppar.c       Revision: 19.10.2026                              */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 2001-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "flint.h"
+#include "primepar.h"
+
+#define NTHREADS   4
+
+static void seed (STATEPRNG *S, char *str);
+static int check (int error, char *func, int test);
+
+
+int main ()
+{
+  STATEPRNG S;
+  CLINT p_l, ref_l, rmin_l, rmax_l, rmin0_l, rmax0_l, a_l, q_l, f_l, t_l, g_l;
+  static USHORT len[] = {8, 14, 17, 64, 256, 512};
+  static int threads[] = {1, 2, 3, 8};
+  int error = 0, i, k;
+
+  printf ("Testmodule %s, compiled for primepar.c as part of FLINT/C-Library\n", __FILE__);
+
+  seed (&S, "primepar");
+
+  /* Test #1: Random primes of given length */
+  for (i = 0; i < (int)(sizeof (len) / sizeof (len[0])) && !error; i++)
+    {
+      for (k = 0; k < 5 && !error; k++)
+        {
+          error = FindPrimePar_l (p_l, &S, len[i], NTHREADS, PRIMEPAR_FIRST);
+          if (!error && (ld_l (p_l) != len[i] || !prime_l (p_l, 302, 40)))
+            {
+              error = 1;
+            }
+        }
+    }
+  check (error, "FindPrimePar_l", 1);
+
+  /* Test #2: Bounds spanning several windows, gcd (p - 1, f) = 1 */
+  SETZERO_L (rmin_l);
+  setbit_l (rmin_l, 100);
+  u2clint_l (t_l, 20000);
+  add_l (rmin_l, t_l, rmax_l);
+  cpy_l (rmin0_l, rmin_l);
+  cpy_l (rmax0_l, rmax_l);
+  u2clint_l (f_l, 3 * 5 * 7);
+  for (k = 0; k < 50 && !error; k++)
+    {
+      error = FindPrimeMinMaxGcdPar_l (p_l, &S, rmin_l, rmax_l, f_l,
+                                       NTHREADS, PRIMEPAR_FIRST);
+      if (!error)
+        {
+          cpy_l (t_l, p_l);
+          dec_l (t_l);
+          gcd_l (t_l, f_l, g_l);
+          if (LT_L (p_l, rmin_l) || GT_L (p_l, rmax_l) || !EQONE_L (g_l) ||
+              !prime_l (p_l, 302, 40))
+            {
+              error = 1;
+            }
+        }
+    }
+  if (!error && (!equ_l (rmin_l, rmin0_l) || !equ_l (rmax_l, rmax0_l)))
+    {
+      error = 1;
+    }
+  check (error, "FindPrimeMinMaxGcdPar_l", 2);
+
+  /* Test #3: Primes p = a mod q for odd and even a */
+  str2clint_l (q_l, "1000003", 10);
+  SETZERO_L (rmin_l);
+  setbit_l (rmin_l, 255);
+  SETZERO_L (rmax_l);
+  setbit_l (rmax_l, 256);
+  dec_l (rmax_l);
+  for (k = 0; k < 20 && !error; k++)
+    {
+      u2clint_l (a_l, (USHORT)(k + 1));
+      error = ExtendPrimePar_l (p_l, &S, rmin_l, rmax_l, a_l, q_l, one_l,
+                                NTHREADS, PRIMEPAR_FIRST);
+      if (!error)
+        {
+          sub_l (p_l, a_l, t_l);
+          mod_l (t_l, q_l, t_l);
+          if (!EQZ_L (t_l) || LT_L (p_l, rmin_l) || GT_L (p_l, rmax_l) ||
+              !prime_l (p_l, 302, 40))
+            {
+              error = 1;
+            }
+        }
+    }
+  check (error, "ExtendPrimePar_l", 3);
+
+  /* Test #4: Strong primes */
+  u2clint_l (f_l, 65535);
+  inc_l (f_l);
+  inc_l (f_l);
+  for (k = 0; k < 3 && !error; k++)
+    {
+      error = StrongPrimePar_l (p_l, &S, rmin_l, rmax_l, 56, 120, 120, f_l,
+                                NTHREADS, PRIMEPAR_FIRST);
+      if (!error)
+        {
+          cpy_l (t_l, p_l);
+          dec_l (t_l);
+          gcd_l (t_l, f_l, g_l);
+          if (LT_L (p_l, rmin_l) || GT_L (p_l, rmax_l) || !EQONE_L (g_l) ||
+              !prime_l (p_l, 302, 40))
+            {
+              error = 1;
+            }
+        }
+    }
+  check (error, "StrongPrimePar_l", 4);
+
+  /* Test #5: Deterministic mode yields the same primes for any number */
+  /* of threads                                                       */
+  seed (&S, "deterministic");
+  error = FindPrimePar_l (ref_l, &S, 512, 1, PRIMEPAR_DETERMINISTIC);
+  for (i = 0; i < (int)(sizeof (threads) / sizeof (threads[0])) && !error; i++)
+    {
+      seed (&S, "deterministic");
+      error = FindPrimePar_l (p_l, &S, 512, threads[i], PRIMEPAR_DETERMINISTIC);
+      if (!error && !equ_l (p_l, ref_l))
+        {
+          error = 1;
+        }
+    }
+  seed (&S, "deterministic");
+  if (!error)
+    {
+      error = StrongPrimePar_l (ref_l, &S, rmin_l, rmax_l, 56, 120, 120, one_l,
+                                1, PRIMEPAR_DETERMINISTIC);
+    }
+  for (i = 0; i < (int)(sizeof (threads) / sizeof (threads[0])) && !error; i++)
+    {
+      seed (&S, "deterministic");
+      error = StrongPrimePar_l (p_l, &S, rmin_l, rmax_l, 56, 120, 120, one_l,
+                                threads[i], PRIMEPAR_DETERMINISTIC);
+      if (!error && !equ_l (p_l, ref_l))
+        {
+          error = 1;
+        }
+    }
+  check (error, "PRIMEPAR_DETERMINISTIC", 5);
+
+  /* Test #6: Invalid parameters, ranges without primes */
+  u2clint_l (rmin_l, 31398);
+  u2clint_l (rmax_l, 31468);
+  if (FindPrimeMinMaxGcdPar_l (p_l, &S, rmin_l, rmax_l, one_l, NTHREADS,
+                               PRIMEPAR_FIRST) != E_CLINT_RGE)
+    {
+      error = 1;
+    }
+  u2clint_l (rmin_l, 24);
+  u2clint_l (rmax_l, 28);
+  if (FindPrimeMinMaxGcdPar_l (p_l, &S, rmin_l, rmax_l, one_l, NTHREADS,
+                               PRIMEPAR_FIRST) != E_CLINT_RGE)
+    {
+      error = 1;
+    }
+  u2clint_l (rmax_l, 1000);
+  if (FindPrimeMinMaxGcdPar_l (p_l, &S, rmin_l, rmax_l, two_l, NTHREADS,
+                               PRIMEPAR_FIRST) != E_CLINT_RGE ||
+      FindPrimeMinMaxGcdPar_l (p_l, &S, rmax_l, rmin_l, one_l, NTHREADS,
+                               PRIMEPAR_FIRST) != E_CLINT_RGE ||
+      FindPrimePar_l (p_l, &S, 64, NTHREADS, 2) != E_CLINT_RGE ||
+      FindPrimePar_l (p_l, &S, 0, NTHREADS, PRIMEPAR_FIRST) != E_CLINT_RGE ||
+      ExtendPrimePar_l (p_l, &S, rmin_l, rmax_l, one_l, two_l, one_l,
+                        NTHREADS, PRIMEPAR_FIRST) != E_CLINT_RGE ||
+      ExtendPrimePar_l (p_l, &S, rmin_l, rmax_l, q_l, q_l, one_l,
+                        NTHREADS, PRIMEPAR_FIRST) != E_CLINT_RGE)
+    {
+      error = 1;
+    }
+  check (error, "Parameter checks", 6);
+
+  PurgeRand_l (&S);
+
+  printf ("All tests in %s passed.\n", __FILE__);
+
+  return 0;
+}
+
+
+/* Reproducible state of RandRMDSHA1 */
+
+static void seed (STATEPRNG *S, char *str)
+{
+  S->Generator = FLINT_RNDRMDSHA1;
+  SeedRandRMDSHA1_l (&S->StateRMDSHA1, (UCHAR *)str, (int)strlen (str));
+}
+
+
+static int check (int error, char *func, int test)
+{
+  if (error)
+    {
+      fprintf (stderr, "Error in %s in test %d: Error code %d\n", func, test, error);
+      exit (1);
+    }
+
+  fprintf (stderr, "Test #%d O.K.\n", test);
+
+  return 0;
+}
@@ -0,0 +1,270 @@
+/******************************************************************************/
+/*                                                                            */
+/*  Software supplement to the book "Cryptography in C and C++"               */
+/*  by Michael Welschenbach                                                   */
+/*                                                                            */
+/*  Module testppool.c      Revision: 19.10.2026                              */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 2001-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+
+
+/* POSIX usleep, fork and pipes */
+#define _XOPEN_SOURCE 600
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "flint.h"
+#include "primepool.h"
+
+#define BITS       256
+#define NPLAIN     8
+#define NSTRONG    4
+#define TIMEOUT    6000  /* Maximum waiting time in units of 10 ms */
+
+static int wait_full (USHORT Bits, CLINT f_l, unsigned int Size);
+static int check_prime (CLINT p_l, USHORT Bits, CLINT f_l);
+static int check (int error, char *func, int test);
+
+
+int main ()
+{
+  CLINT p_l, e_l, one_l, f_l, prm_l[NPLAIN + NSTRONG];
+  unsigned int count[2];
+  int error = 0, i, k, fd[2], status;
+  pid_t pid;
+
+  printf ("Testmodule %s, compiled for primepool.c as part of FLINT/C-Library\n", __FILE__);
+
+  ul2clint_l (e_l, 65537UL);
+  SETONE_L (one_l);
+  u2clint_l (f_l, 4);
+
+  /* Test #1: Invalid arguments, no pools defined */
+  if (PrimePoolAdd_l (PRIMEPOOL_MINBITS - 1, e_l, 1, PRIMEPOOL_PLAIN) != E_PRIMEPOOL_ARG ||
+      PrimePoolAdd_l (CLINTMAXBIT/2 + 1, e_l, 1, PRIMEPOOL_PLAIN) != E_PRIMEPOOL_ARG ||
+      PrimePoolAdd_l (BITS, f_l, 1, PRIMEPOOL_PLAIN) != E_PRIMEPOOL_ARG ||
+      PrimePoolAdd_l (BITS, e_l, 0, PRIMEPOOL_PLAIN) != E_PRIMEPOOL_ARG ||
+      PrimePoolAdd_l (BITS, e_l, PRIMEPOOL_MAXSIZE + 1, PRIMEPOOL_PLAIN) != E_PRIMEPOOL_ARG ||
+      PrimePoolAdd_l (BITS, e_l, 1, 2) != E_PRIMEPOOL_ARG ||
+      PrimePoolGet_l (p_l, BITS, e_l) != E_PRIMEPOOL_EMPTY ||
+      PrimePoolCount_l (BITS, e_l) != 0)
+    {
+      error = 1;
+    }
+  check (error, "PrimePoolAdd_l", 1);
+
+  /* Test #2: Pools of plain and strong primes are filled by two threads */
+  error = PrimePoolAdd_l (BITS, e_l, NPLAIN, PRIMEPOOL_PLAIN);
+  if (!error)
+    {
+      error = PrimePoolAdd_l (BITS, one_l, NSTRONG, PRIMEPOOL_STRONG);
+    }
+  if (!error && PrimePoolAdd_l (BITS, e_l, 1, PRIMEPOOL_STRONG) != E_PRIMEPOOL_ARG)
+    {
+      error = 1;
+    }
+  if (!error)
+    {
+      error = PrimePoolStart_l (2);
+    }
+  if (!error && PrimePoolStart_l (1) != E_PRIMEPOOL_INI)
+    {
+      error = 1;
+    }
+  if (!error)
+    {
+      error = wait_full (BITS, e_l, NPLAIN) || wait_full (BITS, one_l, NSTRONG);
+    }
+  check (error, "PrimePoolStart_l", 2);
+
+  /* Test #3: Primes taken from the pools are valid and distinct */
+  for (i = 0; i < NPLAIN + NSTRONG && !error; i++)
+    {
+      if (i < NPLAIN)
+        {
+          error = PrimePoolGet_l (prm_l[i], BITS, e_l);
+          error = error || check_prime (prm_l[i], BITS, e_l);
+        }
+      else
+        {
+          error = PrimePoolGet_l (prm_l[i], BITS, one_l);
+          error = error || check_prime (prm_l[i], BITS, one_l);
+        }
+      for (k = 0; k < i && !error; k++)
+        {
+          if (equ_l (prm_l[i], prm_l[k]))
+            {
+              error = 1;
+            }
+        }
+    }
+  if (!error && PrimePoolGet_l (p_l, BITS + 1, e_l) != E_PRIMEPOOL_EMPTY)
+    {
+      error = 1;
+    }
+  check (error, "PrimePoolGet_l", 3);
+
+  /* Test #4: Pools are refilled after primes have been taken */
+  error = wait_full (BITS, e_l, NPLAIN) || wait_full (BITS, one_l, NSTRONG);
+  check (error, "PrimePoolGet_l", 4);
+
+  /* Test #5: The pools of a child process are empty, its primes purged */
+  pipe (fd);
+  if ((pid = fork ()) == 0)
+    {
+      close (fd[0]);
+      count[0] = PrimePoolCount_l (BITS, e_l);
+      count[1] = (PrimePoolGet_l (p_l, BITS, one_l) == E_PRIMEPOOL_EMPTY) ? 0 : 1;
+      write (fd[1], count, sizeof (count));
+      close (fd[1]);
+      _exit (0);
+    }
+  close (fd[1]);
+  if (read (fd[0], count, sizeof (count)) != sizeof (count) ||
+      count[0] != 0 || count[1] != 0 || PrimePoolCount_l (BITS, e_l) != NPLAIN)
+    {
+      error = 1;
+    }
+  close (fd[0]);
+  waitpid (pid, &status, 0);
+  check (error, "PrimePoolCount_l after fork", 5);
+
+  /* Test #6: Stop releases all pools, pools can be defined again */
+  PrimePoolStop_l ();
+  if (PrimePoolCount_l (BITS, e_l) != 0 ||
+      PrimePoolGet_l (p_l, BITS, e_l) != E_PRIMEPOOL_EMPTY)
+    {
+      error = 1;
+    }
+  for (i = 0; i < PRIMEPOOL_MAXPOOLS && !error; i++)
+    {
+      u2clint_l (f_l, (USHORT)(2 * i + 1));
+      error = PrimePoolAdd_l (PRIMEPOOL_MINBITS, f_l, 1, PRIMEPOOL_PLAIN);
+    }
+  if (!error && PrimePoolAdd_l (BITS, e_l, 1, PRIMEPOOL_PLAIN) != E_PRIMEPOOL_FULL)
+    {
+      error = 1;
+    }
+  PrimePoolStop_l ();
+  if (!error)
+    {
+      error = PrimePoolAdd_l (BITS, e_l, 1, PRIMEPOOL_PLAIN);
+    }
+  if (!error)
+    {
+      error = PrimePoolStart_l (0);
+    }
+  if (!error)
+    {
+      error = wait_full (BITS, e_l, 1);
+    }
+  if (!error)
+    {
+      error = PrimePoolGet_l (p_l, BITS, e_l) || check_prime (p_l, BITS, e_l);
+    }
+  PrimePoolStop_l ();
+  check (error, "PrimePoolStop_l", 6);
+
+  printf ("All tests in %s passed.\n", __FILE__);
+
+  return 0;
+}
+
+
+/* Wait until the pool for Bits and f holds Size primes */
+static int wait_full (USHORT Bits, CLINT f_l, unsigned int Size)
+{
+  int t;
+
+  for (t = 0; t < TIMEOUT; t++)
+    {
+      if (PrimePoolCount_l (Bits, f_l) == Size)
+        {
+          return 0;
+        }
+      usleep (10000);
+    }
+
+  return 1;
+}
+
+
+/* Check 0xb505 * 2^(Bits - 16) <= p < 2^Bits, gcd (p - 1, f) = 1 and primality */
+static int check_prime (CLINT p_l, USHORT Bits, CLINT f_l)
+{
+  CLINT t_l, g_l;
+
+  u2clint_l (t_l, 0xb505);
+  shift_l (t_l, (long int)Bits - 16);
+  if (LT_L (p_l, t_l) || ld_l (p_l) != Bits)
+    {
+      return 1;
+    }
+
+  cpy_l (t_l, p_l);
+  dec_l (t_l);
+  gcd_l (t_l, f_l, g_l);
+  if (!EQONE_L (g_l) || !prime_l (p_l, 302, 40))
+    {
+      return 1;
+    }
+
+  return 0;
+}
+
+
+static int check (int error, char *func, int test)
+{
+  if (error)
+    {
+      fprintf (stderr, "Error in %s in test %d: Error code %d\n", func, test, error);
+      exit (1);
+    }
+
+  fprintf (stderr, "Test #%d O.K.\n", test);
+
+  return 0;
+}
@@ -0,0 +1,407 @@
+/******************************************************************************/
+/*                                                                            */
+/*  Software supplement to the book "Cryptography in C and C++"               */
+/*  by Michael Welschenbach                                                   */
+/*                                                                            */
+/*  Module testprng.c       Revision: 19.10.2026                              */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 2001-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "flint.h"
+#include "random.h"
+
+#define MAXLEN   100000
+
+static int prng_test (int Generator, int update, ULONG Len, char *prng);
+static int aes_test (void);
+static int bbs_test (void);
+static int findprime_test (void);
+static int check (int error, char *prng, int test);
+
+
+int main ()
+{
+  printf ("Testmodule %s, compiled for FLINT/C-Library Version %s\n", __FILE__, verstr_l ());
+
+  prng_test (FLINT_RNDAES, 0, MAXLEN, "RandAES w/o key update");
+  prng_test (FLINT_RNDAES, 1, MAXLEN, "RandAES with key update 1");
+  prng_test (FLINT_RNDAES, 10, MAXLEN, "RandAES with key update 10");
+  aes_test ();
+  prng_test (FLINT_RNDRMDSHA1, 0, MAXLEN, "RandRMDSHA1");
+  prng_test (FLINT_RNDBBS, 0, 4000, "RandBBS");
+  bbs_test ();
+  findprime_test ();
+
+  printf ("All tests in %s passed.\n", __FILE__);
+
+  return 0;
+}
+
+
+/* Tests of the buffered output functions of a PRNG. The byte stream of */
+/* bRand_l serves as reference for all other output functions, applied  */
+/* to copies of the same initial state                                  */
+static int prng_test (int Generator, int update, ULONG Len, char *prng)
+{
+  STATEPRNG P, T;
+  UCHAR *ref, *buf;
+  ULONG pos, n, i, r, e;
+  int error = 0, l;
+  CLINT r_l;
+
+  if ((ref = (UCHAR *)malloc (Len)) == NULL ||
+      (buf = (UCHAR *)malloc (Len)) == NULL)
+    {
+      fprintf (stderr, "Error: out of memory\n");
+      exit (1);
+    }
+
+  printf ("Test %s ...\n", prng);
+
+  memset (&P, 0, sizeof (P));
+  InitRand_l (&P, "testprng", 8, 0, Generator);
+  P.StateAES.UpdateKeyAES = (unsigned)update;
+  T = P;
+  for (i = 0; i < Len; i++)
+    {
+      ref[i] = bRand_l (&P);
+    }
+
+  /* Test #1: RandBytes_l in pieces of varying length, also empty ones */
+  P = T;
+  for (pos = 0; pos < Len && !error; pos += n)
+    {
+      n = (pos * 7 + 3) % 61;
+      if (n > Len - pos)
+        {
+          n = Len - pos;
+        }
+      error = RandBytes_l (buf + pos, n, &P);
+    }
+  if (!error && memcmp (ref, buf, Len))
+    {
+      error = 1;
+    }
+  check (error, "RandBytes_l", 1);
+
+  /* Test #2: 8, 16 and 32 bit values at all positions in the buffer */
+  P = T;
+  for (pos = 0; pos + 4 <= Len && !error; pos += n)
+    {
+      switch (pos % 3)
+        {
+          case 0:
+            r = bRand_l (&P);
+            n = 1;
+            break;
+          case 1:
+            r = sRand_l (&P);
+            n = 2;
+            break;
+          default:
+            r = lRand_l (&P);
+            n = 4;
+        }
+      for (e = 0, i = 0; i < n; i++)
+        {
+          e = (e << 8) | (ULONG)ref[pos + i];
+        }
+      if (r != e)
+        {
+          error = 1;
+        }
+    }
+  check (error, "bRand_l, sRand_l, lRand_l", 2);
+
+  /* Test #3: Rand_l yields numbers of l bits made of 16 bit values */
+  P = T;
+  for (l = 0, pos = 0; l <= (int)CLINTMAXBIT && !error; l += 13)
+    {
+      n = ((ULONG)l + BITPERDGT - 1) >> LDBITPERDGT;
+      if (pos + (n << 1) > Len)
+        {
+          break;
+        }
+      error = Rand_l (r_l, &P, l);
+      if (ld_l (r_l) != (unsigned int)l)
+        {
+          error = 1;
+        }
+      for (i = 1; i < n && !error; i++, pos += 2)
+        {
+          if (r_l[i] != (USHORT)((ref[pos] << 8) | ref[pos + 1]))
+            {
+              error = 1;
+            }
+        }
+      pos += (n > 0) ? 2 : 0;
+    }
+  check (error, "Rand_l", 3);
+
+  /* Test #4: Uninitialized generator */
+  PurgeRand_l (&P);
+  if (RandBytes_l (buf, 10, &P) != E_CLINT_RIN ||
+      Rand_l (r_l, &P, 100) != E_CLINT_RIN)
+    {
+      error = 1;
+    }
+  check (error, "RandBytes_l", 4);
+
+  free (ref);
+  free (buf);
+  return 0;
+}
+
+
+/* RandAES outputs the encryptions of a secret counter: No output block is */
+/* the encryption of its predecessor, neither key nor counter are output  */
+
+static int aes_test (void)
+{
+  STATEPRNG P;
+  STATEAES A;
+  AESBLOCK X, Y;
+  UCHAR buf[21 * RANDAESBLOCKLEN];
+  int error, i;
+
+  printf ("Test RandAES in CTR mode ...\n");
+
+  memset (&P, 0, sizeof (P));
+  error = InitRand_l (&P, "testprng", 8, 0, FLINT_RNDAES);
+  A = P.StateAES;
+  if (!error)
+    {
+      error = RandBytes_l (buf, sizeof (buf), &P);
+    }
+
+  AESCrypt_l (X, &A.RandAESWorksp, &A.RandAESSched, A.XAES, RANDAESBLOCKLEN);
+  if (!error && memcmp (X, buf, RANDAESBLOCKLEN))
+    {
+      error = 1;
+    }
+
+  for (i = 0; i < 20 && !error; i++)
+    {
+      memcpy (Y, buf + i * RANDAESBLOCKLEN, RANDAESBLOCKLEN);
+      AESCrypt_l (X, &A.RandAESWorksp, &A.RandAESSched, Y, RANDAESBLOCKLEN);
+      if (!memcmp (X, buf + (i + 1) * RANDAESBLOCKLEN, RANDAESBLOCKLEN) ||
+          !memcmp (Y, A.XAES, RANDAESBLOCKLEN) ||
+          !memcmp (Y, A.RandAESKey, RANDAESBLOCKLEN))
+        {
+          error = 1;
+        }
+    }
+
+#ifdef FLINT_SECURE
+  /* Delivered bytes are purged from the output buffer */
+  for (i = 0; i < RANDAESBLOCKLEN && !error; i++)
+    {
+      if (P.StateAES.OutAES[i] != 0)
+        {
+          error = 1;
+        }
+    }
+#endif
+  check (error, "RandAESBytes_l", 11);
+
+  PurgeRand_l (&P);
+  return 0;
+}
+
+
+/* Known answer test of RandBBS: Output for the seed 0123...cdef with the  */
+/* 2048 bit modulus, 11 bits taken from each square, computed independently */
+
+#if (CLINTMAXDIGIT >= 128)
+static UCHAR bbsref[] = {0xc8,0x32,0x04,0x80,0xb1,0x95,0xd0,0xb4,0xb0,0x65,0x71,0x3c,0x06,0x63,0xca,0x27,0x50,0x0c,0x6f,0x05,0xad,0x0b,0x5d,0x2a,0x4d,0x35,0x57,0x86,0xc6,0x4e,0xbf,0x00,0xdf,0x63,0x18,0xbb,0xc3,0xcc,0xb8,0x1d,0xa8,0x5b,0x48,0xe5,0x21,0x41,0x53,0x75,0x60,0xcd,0x67,0xfc,0x5a,0x18,0xd7,0x32,0xbd,0x85,0x40,0xf5,0x12,0x87,0x1a,0xda};
+#endif
+
+static int bbs_test (void)
+{
+#if (CLINTMAXDIGIT >= 128)
+  STATEBBS S;
+  UCHAR buf[sizeof (bbsref)];
+  CLINT seed_l;
+  int error, i;
+
+  printf ("Test RandBBS with known answer ...\n");
+
+  str2clint_l (seed_l, "0123456789abcdef0123456789abcdef", 16);
+  error = SeedBBS_l (&S, seed_l);
+  if (!error)
+    {
+      error = RandBBSBytes_l (buf, sizeof (buf), &S);
+    }
+  if (!error && memcmp (buf, bbsref, sizeof (buf)))
+    {
+      error = 1;
+    }
+  check (error, "RandBBSBytes_l", 5);
+
+  /* The same stream bit by bit */
+  SeedBBS_l (&S, seed_l);
+  for (i = 0; i < (int)(sizeof (buf) << 3) && !error; i++)
+    {
+      if (SwitchRandBBS_l (&S) != ((bbsref[i >> 3] >> (7 - (i & 7))) & 1))
+        {
+          error = 1;
+        }
+    }
+  check (error, "SwitchRandBBS_l", 6);
+
+  /* Seed not coprime to the modulus */
+  SETZERO_L (seed_l);
+  if (SeedBBS_l (&S, seed_l) != E_CLINT_RCP)
+    {
+      error = 1;
+    }
+  check (error, "SeedBBS_l", 7);
+#endif
+
+  return 0;
+}
+
+
+/* Tests of the prime search, short lengths are searched without sieve */
+
+static int findprime_test (void)
+{
+  STATEPRNG S;
+  CLINT p_l, rmin_l, rmax_l, rmin0_l, rmax0_l, f_l, t_l, g_l;
+  static USHORT len[] = {8, 14, 15, 16, 32, 64, 100, 256, 512};
+  int error, i, k;
+
+  printf ("Test FindPrime ...\n");
+
+  error = InitRand_l (&S, "FindPrime", 9, 0, FLINT_RNDAES);
+
+  /* Random primes of given length. Without sieve the search may give up */
+  /* after the estimated number of candidates with E_CLINT_RGE            */
+  for (i = 0; i < (int)(sizeof (len) / sizeof (len[0])) && !error; i++)
+    {
+      for (k = 0; k < 10 && !error; k++)
+        {
+          while ((error = FindPrime_l (p_l, &S, len[i])) == E_CLINT_RGE &&
+                 len[i] < 16)
+            {
+              ;
+            }
+          if (!error && (ld_l (p_l) != len[i] || !prime_l (p_l, 302, 40)))
+            {
+              error = 1;
+            }
+        }
+    }
+  check (error, "FindPrime_l", 8);
+
+  /* Bounds spanning several sieve windows, gcd (p - 1, f) = 1 */
+  SETZERO_L (rmin_l);
+  setbit_l (rmin_l, 100);
+  u2clint_l (t_l, 5000);
+  add_l (rmin_l, t_l, rmax_l);
+  cpy_l (rmin0_l, rmin_l);
+  cpy_l (rmax0_l, rmax_l);
+  u2clint_l (f_l, 3 * 5 * 7);
+  for (k = 0; k < 100 && !error; k++)
+    {
+      error = FindPrimeMinMaxGcd_l (p_l, &S, rmin_l, rmax_l, f_l);
+      if (!error)
+        {
+          cpy_l (t_l, p_l);
+          dec_l (t_l);
+          gcd_l (t_l, f_l, g_l);
+          if (LT_L (p_l, rmin_l) || GT_L (p_l, rmax_l) || !EQONE_L (g_l) ||
+              !prime_l (p_l, 302, 40))
+            {
+              error = 1;
+            }
+        }
+    }
+  /* The bounds are left unchanged */
+  if (!error && (!equ_l (rmin_l, rmin0_l) || !equ_l (rmax_l, rmax0_l)))
+    {
+      error = 1;
+    }
+  check (error, "FindPrimeMinMaxGcd_l", 9);
+
+  /* No prime between 31397 and 31469 */
+  u2clint_l (rmin_l, 31398);
+  u2clint_l (rmax_l, 31468);
+  if (FindPrimeMinMaxGcd_l (p_l, &S, rmin_l, rmax_l, one_l) != E_CLINT_RGE)
+    {
+      error = 1;
+    }
+  /* No prime between 24 and 28 */
+  u2clint_l (rmin_l, 24);
+  u2clint_l (rmax_l, 28);
+  if (FindPrimeMinMaxGcd_l (p_l, &S, rmin_l, rmax_l, one_l) != E_CLINT_RGE)
+    {
+      error = 1;
+    }
+  /* f_l even */
+  if (FindPrimeGcd_l (p_l, &S, 64, two_l) != E_CLINT_RGE)
+    {
+      error = 1;
+    }
+  check (error, "FindPrimeMinMaxGcd_l", 10);
+
+  PurgeRand_l (&S);
+
+  return 0;
+}
+
+
+static int check (int error, char *prng, int test)
+{
+  if (error)
+    {
+      fprintf (stderr, "Error in %s in test %d: Error code %d\n", prng, test, error);
+      exit (1);
+    }
+
+  fprintf (stderr, "Test #%d O.K.\n", test);
+
+  return 0;
+}
@@ -86,11 +86,17 @@ UCHAR clear_bin1[] = {0xea,0xe5,0xe8,0x49,0x85,0x03,0xe8,0x25,0xb2,0xa0,0xa7,0x4
 UCHAR clear_bin2[] = {0xe1,0x1f,0x59,0xa6,0x96,0x1d,0xde,0xa9,0xec,0x63,0xe7,0x65,0xbb,0x70,0xd3,0x7b,0x44,0x46,0x01,0x6f};
 UCHAR clear_bin3[] = {0x4c,0xb3,0x3d,0xb6,0x14,0x35,0x42,0xd9,0x2c,0x9b,0x6d,0xfc,0xfd,0xa8,0x1b,0x63,0xa9,0x23,0xb2,0x04};
 
+/* Exported initial status of RIPEMD-128 and RIPEMD-160 */
+
+UCHAR stat_init128[] = {'R','1','2','8',0x67,0x45,0x23,0x01,0xef,0xcd,0xab,0x89,0x98,0xba,0xdc,0xfe,0x10,0x32,0x54,0x76,0,0,0,0,0,0,0,0};
+UCHAR stat_init[] = {'R','1','6','0',0x67,0x45,0x23,0x01,0xef,0xcd,0xab,0x89,0x98,0xba,0xdc,0xfe,0x10,0x32,0x54,0x76,0xc3,0xd2,0xe1,0xf0,0,0,0,0,0,0,0,0};
+
 int main ()
 {
   int error = 0;
   unsigned i, nbytes;
-  RMDSTAT hws;
+  RMDSTAT hws, hwsc;
+  UCHAR StatBuf[RMDSTATLEN];
   UCHAR HashRes[RMDVER>>3];
   UCHAR data[1024];
   FILE *mf;
@@ -140,6 +146,48 @@ int main ()
   ripefinish128 (HashRes, &hws, data, 576);
   check (clear128_M_a, HashRes, 16, error, 8);
 
+  /* Test #9: 1 million times 'a', status exported after the first */
+  /* half, imported into a cleared status buffer and cloned        */
+  memset (data, 'a', 1024);
+  ripeinit128 (&hws);
+  for (i = 0; i < 488; i++)
+    {
+      error |= ripehash128 (&hws, data, 1024);
+    }
+  ripeexport128 (StatBuf, &hws);
+  memset (&hws, 0, sizeof (hws));
+  error |= ripeimport128 (&hws, StatBuf, RMD128STATLEN);
+  ripeclone (&hwsc, &hws);
+  for (i = 488; i < 976; i++)
+    {
+      error |= ripehash128 (&hws, data, 1024);
+      error |= ripehash128 (&hwsc, data, 1024);
+    }
+  ripefinish128 (HashRes, &hws, data, 576);
+  check (clear128_M_a, HashRes, 16, error, 9);
+  ripefinish128 (HashRes, &hwsc, data, 576);
+  check (clear128_M_a, HashRes, 16, error, 9);
+
+  /* Test #10: Exported initial status, a RIPEMD-128 status is not */
+  /* accepted as RIPEMD-160 status and vice versa                  */
+  ripeinit128 (&hws);
+  ripeexport128 (StatBuf, &hws);
+  check (stat_init128, StatBuf, RMD128STATLEN, error, 10);
+  if (ripeimport (&hws, StatBuf, RMD128STATLEN) != E_CLINT_RMD
+      || ripeimport (&hws, StatBuf, RMDSTATLEN) != E_CLINT_RMD)
+    {
+      error = 1;
+    }
+  ripeinit (&hws);
+  ripeexport (StatBuf, &hws);
+  check (stat_init, StatBuf, RMDSTATLEN, error, 10);
+  if (ripeimport128 (&hws, StatBuf, RMDSTATLEN) != E_CLINT_RMD
+      || ripeimport128 (&hws, StatBuf, RMD128STATLEN) != E_CLINT_RMD)
+    {
+      error = 2;
+    }
+  check (stat_init, StatBuf, RMDSTATLEN, error, 10);
+
 
   /* Tests RIPEMD-160 */
   printf ("Testing RIPEMD-160\n");
@@ -261,6 +309,28 @@ int main ()
   check (clear_bin3, HashRes, 20, error, 11);
   fclose (mf);
 
+  /* Test #12: 1 million times 'a', status exported after the first */
+  /* half, imported into a cleared status buffer and cloned         */
+  memset (data, 'a', 1024);
+  ripeinit (&hws);
+  for (i = 0; i < 488; i++)
+    {
+      error |= ripehash (&hws, data, 1024);
+    }
+  ripeexport (StatBuf, &hws);
+  memset (&hws, 0, sizeof (hws));
+  error |= ripeimport (&hws, StatBuf, RMDSTATLEN);
+  ripeclone (&hwsc, &hws);
+  for (i = 488; i < 976; i++)
+    {
+      error |= ripehash (&hws, data, 1024);
+      error |= ripehash (&hwsc, data, 1024);
+    }
+  ripefinish (HashRes, &hws, data, 576);
+  check (clear_M_a, HashRes, 20, error, 12);
+  ripefinish (HashRes, &hwsc, data, 576);
+  check (clear_M_a, HashRes, 20, error, 12);
+
   printf ("All tests in %s passed.\n", __FILE__);
 
   return 0;
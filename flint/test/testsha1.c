@@ -64,17 +64,27 @@ UCHAR clear_abc[] = {0xa9,0x99,0x3e,0x36,0x47,0x06,0x81,0x6a,0xba,0x3e,0x25,0x71
 UCHAR clear_a_q[] = {0x84,0x98,0x3e,0x44,0x1c,0x3b,0xd2,0x6e,0xba,0xae,0x4a,0xa1,0xf9,0x51,0x29,0xe5,0xe5,0x46,0x70,0xf1};
 UCHAR clear_M_a[] = {0x34,0xaa,0x97,0x3c,0xd4,0xc4,0xda,0xa4,0xf6,0x1e,0xeb,0x2b,0xdb,0xad,0x27,0x31,0x65,0x34,0x01,0x6f};
 
+/* Exported initial status of SHA-1 */
+UCHAR stat_init[] = {'S','H','A','1',0x67,0x45,0x23,0x01,0xef,0xcd,0xab,0x89,0x98,0xba,0xdc,0xfe,0x10,0x32,0x54,0x76,0xc3,0xd2,0xe1,0xf0,0,0,0,0,0,0,0,0};
+
+static char *implname[] = {"C", "SSSE3", "AVX2", "SHA-NI"};
+
 int main ()
 {
   int error = 0;
   unsigned i;
-  SHASTAT hws;
+  SHASTAT hws, hwsc;
+  UCHAR StatBuf[SHASTATLEN];
   UCHAR HashRes[SHALEN>>3];
+  UCHAR HashRef[SHALEN>>3];
+  ULONG len;
+  int impl;
   UCHAR data[1024];
 
   printf ("Testmodule %s, compiled for sha1.c as part of FLINT/C-Library\n", __FILE__);
 
-  printf ("Testing SHA-1\n");
+  printf ("Testing SHA-1, block function %s\n",
+          implname[shaimpl (SHA_IMPL_BEST)]);
 
   /* Test #1: String "abc" */
   sha1 (HashRes, ( UCHAR * ) "abc", 3);
@@ -94,6 +104,99 @@ int main ()
   sha1finish (HashRes, &hws, data, 576);
   check (clear_M_a, HashRes, 20, error, 3);
 
+  /* Test #4: 1 million times 'a' with portable block function */
+  shaimpl (SHA_IMPL_C);
+  memset (data, 'a', 1024);
+  sha1init (&hws);
+  for (i = 0; i < 976; i++)
+    {
+      error = sha1hash (&hws, data, 1024);
+    }
+  sha1finish (HashRes, &hws, data, 576);
+  check (clear_M_a, HashRes, 20, error, 4);
+
+  /* Test #5: All implementations of the block function agree, also if */
+  /* the implementation changes within a message                       */
+  for (i = 0; i < 1024; i++)
+    {
+      data[i] = (UCHAR)(i * 7 + 1);
+    }
+  for (impl = SHA_IMPL_C + 1; impl <= SHA_IMPL_BEST; impl++)
+    {
+      for (len = 0; len <= 300; len++)
+        {
+          shaimpl (SHA_IMPL_C);
+          sha1 (HashRef, data, len);
+          shaimpl (impl);
+          sha1 (HashRes, data, len);
+          if (memcmp (HashRef, HashRes, 20))
+            {
+              break;
+            }
+          if (len >= 64)
+            {
+              shaimpl (SHA_IMPL_C);
+              sha1init (&hws);
+              error = sha1hash (&hws, data, 64);
+              shaimpl (impl);
+              sha1finish (HashRes, &hws, data + 64, len - 64);
+              if (error || memcmp (HashRef, HashRes, 20))
+                {
+                  break;
+                }
+            }
+        }
+      check (HashRef, HashRes, 20, error, 5);
+    }
+
+  shaimpl (SHA_IMPL_BEST);
+
+  /* Test #6: 1 million times 'a', status exported after the first */
+  /* half, imported into a cleared status buffer and cloned        */
+  memset (data, 'a', 1024);
+  sha1init (&hws);
+  for (i = 0; i < 488; i++)
+    {
+      error |= sha1hash (&hws, data, 1024);
+    }
+  sha1export (StatBuf, &hws);
+  memset (&hws, 0, sizeof (hws));
+  error |= sha1import (&hws, StatBuf, SHASTATLEN);
+  sha1clone (&hwsc, &hws);
+  for (i = 488; i < 976; i++)
+    {
+      error |= sha1hash (&hws, data, 1024);
+      error |= sha1hash (&hwsc, data, 1024);
+    }
+  sha1finish (HashRes, &hws, data, 576);
+  check (clear_M_a, HashRes, 20, error, 6);
+  sha1finish (HashRes, &hwsc, data, 576);
+  check (clear_M_a, HashRes, 20, error, 6);
+
+  /* Test #7: Exported initial status, rejection of a wrong length,  */
+  /* a wrong tag and of a status within a block, status unchanged    */
+  sha1init (&hws);
+  sha1export (StatBuf, &hws);
+  check (stat_init, StatBuf, SHASTATLEN, error, 7);
+  if (sha1import (&hws, StatBuf, SHASTATLEN - 1) != E_CLINT_SHA
+      || sha1import (&hws, StatBuf, SHASTATLEN + 1) != E_CLINT_SHA)
+    {
+      error = 1;
+    }
+  StatBuf[SHASTATLEN - 1] = 32;
+  if (sha1import (&hws, StatBuf, SHASTATLEN) != E_CLINT_SHA)
+    {
+      error = 2;
+    }
+  StatBuf[SHASTATLEN - 1] = 0;
+  StatBuf[3] = '2';
+  if (sha1import (&hws, StatBuf, SHASTATLEN) != E_CLINT_SHA)
+    {
+      error = 3;
+    }
+  sha1export (StatBuf, &hws);
+  check (stat_init, StatBuf, SHASTATLEN, error, 7);
+
   printf ("All tests in %s passed.\n", __FILE__);
 
   return 0;
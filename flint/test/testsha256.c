@@ -55,7 +55,7 @@
 #include "sha256.h"
 
 
-static int check (UCHAR *HashRef, UCHAR *HashRes, int Len, int error, UCHAR *shav, int test);
+static int check (UCHAR *HashRef, UCHAR *HashRes, int Len, int error, const char *shav, int test);
 
 
 /* Reference values for SHA-1 */
@@ -72,19 +72,30 @@ UCHAR clear_a_q_256[] = {0x24,0x8d,0x6a,0x61,0xd2,0x06,0x38,0xb8,0xe5,0xc0,0x26,
 
 UCHAR clear_M_a_256[] = {0xcd,0xc7,0x6e,0x5c,0x99,0x14,0xfb,0x92,0x81,0xa1,0xc7,0xe2,0x84,0xd7,0x3e,0x67,0xf1,0x80,0x9a,0x48,0xa4,0x97,0x20,0x0e,0x04,0x6d,0x39,0xcc,0xc7,0x11,0x2c,0xd0};
 
+/* Exported initial status of SHA-1 and SHA-256 */
+UCHAR stat_init[] = {'S','H','A','1',0x67,0x45,0x23,0x01,0xef,0xcd,0xab,0x89,0x98,0xba,0xdc,0xfe,0x10,0x32,0x54,0x76,0xc3,0xd2,0xe1,0xf0,0,0,0,0,0,0,0,0};
+UCHAR stat_init_256[] = {'S','2','5','6',0x6a,0x09,0xe6,0x67,0xbb,0x67,0xae,0x85,0x3c,0x6e,0xf3,0x72,0xa5,0x4f,0xf5,0x3a,0x51,0x0e,0x52,0x7f,0x9b,0x05,0x68,0x8c,0x1f,0x83,0xd9,0xab,0x5b,0xe0,0xcd,0x19,0,0,0,0,0,0,0,0};
+
+
+static char *implname[] = {"C", "SSSE3", "AVX2", "SHA-NI"};
 
 int main ()
 {
   int error = 0;
   unsigned i;
-  SHASTAT hws;
-  SHA256STAT hws256;
+  SHASTAT hws, hwsc;
+  SHA256STAT hws256, hws256c;
+  UCHAR StatBuf[SHA256STATLEN];
   UCHAR HashRes[SHALEN256>>3];
+  UCHAR HashRef[SHALEN256>>3];
+  ULONG len;
+  int impl;
   UCHAR data[1024];
 
   printf ("Testmodule %s, compiled for sha1.c as part of FLINT/C-Library\n", __FILE__);
 
-  printf ("Testing SHA-1\n");
+  printf ("Testing SHA-1, block function %s\n",
+          implname[shaimpl (SHA_IMPL_BEST)]);
 
   /* Test #1: String "abc" */
   sha1 (HashRes, ( UCHAR * ) "abc", 3);
@@ -104,6 +115,99 @@ int main ()
   sha1finish (HashRes, &hws, data, 576);
   check (clear_M_a, HashRes, 20, error, "1", 3);
 
+  /* Test #4: 1 million times 'a' with portable block function */
+  shaimpl (SHA_IMPL_C);
+  memset (data, 'a', 1024);
+  sha1init (&hws);
+  for (i = 0; i < 976; i++)
+    {
+      error = sha1hash (&hws, data, 1024);
+    }
+  sha1finish (HashRes, &hws, data, 576);
+  check (clear_M_a, HashRes, 20, error, "1", 4);
+
+  /* Test #5: All implementations of the block function agree, also if */
+  /* the implementation changes within a message                       */
+  for (i = 0; i < 1024; i++)
+    {
+      data[i] = (UCHAR)(i * 7 + 1);
+    }
+  for (impl = SHA_IMPL_C + 1; impl <= SHA_IMPL_BEST; impl++)
+    {
+      for (len = 0; len <= 300; len++)
+        {
+          shaimpl (SHA_IMPL_C);
+          sha1 (HashRef, data, len);
+          shaimpl (impl);
+          sha1 (HashRes, data, len);
+          if (memcmp (HashRef, HashRes, 20))
+            {
+              break;
+            }
+          if (len >= 64)
+            {
+              shaimpl (SHA_IMPL_C);
+              sha1init (&hws);
+              error = sha1hash (&hws, data, 64);
+              shaimpl (impl);
+              sha1finish (HashRes, &hws, data + 64, len - 64);
+              if (error || memcmp (HashRef, HashRes, 20))
+                {
+                  break;
+                }
+            }
+        }
+      check (HashRef, HashRes, 20, error, "1", 5);
+    }
+
+  shaimpl (SHA_IMPL_BEST);
+
+  /* Test #6: 1 million times 'a', status exported after the first */
+  /* half, imported into a cleared status buffer and cloned        */
+  memset (data, 'a', 1024);
+  sha1init (&hws);
+  for (i = 0; i < 488; i++)
+    {
+      error |= sha1hash (&hws, data, 1024);
+    }
+  sha1export (StatBuf, &hws);
+  memset (&hws, 0, sizeof (hws));
+  error |= sha1import (&hws, StatBuf, SHASTATLEN);
+  sha1clone (&hwsc, &hws);
+  for (i = 488; i < 976; i++)
+    {
+      error |= sha1hash (&hws, data, 1024);
+      error |= sha1hash (&hwsc, data, 1024);
+    }
+  sha1finish (HashRes, &hws, data, 576);
+  check (clear_M_a, HashRes, 20, error, "1", 6);
+  sha1finish (HashRes, &hwsc, data, 576);
+  check (clear_M_a, HashRes, 20, error, "1", 6);
+
+  /* Test #7: Exported initial status, rejection of a wrong length,  */
+  /* a wrong tag and of a status within a block, status unchanged    */
+  sha1init (&hws);
+  sha1export (StatBuf, &hws);
+  check (stat_init, StatBuf, SHASTATLEN, error, "1", 7);
+  if (sha1import (&hws, StatBuf, SHASTATLEN - 1) != E_CLINT_SHA
+      || sha1import (&hws, StatBuf, SHASTATLEN + 1) != E_CLINT_SHA)
+    {
+      error = 1;
+    }
+  StatBuf[SHASTATLEN - 1] = 32;
+  if (sha1import (&hws, StatBuf, SHASTATLEN) != E_CLINT_SHA)
+    {
+      error = 2;
+    }
+  StatBuf[SHASTATLEN - 1] = 0;
+  StatBuf[3] = '2';
+  if (sha1import (&hws, StatBuf, SHASTATLEN) != E_CLINT_SHA)
+    {
+      error = 3;
+    }
+  sha1export (StatBuf, &hws);
+  check (stat_init, StatBuf, SHASTATLEN, error, "1", 7);
+
   printf ("Testing SHA-256\n");
 
   /* Test #1: String "abc" */
@@ -124,13 +228,106 @@ int main ()
   sha256finish_l (HashRes, &hws256, data, 576);
   check (clear_M_a_256, HashRes, 32, error, "256", 3);
 
+  /* Test #4: 1 million times 'a' with portable block function */
+  shaimpl (SHA_IMPL_C);
+  memset (data, 'a', 1024);
+  sha256init_l (&hws256);
+  for (i = 0; i < 976; i++)
+    {
+      error = sha256hash_l (&hws256, data, 1024);
+    }
+  sha256finish_l (HashRes, &hws256, data, 576);
+  check (clear_M_a_256, HashRes, 32, error, "256", 4);
+
+  /* Test #5: All implementations of the block function agree, also if */
+  /* the implementation changes within a message                       */
+  for (i = 0; i < 1024; i++)
+    {
+      data[i] = (UCHAR)(i * 7 + 1);
+    }
+  for (impl = SHA_IMPL_C + 1; impl <= SHA_IMPL_BEST; impl++)
+    {
+      for (len = 0; len <= 300; len++)
+        {
+          shaimpl (SHA_IMPL_C);
+          sha256_l (HashRef, data, len);
+          shaimpl (impl);
+          sha256_l (HashRes, data, len);
+          if (memcmp (HashRef, HashRes, 32))
+            {
+              break;
+            }
+          if (len >= 64)
+            {
+              shaimpl (SHA_IMPL_C);
+              sha256init_l (&hws256);
+              error = sha256hash_l (&hws256, data, 64);
+              shaimpl (impl);
+              sha256finish_l (HashRes, &hws256, data + 64, len - 64);
+              if (error || memcmp (HashRef, HashRes, 32))
+                {
+                  break;
+                }
+            }
+        }
+      check (HashRef, HashRes, 32, error, "256", 5);
+    }
+
+  shaimpl (SHA_IMPL_BEST);
+
+  /* Test #6: 1 million times 'a', status exported after the first */
+  /* half, imported into a cleared status buffer and cloned        */
+  memset (data, 'a', 1024);
+  sha256init (&hws256);
+  for (i = 0; i < 488; i++)
+    {
+      error |= sha256hash (&hws256, data, 1024);
+    }
+  sha256export (StatBuf, &hws256);
+  memset (&hws256, 0, sizeof (hws256));
+  error |= sha256import (&hws256, StatBuf, SHA256STATLEN);
+  sha256clone (&hws256c, &hws256);
+  for (i = 488; i < 976; i++)
+    {
+      error |= sha256hash (&hws256, data, 1024);
+      error |= sha256hash (&hws256c, data, 1024);
+    }
+  sha256finish (HashRes, &hws256, data, 576);
+  check (clear_M_a_256, HashRes, 32, error, "256", 6);
+  sha256finish (HashRes, &hws256c, data, 576);
+  check (clear_M_a_256, HashRes, 32, error, "256", 6);
+
+  /* Test #7: Exported initial status, rejection of a wrong length,  */
+  /* a wrong tag and of a status within a block, status unchanged    */
+  sha256init (&hws256);
+  sha256export (StatBuf, &hws256);
+  check (stat_init_256, StatBuf, SHA256STATLEN, error, "256", 7);
+  if (sha256import (&hws256, StatBuf, SHA256STATLEN - 1) != E_CLINT_SHA
+      || sha256import (&hws256, StatBuf, SHA256STATLEN + 1) != E_CLINT_SHA)
+    {
+      error = 1;
+    }
+  StatBuf[SHA256STATLEN - 1] = 32;
+  if (sha256import (&hws256, StatBuf, SHA256STATLEN) != E_CLINT_SHA)
+    {
+      error = 2;
+    }
+  StatBuf[SHA256STATLEN - 1] = 0;
+  StatBuf[1] = 'H';
+  if (sha256import (&hws256, StatBuf, SHA256STATLEN) != E_CLINT_SHA)
+    {
+      error = 3;
+    }
+  sha256export (StatBuf, &hws256);
+  check (stat_init_256, StatBuf, SHA256STATLEN, error, "256", 7);
+
   printf ("All tests in %s passed.\n", __FILE__);
 
   return 0;
 }
 
 
-static int check (UCHAR *HashRef, UCHAR *HashRes, int Len, int error, UCHAR *shav, int test)
+static int check (UCHAR *HashRef, UCHAR *HashRes, int Len, int error, const char *shav, int test)
 {
   int i;
   if (error)
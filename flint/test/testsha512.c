@@ -0,0 +1,230 @@
+/******************************************************************************/
+/*                                                                            */
+/*  Software supplement to the book "Cryptography in C and C++"               */
+/*  by Michael Welschenbach                                                   */
+/*                                                                            */
+/*  Module testsha512.c     Revision: 19.10.2026                              */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 2001-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "flint.h"
+#include "sha512.h"
+
+
+static int check (UCHAR *HashRef, UCHAR *HashRes, int Len, int error, char *shav, int test);
+
+
+/* Reference values for SHA-512 */
+
+UCHAR clear_abc_512[] = {0xdd,0xaf,0x35,0xa1,0x93,0x61,0x7a,0xba,0xcc,0x41,0x73,0x49,0xae,0x20,0x41,0x31,0x12,0xe6,0xfa,0x4e,0x89,0xa9,0x7e,0xa2,0x0a,0x9e,0xee,0xe6,0x4b,0x55,0xd3,0x9a,0x21,0x92,0x99,0x2a,0x27,0x4f,0xc1,0xa8,0x36,0xba,0x3c,0x23,0xa3,0xfe,0xeb,0xbd,0x45,0x4d,0x44,0x23,0x64,0x3c,0xe8,0x0e,0x2a,0x9a,0xc9,0x4f,0xa5,0x4c,0xa4,0x9f};
+
+UCHAR clear_a_q_512[] = {0x20,0x4a,0x8f,0xc6,0xdd,0xa8,0x2f,0x0a,0x0c,0xed,0x7b,0xeb,0x8e,0x08,0xa4,0x16,0x57,0xc1,0x6e,0xf4,0x68,0xb2,0x28,0xa8,0x27,0x9b,0xe3,0x31,0xa7,0x03,0xc3,0x35,0x96,0xfd,0x15,0xc1,0x3b,0x1b,0x07,0xf9,0xaa,0x1d,0x3b,0xea,0x57,0x78,0x9c,0xa0,0x31,0xad,0x85,0xc7,0xa7,0x1d,0xd7,0x03,0x54,0xec,0x63,0x12,0x38,0xca,0x34,0x45};
+
+UCHAR clear_a_u_512[] = {0x8e,0x95,0x9b,0x75,0xda,0xe3,0x13,0xda,0x8c,0xf4,0xf7,0x28,0x14,0xfc,0x14,0x3f,0x8f,0x77,0x79,0xc6,0xeb,0x9f,0x7f,0xa1,0x72,0x99,0xae,0xad,0xb6,0x88,0x90,0x18,0x50,0x1d,0x28,0x9e,0x49,0x00,0xf7,0xe4,0x33,0x1b,0x99,0xde,0xc4,0xb5,0x43,0x3a,0xc7,0xd3,0x29,0xee,0xb6,0xdd,0x26,0x54,0x5e,0x96,0xe5,0x5b,0x87,0x4b,0xe9,0x09};
+
+UCHAR clear_M_a_512[] = {0xe7,0x18,0x48,0x3d,0x0c,0xe7,0x69,0x64,0x4e,0x2e,0x42,0xc7,0xbc,0x15,0xb4,0x63,0x8e,0x1f,0x98,0xb1,0x3b,0x20,0x44,0x28,0x56,0x32,0xa8,0x03,0xaf,0xa9,0x73,0xeb,0xde,0x0f,0xf2,0x44,0x87,0x7e,0xa6,0x0a,0x4c,0xb0,0x43,0x2c,0xe5,0x77,0xc3,0x1b,0xeb,0x00,0x9c,0x5c,0x2c,0x49,0xaa,0x2e,0x4e,0xad,0xb2,0x17,0xad,0x8c,0xc0,0x9b};
+
+/* Reference values for SHA-384 */
+
+UCHAR clear_abc_384[] = {0xcb,0x00,0x75,0x3f,0x45,0xa3,0x5e,0x8b,0xb5,0xa0,0x3d,0x69,0x9a,0xc6,0x50,0x07,0x27,0x2c,0x32,0xab,0x0e,0xde,0xd1,0x63,0x1a,0x8b,0x60,0x5a,0x43,0xff,0x5b,0xed,0x80,0x86,0x07,0x2b,0xa1,0xe7,0xcc,0x23,0x58,0xba,0xec,0xa1,0x34,0xc8,0x25,0xa7};
+
+UCHAR clear_a_q_384[] = {0x33,0x91,0xfd,0xdd,0xfc,0x8d,0xc7,0x39,0x37,0x07,0xa6,0x5b,0x1b,0x47,0x09,0x39,0x7c,0xf8,0xb1,0xd1,0x62,0xaf,0x05,0xab,0xfe,0x8f,0x45,0x0d,0xe5,0xf3,0x6b,0xc6,0xb0,0x45,0x5a,0x85,0x20,0xbc,0x4e,0x6f,0x5f,0xe9,0x5b,0x1f,0xe3,0xc8,0x45,0x2b};
+
+UCHAR clear_a_u_384[] = {0x09,0x33,0x0c,0x33,0xf7,0x11,0x47,0xe8,0x3d,0x19,0x2f,0xc7,0x82,0xcd,0x1b,0x47,0x53,0x11,0x1b,0x17,0x3b,0x3b,0x05,0xd2,0x2f,0xa0,0x80,0x86,0xe3,0xb0,0xf7,0x12,0xfc,0xc7,0xc7,0x1a,0x55,0x7e,0x2d,0xb9,0x66,0xc3,0xe9,0xfa,0x91,0x74,0x60,0x39};
+
+UCHAR clear_M_a_384[] = {0x9d,0x0e,0x18,0x09,0x71,0x64,0x74,0xcb,0x08,0x6e,0x83,0x4e,0x31,0x0a,0x4a,0x1c,0xed,0x14,0x9e,0x9c,0x00,0xf2,0x48,0x52,0x79,0x72,0xce,0xc5,0x70,0x4c,0x2a,0x5b,0x07,0xb8,0xb3,0xdc,0x38,0xec,0xc4,0xeb,0xae,0x97,0xdd,0xd8,0x7f,0x3d,0x89,0x85};
+
+/* Reference values for SHA-512/256 */
+
+UCHAR clear_abc_512_256[] = {0x53,0x04,0x8e,0x26,0x81,0x94,0x1e,0xf9,0x9b,0x2e,0x29,0xb7,0x6b,0x4c,0x7d,0xab,0xe4,0xc2,0xd0,0xc6,0x34,0xfc,0x6d,0x46,0xe0,0xe2,0xf1,0x31,0x07,0xe7,0xaf,0x23};
+
+UCHAR clear_a_q_512_256[] = {0xbd,0xe8,0xe1,0xf9,0xf1,0x9b,0xb9,0xfd,0x34,0x06,0xc9,0x0e,0xc6,0xbc,0x47,0xbd,0x36,0xd8,0xad,0xa9,0xf1,0x18,0x80,0xdb,0xc8,0xa2,0x2a,0x70,0x78,0xb6,0xa4,0x61};
+
+UCHAR clear_a_u_512_256[] = {0x39,0x28,0xe1,0x84,0xfb,0x86,0x90,0xf8,0x40,0xda,0x39,0x88,0x12,0x1d,0x31,0xbe,0x65,0xcb,0x9d,0x3e,0xf8,0x3e,0xe6,0x14,0x6f,0xea,0xc8,0x61,0xe1,0x9b,0x56,0x3a};
+
+UCHAR clear_M_a_512_256[] = {0x9a,0x59,0xa0,0x52,0x93,0x01,0x87,0xa9,0x70,0x38,0xca,0xe6,0x92,0xf3,0x07,0x08,0xaa,0x64,0x91,0x92,0x3e,0xf5,0x19,0x43,0x94,0xdc,0x68,0xd5,0x6c,0x74,0xfb,0x21};
+
+
+static char str_abc[] = "abc";
+static char str_a_q[] = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+static char str_a_u[] = "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu";
+
+int main ()
+{
+  int error = 0;
+  unsigned i;
+  SHA512STAT hws;
+  UCHAR HashRes[SHALEN512>>3];
+  UCHAR HashRef[SHALEN512>>3];
+  ULONG len;
+  UCHAR data[1024];
+
+  printf ("Testmodule %s, compiled for sha512.c as part of FLINT/C-Library\n", __FILE__);
+
+  printf ("Testing SHA-512\n");
+
+  /* Test #1: String "abc" */
+  sha512 (HashRes, (UCHAR *)str_abc, 3);
+  check (clear_abc_512, HashRes, 64, error, "512", 1);
+
+  /* Test #2: String "a-q", padding in one block */
+  sha512 (HashRes, (UCHAR *)str_a_q, 56);
+  check (clear_a_q_512, HashRes, 64, error, "512", 2);
+
+  /* Test #3: String "a-u", padding in two blocks */
+  sha512 (HashRes, (UCHAR *)str_a_u, 112);
+  check (clear_a_u_512, HashRes, 64, error, "512", 3);
+
+  /* Test #4: 1 million times 'a' in sha512hash() und sha512finish() */
+  memset (data, 'a', 1024);
+  sha512init (&hws);
+  for (i = 0; i < 976; i++)
+    {
+      error = sha512hash (&hws, data, 1024);
+    }
+  sha512finish (HashRes, &hws, data, 576);
+  check (clear_M_a_512, HashRes, 64, error, "512", 4);
+
+  /* Test #5: Blockwise hashing agrees with hashing in a single step, */
+  /* incomplete blocks are rejected by sha512hash()                  */
+  for (i = 0; i < 1024; i++)
+    {
+      data[i] = (UCHAR)(i * 7 + 1);
+    }
+  for (len = 0; len <= 400; len++)
+    {
+      sha512 (HashRef, data, len);
+      sha512init (&hws);
+      error = sha512hash (&hws, data, (len >> 7) << 7);
+      sha512finish (HashRes, &hws, data + ((len >> 7) << 7), len & 127);
+      if (error || memcmp (HashRef, HashRes, 64))
+        {
+          break;
+        }
+    }
+  if (!error && sha512hash (&hws, data, 64) != E_CLINT_SHA)
+    {
+      error = 1;
+    }
+  check (HashRef, HashRes, 64, error, "512", 5);
+
+  printf ("Testing SHA-384\n");
+
+  /* Test #1: String "abc" */
+  sha384 (HashRes, (UCHAR *)str_abc, 3);
+  check (clear_abc_384, HashRes, 48, error, "384", 1);
+
+  /* Test #2: String "a-q", padding in one block */
+  sha384 (HashRes, (UCHAR *)str_a_q, 56);
+  check (clear_a_q_384, HashRes, 48, error, "384", 2);
+
+  /* Test #3: String "a-u", padding in two blocks */
+  sha384 (HashRes, (UCHAR *)str_a_u, 112);
+  check (clear_a_u_384, HashRes, 48, error, "384", 3);
+
+  /* Test #4: 1 million times 'a' in sha384hash() und sha384finish() */
+  memset (data, 'a', 1024);
+  sha384init (&hws);
+  for (i = 0; i < 976; i++)
+    {
+      error = sha384hash (&hws, data, 1024);
+    }
+  sha384finish (HashRes, &hws, data, 576);
+  check (clear_M_a_384, HashRes, 48, error, "384", 4);
+
+  printf ("Testing SHA-512/256\n");
+
+  /* Test #1: String "abc" */
+  sha512_256 (HashRes, (UCHAR *)str_abc, 3);
+  check (clear_abc_512_256, HashRes, 32, error, "512/256", 1);
+
+  /* Test #2: String "a-q", padding in one block */
+  sha512_256 (HashRes, (UCHAR *)str_a_q, 56);
+  check (clear_a_q_512_256, HashRes, 32, error, "512/256", 2);
+
+  /* Test #3: String "a-u", padding in two blocks */
+  sha512_256 (HashRes, (UCHAR *)str_a_u, 112);
+  check (clear_a_u_512_256, HashRes, 32, error, "512/256", 3);
+
+  /* Test #4: 1 million times 'a' in sha512_256hash() und sha512_256finish() */
+  memset (data, 'a', 1024);
+  sha512_256init (&hws);
+  for (i = 0; i < 976; i++)
+    {
+      error = sha512_256hash (&hws, data, 1024);
+    }
+  sha512_256finish (HashRes, &hws, data, 576);
+  check (clear_M_a_512_256, HashRes, 32, error, "512/256", 4);
+
+  printf ("All tests in %s passed.\n", __FILE__);
+
+  return 0;
+}
+
+
+static int check (UCHAR *HashRef, UCHAR *HashRes, int Len, int error, char *shav, int test)
+{
+  int i;
+  if (error)
+    {
+      fprintf (stderr, "Error in SHA-%s in test %d: Error code %d\n", shav, test, error);
+    }
+
+  if (memcmp (HashRef, HashRes, Len))
+    {
+      fprintf (stderr, "Error in SHA-%s in test %d: Message Digest invalid\n", shav, test);
+      for (i = 0; i < Len; i++)
+        {
+          fprintf (stderr, "%2x ", HashRes[i] & 0x00ff);
+        }
+      fprintf (stderr, "\n");
+      exit (1);
+    }
+
+  fprintf (stderr, "Test #%d O.K.\n", test);
+
+  return 0;
+}
@@ -0,0 +1,400 @@
+/******************************************************************************/
+/*                                                                            */
+/*  Software supplement to the book "Cryptography in C and C++"               */
+/*  by Michael Welschenbach                                                   */
+/*                                                                            */
+/*  Module testsieve.c      Revision: 19.10.2026                              */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 2001-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+/*                                                                            */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "flint.h"
+
+#define MAXTESTLEN (CLINTMAXBIT)
+#define CLINTRNDLN (1 + ulrand64_l() % MAXTESTLEN)
+
+#define disperr_l(S,A) fprintf(stderr,"%s%s\n%u bit\n\n",(S),hexstr_l(A),ld_l(A))
+
+static USHORT ref_sieve (CLINT, unsigned int);
+static int special_tests (void);
+static int random_tests (int);
+static int prime_tests (int);
+static int genprimes_tests (void);
+static int iter_tests (void);
+static int check_primes (ULONG *, ULONG, int);
+static int check (CLINT, unsigned int, USHORT, USHORT, int);
+
+static unsigned int noofprimes[] = {0, 1, 2, 9, 10, 302, 1000,
+                                    NOOFSMALLPRIMES - 1, NOOFSMALLPRIMES,
+                                    NOOFSMALLPRIMES + 100};
+#define NOOFN (sizeof (noofprimes) / sizeof (noofprimes[0]))
+
+
+int main ()
+{
+  int impl;
+
+  printf ("Testmodule %s, compiled for FLINT/C-Library Version %s\n", __FILE__, verstr_l ());
+  initrand64_lt ();
+
+  for (impl = SIEVE_IMPL_C; impl <= SIEVE_IMPL_BEST; impl++)
+    {
+      if (sieveimpl_l (impl) != impl)
+        {
+          printf ("Implementation %d of sieve_l not available.\n", impl);
+          continue;
+        }
+      printf ("Tests of implementation %d of sieve_l ...\n", impl);
+      special_tests ();
+      random_tests (200);
+    }
+
+  prime_tests (200);
+  genprimes_tests ();
+  iter_tests ();
+
+  printf ("All tests in %s passed.\n", __FILE__);
+
+  return 0;
+}
+
+
+/* Small numbers, prime numbers and products of the sieving primes */
+static int
+special_tests (void)
+{
+  CLINT a_l, p_l, q_l;
+  USHORT pv, qv;
+  unsigned int i, k;
+
+  for (k = 0; k < 70000; k += (k < 2000) ? 1 : 97)
+    {
+      ul2clint_l (a_l, (ULONG)k);
+      for (i = 0; i < NOOFN; i++)
+        {
+          check (a_l, noofprimes[i], sieve_l (a_l, noofprimes[i]),
+                 ref_sieve (a_l, noofprimes[i]), __LINE__);
+        }
+    }
+
+  /* Products of two primes of the table, in particular the largest ones */
+  pv = 2;
+  for (i = 1; i < NOOFSMALLPRIMES; i++)
+    {
+      pv += smallprimes[i];
+      if (i > 20 && i < NOOFSMALLPRIMES - 20)
+        {
+          continue;
+        }
+      qv = 2;
+      for (k = 1; k <= i; k++)
+        {
+          qv += smallprimes[k];
+          if (k > 20 && k < NOOFSMALLPRIMES - 20)
+            {
+              continue;
+            }
+          u2clint_l (p_l, pv);
+          u2clint_l (q_l, qv);
+          mul_l (p_l, q_l, a_l);
+          check (a_l, NOOFSMALLPRIMES, sieve_l (a_l, NOOFSMALLPRIMES), qv, __LINE__);
+          check (a_l, k - 1, sieve_l (a_l, k - 1),
+                 ref_sieve (a_l, k - 1), __LINE__);
+
+          /* Large multiple of the primes */
+          rand_l (p_l, 1024);
+          mul_l (a_l, p_l, a_l);
+          check (a_l, NOOFSMALLPRIMES, sieve_l (a_l, NOOFSMALLPRIMES),
+                 ref_sieve (a_l, NOOFSMALLPRIMES), __LINE__);
+        }
+    }
+
+  return 0;
+}
+
+
+/* Random odd numbers of random length, with and without small factors */
+static int
+random_tests (int nooftests)
+{
+  CLINT a_l, p_l;
+  unsigned int i, j;
+  USHORT pv;
+
+  for (i = 0; i < (unsigned int)nooftests; i++)
+    {
+      rand_l (a_l, CLINTRNDLN);
+      if (ISEVEN_L (a_l))
+        {
+          inc_l (a_l);
+        }
+
+      if (i & 1)
+        {
+          /* Multiply by a random prime of the table */
+          pv = 2;
+          for (j = 1 + ulrand64_l () % (NOOFSMALLPRIMES - 1); j > 0; j--)
+            {
+              pv += smallprimes[j];
+            }
+          u2clint_l (p_l, pv);
+          if (ld_l (a_l) + 16 < CLINTMAXBIT)
+            {
+              mul_l (a_l, p_l, a_l);
+            }
+        }
+
+      for (j = 0; j < NOOFN; j++)
+        {
+          check (a_l, noofprimes[j], sieve_l (a_l, noofprimes[j]),
+                 ref_sieve (a_l, noofprimes[j]), __LINE__);
+        }
+    }
+
+  return 0;
+}
+
+
+/* prime_l gives the same results with both implementations of sieve_l */
+static int
+prime_tests (int nooftests)
+{
+  CLINT a_l;
+  int i, r;
+
+  printf ("Tests of prime_l with all implementations of sieve_l ...\n");
+
+  for (i = 0; i < nooftests; i++)
+    {
+      rand_l (a_l, 16 + (int)(ulrand64_l () % 1024));
+      setbit_l (a_l, 0);
+      sieveimpl_l (SIEVE_IMPL_C);
+      r = prime_l (a_l, 302, 5);
+      sieveimpl_l (SIEVE_IMPL_BEST);
+      if (r != prime_l (a_l, 302, 5))
+        {
+          disperr_l ("Result of prime_l depends on implementation of sieve_l, a_l = ", a_l);
+          exit (-1);
+        }
+    }
+
+  return 0;
+}
+
+
+/* genprimes for small bounds and bounds around the segments of the sieve */
+static int
+genprimes_tests (void)
+{
+  static ULONG bounds[] = {65521UL, 65536UL, 1018080UL, 1018081UL, 524287UL,
+                           524288UL, 524289UL, 1048575UL, 1048577UL, 3000017UL};
+  ULONG *primes;
+  unsigned int i;
+
+  printf ("Tests of genprimes ...\n");
+
+  for (i = 0; i < 3000; i++)
+    {
+      if ((primes = genprimes ((ULONG)i)) == NULL)
+        {
+          fprintf (stderr, "Error in genprimes: Memory allocation error\n");
+          exit (-1);
+        }
+      check_primes (primes, (ULONG)i, __LINE__);
+      free (primes);
+    }
+
+  for (i = 0; i < sizeof (bounds) / sizeof (bounds[0]); i++)
+    {
+      if ((primes = genprimes (bounds[i])) == NULL)
+        {
+          fprintf (stderr, "Error in genprimes: Memory allocation error\n");
+          exit (-1);
+        }
+      check_primes (primes, bounds[i], __LINE__);
+      free (primes);
+    }
+
+  return 0;
+}
+
+
+/* Prime iterator: Number of primes <= 10^7, largest bound of type ULONG */
+static int
+iter_tests (void)
+{
+  PRIMEITER it;
+  ULONG p, q = 0, count = 0, *primes;
+
+  printf ("Tests of the prime iterator ...\n");
+
+  if (initprimes_l (&it, 10000000UL) != E_CLINT_OK ||
+      (primes = genprimes (10000000UL)) == NULL)
+    {
+      fprintf (stderr, "Error in initprimes_l: Memory allocation error\n");
+      exit (-1);
+    }
+  while ((p = nextprime_l (&it)) != 0)
+    {
+      if (++count > primes[0] || p != primes[count] || p <= q)
+        {
+          fprintf (stderr, "Error in nextprime_l: Prime %lu is %lu\n",
+                   (unsigned long)count, (unsigned long)p);
+          exit (-1);
+        }
+      q = p;
+    }
+  if (count != 664579UL || primes[0] != count || nextprime_l (&it) != 0)
+    {
+      fprintf (stderr, "Error in nextprime_l: %lu primes <= 10^7\n",
+               (unsigned long)count);
+      exit (-1);
+    }
+  free (primes);
+  purgeprimes_l (&it);
+
+  if (initprimes_l (&it, 0xffffffffUL) != E_CLINT_OK)
+    {
+      fprintf (stderr, "Error in initprimes_l: Memory allocation error\n");
+      exit (-1);
+    }
+  for (p = 2, count = 0; count < NOOFSMALLPRIMES; p += smallprimes[++count])
+    {
+      if (nextprime_l (&it) != p)
+        {
+          fprintf (stderr, "Error in nextprime_l: Prime %lu\n",
+                   (unsigned long)count + 1);
+          exit (-1);
+        }
+    }
+  purgeprimes_l (&it);
+
+  return 0;
+}
+
+
+/* Comparison with a simple sieve of Eratosthenes */
+static int
+check_primes (ULONG *primes, ULONG N, int line)
+{
+  char *f;
+  ULONG i, k, count = 0;
+
+  if ((f = (char *)malloc ((size_t)N + 1)) == NULL)
+    {
+      fprintf (stderr, "Error in check_primes: Memory allocation error\n");
+      exit (-1);
+    }
+  memset (f, 1, (size_t)N + 1);
+
+  for (i = 2; i <= N; i++)
+    {
+      if (f[i])
+        {
+          for (k = i * i; i <= N / i && k <= N; k += i)
+            {
+              f[k] = 0;
+            }
+          if (++count > primes[0] || primes[count] != i)
+            {
+              fprintf (stderr, "Error in genprimes in line %d, N = %lu: Prime %lu\n",
+                       line, (unsigned long)N, (unsigned long)count);
+              exit (-1);
+            }
+        }
+    }
+  if (count != primes[0])
+    {
+      fprintf (stderr, "Error in genprimes in line %d, N = %lu: %lu primes\n",
+               line, (unsigned long)N, (unsigned long)primes[0]);
+      exit (-1);
+    }
+
+  free (f);
+  return 0;
+}
+
+
+/* Trial division by the first odd primes, one prime at a time */
+static USHORT
+ref_sieve (CLINT a_l, unsigned int n)
+{
+  USHORT qv = 2;
+  unsigned int i;
+
+  if (ISEVEN_L (a_l))
+    {
+      return equ_l (a_l, two_l) ? 1 : 2;
+    }
+
+  n = MAX (1, MIN (n, NOOFSMALLPRIMES - 1));
+  for (i = 1; i <= n; i++)
+    {
+      qv += smallprimes[i];
+      if (0 == umod_l (a_l, qv))
+        {
+          return (DIGITS_L (a_l) == 1 && *LSDPTR_L (a_l) == qv) ? 1 : qv;
+        }
+    }
+
+  return 0;
+}
+
+
+static int
+check (CLINT a_l, unsigned int n, USHORT r, USHORT ref, int line)
+{
+  if (r != ref)
+    {
+      fprintf (stderr, "Error in sieve_l in line %d, n = %u: %u instead of %u\n",
+               line, n, r, ref);
+      disperr_l ("a_l = ", a_l);
+      exit (-1);
+    }
+
+  return 0;
+}
@@ -0,0 +1,256 @@
+/******************************************************************************/
+/*                                                                            */
+/*  Software supplement to the book "Cryptography in C and C++"               */
+/*  by Michael Welschenbach                                                   */
+/*                                                                            */
+/*  Module teststrm.c       Revision: 19.10.2026                              */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 2001-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+
+/* POSIX interfaces for file descriptors */
+#define _XOPEN_SOURCE 600
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include "flint.h"
+#include "aes.h"
+#include "aesstrm.h"
+
+#define LEN (3*AESSTREAM_CHUNK + 37)
+
+static void strmtest (int test, int mode, int BlkLength, int DFlag,
+                      int Method, int Length);
+static void wronlytest (int test, int Length);
+static void check (UCHAR *Ref, UCHAR *Res, int Len, int error, int test);
+
+static UCHAR Key[32] = {0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe,
+                        0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+                        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7,
+                        0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4};
+
+static UCHAR IV[32] =  {0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
+                        0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff};
+
+static UCHAR *PT, *Ref, *Res;
+
+
+int main ()
+{
+  int i;
+
+  printf ("Testmodule %s, compiled for aesstrm.c as part of FLINT/C-Library\n", __FILE__);
+
+  PT = (UCHAR *)malloc (LEN);
+  Ref = (UCHAR *)malloc (LEN);
+  Res = (UCHAR *)malloc (LEN);
+  if (PT == NULL || Ref == NULL || Res == NULL)
+    {
+      fprintf (stderr, "Error in %s: Out of memory\n", __FILE__);
+      exit (1);
+    }
+
+  for (i = 0; i < LEN; i++)
+    {
+      PT[i] = (UCHAR)(i ^ (i >> 8));
+    }
+
+  /* Test #1, #2: CTR mode, arbitrary length */
+  strmtest (1, AES_CTR, 128, AES_ENC, AESSTREAM_MMAP, LEN);
+  strmtest (2, AES_CTR, 128, AES_ENC, AESSTREAM_BUFFERED, LEN);
+
+  /* Test #3 - #6: CBC mode, length multiple of block length */
+  strmtest (3, AES_CBC, 128, AES_ENC, AESSTREAM_MMAP, LEN - 5);
+  strmtest (4, AES_CBC, 128, AES_ENC, AESSTREAM_BUFFERED, LEN - 5);
+  strmtest (5, AES_CBC, 128, AES_DEC, AESSTREAM_AUTO, LEN - 5);
+  strmtest (6, AES_CBC, 128, AES_DEC, AESSTREAM_BUFFERED, 2*AESSTREAM_CHUNK);
+
+  /* Test #7: Empty file */
+  strmtest (7, AES_CTR, 128, AES_ENC, AESSTREAM_AUTO, 0);
+
+  /* Test #8: Output file opened write-only cannot be memory mapped */
+  wronlytest (8, LEN - 5);
+
+  /* Test #9 - #11: 192-bit blocks do not divide the chunk and window sizes */
+  strmtest (9, AES_CBC, 192, AES_ENC, AESSTREAM_MMAP, LEN - LEN % 24);
+  strmtest (10, AES_CBC, 192, AES_DEC, AESSTREAM_BUFFERED, LEN - LEN % 24);
+  strmtest (11, AES_ECB, 192, AES_ENC, AESSTREAM_AUTO, LEN - LEN % 24);
+
+  free (PT);
+  free (Ref);
+  free (Res);
+
+  printf ("All tests in %s passed.\n", __FILE__);
+
+  return 0;
+}
+
+
+static void strmtest (int test, int mode, int BlkLength, int DFlag,
+                      int Method, int Length)
+{
+  AESWORKSPACE ws;
+  AESKEYSCHED ks;
+  FILE *in, *out;
+  int i, n, error;
+
+  /* Reference result computed in memory */
+  AESInit (&ws, mode, BlkLength, IV, &ks, Key, 256, DFlag);
+  AESCrypt (Ref, &ws, &ks, PT, Length);
+
+  in = tmpfile ();
+  out = tmpfile ();
+  if (in == NULL || out == NULL || (int)fwrite (PT, 1, Length, in) != Length)
+    {
+      fprintf (stderr, "Error in %s: Temporary files cannot be written\n", __FILE__);
+      exit (1);
+    }
+  fflush (in);
+  lseek (fileno (in), 0, SEEK_SET);
+
+  AESInit (&ws, mode, BlkLength, IV, &ks, Key, 256, DFlag);
+  error = AESCryptFd (fileno (out), fileno (in), &ws, &ks, Method);
+
+  lseek (fileno (out), 0, SEEK_SET);
+  for (i = 0; i < Length; i += n)
+    {
+      if ((n = (int)read (fileno (out), Res + i, Length - i)) <= 0)
+        {
+          break;
+        }
+    }
+
+  check (Ref, Res, Length, error || i != Length, test);
+
+  /* ECB and CBC mode require a multiple of the block length */
+  if (mode == AES_CBC && Method == AESSTREAM_MMAP)
+    {
+      fflush (in);
+      ftruncate (fileno (in), Length - 1);
+      lseek (fileno (in), 0, SEEK_SET);
+      lseek (fileno (out), 0, SEEK_SET);
+      AESInit (&ws, mode, BlkLength, IV, &ks, Key, 256, DFlag);
+      if (AESCryptFd (fileno (out), fileno (in), &ws, &ks, Method) != AES_ERR_BLKLENGTH)
+        {
+          fprintf (stderr, "Error in %s in test %d: Invalid length not detected\n", __FILE__, test);
+          exit (1);
+        }
+    }
+
+  fclose (in);
+  fclose (out);
+  AESPurge (&ws, &ks);
+  fprintf (stderr, "Test #%d O.K.\n", test);
+}
+
+
+static void wronlytest (int test, int Length)
+{
+  AESWORKSPACE ws;
+  AESKEYSCHED ks;
+  FILE *in;
+  char Name[] = "teststrmXXXXXX";
+  int OutFd, RdFd, i, n, error;
+
+  AESInit (&ws, AES_CBC, 128, IV, &ks, Key, 256, AES_ENC);
+  AESCrypt (Ref, &ws, &ks, PT, Length);
+
+  in = tmpfile ();
+  if (in == NULL || (int)fwrite (PT, 1, Length, in) != Length ||
+      (RdFd = mkstemp (Name)) < 0)
+    {
+      fprintf (stderr, "Error in %s: Temporary files cannot be written\n", __FILE__);
+      exit (1);
+    }
+  fflush (in);
+  OutFd = open (Name, O_WRONLY | O_TRUNC);
+  unlink (Name);
+  if (OutFd < 0)
+    {
+      fprintf (stderr, "Error in %s: Temporary file cannot be opened\n", __FILE__);
+      exit (1);
+    }
+
+  /* Explicit memory mapping is refused before the output is touched */
+  lseek (fileno (in), 0, SEEK_SET);
+  AESInit (&ws, AES_CBC, 128, IV, &ks, Key, 256, AES_ENC);
+  if (AESCryptFd (OutFd, fileno (in), &ws, &ks, AESSTREAM_MMAP) != AES_ERR_IO ||
+      lseek (RdFd, 0, SEEK_END) != 0)
+    {
+      fprintf (stderr, "Error in %s in test %d: Write-only output mapped\n", __FILE__, test);
+      exit (1);
+    }
+
+  /* Automatic selection falls back to buffered processing */
+  lseek (fileno (in), 0, SEEK_SET);
+  AESInit (&ws, AES_CBC, 128, IV, &ks, Key, 256, AES_ENC);
+  error = AESCryptFd (OutFd, fileno (in), &ws, &ks, AESSTREAM_AUTO);
+
+  lseek (RdFd, 0, SEEK_SET);
+  for (i = 0; i < Length; i += n)
+    {
+      if ((n = (int)read (RdFd, Res + i, Length - i)) <= 0)
+        {
+          break;
+        }
+    }
+
+  check (Ref, Res, Length, error || i != Length, test);
+
+  fclose (in);
+  close (OutFd);
+  close (RdFd);
+  AESPurge (&ws, &ks);
+  fprintf (stderr, "Test #%d O.K.\n", test);
+}
+
+
+static void check (UCHAR *Ref, UCHAR *Res, int Len, int error, int test)
+{
+  if (error || memcmp (Ref, Res, Len))
+    {
+      fprintf (stderr, "Error in %s in test %d\n", __FILE__, test);
+      exit (1);
+    }
+}
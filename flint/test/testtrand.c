@@ -0,0 +1,213 @@
+/******************************************************************************/
+/*                                                                            */
+/*  Software supplement to the book "Cryptography in C and C++"               */
+/*  by Michael Welschenbach                                                   */
+/*                                                                            */
+/*  Module testtrand.c      Revision: 19.10.2026                              */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 2001-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "flint.h"
+#include "threadrand.h"
+
+#define RESEED     1000
+#define NTHREADS   4
+#define THREADLEN  4096
+
+static void *Worker (void *arg);
+static int check (int error, char *func, int test);
+
+static UCHAR Out[NTHREADS][THREADLEN];
+static int Err[NTHREADS];
+
+
+int main ()
+{
+  pthread_t th[NTHREADS];
+  STATEPRNG T;
+  UCHAR buf[4000], ref[4000];
+  CLINT r_l;
+  int error = 0, i, j, fd[2], status;
+  pid_t pid;
+
+  printf ("Testmodule %s, compiled for threadrand.c as part of FLINT/C-Library\n", __FILE__);
+
+  /* Test #1: Parameters are checked before first use */
+  if (InitThreadRand_l (FLINT_RND64, RESEED) != E_THREADRAND_ARG ||
+      InitThreadRand_l (FLINT_RNDAES, 0) != E_THREADRAND_ARG ||
+      InitThreadRand_l (FLINT_RNDAES, RESEED) != 0)
+    {
+      error = 1;
+    }
+  check (error, "InitThreadRand_l", 1);
+
+  /* Test #2: Threads get PRNGs of their own, each one reseeded several times */
+  for (i = 0; i < NTHREADS; i++)
+    {
+      pthread_create (&th[i], NULL, Worker, &Err[i]);
+    }
+  for (i = 0; i < NTHREADS; i++)
+    {
+      pthread_join (th[i], NULL);
+      error |= Err[i];
+    }
+  for (i = 0; i < NTHREADS && !error; i++)
+    {
+      for (j = i + 1; j < NTHREADS; j++)
+        {
+          if (!memcmp (Out[i], Out[j], 64) ||
+              !memcmp (Out[i] + RESEED, Out[j] + RESEED, 64))
+            {
+              error = 1;
+            }
+        }
+    }
+  check (error, "ThreadRandBytes_l", 2);
+
+  /* Test #3: Output is taken from the state of the thread until the  */
+  /* reseed interval is exhausted                                     */
+  error = ThreadRandBytes_l (buf, 1);
+  T = *ThreadRandState_l ();
+  if (!error)
+    {
+      error = ThreadRandBytes_l (buf, sizeof (buf));
+    }
+  RandBytes_l (ref, sizeof (ref), &T);
+  if (!error && (memcmp (buf, ref, RESEED - 1) ||
+                 !memcmp (buf + RESEED - 1, ref + RESEED - 1, 64)))
+    {
+      error = 1;
+    }
+  check (error, "ThreadRandBytes_l", 3);
+
+  /* Test #4: 8, 16 and 32 bit values and CLINT values */
+  PurgeThreadRand_l ();
+  T = *ThreadRandState_l ();
+  RandBytes_l (ref, 7, &T);
+  if (bThreadRand_l () != ref[0] ||
+      sThreadRand_l () != (USHORT)((ref[1] << 8) | ref[2]) ||
+      lThreadRand_l () != (((ULONG)ref[3] << 24) | ((ULONG)ref[4] << 16) |
+                           ((ULONG)ref[5] << 8) | (ULONG)ref[6]))
+    {
+      error = 1;
+    }
+  for (i = 0; i <= (int)CLINTMAXBIT && !error; i += 97)
+    {
+      error = ThreadRand_l (r_l, i);
+      if (!error && ld_l (r_l) != (unsigned int)i)
+        {
+          error = 1;
+        }
+    }
+  check (error, "bThreadRand_l, sThreadRand_l, lThreadRand_l, ThreadRand_l", 4);
+
+  /* Test #5: After fork the child reseeds, parent and child output differ */
+  ThreadRandBytes_l (buf, 1);
+  pipe (fd);
+  if ((pid = fork ()) == 0)
+    {
+      close (fd[0]);
+      ThreadRandBytes_l (buf, 64);
+      write (fd[1], buf, 64);
+      close (fd[1]);
+      _exit (0);
+    }
+  close (fd[1]);
+  error = ThreadRandBytes_l (ref, 64);
+  if (read (fd[0], buf, 64) != 64 || !memcmp (buf, ref, 64))
+    {
+      error = 1;
+    }
+  close (fd[0]);
+  waitpid (pid, &status, 0);
+  check (error, "ThreadRandBytes_l after fork", 5);
+
+  /* Test #6: Parameters cannot be changed any more */
+  if (InitThreadRand_l (FLINT_RNDRMDSHA1, RESEED) != E_THREADRAND_INI)
+    {
+      error = 1;
+    }
+  check (error, "InitThreadRand_l", 6);
+
+  PurgeThreadRand_l ();
+
+  printf ("All tests in %s passed.\n", __FILE__);
+
+  return 0;
+}
+
+
+/* Worker thread: Random bytes in pieces of varying length */
+static void *Worker (void *arg)
+{
+  int i = (int)((int *)arg - Err);
+  ULONG pos, n;
+
+  for (pos = 0; pos < THREADLEN && !Err[i]; pos += n)
+    {
+      n = MIN ((pos * 7 + 5) % 300 + 1, THREADLEN - pos);
+      Err[i] = ThreadRandBytes_l (Out[i] + pos, n);
+    }
+
+  return NULL;
+}
+
+
+static int check (int error, char *func, int test)
+{
+  if (error)
+    {
+      fprintf (stderr, "Error in %s in test %d: Error code %d\n", func, test, error);
+      exit (1);
+    }
+
+  fprintf (stderr, "Test #%d O.K.\n", test);
+
+  return 0;
+}
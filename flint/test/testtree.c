@@ -0,0 +1,375 @@
+/******************************************************************************/
+/*                                                                            */
+/*  Software supplement to the book "Cryptography in C and C++"               */
+/*  by Michael Welschenbach                                                   */
+/*                                                                            */
+/*  Module testtree.c       Revision: 19.10.2026                              */
+/*                                                                            */
+/*  Copyright (C) 1998-2005 by Michael Welschenbach                           */
+/*  Copyright (C) 2001-2005 by Springer-Verlag Berlin, Heidelberg             */
+/*  Copyright (C) 2001-2005 by Apress L.P., Berkeley, CA                      */
+/*  Copyright (C) 2002-2005 by Wydawnictwa MIKOM, Poland                      */
+/*  Copyright (C) 2002-2005 by PHEI, P.R.China                                */
+/*  Copyright (C) 2002-2005 by InfoBook, Korea                                */
+/*  Copyright (C) 2002-2005 by Triumph Publishing, Russia                     */
+/*                                                                            */
+/*  All Rights Reserved                                                       */
+/*                                                                            */
+/*  The software may be used for noncommercial purposes and may be altered,   */
+/*  as long as the following conditions are accepted without any              */
+/*  qualification:                                                            */
+/*                                                                            */
+/*  (1) All changes to the sources must be identified in such a way that the  */
+/*      changed software cannot be misinterpreted as the original software.   */
+/*                                                                            */
+/*  (2) The statements of copyright may not be removed or altered.            */
+/*                                                                            */
+/*  (3) The following DISCLAIMER is accepted:                                 */
+/*                                                                            */
+/*  DISCLAIMER:                                                               */
+/*                                                                            */
+/*  There is no warranty for the software contained in this distribution, to  */
+/*  the extent permitted by applicable law. The copyright holders provide the */
+/*  software `as is' without warranty of any kind, either expressed or        */
+/*  implied, including, but not limited to, the implied warranty of fitness   */
+/*  for a particular purpose. The entire risk as to the quality and           */
+/*  performance of the program is with you.                                   */
+/*                                                                            */
+/*  In no event unless required by applicable law or agreed to in writing     */
+/*  will the copyright holders, or any of the individual authors named in     */
+/*  the source files, be liable to you for damages, including any general,    */
+/*  special, incidental or consequential damages arising out of any use of    */
+/*  the software or out of inability to use the software (including but not   */
+/*  limited to any financial losses, loss of data or data being rendered      */
+/*  inaccurate or losses sustained by you or by third parties as a result of  */
+/*  a failure of the software to operate with any other programs), even if    */
+/*  such holder or other party has been advised of the possibility of such    */
+/*  damages.                                                                  */
+
+
+/* POSIX interfaces for pipes and threads */
+#define _XOPEN_SOURCE 600
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "flint.h"
+#include "sha256.h"
+#include "hashtree.h"
+
+#define MAXLEN   (1L << 20)
+#define HLEN     HASHTREE_HASHLEN
+
+/* Leaves given to hashtreeleaf_l by one of the feeding threads */
+typedef struct
+{
+  HASHTREE *ht;
+  UCHAR *data;
+  ULONG len;
+  ULONG LeafSize;
+  int First, Step;
+  int Error;
+} FEEDER;
+
+/* Message written into a pipe by a writer thread */
+typedef struct
+{
+  int fd;
+  UCHAR *data;
+  ULONG len;
+} WRITER;
+
+static void reftree (UCHAR *Root, UCHAR *data, ULONG len, ULONG LeafSize, int FanOut);
+static void *feed (void *arg);
+static void *writer (void *arg);
+static int check (UCHAR *HashRef, UCHAR *HashRes, int error, int test);
+
+
+int main ()
+{
+  UCHAR Root[HLEN], Ref[HLEN];
+  UCHAR *data;
+  HASHTREE ht;
+  FEEDER fd[4];
+  WRITER wr;
+  pthread_t tid[4];
+  FILE *f;
+  int pfd[2];
+  static ULONG LeafSizes[] = {64, 128, 192};
+  static int FanOuts[] = {2, 3, 16};
+  static int Threads[] = {1, 2, 3, 8, 0};
+  ULONG len, i, n;
+  int error = 0, l, k, t;
+
+  printf ("Testmodule %s, compiled for hashtree.c as part of FLINT/C-Library\n", __FILE__);
+
+  if ((data = (UCHAR *)malloc (MAXLEN)) == NULL)
+    {
+      fprintf (stderr, "Error: out of memory\n");
+      exit (1);
+    }
+  for (i = 0; i < MAXLEN; i++)
+    {
+      data[i] = (UCHAR)((i * 2654435761UL) >> 13);
+    }
+
+  /* Test #1: Root agrees with a direct computation of the tree */
+  for (l = 0; l < 3 && !error; l++)
+    {
+      for (k = 0; k < 3 && !error; k++)
+        {
+          for (len = 0; len <= 2500 && !error; len += (len < 300) ? 1 : 61)
+            {
+              reftree (Ref, data, len, LeafSizes[l], FanOuts[k]);
+              error = hashtree_l (Root, data, len, LeafSizes[l], FanOuts[k], 1);
+              if (!error && memcmp (Ref, Root, HLEN))
+                {
+                  break;
+                }
+              error = hashtree_l (Root, data, len, LeafSizes[l], FanOuts[k], 4);
+              if (!error && memcmp (Ref, Root, HLEN))
+                {
+                  break;
+                }
+            }
+        }
+    }
+  check (Ref, Root, error, 1);
+
+  /* Test #2: Root does not depend on the number of threads */
+  reftree (Ref, data, MAXLEN - 1000, 4096, 4);
+  for (t = 0; t < 5 && !error; t++)
+    {
+      error = hashtree_l (Root, data, MAXLEN - 1000, 4096, 4, Threads[t]);
+      if (!error && memcmp (Ref, Root, HLEN))
+        {
+          break;
+        }
+    }
+  check (Ref, Root, error, 2);
+
+  /* Test #3: Leaves given in reverse order */
+  len = MAXLEN - 1000;
+  n = HASHTREE_LEAVES (len, 4096);
+  error = hashtreeinit (&ht, 4096, 4);
+  for (i = n; i > 0 && !error; i--)
+    {
+      error = hashtreeleaf (&ht, i - 1, data + (i - 1) * 4096,
+                            (i == n) ? len - (n - 1) * 4096 : 4096);
+    }
+  if (!error)
+    {
+      error = hashtreefinish (Root, &ht, n);
+    }
+  check (Ref, Root, error, 3);
+
+  /* Test #4: Leaves given by four threads concurrently */
+  error = hashtreeinit (&ht, 4096, 4);
+  for (t = 0; t < 4 && !error; t++)
+    {
+      fd[t].ht = &ht;
+      fd[t].data = data;
+      fd[t].len = len;
+      fd[t].LeafSize = 4096;
+      fd[t].First = 3 - t;
+      fd[t].Step = 4;
+      fd[t].Error = 0;
+      pthread_create (&tid[t], NULL, feed, &fd[t]);
+    }
+  for (t = 0; t < 4; t++)
+    {
+      pthread_join (tid[t], NULL);
+      error |= fd[t].Error;
+    }
+  if (!error)
+    {
+      error = hashtreefinish (Root, &ht, n);
+    }
+  check (Ref, Root, error, 4);
+
+  /* Test #5: Invalid parameters and leaves are rejected */
+  if (hashtreeinit (&ht, 100, 4) != E_HASHTREE_ARG ||
+      hashtreeinit (&ht, 64, 1) != E_HASHTREE_ARG ||
+      hashtreeinit (&ht, 64, HASHTREE_MAXFANOUT + 1) != E_HASHTREE_ARG ||
+      hashtree (Root, data, 1000, 0, 4, 1) != E_HASHTREE_ARG)
+    {
+      error = 1;
+    }
+  /* Leaf given twice, leaf too long */
+  hashtreeinit (&ht, 64, 4);
+  if (hashtreeleaf (&ht, 2, data, 64) != 0 ||
+      hashtreeleaf (&ht, 2, data, 64) != E_HASHTREE_LEAF ||
+      hashtreeleaf (&ht, 3, data, 65) != E_HASHTREE_LEAF)
+    {
+      error = 1;
+    }
+  /* Short leaf followed by a later leaf, short leaf before a later leaf */
+  if (hashtreeleaf (&ht, 1, data, 10) != E_HASHTREE_LEAF ||
+      hashtreeleaf (&ht, 4, data, 10) != 0 ||
+      hashtreeleaf (&ht, 5, data, 64) != E_HASHTREE_LEAF)
+    {
+      error = 1;
+    }
+  /* Leaves 0, 1 and 3 missing */
+  if (hashtreefinish (Root, &ht, 5) != E_HASHTREE_MISSING)
+    {
+      error = 1;
+    }
+  /* Leaf beyond the announced end of the message */
+  hashtreeinit (&ht, 64, 4);
+  hashtreeleaf (&ht, 0, data, 64);
+  hashtreeleaf (&ht, 1, data, 64);
+  if (hashtreefinish (Root, &ht, 1) != E_HASHTREE_MISSING)
+    {
+      error = 1;
+    }
+  check (Root, Root, error, 5);
+
+  /* Test #6: Regular file, hashed by positioned reads */
+  len = MAXLEN - 1000;
+  if ((f = tmpfile ()) == NULL ||
+      fwrite (data, 1, len, f) != len || fflush (f) != 0)
+    {
+      fprintf (stderr, "Error: temporary file could not be written\n");
+      exit (1);
+    }
+  for (t = 0; t < 5 && !error; t++)
+    {
+      error = hashtreefd (Root, fileno (f), 4096, 4, Threads[t]);
+      if (!error && memcmp (Ref, Root, HLEN))
+        {
+          break;
+        }
+    }
+  fclose (f);
+  check (Ref, Root, error, 6);
+
+  /* Test #7: Pipe, hashed sequentially */
+  if (pipe (pfd) != 0)
+    {
+      fprintf (stderr, "Error: pipe could not be created\n");
+      exit (1);
+    }
+  wr.fd = pfd[1];
+  wr.data = data;
+  wr.len = len;
+  pthread_create (&tid[0], NULL, writer, &wr);
+  error = hashtreefd (Root, pfd[0], 4096, 4, 0);
+  pthread_join (tid[0], NULL);
+  close (pfd[0]);
+  check (Ref, Root, error, 7);
+
+  free (data);
+
+  printf ("All tests in %s passed.\n", __FILE__);
+
+  return 0;
+}
+
+
+/* Direct computation of the tree following its definition in hashtree.h */
+static void reftree (UCHAR *Root, UCHAR *data, ULONG len, ULONG LeafSize, int FanOut)
+{
+  UCHAR *Level, *Buf;
+  ULONG n, i, j, k, l;
+
+  n = (len == 0) ? 1 : (len - 1) / LeafSize + 1;
+  Level = (UCHAR *)malloc (n * HLEN);
+  Buf = (UCHAR *)malloc (LeafSize + FanOut * HLEN + 1);
+  if (Level == NULL || Buf == NULL)
+    {
+      fprintf (stderr, "Error: out of memory\n");
+      exit (1);
+    }
+
+  for (i = 0; i < n; i++)
+    {
+      l = (len - i * LeafSize < LeafSize) ? len - i * LeafSize : LeafSize;
+      memcpy (Buf, data + i * LeafSize, l);
+      Buf[l] = 0x00;
+      sha256 (Level + i * HLEN, Buf, l + 1);
+    }
+
+  for (; n > 1; n = j)
+    {
+      for (i = 0, j = 0; i < n; i += k, j++)
+        {
+          k = (n - i < (ULONG)FanOut) ? n - i : (ULONG)FanOut;
+          memcpy (Buf, Level + i * HLEN, k * HLEN);
+          Buf[k * HLEN] = 0x01;
+          sha256 (Level + j * HLEN, Buf, k * HLEN + 1);
+        }
+    }
+
+  memcpy (Root, Level, HLEN);
+  free (Level);
+  free (Buf);
+}
+
+
+static void *feed (void *arg)
+{
+  FEEDER *fd = (FEEDER *)arg;
+  ULONG n = HASHTREE_LEAVES (fd->len, fd->LeafSize);
+  ULONG i, l;
+
+  for (i = fd->First; i < n && !fd->Error; i += fd->Step)
+    {
+      l = (fd->len - i * fd->LeafSize < fd->LeafSize) ?
+          fd->len - i * fd->LeafSize : fd->LeafSize;
+      fd->Error = hashtreeleaf (fd->ht, i, fd->data + i * fd->LeafSize, l);
+    }
+
+  return NULL;
+}
+
+
+static void *writer (void *arg)
+{
+  WRITER *wr = (WRITER *)arg;
+  ULONG done = 0;
+  ssize_t n;
+
+  /* Irregular chunks, partial leaves arrive at the reader */
+  while (done < wr->len)
+    {
+      n = write (wr->fd, wr->data + done,
+                 (wr->len - done < 1000) ? wr->len - done : 1000);
+      if (n <= 0)
+        {
+          break;
+        }
+      done += (ULONG)n;
+    }
+  close (wr->fd);
+
+  return NULL;
+}
+
+
+static int check (UCHAR *HashRef, UCHAR *HashRes, int error, int test)
+{
+  int i;
+  if (error)
+    {
+      fprintf (stderr, "Error in tree hash in test %d: Error code %d\n", test, error);
+      exit (1);
+    }
+
+  if (memcmp (HashRef, HashRes, HLEN))
+    {
+      fprintf (stderr, "Error in tree hash in test %d: Root invalid\n", test);
+      for (i = 0; i < HLEN; i++)
+        {
+          fprintf (stderr, "%2x ", HashRes[i] & 0x00ff);
+        }
+      fprintf (stderr, "\n");
+      exit (1);
+    }
+
+  fprintf (stderr, "Test #%d O.K.\n", test);
+
+  return 0;
+}